@@ -45,6 +45,7 @@ BEGIN {
 	myFixedClasses["AIException"] = 1;
 	myFixedClasses["CallbackAIException"] = 1;
 	myFixedClasses["EventAIException"] = 1;
+	myFixedClasses["UnitStates"] = 1;
 
 	MAX_IDS = 1024;
 
@@ -60,6 +61,10 @@ function doWrappOO(funcFullName_dw, params_dw, metaComment_dw) {
 	doWrapp_dw = 1;
 
 	#doWrapp_dw = doWrapp_dw && !match(funcFullName_dw, /Lua_callRules/) && !match(funcFullName_dw, /Lua_callUI/);
+	# these fill several arrays per call, see the hand-written UnitStates class
+	doWrapp_dw = doWrapp_dw && !match(funcFullName_dw, /^getUnitStates/);
+	# reads one array and writes another, use the C callback directly
+	doWrapp_dw = doWrapp_dw && !match(funcFullName_dw, /getResourceMapSpotsNearestBatch/);
 
 	return doWrapp_dw;
 }
@@ -0,0 +1,62 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "UnitStates.h"
+
+#include "CombinedCallbackBridge.h"
+
+#include <algorithm>
+
+// initial array size for FetchIn, before the first result is known
+static const int MIN_FETCH_CAPACITY = 64;
+
+springai::UnitStates::UnitStates(int skirmishAIId)
+	: skirmishAIId(skirmishAIId)
+{
+}
+
+
+
+void springai::UnitStates::Resize(int numUnits) {
+
+	unitIds.resize(numUnits);
+	positions.resize(numUnits * 3);
+	velocities.resize(numUnits * 3);
+	healths.resize(numUnits);
+	unitDefIds.resize(numUnits);
+	teamIds.resize(numUnits);
+}
+
+int springai::UnitStates::Fetch(const std::vector<int>& ids) {
+
+	Resize(ids.size());
+
+	if (ids.empty())
+		return 0;
+
+	// copied since the C interface takes a non-const array
+	unitIds = ids;
+
+	return bridged_getUnitStates(skirmishAIId, &unitIds[0], GetSize(), &positions[0], &velocities[0], &healths[0], &unitDefIds[0], &teamIds[0]);
+}
+
+int springai::UnitStates::FetchIn(int allegiances, const AIFloat3& pos, float radius) {
+
+	float pos_posF3[3];
+	pos.LoadInto(pos_posF3);
+
+	// fetch straight into the arrays at their current capacity; a full
+	// result may have been truncated, so only then grow and fetch again
+	int numUnits = 0;
+
+	for (int maxUnits = std::max(static_cast<int>(unitIds.capacity()), MIN_FETCH_CAPACITY); ; maxUnits *= 2) {
+		Resize(maxUnits);
+
+		numUnits = bridged_getUnitStatesIn(skirmishAIId, allegiances, pos_posF3, radius, &unitIds[0], &positions[0], &velocities[0], &healths[0], &unitDefIds[0], &teamIds[0], maxUnits);
+
+		if (numUnits < maxUnits)
+			break;
+	}
+
+	Resize(numUnits);
+	return GetSize();
+}
@@ -0,0 +1,64 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _CPPWRAPPER_UNIT_STATES_H
+#define _CPPWRAPPER_UNIT_STATES_H
+
+#include <vector>
+
+#include "AIFloat3.h"
+#include "ExternalAI/Interface/SSkirmishAICallback.h" // UNIT_ALLEGIANCE_*
+
+namespace springai {
+
+/**
+ * State of a set of units, stored as parallel arrays (one element per unit)
+ * and fetched with a single callback call; see getUnitStates and
+ * getUnitStatesIn in SSkirmishAICallback.h for the visibility rules.
+ * The arrays are reused by successive Fetch* calls on the same instance,
+ * which may only be made once the AI's OOAICallback has been created.
+ */
+class UnitStates {
+public:
+
+	UnitStates(int skirmishAIId);
+
+	/// fetches the state of the units in <ids>
+	int Fetch(const std::vector<int>& ids);
+
+	/// fetches the state of all units of the given allegiances (UNIT_ALLEGIANCE_* mask) in an area
+	int FetchIn(int allegiances, const AIFloat3& pos, float radius);
+
+	int GetSize() const { return (static_cast<int>(unitIds.size())); }
+
+	int GetUnitId(int i) const { return unitIds[i]; }
+	AIFloat3 GetPos(int i) const { return (AIFloat3(positions[i * 3 + 0], positions[i * 3 + 1], positions[i * 3 + 2])); }
+	AIFloat3 GetVel(int i) const { return (AIFloat3(velocities[i * 3 + 0], velocities[i * 3 + 1], velocities[i * 3 + 2])); }
+	float GetHealth(int i) const { return healths[i]; }
+	int GetUnitDefId(int i) const { return unitDefIds[i]; }
+	int GetTeamId(int i) const { return teamIds[i]; }
+
+	/// raw arrays, positions and velocities hold 3 floats per unit
+	const std::vector<int>& GetUnitIds() const { return unitIds; }
+	const std::vector<float>& GetPositions() const { return positions; }
+	const std::vector<float>& GetVelocities() const { return velocities; }
+	const std::vector<float>& GetHealths() const { return healths; }
+	const std::vector<int>& GetUnitDefIds() const { return unitDefIds; }
+	const std::vector<int>& GetTeamIds() const { return teamIds; }
+
+private:
+	void Resize(int numUnits);
+
+private:
+	int skirmishAIId;
+
+	std::vector<int> unitIds;
+	std::vector<float> positions;
+	std::vector<float> velocities;
+	std::vector<float> healths;
+	std::vector<int> unitDefIds;
+	std::vector<int> teamIds;
+}; // class UnitStates
+
+}  // namespace springai
+
+#endif // _CPPWRAPPER_UNIT_STATES_H
@@ -129,6 +129,7 @@ local flexCallIns = {
   'UnitCommand',
   'UnitCmdDone',
   'UnitDamaged',
+  'UnitDamagedBatch',
   'UnitStunned',
   'UnitEnteredRadar',
   'UnitEnteredLos',
@@ -1892,6 +1893,13 @@ function widgetHandler:UnitDamaged(unitID, unitDefID, unitTeam, damage, paralyze
   return
 end
 
+function widgetHandler:UnitDamagedBatch(count, ...)
+  for _,w in ipairs(self.UnitDamagedBatchList) do
+    w:UnitDamagedBatch(count, ...)
+  end
+  return
+end
+
 function widgetHandler:UnitStunned(unitID, unitDefID, unitTeam, stunned)
   for _,w in ipairs(self.UnitStunnedList) do
     w:UnitStunned(unitID, unitDefID, unitTeam, stunned)
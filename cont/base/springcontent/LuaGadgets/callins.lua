@@ -55,6 +55,7 @@ CALLIN_LIST = {
 	"UnitCmdDone",
 	"UnitPreDamaged",
 	"UnitDamaged",
+	"UnitDamagedBatch",
 	"UnitStunned",
 	"UnitTaken",
 	"UnitGiven",
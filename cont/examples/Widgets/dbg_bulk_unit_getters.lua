@@ -0,0 +1,72 @@
+function widget:GetInfo()
+return {
+	name    = "Bulk Unit Getters Benchmark",
+	desc    = "Compares per-unit GetUnit{Position,Velocity,Health} calls against their GetUnitArray* counterparts",
+	date    = "Oct. 2026",
+	license = "GNU GPL, v2 or later",
+	layer   = 0,
+	enabled = false,
+}
+end
+
+local spGetAllUnits            = Spring.GetAllUnits
+local spGetUnitPosition        = Spring.GetUnitPosition
+local spGetUnitVelocity        = Spring.GetUnitVelocity
+local spGetUnitHealth          = Spring.GetUnitHealth
+local spGetUnitArrayPositions  = Spring.GetUnitArrayPositions
+local spGetUnitArrayVelocities = Spring.GetUnitArrayVelocities
+local spGetUnitArrayHealths    = Spring.GetUnitArrayHealths
+local spGetTimer               = Spring.GetTimer
+local spDiffTimers             = Spring.DiffTimers
+
+local NUM_ITERS = 10
+local REPORT_INTERVAL = 30 * 10
+
+-- reused between calls, as a real consumer would
+local posArray = {}
+local velArray = {}
+local hpArray  = {}
+
+local perUnitTime = 0
+local bulkTime    = 0
+local numSamples  = 0
+
+local function PerUnit(unitIDs)
+	for i = 1, #unitIDs do
+		local unitID = unitIDs[i]
+		local px, py, pz = spGetUnitPosition(unitID)
+		local vx, vy, vz, vw = spGetUnitVelocity(unitID)
+		local hp, maxHP, paraDmg, _, bp = spGetUnitHealth(unitID)
+	end
+end
+
+local function Bulk(unitIDs)
+	spGetUnitArrayPositions(unitIDs, posArray)
+	spGetUnitArrayVelocities(unitIDs, velArray)
+	spGetUnitArrayHealths(unitIDs, hpArray)
+end
+
+function widget:GameFrame(n)
+	local unitIDs = spGetAllUnits()
+
+	local t0 = spGetTimer()
+	for i = 1, NUM_ITERS do PerUnit(unitIDs) end
+	local t1 = spGetTimer()
+	for i = 1, NUM_ITERS do Bulk(unitIDs) end
+	local t2 = spGetTimer()
+
+	perUnitTime = perUnitTime + spDiffTimers(t1, t0)
+	bulkTime    = bulkTime    + spDiffTimers(t2, t1)
+	numSamples  = numSamples  + NUM_ITERS
+
+	if ((n % REPORT_INTERVAL) ~= 0) then
+		return
+	end
+
+	Spring.Echo(string.format("[%s] %d units: per-unit %.3fms, bulk %.3fms (avg. per frame over %d runs)",
+		widget:GetInfo().name, #unitIDs, perUnitTime * 1000 / numSamples, bulkTime * 1000 / numSamples, numSamples))
+
+	perUnitTime = 0
+	bulkTime    = 0
+	numSamples  = 0
+end
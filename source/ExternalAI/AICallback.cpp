@@ -123,12 +123,35 @@ CAICallback::CAICallback(int teamId)
 	, gh(&uiGroupHandlers[teamId])
 {}
 
+
+void CAICallback::DeferNetMessages(bool b)
+{
+	if ((deferNetMessages = b))
+		return;
+
+	for (auto& packet: deferredNetMessages) {
+		clientNet->Send(std::move(packet));
+	}
+
+	deferredNetMessages.clear();
+}
+
+void CAICallback::SendNetMessage(std::shared_ptr<const netcode::RawPacket> packet)
+{
+	if (deferNetMessages) {
+		deferredNetMessages.emplace_back(std::move(packet));
+		return;
+	}
+
+	clientNet->Send(std::move(packet));
+}
+
 void CAICallback::SendStartPos(bool ready, float3 startPos)
 {
 	if (ready) {
-		clientNet->Send(CBaseNetProtocol::Get().SendStartPos(gu->myPlayerNum, team, CPlayer::PLAYER_RDYSTATE_READIED, startPos.x, startPos.y, startPos.z));
+		SendNetMessage(CBaseNetProtocol::Get().SendStartPos(gu->myPlayerNum, team, CPlayer::PLAYER_RDYSTATE_READIED, startPos.x, startPos.y, startPos.z));
 	} else {
-		clientNet->Send(CBaseNetProtocol::Get().SendStartPos(gu->myPlayerNum, team, CPlayer::PLAYER_RDYSTATE_UPDATED, startPos.x, startPos.y, startPos.z));
+		SendNetMessage(CBaseNetProtocol::Get().SendStartPos(gu->myPlayerNum, team, CPlayer::PLAYER_RDYSTATE_UPDATED, startPos.x, startPos.y, startPos.z));
 	}
 }
 
@@ -179,7 +202,7 @@ bool CAICallback::SendResources(float mAmount, float eAmount, int receivingTeamI
 		eAmount = std::max(0.0f, std::min(eAmount, GetEnergy()));
 		std::vector<short> empty;
 
-		clientNet->Send(CBaseNetProtocol::Get().SendAIShare(ubyte(gu->myPlayerNum), skirmishAIHandler.GetCurrentAIID(), ubyte(team), ubyte(receivingTeamId), mAmount, eAmount, empty));
+		SendNetMessage(CBaseNetProtocol::Get().SendAIShare(ubyte(gu->myPlayerNum), skirmishAIHandler.GetCurrentAIID(), ubyte(team), ubyte(receivingTeamId), mAmount, eAmount, empty));
 	}
 
 	return ret;
@@ -218,7 +241,7 @@ int CAICallback::SendUnits(const std::vector<int>& unitIds, int receivingTeamId)
 		if (!sentUnitIDs.empty()) {
 			// we ca not use SendShare() here either, since
 			// AIs do not have a notion of "selected units"
-			clientNet->Send(CBaseNetProtocol::Get().SendAIShare(ubyte(gu->myPlayerNum), skirmishAIHandler.GetCurrentAIID(), ubyte(team), ubyte(receivingTeamId), 0.0f, 0.0f, sentUnitIDs));
+			SendNetMessage(CBaseNetProtocol::Get().SendAIShare(ubyte(gu->myPlayerNum), skirmishAIHandler.GetCurrentAIID(), ubyte(team), ubyte(receivingTeamId), 0.0f, 0.0f, sentUnitIDs));
 		}
 	}
 
@@ -344,8 +367,7 @@ int CAICallback::GetUnitGroup(int unitId)
 
 const std::vector<const SCommandDescription*>* CAICallback::GetGroupCommands(int groupId)
 {
-	static std::vector<const SCommandDescription*> tempcmds;
-	return &tempcmds;
+	return &groupCommands;
 }
 
 int CAICallback::GiveGroupOrder(int groupId, Command* c)
@@ -371,7 +393,7 @@ int CAICallback::GiveOrder(int unitId, Command* c)
 	if (unit->team != team)
 		return -5;
 
-	clientNet->Send(CBaseNetProtocol::Get().SendAICommand(gu->myPlayerNum, skirmishAIHandler.GetCurrentAIID(), unitId, c->GetID(false), c->GetID(true), c->GetTimeOut(), c->GetOpts(), c->GetNumParams(), c->GetParams()));
+	SendNetMessage(CBaseNetProtocol::Get().SendAICommand(gu->myPlayerNum, skirmishAIHandler.GetCurrentAIID(), unitId, c->GetID(false), c->GetID(true), c->GetTimeOut(), c->GetOpts(), c->GetNumParams(), c->GetParams()));
 	return 0;
 }
 
@@ -822,6 +844,14 @@ static inline bool unit_IsFriendly(const CUnit* unit) {
 	return (teamHandler.Ally(unit->allyteam, myAllyTeamId) && !unit->IsNeutral());
 }
 
+static inline bool unit_IsNeutral(const CUnit* unit) {
+	return (unit->IsNeutral());
+}
+
+static inline bool unit_IsNotNeutral(const CUnit* unit) {
+	return (!unit->IsNeutral());
+}
+
 /// You have to set myAllyTeamId before calling this function. NOT thread safe!
 static inline bool unit_IsInSensor(const CUnit* unit, const unsigned short losFlags) {
 	// Skip in-sensor-range test if the unit is allied with our team.
@@ -869,10 +899,19 @@ int CAICallback::GetEnemyUnits(int* unitIds, const float3& pos, float radius,
 		int unitIds_max)
 {
 	verify();
-	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos, radius);
 	myAllyTeamId = teamHandler.AllyTeam(team);
-	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsEnemyAndInLos);
+
+	QuadFieldAllyFilter filter;
+	filter.SetLosTest(myAllyTeamId, LOS_INLOS);
+
+	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+		if (!teamHandler.Ally(t, myAllyTeamId))
+			filter.Include(t, !teamHandler.Ally(myAllyTeamId, t));
+	}
+
+	QuadFieldQuery qfQuery;
+	quadField.GetUnitsExact(qfQuery, pos, radius, true, filter);
+	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsNotNeutral);
 }
 
 
@@ -887,10 +926,18 @@ int CAICallback::GetFriendlyUnits(int* unitIds, const float3& pos, float radius,
 		int unitIds_max)
 {
 	verify();
-	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos, radius);
 	myAllyTeamId = teamHandler.AllyTeam(team);
-	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsFriendly);
+
+	QuadFieldAllyFilter filter;
+
+	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+		if (teamHandler.Ally(t, myAllyTeamId))
+			filter.Include(t);
+	}
+
+	QuadFieldQuery qfQuery;
+	quadField.GetUnitsExact(qfQuery, pos, radius, true, filter);
+	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsNotNeutral);
 }
 
 
@@ -904,10 +951,19 @@ int CAICallback::GetNeutralUnits(int* unitIds, int unitIds_max)
 int CAICallback::GetNeutralUnits(int* unitIds, const float3& pos, float radius, int unitIds_max)
 {
 	verify();
-	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos, radius);
 	myAllyTeamId = teamHandler.AllyTeam(team);
-	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsNeutralAndInLosOrRadar);
+
+	// neutral units can belong to any allyteam, only the sensor test is moved
+	QuadFieldAllyFilter filter;
+	filter.SetLosTest(myAllyTeamId, LOS_INLOS | LOS_INRADAR);
+
+	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+		filter.Include(t, !teamHandler.Ally(myAllyTeamId, t));
+	}
+
+	QuadFieldQuery qfQuery;
+	quadField.GetUnitsExact(qfQuery, pos, radius, true, filter);
+	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsNeutral);
 }
 
 
@@ -1397,19 +1453,19 @@ int CAICallback::HandleCommand(int commandId, void* data)
 			   TODO: gu->myPlayerNum makes the command to look like as it comes from the local player,
 			   "team" should be used (but needs some major changes in other engine parts)
 			*/
-			clientNet->Send(CBaseNetProtocol::Get().SendMapDrawPoint(gu->myPlayerNum, (short)cmdData->pos.x, (short)cmdData->pos.z, std::string(cmdData->label), false));
+			SendNetMessage(CBaseNetProtocol::Get().SendMapDrawPoint(gu->myPlayerNum, (short)cmdData->pos.x, (short)cmdData->pos.z, std::string(cmdData->label), false));
 			return 1;
 		} break;
 		case AIHCAddMapLineId: {
 			const AIHCAddMapLine* cmdData = static_cast<AIHCAddMapLine*>(data);
 			// see TODO above
-			clientNet->Send(CBaseNetProtocol::Get().SendMapDrawLine(gu->myPlayerNum, (short)cmdData->posfrom.x, (short)cmdData->posfrom.z, (short)cmdData->posto.x, (short)cmdData->posto.z, false));
+			SendNetMessage(CBaseNetProtocol::Get().SendMapDrawLine(gu->myPlayerNum, (short)cmdData->posfrom.x, (short)cmdData->posfrom.z, (short)cmdData->posto.x, (short)cmdData->posto.z, false));
 			return 1;
 		} break;
 		case AIHCRemoveMapPointId: {
 			const AIHCRemoveMapPoint* cmdData = static_cast<AIHCRemoveMapPoint*>(data);
 			// see TODO above
-			clientNet->Send(CBaseNetProtocol::Get().SendMapErase(gu->myPlayerNum, (short)cmdData->pos.x, (short)cmdData->pos.z));
+			SendNetMessage(CBaseNetProtocol::Get().SendMapErase(gu->myPlayerNum, (short)cmdData->pos.x, (short)cmdData->pos.z));
 			return 1;
 		} break;
 		case AIHCSendStartPosId:
@@ -1478,7 +1534,7 @@ int CAICallback::HandleCommand(int commandId, void* data)
 		case AIHCPauseId: {
 			AIHCPause* cmdData = static_cast<AIHCPause*>(data);
 
-			clientNet->Send(CBaseNetProtocol::Get().SendPause(gu->myPlayerNum, cmdData->enable));
+			SendNetMessage(CBaseNetProtocol::Get().SendPause(gu->myPlayerNum, cmdData->enable));
 			LOG("Skirmish AI controlling team %i paused the game, reason: %s",
 					team,
 					cmdData->reason != nullptr ? cmdData->reason : "UNSPECIFIED");
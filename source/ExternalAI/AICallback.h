@@ -6,10 +6,15 @@
 #include "ExternalAI/AILegacySupport.h"
 #include "System/float3.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
 
+namespace netcode {
+	class RawPacket;
+}
+
 struct Command;
 struct UnitDef;
 struct FeatureDef;
@@ -27,12 +32,19 @@ private:
 	int team = -1;
 
 	bool allowOrders = true;
+	bool deferNetMessages = false;
 
 	CGroupHandler* gh = nullptr;
 
+	/// messages held back by DeferNetMessages, in the order they were sent
+	std::vector< std::shared_ptr<const netcode::RawPacket> > deferredNetMessages;
+	/// returned by GetGroupCommands; groups have no commands of their own
+	std::vector<const SCommandDescription*> groupCommands;
+
 private:
 	// utility methods
 	void verify();
+	void SendNetMessage(std::shared_ptr<const netcode::RawPacket> packet);
 
 	/// Returns the unit if the ID is valid
 	CUnit* GetUnit(int unitId) const;
@@ -49,6 +61,11 @@ public:
 	CAICallback(int teamId);
 
 	void AllowOrders(bool b) { allowOrders = b; }
+	/**
+	 * While enabled, network messages (orders, shares, map drawings, ...)
+	 * are queued rather than sent; disabling sends the queue in order.
+	 */
+	void DeferNetMessages(bool b);
 
 	void SendStartPos(bool ready, float3 pos);
 	void SendTextMsg(const char* text, int zone);
@@ -148,6 +148,10 @@ static inline bool unit_IsNeutral(CUnit* unit) {
 	return unit->IsNeutral();
 }
 
+static inline bool unit_IsNotNeutral(CUnit* unit) {
+	return !unit->IsNeutral();
+}
+
 static int myAllyTeamId = -1;
 
 /// You have to set myAllyTeamId before callign this function. NOT thread safe!
@@ -164,10 +168,18 @@ int CAICheats::GetEnemyUnits(int* unitIds, int unitIds_max)
 
 int CAICheats::GetEnemyUnits(int* unitIds, const float3& pos, float radius, int unitIds_max)
 {
-	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos, radius);
 	myAllyTeamId = teamHandler.AllyTeam(ai->GetTeamId());
-	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsEnemy);
+
+	QuadFieldAllyFilter filter;
+
+	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+		if (!teamHandler.Ally(t, myAllyTeamId))
+			filter.Include(t);
+	}
+
+	QuadFieldQuery qfQuery;
+	quadField.GetUnitsExact(qfQuery, pos, radius, true, filter);
+	return FilterUnitsVector(*qfQuery.units, unitIds, unitIds_max, &unit_IsNotNeutral);
 }
 
 int CAICheats::GetNeutralUnits(int* unitIds, int unitIds_max)
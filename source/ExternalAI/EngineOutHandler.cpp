@@ -3,6 +3,7 @@
 #include "EngineOutHandler.h"
 
 #include "ExternalAI/SkirmishAIWrapper.h"
+#include "ExternalAI/SSkirmishAICallbackImpl.h"
 #include "ExternalAI/SkirmishAIData.h"
 #include "ExternalAI/SkirmishAIHandler.h"
 #include "ExternalAI/AILibraryManager.h"
@@ -19,7 +20,9 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "Sim/Weapons/WeaponDef.h"
 #include "Net/Protocol/NetProtocol.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/TimeProfiler.h"
 #include "System/SafeUtil.h"
 
@@ -32,10 +35,19 @@ CR_REG_METADATA(CEngineOutHandler, (
 	//   is implicitly deleted because the default definition would be ill-formed"
 	CR_IGNORED(hostSkirmishAIs),
 	CR_IGNORED(teamSkirmishAIs),
-	CR_IGNORED(activeSkirmishAIs)
+	CR_IGNORED(activeSkirmishAIs),
+	CR_IGNORED(concurrentSkirmishAIs),
+
+	CR_IGNORED(concurrentUpdates),
+	CR_IGNORED(inConcurrentUpdate)
 ))
 
 
+CONFIG(bool, ConcurrentSkirmishAIs)
+	.defaultValue(false)
+	.description("Lets each local non-cheating Skirmish AI handle its Update event on its own worker thread. Engine callbacks are serialized and orders sent in AI order after all have finished; calls into LuaRules or LuaUI fail during that time. The AI's and their interfaces must tolerate being called from any thread.");
+
+
 static inline bool IsUnitInLosOrRadarOfAllyTeam(const CUnit& unit, const int allyTeamId) {
 	// NOTE:
 	//   we check for globalLOS because the LOS-state of a
@@ -79,7 +91,9 @@ void CEngineOutHandler::Destroy() {
 
 
 // This macro should be inserted at the start of each method sending AI events
+// (none may be sent while AI's are running concurrently, see Update)
 #define AI_SCOPED_TIMER()           \
+	assert(!inConcurrentUpdate);    \
 	if (activeSkirmishAIs.empty())  \
 		return;                     \
 	SCOPED_TIMER("AI");
@@ -90,6 +104,15 @@ void CEngineOutHandler::Destroy() {
 	}
 
 
+void CEngineOutHandler::Init() {
+	activeSkirmishAIs.reserve(16);
+	concurrentSkirmishAIs.reserve(16);
+
+	concurrentUpdates = configHandler->GetBool("ConcurrentSkirmishAIs");
+	inConcurrentUpdate = false;
+}
+
+
 void CEngineOutHandler::PreDestroy() {
 	AI_SCOPED_TIMER();
 	DO_FOR_SKIRMISH_AIS(PreDestroy())
@@ -123,7 +146,39 @@ void CEngineOutHandler::Save(std::ostream* s, const uint8_t skirmishAIId) {
 
 void CEngineOutHandler::Update() {
 	AI_SCOPED_TIMER();
-	DO_FOR_SKIRMISH_AIS(Update(gs->frameNum))
+
+	if (!concurrentUpdates || activeSkirmishAIs.size() <= 1) {
+		DO_FOR_SKIRMISH_AIS(Update(gs->frameNum))
+		return;
+	}
+
+	concurrentSkirmishAIs.clear();
+
+	// cheating AI's can change the sim (and raise events) from within
+	// Update, so they go first; the others then all read the same state
+	for (uint8_t aiID: activeSkirmishAIs) {
+		if (!skirmishAiCallback_AllowConcurrent(&hostSkirmishAIs[aiID])) {
+			hostSkirmishAIs[aiID].Update(gs->frameNum);
+			continue;
+		}
+
+		concurrentSkirmishAIs.push_back(aiID);
+	}
+
+	const int frameNum = gs->frameNum;
+
+	inConcurrentUpdate = true;
+	skirmishAiCallback_SetConcurrent(true);
+
+	// one task per AI; note that a callback fanning out to the pool itself
+	// could deadlock on workers blocked by the callback lock (none does)
+	for_mt(0, concurrentSkirmishAIs.size(), [&](const int i) {
+		hostSkirmishAIs[ concurrentSkirmishAIs[i] ].Update(frameNum);
+	});
+
+	// sends the orders given meanwhile, in AI ID order
+	skirmishAiCallback_SetConcurrent(false);
+	inConcurrentUpdate = false;
 }
 
 
@@ -478,6 +533,10 @@ void CEngineOutHandler::SendChatMessage(const char* msg, int fromPlayerId) {
 }
 
 bool CEngineOutHandler::SendLuaMessages(int aiTeam, const char* inData, std::vector<const char*>& outData) {
+	// can be reached through an AI's Lua callback, but others might be running
+	if (inConcurrentUpdate)
+		return false;
+
 	SCOPED_TIMER("AI");
 
 	if (activeSkirmishAIs.empty())
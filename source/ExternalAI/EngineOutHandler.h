@@ -31,7 +31,7 @@ public:
 	static void Create();
 	static void Destroy();
 
-	void Init() { activeSkirmishAIs.reserve(16); }
+	void Init();
 	void Kill() {
 		PreDestroy();
 
@@ -115,6 +115,11 @@ private:
 	std::array<std::vector<uint8_t>, MAX_TEAMS> teamSkirmishAIs;
 
 	std::vector<uint8_t> activeSkirmishAIs;
+	/// subset of activeSkirmishAIs handling Update concurrently this frame
+	std::vector<uint8_t> concurrentSkirmishAIs;
+
+	bool concurrentUpdates = false;
+	bool inConcurrentUpdate = false;
 };
 
 #define eoh CEngineOutHandler::GetInstance()
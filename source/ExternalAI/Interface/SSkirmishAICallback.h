@@ -10,6 +10,12 @@ extern "C" {
 #endif
 
 
+/// allegiance bits for getUnitStatesIn
+#define UNIT_ALLEGIANCE_ENEMY    1
+#define UNIT_ALLEGIANCE_FRIENDLY 2
+#define UNIT_ALLEGIANCE_NEUTRAL  4
+
+
 /**
  * @brief Skirmish AI Callback function pointers.
  * Each Skirmish AI instance will receive an instance of this struct
@@ -2269,6 +2275,49 @@ struct SSkirmishAICallback {
 
 	bool              (CALLING_CONV *Debug_GraphDrawer_isEnabled)(int skirmishAIId);
 
+	/**
+	 * Batched Map_getResourceMapSpotsNearest: writes the nearest spot to each
+	 * of a list of positions. If extractorUnitDefId is a valid UnitDef, only
+	 * spots where this team can build it are considered, and the build-site
+	 * test of each candidate spot is shared between all positions.
+	 *
+	 * @param extractorUnitDefId     -1 to skip the build-site tests
+	 * @param positions_AposF3       3 floats per position
+	 * @param positions_AposF3_size  number of floats in positions_AposF3
+	 * @param spots_AposF3_out       receives 3 floats per position
+	 * @return number of floats written to spots_AposF3_out
+	 */
+	int               (CALLING_CONV *Map_getResourceMapSpotsNearestBatch)(int skirmishAIId, int resourceId, int extractorUnitDefId, float* positions_AposF3, int positions_AposF3_size, float* spots_AposF3_out);
+
+	/**
+	 * Fills the state of a whole set of units into parallel (SoA) arrays,
+	 * which saves calling Unit_getPos, Unit_getVel, Unit_getHealth,
+	 * Unit_getDef and Unit_getTeam once per unit.
+	 * The same visibility rules apply as for those functions (including
+	 * cheat mode), and elements for units not visible to this AI are set
+	 * to what they would return (zero vectors, -1, ...).
+	 * Any of the output arrays may be NULL if the AI is not interested in it.
+	 *
+	 * @param unitIds            the units to query
+	 * @param unitIds_size       number of units to query; positions and
+	 *                           velocities need room for 3 floats per unit
+	 * @return number of units written, which is unitIds_size
+	 */
+	int               (CALLING_CONV *getUnitStates)(int skirmishAIId, int* unitIds, int unitIds_size, float* positions_AposF3, float* velocities_AposF3, float* healths, int* unitDefIds, int* teamIds);
+
+	/**
+	 * Combines getEnemyUnitsIn, getFriendlyUnitsIn and getNeutralUnitsIn
+	 * (selected by <allegiances>, a mask of UNIT_ALLEGIANCE_* bits) with
+	 * getUnitStates, so an AI can fetch the state of all units in an area
+	 * with a single call.
+	 * If unitIds is NULL, only the number of units is returned.
+	 *
+	 * @param unitIds_sizeMax    maximum number of units to write into the
+	 *                           unitIds array and the arrays that follow it
+	 * @return number of units written (or found, if unitIds is NULL)
+	 */
+	int               (CALLING_CONV *getUnitStatesIn)(int skirmishAIId, int allegiances, float* pos_posF3, float radius, int* unitIds, float* positions_AposF3, float* velocities_AposF3, float* healths, int* unitDefIds, int* teamIds, int unitIds_sizeMax);
+
 };
 
 #if	defined(__cplusplus)
@@ -45,6 +45,7 @@
 #include "Sim/Misc/QuadField.h" // for quadField.GetFeaturesExact(pos, radius)
 #include "System/SafeCStrings.h"
 #include "System/SpringMath.h"
+#include "System/Threading/SpringThreading.h"
 #include "System/FileSystem/ArchiveScanner.h"
 #include "System/Log/ILog.h"
 
@@ -59,6 +60,10 @@ static std::array<int, MAX_AIS> AI_TEAM_IDS = {{-1}};
 static std::vector<PointMarker> AI_TMP_POINT_MARKERS[MAX_AIS];
 static std::vector<LineMarker> AI_TMP_LINE_MARKERS[MAX_AIS];
 
+// returned to AI's by pointer, so must not be shared between them or move
+static char AI_ALLOCATED_PATHS[MAX_AIS][2048];
+static std::string AI_WRITEABLE_DATA_DIRS[MAX_AIS];
+
 static constexpr size_t MAX_NUM_MARKERS = 16384;
 
 
@@ -66,6 +71,25 @@ static inline CAICallback* GetCallBack(int skirmishAIId) { return &AI_LEGACY_CAL
 static inline CAICheats* GetCheatCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].second; }
 
 
+// see skirmishAiCallback_SetConcurrent; recursive since callbacks can
+// (e.g. through Lua) end up raising events that call back into the AI
+static spring::recursive_mutex AI_CALLBACK_MUTEX;
+static bool AI_CONCURRENT_CALLBACKS = false;
+
+template<typename T, T func> struct SerializedCallback;
+template<typename R, typename... A, R(*func)(A...)> struct SerializedCallback<R(*)(A...), func> {
+	static R Call(A... args) {
+		if (!AI_CONCURRENT_CALLBACKS)
+			return func(args...);
+
+		std::lock_guard<spring::recursive_mutex> lock(AI_CALLBACK_MUTEX);
+		return func(args...);
+	}
+};
+
+#define SERIALIZED_CALLBACK(func) (&SerializedCallback<decltype(&func), &func>::Call)
+
+
 static void CheckSkirmishAIId(int skirmishAIId, const char* caller) {
 	if (skirmishAIId >= 0 && skirmishAIId < MAX_AIS)
 		return;
@@ -791,9 +815,16 @@ EXPORT(int) skirmishAiCallback_Engine_handleCommand(
 		} break;
 
 		// @see AI/Wrappers/Cpp/bin/wrappCallback.awk, printMember
+		// Lua call-ins must run on the main thread, so are refused while AI's update concurrently
 		#define SSAICALLBACK_CALL_LUA(HandleName, HANDLENAME)  \
 			case COMMAND_CALL_LUA_ ## HANDLENAME: {  \
 				SCallLua ## HandleName ## Command* cmd = static_cast<SCallLua ## HandleName ## Command*>(commandData);  \
+				if (AI_CONCURRENT_CALLBACKS) {                                                                          \
+					if (cmd->ret_outData != NULL)                                                                       \
+						cmd->ret_outData[0] = '\0';                                                                     \
+					ret = -1;                                                                                           \
+					break;                                                                                              \
+				}                                                                                                       \
 				size_t len = 0;                                                                                         \
 				const char* outData = clb->CallLua ## HandleName(cmd->inData, cmd->inSize, &len);                       \
 				if (cmd->ret_outData != NULL) {                                                                         \
@@ -1396,27 +1427,23 @@ EXPORT(char*) skirmishAiCallback_DataDirs_allocatePath(
 	bool dir,
 	bool common
 ) {
-	static char path[2048];
+	CheckSkirmishAIId(skirmishAIId, __func__);
 
-	if (!skirmishAiCallback_DataDirs_locatePath(skirmishAIId, &path[0], sizeof(path), relPath, writeable, create, dir, common))
+	char* path = &AI_ALLOCATED_PATHS[skirmishAIId][0];
+
+	if (!skirmishAiCallback_DataDirs_locatePath(skirmishAIId, path, sizeof(AI_ALLOCATED_PATHS[skirmishAIId]), relPath, writeable, create, dir, common))
 		path[0] = 0;
 
-	return &path[0];
+	return path;
 }
 
 
 EXPORT(const char*) skirmishAiCallback_DataDirs_getWriteableDir(int skirmishAIId) {
 	CheckSkirmishAIId(skirmishAIId, __func__);
 
-	static std::vector<std::string> writeableDataDirs;
-
-	// fill up writeableDataDirs until teamId index is in there
-	// if it is not yet
-	for (size_t wdd = writeableDataDirs.size(); wdd <= (size_t)skirmishAIId; ++wdd) {
-		writeableDataDirs.emplace_back("");
-	}
+	std::string& writeableDataDir = AI_WRITEABLE_DATA_DIRS[skirmishAIId];
 
-	if (writeableDataDirs[skirmishAIId].empty()) {
+	if (writeableDataDir.empty()) {
 		char tmpRes[1024];
 
 		if (!skirmishAiCallback_DataDirs_locatePath(skirmishAIId, tmpRes, sizeof(tmpRes), "", true, true, true, false)) {
@@ -1427,11 +1454,11 @@ EXPORT(const char*) skirmishAiCallback_DataDirs_getWriteableDir(int skirmishAIId
 			skirmishAiCallback_Log_exception(skirmishAIId, errorMsg, 1, true);
 			return nullptr;
 		} else {
-			writeableDataDirs[skirmishAIId] = tmpRes;
+			writeableDataDir = tmpRes;
 		}
 	}
 
-	return writeableDataDirs[skirmishAIId].c_str();
+	return writeableDataDir.c_str();
 }
 
 
@@ -1442,6 +1469,12 @@ EXPORT(bool) skirmishAiCallback_Cheats_isEnabled(int skirmishAIId) {
 
 EXPORT(bool) skirmishAiCallback_Cheats_setEnabled(int skirmishAIId, bool enabled)
 {
+	// cheats act on the sim immediately, not while other AI's are reading it
+	if (enabled && AI_CONCURRENT_CALLBACKS) {
+		LOG_L(L_WARNING, "[%s] SkirmishAI (id %i, team %i) can not enable cheats while running concurrently", __func__, skirmishAIId, AI_TEAM_IDS[skirmishAIId]);
+		return false;
+	}
+
 	if ((AI_CHEAT_FLAGS[skirmishAIId].first = enabled) && !AI_CHEAT_FLAGS[skirmishAIId].second) {
 		LOG("[%s] SkirmishAI (id %i, team %i) is using cheats!", __func__, skirmishAIId, AI_TEAM_IDS[skirmishAIId]);
 		AI_CHEAT_FLAGS[skirmishAIId].second = true;
@@ -2079,6 +2112,37 @@ EXPORT(void) skirmishAiCallback_Map_getResourceMapSpotsNearest(
 	getResourceMapAnalyzer(resourceId)->GetNearestSpot(pos_posF3, AI_TEAM_IDS[skirmishAIId]).copyInto(return_posF3_out);
 }
 
+EXPORT(int) skirmishAiCallback_Map_getResourceMapSpotsNearestBatch(
+	int skirmishAIId,
+	int resourceId,
+	int extractorUnitDefId,
+	float* positions_AposF3,
+	int positions_AposF3_size,
+	float* spots_AposF3_out
+) {
+	const int numPositions = std::max(0, positions_AposF3_size) / 3;
+
+	std::vector<float3> fromPositions;
+	std::vector<float3> nearestSpots;
+
+	fromPositions.reserve(numPositions);
+
+	for (int i = 0; i < numPositions; i++) {
+		fromPositions.emplace_back(&positions_AposF3[i * 3]);
+	}
+
+	// without an extractor there are no build-site tests to share
+	const UnitDef* extractor = (extractorUnitDefId >= 0)? getUnitDefById(skirmishAIId, extractorUnitDefId): nullptr;
+
+	getResourceMapAnalyzer(resourceId)->GetNearestSpots(fromPositions, AI_TEAM_IDS[skirmishAIId], extractor, nearestSpots);
+
+	for (int i = 0; i < numPositions; i++) {
+		nearestSpots[i].copyInto(&spots_AposF3_out[i * 3]);
+	}
+
+	return (numPositions * 3);
+}
+
 EXPORT(int) skirmishAiCallback_Map_getHash(int skirmishAIId) {
 	return archiveScanner->GetArchiveCompleteChecksum(mapInfo->map.name);
 }
@@ -3951,6 +4015,7 @@ EXPORT(int) skirmishAiCallback_getSelectedUnits(int skirmishAIId, int* unitIds,
 	return GetCallBack(skirmishAIId)->GetSelectedUnits(unitIds, unitIdsMaxSize);
 }
 
+
 EXPORT(int) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int unitIdsMaxSize) {
 	int a = 0;
 
@@ -3972,6 +4037,92 @@ EXPORT(int) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int
 	return a;
 }
 
+// one callback-type check per batch; the per-unit getters keep the rules
+// identical to those of the single-unit skirmishAiCallback_Unit_* functions
+template<typename Callback>
+static int FillUnitStates(
+	Callback* callback,
+	const int* unitIds,
+	int numUnitIds,
+	float* positions,
+	float* velocities,
+	float* healths,
+	int* unitDefIds,
+	int* teamIds
+) {
+	for (int i = 0; i < numUnitIds; i++) {
+		const int unitId = unitIds[i];
+
+		if (positions != nullptr)
+			callback->GetUnitPos(unitId).copyInto(&positions[i * 3]);
+		if (velocities != nullptr)
+			callback->GetUnitVelocity(unitId).copyInto(&velocities[i * 3]);
+		if (healths != nullptr)
+			healths[i] = callback->GetUnitHealth(unitId);
+		if (teamIds != nullptr)
+			teamIds[i] = callback->GetUnitTeam(unitId);
+
+		if (unitDefIds == nullptr)
+			continue;
+
+		const UnitDef* unitDef = callback->GetUnitDef(unitId);
+		unitDefIds[i] = (unitDef != nullptr)? unitDef->id: -1;
+	}
+
+	return numUnitIds;
+}
+
+EXPORT(int) skirmishAiCallback_getUnitStates(
+	int skirmishAIId,
+	int* unitIds,
+	int unitIds_size,
+	float* positions_AposF3,
+	float* velocities_AposF3,
+	float* healths,
+	int* unitDefIds,
+	int* teamIds
+) {
+	if (unitIds == nullptr || unitIds_size <= 0)
+		return 0;
+
+	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId))
+		return FillUnitStates(GetCheatCallBack(skirmishAIId), unitIds, unitIds_size, positions_AposF3, velocities_AposF3, healths, unitDefIds, teamIds);
+
+	return FillUnitStates(GetCallBack(skirmishAIId), unitIds, unitIds_size, positions_AposF3, velocities_AposF3, healths, unitDefIds, teamIds);
+}
+
+EXPORT(int) skirmishAiCallback_getUnitStatesIn(
+	int skirmishAIId,
+	int allegiances,
+	float* pos_posF3,
+	float radius,
+	int* unitIds,
+	float* positions_AposF3,
+	float* velocities_AposF3,
+	float* healths,
+	int* unitDefIds,
+	int* teamIds,
+	int unitIds_sizeMax
+) {
+	int numUnitIds = 0;
+
+	// with unitIds == nullptr the fetchers below only count
+	if (unitIds == nullptr)
+		unitIds_sizeMax = unitHandler.MaxUnits();
+
+	if ((allegiances & UNIT_ALLEGIANCE_ENEMY) != 0 && numUnitIds < unitIds_sizeMax)
+		numUnitIds += skirmishAiCallback_getEnemyUnitsIn(skirmishAIId, pos_posF3, radius, (unitIds != nullptr)? &unitIds[numUnitIds]: nullptr, unitIds_sizeMax - numUnitIds);
+	if ((allegiances & UNIT_ALLEGIANCE_FRIENDLY) != 0 && numUnitIds < unitIds_sizeMax)
+		numUnitIds += skirmishAiCallback_getFriendlyUnitsIn(skirmishAIId, pos_posF3, radius, (unitIds != nullptr)? &unitIds[numUnitIds]: nullptr, unitIds_sizeMax - numUnitIds);
+	if ((allegiances & UNIT_ALLEGIANCE_NEUTRAL) != 0 && numUnitIds < unitIds_sizeMax)
+		numUnitIds += skirmishAiCallback_getNeutralUnitsIn(skirmishAIId, pos_posF3, radius, (unitIds != nullptr)? &unitIds[numUnitIds]: nullptr, unitIds_sizeMax - numUnitIds);
+
+	if (unitIds == nullptr)
+		return numUnitIds;
+
+	return (skirmishAiCallback_getUnitStates(skirmishAIId, unitIds, numUnitIds, positions_AposF3, velocities_AposF3, healths, unitDefIds, teamIds));
+}
+
 
 //########### BEGINN Team
 EXPORT(bool) skirmishAiCallback_Team_hasAIController(int skirmishAIId, int teamId) {
@@ -5024,600 +5175,603 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	memset(callback, 0, sizeof(SSkirmishAICallback));
 
 	// register function pointers to accessors (which wrap around the legacy callbacks)
-	callback->Engine_handleCommand = &skirmishAiCallback_Engine_handleCommand;
-	callback->Engine_executeCommand = &skirmishAiCallback_Engine_executeCommand;
-
-	callback->Engine_Version_getMajor = &skirmishAiCallback_Engine_Version_getMajor;
-	callback->Engine_Version_getMinor = &skirmishAiCallback_Engine_Version_getMinor;
-	callback->Engine_Version_getPatchset = &skirmishAiCallback_Engine_Version_getPatchset;
-	callback->Engine_Version_getCommits = &skirmishAiCallback_Engine_Version_getCommits;
-	callback->Engine_Version_getHash = &skirmishAiCallback_Engine_Version_getHash;
-	callback->Engine_Version_getBranch = &skirmishAiCallback_Engine_Version_getBranch;
-	callback->Engine_Version_getAdditional = &skirmishAiCallback_Engine_Version_getAdditional;
-	callback->Engine_Version_getBuildTime = &skirmishAiCallback_Engine_Version_getBuildTime;
-	callback->Engine_Version_isRelease = &skirmishAiCallback_Engine_Version_isRelease;
-	callback->Engine_Version_getNormal = &skirmishAiCallback_Engine_Version_getNormal;
-	callback->Engine_Version_getSync = &skirmishAiCallback_Engine_Version_getSync;
-	callback->Engine_Version_getFull = &skirmishAiCallback_Engine_Version_getFull;
-	callback->Teams_getSize = &skirmishAiCallback_Teams_getSize;
-	callback->SkirmishAIs_getSize = &skirmishAiCallback_SkirmishAIs_getSize;
-	callback->SkirmishAIs_getMax = &skirmishAiCallback_SkirmishAIs_getMax;
-	callback->SkirmishAI_getTeamId = &skirmishAiCallback_SkirmishAI_getTeamId;
-	callback->SkirmishAI_Info_getSize = &skirmishAiCallback_SkirmishAI_Info_getSize;
-	callback->SkirmishAI_Info_getKey = &skirmishAiCallback_SkirmishAI_Info_getKey;
-	callback->SkirmishAI_Info_getValue = &skirmishAiCallback_SkirmishAI_Info_getValue;
-	callback->SkirmishAI_Info_getDescription = &skirmishAiCallback_SkirmishAI_Info_getDescription;
-	callback->SkirmishAI_Info_getValueByKey = &skirmishAiCallback_SkirmishAI_Info_getValueByKey;
-	callback->SkirmishAI_OptionValues_getSize = &skirmishAiCallback_SkirmishAI_OptionValues_getSize;
-	callback->SkirmishAI_OptionValues_getKey = &skirmishAiCallback_SkirmishAI_OptionValues_getKey;
-	callback->SkirmishAI_OptionValues_getValue = &skirmishAiCallback_SkirmishAI_OptionValues_getValue;
-	callback->SkirmishAI_OptionValues_getValueByKey = &skirmishAiCallback_SkirmishAI_OptionValues_getValueByKey;
-	callback->Log_log = &skirmishAiCallback_Log_log;
-	callback->Log_exception = &skirmishAiCallback_Log_exception;
-	callback->DataDirs_getPathSeparator = &skirmishAiCallback_DataDirs_getPathSeparator;
-	callback->DataDirs_getConfigDir = &skirmishAiCallback_DataDirs_getConfigDir;
-	callback->DataDirs_getWriteableDir = &skirmishAiCallback_DataDirs_getWriteableDir;
-	callback->DataDirs_locatePath = &skirmishAiCallback_DataDirs_locatePath;
-	callback->DataDirs_allocatePath = &skirmishAiCallback_DataDirs_allocatePath;
-	callback->DataDirs_Roots_getSize = &skirmishAiCallback_DataDirs_Roots_getSize;
-	callback->DataDirs_Roots_getDir = &skirmishAiCallback_DataDirs_Roots_getDir;
-	callback->DataDirs_Roots_locatePath = &skirmishAiCallback_DataDirs_Roots_locatePath;
-	callback->DataDirs_Roots_allocatePath = &skirmishAiCallback_DataDirs_Roots_allocatePath;
-	callback->Game_getCurrentFrame = &skirmishAiCallback_Game_getCurrentFrame;
-	callback->Game_getAiInterfaceVersion = &skirmishAiCallback_Game_getAiInterfaceVersion;
-	callback->Game_getMyTeam = &skirmishAiCallback_Game_getMyTeam;
-	callback->Game_getMyAllyTeam = &skirmishAiCallback_Game_getMyAllyTeam;
-	callback->Game_getPlayerTeam = &skirmishAiCallback_Game_getPlayerTeam;
-	callback->Game_getTeams = &skirmishAiCallback_Game_getTeams;
-	callback->Game_getTeamSide = &skirmishAiCallback_Game_getTeamSide;
-	callback->Game_getTeamColor = &skirmishAiCallback_Game_getTeamColor;
-	callback->Game_getTeamIncomeMultiplier = &skirmishAiCallback_Game_getTeamIncomeMultiplier;
-	callback->Game_getTeamAllyTeam = &skirmishAiCallback_Game_getTeamAllyTeam;
-	callback->Game_getTeamResourceCurrent = &skirmishAiCallback_Game_getTeamResourceCurrent;
-	callback->Game_getTeamResourceIncome = &skirmishAiCallback_Game_getTeamResourceIncome;
-	callback->Game_getTeamResourceUsage = &skirmishAiCallback_Game_getTeamResourceUsage;
-	callback->Game_getTeamResourceStorage = &skirmishAiCallback_Game_getTeamResourceStorage;
-	callback->Game_getTeamResourcePull = &skirmishAiCallback_Game_getTeamResourcePull;
-	callback->Game_getTeamResourceShare = &skirmishAiCallback_Game_getTeamResourceShare;
-	callback->Game_getTeamResourceSent = &skirmishAiCallback_Game_getTeamResourceSent;
-	callback->Game_getTeamResourceReceived = &skirmishAiCallback_Game_getTeamResourceReceived;
-	callback->Game_getTeamResourceExcess = &skirmishAiCallback_Game_getTeamResourceExcess;
-	callback->Game_isAllied = &skirmishAiCallback_Game_isAllied;
-	callback->Game_isDebugModeEnabled = &skirmishAiCallback_Game_isDebugModeEnabled;
-	callback->Game_isPaused = &skirmishAiCallback_Game_isPaused;
-	callback->Game_getSpeedFactor = &skirmishAiCallback_Game_getSpeedFactor;
-	callback->Game_getSetupScript = &skirmishAiCallback_Game_getSetupScript;
-	callback->Game_getCategoryFlag = &skirmishAiCallback_Game_getCategoryFlag;
-	callback->Game_getCategoriesFlag = &skirmishAiCallback_Game_getCategoriesFlag;
-	callback->Game_getCategoryName = &skirmishAiCallback_Game_getCategoryName;
-	callback->Game_getRulesParamFloat = &skirmishAiCallback_Game_getRulesParamFloat;
-	callback->Game_getRulesParamString = &skirmishAiCallback_Game_getRulesParamString;
-	callback->Gui_getViewRange = &skirmishAiCallback_Gui_getViewRange;
-	callback->Gui_getScreenX = &skirmishAiCallback_Gui_getScreenX;
-	callback->Gui_getScreenY = &skirmishAiCallback_Gui_getScreenY;
-	callback->Gui_Camera_getDirection = &skirmishAiCallback_Gui_Camera_getDirection;
-	callback->Gui_Camera_getPosition = &skirmishAiCallback_Gui_Camera_getPosition;
-	callback->Cheats_isEnabled = &skirmishAiCallback_Cheats_isEnabled;
-	callback->Cheats_setEnabled = &skirmishAiCallback_Cheats_setEnabled;
-	callback->Cheats_setEventsEnabled = &skirmishAiCallback_Cheats_setEventsEnabled;
-	callback->Cheats_isOnlyPassive = &skirmishAiCallback_Cheats_isOnlyPassive;
-	callback->getResources = &skirmishAiCallback_getResources;
-	callback->getResourceByName = &skirmishAiCallback_getResourceByName;
-	callback->Resource_getName = &skirmishAiCallback_Resource_getName;
-	callback->Resource_getOptimum = &skirmishAiCallback_Resource_getOptimum;
-	callback->Economy_getCurrent = &skirmishAiCallback_Economy_getCurrent;
-	callback->Economy_getIncome = &skirmishAiCallback_Economy_getIncome;
-	callback->Economy_getUsage = &skirmishAiCallback_Economy_getUsage;
-	callback->Economy_getStorage = &skirmishAiCallback_Economy_getStorage;
-	callback->Economy_getPull = &skirmishAiCallback_Economy_getPull;
-	callback->Economy_getShare = &skirmishAiCallback_Economy_getShare;
-	callback->Economy_getSent = &skirmishAiCallback_Economy_getSent;
-	callback->Economy_getReceived = &skirmishAiCallback_Economy_getReceived;
-	callback->Economy_getExcess = &skirmishAiCallback_Economy_getExcess;
-	callback->File_getSize = &skirmishAiCallback_File_getSize;
-	callback->File_getContent = &skirmishAiCallback_File_getContent;
-	callback->getUnitDefs = &skirmishAiCallback_getUnitDefs;
-	callback->getUnitDefByName = &skirmishAiCallback_getUnitDefByName;
-	callback->UnitDef_getHeight = &skirmishAiCallback_UnitDef_getHeight;
-	callback->UnitDef_getRadius = &skirmishAiCallback_UnitDef_getRadius;
-	callback->UnitDef_getName = &skirmishAiCallback_UnitDef_getName;
-	callback->UnitDef_getHumanName = &skirmishAiCallback_UnitDef_getHumanName;
-	callback->UnitDef_getUpkeep = &skirmishAiCallback_UnitDef_getUpkeep;
-	callback->UnitDef_getResourceMake = &skirmishAiCallback_UnitDef_getResourceMake;
-	callback->UnitDef_getMakesResource = &skirmishAiCallback_UnitDef_getMakesResource;
-	callback->UnitDef_getCost = &skirmishAiCallback_UnitDef_getCost;
-	callback->UnitDef_getExtractsResource = &skirmishAiCallback_UnitDef_getExtractsResource;
-	callback->UnitDef_getResourceExtractorRange = &skirmishAiCallback_UnitDef_getResourceExtractorRange;
-	callback->UnitDef_getWindResourceGenerator = &skirmishAiCallback_UnitDef_getWindResourceGenerator;
-	callback->UnitDef_getTidalResourceGenerator = &skirmishAiCallback_UnitDef_getTidalResourceGenerator;
-	callback->UnitDef_getStorage = &skirmishAiCallback_UnitDef_getStorage;
-	callback->UnitDef_getBuildTime = &skirmishAiCallback_UnitDef_getBuildTime;
-	callback->UnitDef_getAutoHeal = &skirmishAiCallback_UnitDef_getAutoHeal;
-	callback->UnitDef_getIdleAutoHeal = &skirmishAiCallback_UnitDef_getIdleAutoHeal;
-	callback->UnitDef_getIdleTime = &skirmishAiCallback_UnitDef_getIdleTime;
-	callback->UnitDef_getPower = &skirmishAiCallback_UnitDef_getPower;
-	callback->UnitDef_getHealth = &skirmishAiCallback_UnitDef_getHealth;
-	callback->UnitDef_getCategory = &skirmishAiCallback_UnitDef_getCategory;
-	callback->UnitDef_getSpeed = &skirmishAiCallback_UnitDef_getSpeed;
-	callback->UnitDef_getTurnRate = &skirmishAiCallback_UnitDef_getTurnRate;
-	callback->UnitDef_isTurnInPlace = &skirmishAiCallback_UnitDef_isTurnInPlace;
-	callback->UnitDef_getTurnInPlaceDistance = &skirmishAiCallback_UnitDef_getTurnInPlaceDistance;
-	callback->UnitDef_getTurnInPlaceSpeedLimit = &skirmishAiCallback_UnitDef_getTurnInPlaceSpeedLimit;
-	callback->UnitDef_isUpright = &skirmishAiCallback_UnitDef_isUpright;
-	callback->UnitDef_isCollide = &skirmishAiCallback_UnitDef_isCollide;
-	callback->UnitDef_getLosRadius = &skirmishAiCallback_UnitDef_getLosRadius;
-	callback->UnitDef_getAirLosRadius = &skirmishAiCallback_UnitDef_getAirLosRadius;
-	callback->UnitDef_getLosHeight = &skirmishAiCallback_UnitDef_getLosHeight;
-	callback->UnitDef_getRadarRadius = &skirmishAiCallback_UnitDef_getRadarRadius;
-	callback->UnitDef_getSonarRadius = &skirmishAiCallback_UnitDef_getSonarRadius;
-	callback->UnitDef_getJammerRadius = &skirmishAiCallback_UnitDef_getJammerRadius;
-	callback->UnitDef_getSonarJamRadius = &skirmishAiCallback_UnitDef_getSonarJamRadius;
-	callback->UnitDef_getSeismicRadius = &skirmishAiCallback_UnitDef_getSeismicRadius;
-	callback->UnitDef_getSeismicSignature = &skirmishAiCallback_UnitDef_getSeismicSignature;
-	callback->UnitDef_isStealth = &skirmishAiCallback_UnitDef_isStealth;
-	callback->UnitDef_isSonarStealth = &skirmishAiCallback_UnitDef_isSonarStealth;
-	callback->UnitDef_isBuildRange3D = &skirmishAiCallback_UnitDef_isBuildRange3D;
-	callback->UnitDef_getBuildDistance = &skirmishAiCallback_UnitDef_getBuildDistance;
-	callback->UnitDef_getBuildSpeed = &skirmishAiCallback_UnitDef_getBuildSpeed;
-	callback->UnitDef_getReclaimSpeed = &skirmishAiCallback_UnitDef_getReclaimSpeed;
-	callback->UnitDef_getRepairSpeed = &skirmishAiCallback_UnitDef_getRepairSpeed;
-	callback->UnitDef_getMaxRepairSpeed = &skirmishAiCallback_UnitDef_getMaxRepairSpeed;
-	callback->UnitDef_getResurrectSpeed = &skirmishAiCallback_UnitDef_getResurrectSpeed;
-	callback->UnitDef_getCaptureSpeed = &skirmishAiCallback_UnitDef_getCaptureSpeed;
-	callback->UnitDef_getTerraformSpeed = &skirmishAiCallback_UnitDef_getTerraformSpeed;
-	callback->UnitDef_getMass = &skirmishAiCallback_UnitDef_getMass;
-	callback->UnitDef_isPushResistant = &skirmishAiCallback_UnitDef_isPushResistant;
-	callback->UnitDef_isStrafeToAttack = &skirmishAiCallback_UnitDef_isStrafeToAttack;
-	callback->UnitDef_getMinCollisionSpeed = &skirmishAiCallback_UnitDef_getMinCollisionSpeed;
-	callback->UnitDef_getSlideTolerance = &skirmishAiCallback_UnitDef_getSlideTolerance;
-	callback->UnitDef_getMaxHeightDif = &skirmishAiCallback_UnitDef_getMaxHeightDif;
-	callback->UnitDef_getMinWaterDepth = &skirmishAiCallback_UnitDef_getMinWaterDepth;
-	callback->UnitDef_getWaterline = &skirmishAiCallback_UnitDef_getWaterline;
-	callback->UnitDef_getMaxWaterDepth = &skirmishAiCallback_UnitDef_getMaxWaterDepth;
-	callback->UnitDef_getArmoredMultiple = &skirmishAiCallback_UnitDef_getArmoredMultiple;
-	callback->UnitDef_getArmorType = &skirmishAiCallback_UnitDef_getArmorType;
-	callback->UnitDef_FlankingBonus_getMode = &skirmishAiCallback_UnitDef_FlankingBonus_getMode;
-	callback->UnitDef_FlankingBonus_getDir = &skirmishAiCallback_UnitDef_FlankingBonus_getDir;
-	callback->UnitDef_FlankingBonus_getMax = &skirmishAiCallback_UnitDef_FlankingBonus_getMax;
-	callback->UnitDef_FlankingBonus_getMin = &skirmishAiCallback_UnitDef_FlankingBonus_getMin;
-	callback->UnitDef_FlankingBonus_getMobilityAdd = &skirmishAiCallback_UnitDef_FlankingBonus_getMobilityAdd;
-	callback->UnitDef_getMaxWeaponRange = &skirmishAiCallback_UnitDef_getMaxWeaponRange;
-	callback->UnitDef_getTooltip = &skirmishAiCallback_UnitDef_getTooltip;
-	callback->UnitDef_getWreckName = &skirmishAiCallback_UnitDef_getWreckName;
-	callback->UnitDef_getDeathExplosion = &skirmishAiCallback_UnitDef_getDeathExplosion;
-	callback->UnitDef_getSelfDExplosion = &skirmishAiCallback_UnitDef_getSelfDExplosion;
-	callback->UnitDef_getCategoryString = &skirmishAiCallback_UnitDef_getCategoryString;
-	callback->UnitDef_isAbleToSelfD = &skirmishAiCallback_UnitDef_isAbleToSelfD;
-	callback->UnitDef_getSelfDCountdown = &skirmishAiCallback_UnitDef_getSelfDCountdown;
-	callback->UnitDef_isAbleToSubmerge = &skirmishAiCallback_UnitDef_isAbleToSubmerge;
-	callback->UnitDef_isAbleToFly = &skirmishAiCallback_UnitDef_isAbleToFly;
-	callback->UnitDef_isAbleToMove = &skirmishAiCallback_UnitDef_isAbleToMove;
-	callback->UnitDef_isAbleToHover = &skirmishAiCallback_UnitDef_isAbleToHover;
-	callback->UnitDef_isFloater = &skirmishAiCallback_UnitDef_isFloater;
-	callback->UnitDef_isBuilder = &skirmishAiCallback_UnitDef_isBuilder;
-	callback->UnitDef_isActivateWhenBuilt = &skirmishAiCallback_UnitDef_isActivateWhenBuilt;
-	callback->UnitDef_isOnOffable = &skirmishAiCallback_UnitDef_isOnOffable;
-	callback->UnitDef_isFullHealthFactory = &skirmishAiCallback_UnitDef_isFullHealthFactory;
-	callback->UnitDef_isFactoryHeadingTakeoff = &skirmishAiCallback_UnitDef_isFactoryHeadingTakeoff;
-	callback->UnitDef_isReclaimable = &skirmishAiCallback_UnitDef_isReclaimable;
-	callback->UnitDef_isCapturable = &skirmishAiCallback_UnitDef_isCapturable;
-	callback->UnitDef_isAbleToRestore = &skirmishAiCallback_UnitDef_isAbleToRestore;
-	callback->UnitDef_isAbleToRepair = &skirmishAiCallback_UnitDef_isAbleToRepair;
-	callback->UnitDef_isAbleToSelfRepair = &skirmishAiCallback_UnitDef_isAbleToSelfRepair;
-	callback->UnitDef_isAbleToReclaim = &skirmishAiCallback_UnitDef_isAbleToReclaim;
-	callback->UnitDef_isAbleToAttack = &skirmishAiCallback_UnitDef_isAbleToAttack;
-	callback->UnitDef_isAbleToPatrol = &skirmishAiCallback_UnitDef_isAbleToPatrol;
-	callback->UnitDef_isAbleToFight = &skirmishAiCallback_UnitDef_isAbleToFight;
-	callback->UnitDef_isAbleToGuard = &skirmishAiCallback_UnitDef_isAbleToGuard;
-	callback->UnitDef_isAbleToAssist = &skirmishAiCallback_UnitDef_isAbleToAssist;
-	callback->UnitDef_isAssistable = &skirmishAiCallback_UnitDef_isAssistable;
-	callback->UnitDef_isAbleToRepeat = &skirmishAiCallback_UnitDef_isAbleToRepeat;
-	callback->UnitDef_isAbleToFireControl = &skirmishAiCallback_UnitDef_isAbleToFireControl;
-	callback->UnitDef_getFireState = &skirmishAiCallback_UnitDef_getFireState;
-	callback->UnitDef_getMoveState = &skirmishAiCallback_UnitDef_getMoveState;
-	callback->UnitDef_getWingDrag = &skirmishAiCallback_UnitDef_getWingDrag;
-	callback->UnitDef_getWingAngle = &skirmishAiCallback_UnitDef_getWingAngle;
-	callback->UnitDef_getFrontToSpeed = &skirmishAiCallback_UnitDef_getFrontToSpeed;
-	callback->UnitDef_getSpeedToFront = &skirmishAiCallback_UnitDef_getSpeedToFront;
-	callback->UnitDef_getMyGravity = &skirmishAiCallback_UnitDef_getMyGravity;
-	callback->UnitDef_getMaxBank = &skirmishAiCallback_UnitDef_getMaxBank;
-	callback->UnitDef_getMaxPitch = &skirmishAiCallback_UnitDef_getMaxPitch;
-	callback->UnitDef_getTurnRadius = &skirmishAiCallback_UnitDef_getTurnRadius;
-	callback->UnitDef_getWantedHeight = &skirmishAiCallback_UnitDef_getWantedHeight;
-	callback->UnitDef_getVerticalSpeed = &skirmishAiCallback_UnitDef_getVerticalSpeed;
-
-	callback->UnitDef_isHoverAttack = &skirmishAiCallback_UnitDef_isHoverAttack;
-	callback->UnitDef_isAirStrafe = &skirmishAiCallback_UnitDef_isAirStrafe;
-
-	callback->UnitDef_getDlHoverFactor = &skirmishAiCallback_UnitDef_getDlHoverFactor;
-	callback->UnitDef_getMaxAcceleration = &skirmishAiCallback_UnitDef_getMaxAcceleration;
-	callback->UnitDef_getMaxDeceleration = &skirmishAiCallback_UnitDef_getMaxDeceleration;
-	callback->UnitDef_getMaxAileron = &skirmishAiCallback_UnitDef_getMaxAileron;
-	callback->UnitDef_getMaxElevator = &skirmishAiCallback_UnitDef_getMaxElevator;
-	callback->UnitDef_getMaxRudder = &skirmishAiCallback_UnitDef_getMaxRudder;
-	callback->UnitDef_getYardMap = &skirmishAiCallback_UnitDef_getYardMap;
-	callback->UnitDef_getXSize = &skirmishAiCallback_UnitDef_getXSize;
-	callback->UnitDef_getZSize = &skirmishAiCallback_UnitDef_getZSize;
-	callback->UnitDef_getLoadingRadius = &skirmishAiCallback_UnitDef_getLoadingRadius;
-	callback->UnitDef_getUnloadSpread = &skirmishAiCallback_UnitDef_getUnloadSpread;
-	callback->UnitDef_getTransportCapacity = &skirmishAiCallback_UnitDef_getTransportCapacity;
-	callback->UnitDef_getTransportSize = &skirmishAiCallback_UnitDef_getTransportSize;
-	callback->UnitDef_getMinTransportSize = &skirmishAiCallback_UnitDef_getMinTransportSize;
-	callback->UnitDef_isAirBase = &skirmishAiCallback_UnitDef_isAirBase;
-	callback->UnitDef_isFirePlatform = &skirmishAiCallback_UnitDef_isFirePlatform;
-	callback->UnitDef_getTransportMass = &skirmishAiCallback_UnitDef_getTransportMass;
-	callback->UnitDef_getMinTransportMass = &skirmishAiCallback_UnitDef_getMinTransportMass;
-	callback->UnitDef_isHoldSteady = &skirmishAiCallback_UnitDef_isHoldSteady;
-	callback->UnitDef_isReleaseHeld = &skirmishAiCallback_UnitDef_isReleaseHeld;
-	callback->UnitDef_isNotTransportable = &skirmishAiCallback_UnitDef_isNotTransportable;
-	callback->UnitDef_isTransportByEnemy = &skirmishAiCallback_UnitDef_isTransportByEnemy;
-	callback->UnitDef_getTransportUnloadMethod = &skirmishAiCallback_UnitDef_getTransportUnloadMethod;
-	callback->UnitDef_getFallSpeed = &skirmishAiCallback_UnitDef_getFallSpeed;
-	callback->UnitDef_getUnitFallSpeed = &skirmishAiCallback_UnitDef_getUnitFallSpeed;
-	callback->UnitDef_isAbleToCloak = &skirmishAiCallback_UnitDef_isAbleToCloak;
-	callback->UnitDef_isStartCloaked = &skirmishAiCallback_UnitDef_isStartCloaked;
-	callback->UnitDef_getCloakCost = &skirmishAiCallback_UnitDef_getCloakCost;
-	callback->UnitDef_getCloakCostMoving = &skirmishAiCallback_UnitDef_getCloakCostMoving;
-	callback->UnitDef_getDecloakDistance = &skirmishAiCallback_UnitDef_getDecloakDistance;
-	callback->UnitDef_isDecloakSpherical = &skirmishAiCallback_UnitDef_isDecloakSpherical;
-	callback->UnitDef_isDecloakOnFire = &skirmishAiCallback_UnitDef_isDecloakOnFire;
-	callback->UnitDef_isAbleToKamikaze = &skirmishAiCallback_UnitDef_isAbleToKamikaze;
-	callback->UnitDef_getKamikazeDist = &skirmishAiCallback_UnitDef_getKamikazeDist;
-	callback->UnitDef_isTargetingFacility = &skirmishAiCallback_UnitDef_isTargetingFacility;
-	callback->UnitDef_canManualFire = &skirmishAiCallback_UnitDef_canManualFire;
-	callback->UnitDef_isNeedGeo = &skirmishAiCallback_UnitDef_isNeedGeo;
-	callback->UnitDef_isFeature = &skirmishAiCallback_UnitDef_isFeature;
-	callback->UnitDef_isHideDamage = &skirmishAiCallback_UnitDef_isHideDamage;
-	callback->UnitDef_isShowPlayerName = &skirmishAiCallback_UnitDef_isShowPlayerName;
-	callback->UnitDef_isAbleToResurrect = &skirmishAiCallback_UnitDef_isAbleToResurrect;
-	callback->UnitDef_isAbleToCapture = &skirmishAiCallback_UnitDef_isAbleToCapture;
-	callback->UnitDef_getHighTrajectoryType = &skirmishAiCallback_UnitDef_getHighTrajectoryType;
-	callback->UnitDef_getNoChaseCategory = &skirmishAiCallback_UnitDef_getNoChaseCategory;
-	callback->UnitDef_isAbleToDropFlare = &skirmishAiCallback_UnitDef_isAbleToDropFlare;
-	callback->UnitDef_getFlareReloadTime = &skirmishAiCallback_UnitDef_getFlareReloadTime;
-	callback->UnitDef_getFlareEfficiency = &skirmishAiCallback_UnitDef_getFlareEfficiency;
-	callback->UnitDef_getFlareDelay = &skirmishAiCallback_UnitDef_getFlareDelay;
-	callback->UnitDef_getFlareDropVector = &skirmishAiCallback_UnitDef_getFlareDropVector;
-	callback->UnitDef_getFlareTime = &skirmishAiCallback_UnitDef_getFlareTime;
-	callback->UnitDef_getFlareSalvoSize = &skirmishAiCallback_UnitDef_getFlareSalvoSize;
-	callback->UnitDef_getFlareSalvoDelay = &skirmishAiCallback_UnitDef_getFlareSalvoDelay;
-	callback->UnitDef_isAbleToLoopbackAttack = &skirmishAiCallback_UnitDef_isAbleToLoopbackAttack;
-	callback->UnitDef_isLevelGround = &skirmishAiCallback_UnitDef_isLevelGround;
-	callback->UnitDef_getMaxThisUnit = &skirmishAiCallback_UnitDef_getMaxThisUnit;
-	callback->UnitDef_getDecoyDef = &skirmishAiCallback_UnitDef_getDecoyDef;
-	callback->UnitDef_isDontLand = &skirmishAiCallback_UnitDef_isDontLand;
-	callback->UnitDef_getShieldDef = &skirmishAiCallback_UnitDef_getShieldDef;
-	callback->UnitDef_getStockpileDef = &skirmishAiCallback_UnitDef_getStockpileDef;
-	callback->UnitDef_getBuildOptions = &skirmishAiCallback_UnitDef_getBuildOptions;
-	callback->UnitDef_getCustomParams = &skirmishAiCallback_UnitDef_getCustomParams;
-	callback->UnitDef_isMoveDataAvailable = &skirmishAiCallback_UnitDef_isMoveDataAvailable;
-	callback->UnitDef_MoveData_getXSize = &skirmishAiCallback_UnitDef_MoveData_getXSize;
-	callback->UnitDef_MoveData_getZSize = &skirmishAiCallback_UnitDef_MoveData_getZSize;
-	callback->UnitDef_MoveData_getDepth = &skirmishAiCallback_UnitDef_MoveData_getDepth;
-	callback->UnitDef_MoveData_getMaxSlope = &skirmishAiCallback_UnitDef_MoveData_getMaxSlope;
-	callback->UnitDef_MoveData_getSlopeMod = &skirmishAiCallback_UnitDef_MoveData_getSlopeMod;
-	callback->UnitDef_MoveData_getDepthMod = &skirmishAiCallback_UnitDef_MoveData_getDepthMod;
-	callback->UnitDef_MoveData_getPathType = &skirmishAiCallback_UnitDef_MoveData_getPathType;
-	callback->UnitDef_MoveData_getCrushStrength = &skirmishAiCallback_UnitDef_MoveData_getCrushStrength;
-	callback->UnitDef_MoveData_getSpeedModClass = &skirmishAiCallback_UnitDef_MoveData_getSpeedModClass;
-	callback->UnitDef_MoveData_getTerrainClass = &skirmishAiCallback_UnitDef_MoveData_getTerrainClass;
-	callback->UnitDef_MoveData_getFollowGround = &skirmishAiCallback_UnitDef_MoveData_getFollowGround;
-	callback->UnitDef_MoveData_isSubMarine = &skirmishAiCallback_UnitDef_MoveData_isSubMarine;
-	callback->UnitDef_MoveData_getName = &skirmishAiCallback_UnitDef_MoveData_getName;
-	callback->UnitDef_getWeaponMounts = &skirmishAiCallback_UnitDef_getWeaponMounts;
-	callback->UnitDef_WeaponMount_getName = &skirmishAiCallback_UnitDef_WeaponMount_getName;
-	callback->UnitDef_WeaponMount_getWeaponDef = &skirmishAiCallback_UnitDef_WeaponMount_getWeaponDef;
-	callback->UnitDef_WeaponMount_getSlavedTo = &skirmishAiCallback_UnitDef_WeaponMount_getSlavedTo;
-	callback->UnitDef_WeaponMount_getMainDir = &skirmishAiCallback_UnitDef_WeaponMount_getMainDir;
-	callback->UnitDef_WeaponMount_getMaxAngleDif = &skirmishAiCallback_UnitDef_WeaponMount_getMaxAngleDif;
-	callback->UnitDef_WeaponMount_getBadTargetCategory = &skirmishAiCallback_UnitDef_WeaponMount_getBadTargetCategory;
-	callback->UnitDef_WeaponMount_getOnlyTargetCategory = &skirmishAiCallback_UnitDef_WeaponMount_getOnlyTargetCategory;
-	callback->Unit_getLimit = &skirmishAiCallback_Unit_getLimit;
-	callback->Unit_getMax = &skirmishAiCallback_Unit_getMax;
-	callback->getEnemyUnits = &skirmishAiCallback_getEnemyUnits;
-	callback->getEnemyUnitsIn = &skirmishAiCallback_getEnemyUnitsIn;
-	callback->getEnemyUnitsInRadarAndLos = &skirmishAiCallback_getEnemyUnitsInRadarAndLos;
-	callback->getFriendlyUnits = &skirmishAiCallback_getFriendlyUnits;
-	callback->getFriendlyUnitsIn = &skirmishAiCallback_getFriendlyUnitsIn;
-	callback->getNeutralUnits = &skirmishAiCallback_getNeutralUnits;
-	callback->getNeutralUnitsIn = &skirmishAiCallback_getNeutralUnitsIn;
-	callback->getTeamUnits = &skirmishAiCallback_getTeamUnits;
-	callback->getSelectedUnits = &skirmishAiCallback_getSelectedUnits;
-	callback->Unit_getDef = &skirmishAiCallback_Unit_getDef;
-	callback->Unit_getRulesParamFloat = &skirmishAiCallback_Unit_getRulesParamFloat;
-	callback->Unit_getRulesParamString = &skirmishAiCallback_Unit_getRulesParamString;
-	callback->Unit_getTeam = &skirmishAiCallback_Unit_getTeam;
-	callback->Unit_getAllyTeam = &skirmishAiCallback_Unit_getAllyTeam;
-	callback->Unit_getStockpile = &skirmishAiCallback_Unit_getStockpile;
-	callback->Unit_getStockpileQueued = &skirmishAiCallback_Unit_getStockpileQueued;
-	callback->Unit_getMaxSpeed = &skirmishAiCallback_Unit_getMaxSpeed;
-	callback->Unit_getMaxRange = &skirmishAiCallback_Unit_getMaxRange;
-	callback->Unit_getMaxHealth = &skirmishAiCallback_Unit_getMaxHealth;
-	callback->Unit_getExperience = &skirmishAiCallback_Unit_getExperience;
-	callback->Unit_getGroup = &skirmishAiCallback_Unit_getGroup;
-	callback->Unit_getCurrentCommands = &skirmishAiCallback_Unit_getCurrentCommands;
-	callback->Unit_CurrentCommand_getType = &skirmishAiCallback_Unit_CurrentCommand_getType;
-	callback->Unit_CurrentCommand_getId = &skirmishAiCallback_Unit_CurrentCommand_getId;
-	callback->Unit_CurrentCommand_getOptions = &skirmishAiCallback_Unit_CurrentCommand_getOptions;
-	callback->Unit_CurrentCommand_getTag = &skirmishAiCallback_Unit_CurrentCommand_getTag;
-	callback->Unit_CurrentCommand_getTimeOut = &skirmishAiCallback_Unit_CurrentCommand_getTimeOut;
-	callback->Unit_CurrentCommand_getParams = &skirmishAiCallback_Unit_CurrentCommand_getParams;
-	callback->Unit_getSupportedCommands = &skirmishAiCallback_Unit_getSupportedCommands;
-	callback->Unit_SupportedCommand_getId = &skirmishAiCallback_Unit_SupportedCommand_getId;
-	callback->Unit_SupportedCommand_getName = &skirmishAiCallback_Unit_SupportedCommand_getName;
-	callback->Unit_SupportedCommand_getToolTip = &skirmishAiCallback_Unit_SupportedCommand_getToolTip;
-	callback->Unit_SupportedCommand_isShowUnique = &skirmishAiCallback_Unit_SupportedCommand_isShowUnique;
-	callback->Unit_SupportedCommand_isDisabled = &skirmishAiCallback_Unit_SupportedCommand_isDisabled;
-	callback->Unit_SupportedCommand_getParams = &skirmishAiCallback_Unit_SupportedCommand_getParams;
-	callback->Unit_getHealth = &skirmishAiCallback_Unit_getHealth;
-	callback->Unit_getParalyzeDamage = &skirmishAiCallback_Unit_getParalyzeDamage;
-	callback->Unit_getCaptureProgress = &skirmishAiCallback_Unit_getCaptureProgress;
-	callback->Unit_getBuildProgress = &skirmishAiCallback_Unit_getBuildProgress;
-	callback->Unit_getSpeed = &skirmishAiCallback_Unit_getSpeed;
-	callback->Unit_getPower = &skirmishAiCallback_Unit_getPower;
-	callback->Unit_getResourceUse = &skirmishAiCallback_Unit_getResourceUse;
-	callback->Unit_getResourceMake = &skirmishAiCallback_Unit_getResourceMake;
-	callback->Unit_getPos = &skirmishAiCallback_Unit_getPos;
-	callback->Unit_getVel = &skirmishAiCallback_Unit_getVel;
-	callback->Unit_isActivated = &skirmishAiCallback_Unit_isActivated;
-	callback->Unit_isBeingBuilt = &skirmishAiCallback_Unit_isBeingBuilt;
-	callback->Unit_isCloaked = &skirmishAiCallback_Unit_isCloaked;
-	callback->Unit_isParalyzed = &skirmishAiCallback_Unit_isParalyzed;
-	callback->Unit_isNeutral = &skirmishAiCallback_Unit_isNeutral;
-	callback->Unit_getBuildingFacing = &skirmishAiCallback_Unit_getBuildingFacing;
-	callback->Unit_getLastUserOrderFrame = &skirmishAiCallback_Unit_getLastUserOrderFrame;
-	callback->Unit_getWeapons = &skirmishAiCallback_Unit_getWeapons;
-	callback->Unit_getWeapon = &skirmishAiCallback_Unit_getWeapon;
-	callback->Team_hasAIController = &skirmishAiCallback_Team_hasAIController;
-	callback->getEnemyTeams = &skirmishAiCallback_getEnemyTeams;
-	callback->getAllyTeams = &skirmishAiCallback_getAllyTeams;
-	callback->Team_getRulesParamFloat = &skirmishAiCallback_Team_getRulesParamFloat;
-	callback->Team_getRulesParamString = &skirmishAiCallback_Team_getRulesParamString;
-	callback->getGroups = &skirmishAiCallback_getGroups;
-	callback->Group_getSupportedCommands = &skirmishAiCallback_Group_getSupportedCommands;
-	callback->Group_SupportedCommand_getId = &skirmishAiCallback_Group_SupportedCommand_getId;
-	callback->Group_SupportedCommand_getName = &skirmishAiCallback_Group_SupportedCommand_getName;
-	callback->Group_SupportedCommand_getToolTip = &skirmishAiCallback_Group_SupportedCommand_getToolTip;
-	callback->Group_SupportedCommand_isShowUnique = &skirmishAiCallback_Group_SupportedCommand_isShowUnique;
-	callback->Group_SupportedCommand_isDisabled = &skirmishAiCallback_Group_SupportedCommand_isDisabled;
-	callback->Group_SupportedCommand_getParams = &skirmishAiCallback_Group_SupportedCommand_getParams;
-	callback->Group_OrderPreview_getId = &skirmishAiCallback_Group_OrderPreview_getId;
-	callback->Group_OrderPreview_getOptions = &skirmishAiCallback_Group_OrderPreview_getOptions;
-	callback->Group_OrderPreview_getTag = &skirmishAiCallback_Group_OrderPreview_getTag;
-	callback->Group_OrderPreview_getTimeOut = &skirmishAiCallback_Group_OrderPreview_getTimeOut;
-	callback->Group_OrderPreview_getParams = &skirmishAiCallback_Group_OrderPreview_getParams;
-	callback->Group_isSelected = &skirmishAiCallback_Group_isSelected;
-	callback->Mod_getFileName = &skirmishAiCallback_Mod_getFileName;
-	callback->Mod_getHash = &skirmishAiCallback_Mod_getHash;
-	callback->Mod_getHumanName = &skirmishAiCallback_Mod_getHumanName;
-	callback->Mod_getShortName = &skirmishAiCallback_Mod_getShortName;
-	callback->Mod_getVersion = &skirmishAiCallback_Mod_getVersion;
-	callback->Mod_getMutator = &skirmishAiCallback_Mod_getMutator;
-	callback->Mod_getDescription = &skirmishAiCallback_Mod_getDescription;
-	callback->Mod_getConstructionDecay = &skirmishAiCallback_Mod_getConstructionDecay;
-	callback->Mod_getConstructionDecayTime = &skirmishAiCallback_Mod_getConstructionDecayTime;
-	callback->Mod_getConstructionDecaySpeed = &skirmishAiCallback_Mod_getConstructionDecaySpeed;
-	callback->Mod_getMultiReclaim = &skirmishAiCallback_Mod_getMultiReclaim;
-	callback->Mod_getReclaimMethod = &skirmishAiCallback_Mod_getReclaimMethod;
-	callback->Mod_getReclaimUnitMethod = &skirmishAiCallback_Mod_getReclaimUnitMethod;
-	callback->Mod_getReclaimUnitEnergyCostFactor = &skirmishAiCallback_Mod_getReclaimUnitEnergyCostFactor;
-	callback->Mod_getReclaimUnitEfficiency = &skirmishAiCallback_Mod_getReclaimUnitEfficiency;
-	callback->Mod_getReclaimFeatureEnergyCostFactor = &skirmishAiCallback_Mod_getReclaimFeatureEnergyCostFactor;
-	callback->Mod_getReclaimAllowEnemies = &skirmishAiCallback_Mod_getReclaimAllowEnemies;
-	callback->Mod_getReclaimAllowAllies = &skirmishAiCallback_Mod_getReclaimAllowAllies;
-	callback->Mod_getRepairEnergyCostFactor = &skirmishAiCallback_Mod_getRepairEnergyCostFactor;
-	callback->Mod_getResurrectEnergyCostFactor = &skirmishAiCallback_Mod_getResurrectEnergyCostFactor;
-	callback->Mod_getCaptureEnergyCostFactor = &skirmishAiCallback_Mod_getCaptureEnergyCostFactor;
-	callback->Mod_getTransportGround = &skirmishAiCallback_Mod_getTransportGround;
-	callback->Mod_getTransportHover = &skirmishAiCallback_Mod_getTransportHover;
-	callback->Mod_getTransportShip = &skirmishAiCallback_Mod_getTransportShip;
-	callback->Mod_getTransportAir = &skirmishAiCallback_Mod_getTransportAir;
-	callback->Mod_getFireAtKilled = &skirmishAiCallback_Mod_getFireAtKilled;
-	callback->Mod_getFireAtCrashing = &skirmishAiCallback_Mod_getFireAtCrashing;
-	callback->Mod_getFlankingBonusModeDefault = &skirmishAiCallback_Mod_getFlankingBonusModeDefault;
-	callback->Mod_getLosMipLevel = &skirmishAiCallback_Mod_getLosMipLevel;
-	callback->Mod_getAirMipLevel = &skirmishAiCallback_Mod_getAirMipLevel;
-	callback->Mod_getRadarMipLevel = &skirmishAiCallback_Mod_getRadarMipLevel;
-	callback->Mod_getRequireSonarUnderWater = &skirmishAiCallback_Mod_getRequireSonarUnderWater;
-	callback->Map_getChecksum = &skirmishAiCallback_Map_getChecksum;
-	callback->Map_getStartPos = &skirmishAiCallback_Map_getStartPos;
-	callback->Map_getMousePos = &skirmishAiCallback_Map_getMousePos;
-	callback->Map_isPosInCamera = &skirmishAiCallback_Map_isPosInCamera;
-	callback->Map_getWidth = &skirmishAiCallback_Map_getWidth;
-	callback->Map_getHeight = &skirmishAiCallback_Map_getHeight;
-	callback->Map_getHeightMap = &skirmishAiCallback_Map_getHeightMap;
-	callback->Map_getCornersHeightMap = &skirmishAiCallback_Map_getCornersHeightMap;
-	callback->Map_getMinHeight = &skirmishAiCallback_Map_getMinHeight;
-	callback->Map_getMaxHeight = &skirmishAiCallback_Map_getMaxHeight;
-	callback->Map_getSlopeMap = &skirmishAiCallback_Map_getSlopeMap;
-	callback->Map_getLosMap = &skirmishAiCallback_Map_getLosMap;
-	callback->Map_getAirLosMap = &skirmishAiCallback_Map_getAirLosMap;
-	callback->Map_getRadarMap = &skirmishAiCallback_Map_getRadarMap;
-	callback->Map_getSonarMap = &skirmishAiCallback_Map_getSonarMap;
-	callback->Map_getSeismicMap = &skirmishAiCallback_Map_getSeismicMap;
-	callback->Map_getJammerMap = &skirmishAiCallback_Map_getJammerMap;
-	callback->Map_getSonarJammerMap = &skirmishAiCallback_Map_getSonarJammerMap;
-	callback->Map_getResourceMapRaw = &skirmishAiCallback_Map_getResourceMapRaw;
-	callback->Map_getResourceMapSpotsPositions = &skirmishAiCallback_Map_getResourceMapSpotsPositions;
-	callback->Map_getResourceMapSpotsAverageIncome = &skirmishAiCallback_Map_getResourceMapSpotsAverageIncome;
-	callback->Map_getResourceMapSpotsNearest = &skirmishAiCallback_Map_getResourceMapSpotsNearest;
-	callback->Map_getHash = &skirmishAiCallback_Map_getHash;
-	callback->Map_getName = &skirmishAiCallback_Map_getName;
-	callback->Map_getHumanName = &skirmishAiCallback_Map_getHumanName;
-	callback->Map_getElevationAt = &skirmishAiCallback_Map_getElevationAt;
-	callback->Map_getMaxResource = &skirmishAiCallback_Map_getMaxResource;
-	callback->Map_getExtractorRadius = &skirmishAiCallback_Map_getExtractorRadius;
-	callback->Map_getMinWind = &skirmishAiCallback_Map_getMinWind;
-	callback->Map_getMaxWind = &skirmishAiCallback_Map_getMaxWind;
-	callback->Map_getCurWind = &skirmishAiCallback_Map_getCurWind;
-	callback->Map_getTidalStrength = &skirmishAiCallback_Map_getTidalStrength;
-	callback->Map_getGravity = &skirmishAiCallback_Map_getGravity;
-	callback->Map_getWaterDamage = &skirmishAiCallback_Map_getWaterDamage;
-	callback->Map_isDeformable = &skirmishAiCallback_Map_isDeformable;
-	callback->Map_getHardness = &skirmishAiCallback_Map_getHardness;
-	callback->Map_getHardnessModMap = &skirmishAiCallback_Map_getHardnessModMap;
-	callback->Map_getSpeedModMap = &skirmishAiCallback_Map_getSpeedModMap;
-	callback->Map_getPoints = &skirmishAiCallback_Map_getPoints;
-	callback->Map_Point_getPosition = &skirmishAiCallback_Map_Point_getPosition;
-	callback->Map_Point_getColor = &skirmishAiCallback_Map_Point_getColor;
-	callback->Map_Point_getLabel = &skirmishAiCallback_Map_Point_getLabel;
-	callback->Map_getLines = &skirmishAiCallback_Map_getLines;
-	callback->Map_Line_getFirstPosition = &skirmishAiCallback_Map_Line_getFirstPosition;
-	callback->Map_Line_getSecondPosition = &skirmishAiCallback_Map_Line_getSecondPosition;
-	callback->Map_Line_getColor = &skirmishAiCallback_Map_Line_getColor;
-	callback->Map_isPossibleToBuildAt = &skirmishAiCallback_Map_isPossibleToBuildAt;
-	callback->Map_findClosestBuildSite = &skirmishAiCallback_Map_findClosestBuildSite;
-	callback->getFeatureDefs = &skirmishAiCallback_getFeatureDefs;
-	callback->FeatureDef_getName = &skirmishAiCallback_FeatureDef_getName;
-	callback->FeatureDef_getDescription = &skirmishAiCallback_FeatureDef_getDescription;
-	callback->FeatureDef_getContainedResource = &skirmishAiCallback_FeatureDef_getContainedResource;
-	callback->FeatureDef_getMaxHealth = &skirmishAiCallback_FeatureDef_getMaxHealth;
-	callback->FeatureDef_getReclaimTime = &skirmishAiCallback_FeatureDef_getReclaimTime;
-	callback->FeatureDef_getMass = &skirmishAiCallback_FeatureDef_getMass;
-	callback->FeatureDef_isUpright = &skirmishAiCallback_FeatureDef_isUpright;
-	callback->FeatureDef_getDrawType = &skirmishAiCallback_FeatureDef_getDrawType;
-	callback->FeatureDef_getModelName = &skirmishAiCallback_FeatureDef_getModelName;
-	callback->FeatureDef_getResurrectable = &skirmishAiCallback_FeatureDef_getResurrectable;
-	callback->FeatureDef_getSmokeTime = &skirmishAiCallback_FeatureDef_getSmokeTime;
-	callback->FeatureDef_isDestructable = &skirmishAiCallback_FeatureDef_isDestructable;
-	callback->FeatureDef_isReclaimable = &skirmishAiCallback_FeatureDef_isReclaimable;
-	callback->FeatureDef_isBlocking = &skirmishAiCallback_FeatureDef_isBlocking;
-	callback->FeatureDef_isBurnable = &skirmishAiCallback_FeatureDef_isBurnable;
-	callback->FeatureDef_isFloating = &skirmishAiCallback_FeatureDef_isFloating;
-	callback->FeatureDef_isNoSelect = &skirmishAiCallback_FeatureDef_isNoSelect;
-	callback->FeatureDef_isGeoThermal = &skirmishAiCallback_FeatureDef_isGeoThermal;
-	callback->FeatureDef_getXSize = &skirmishAiCallback_FeatureDef_getXSize;
-	callback->FeatureDef_getZSize = &skirmishAiCallback_FeatureDef_getZSize;
-	callback->FeatureDef_getCustomParams = &skirmishAiCallback_FeatureDef_getCustomParams;
-	callback->getFeatures = &skirmishAiCallback_getFeatures;
-	callback->getFeaturesIn = &skirmishAiCallback_getFeaturesIn;
-	callback->Feature_getDef = &skirmishAiCallback_Feature_getDef;
-	callback->Feature_getHealth = &skirmishAiCallback_Feature_getHealth;
-	callback->Feature_getReclaimLeft = &skirmishAiCallback_Feature_getReclaimLeft;
-	callback->Feature_getPosition = &skirmishAiCallback_Feature_getPosition;
-	callback->Feature_getRulesParamFloat = &skirmishAiCallback_Feature_getRulesParamFloat;
-	callback->Feature_getRulesParamString = &skirmishAiCallback_Feature_getRulesParamString;
-	callback->getWeaponDefs = &skirmishAiCallback_getWeaponDefs;
-	callback->getWeaponDefByName = &skirmishAiCallback_getWeaponDefByName;
-	callback->WeaponDef_getName = &skirmishAiCallback_WeaponDef_getName;
-	callback->WeaponDef_getType = &skirmishAiCallback_WeaponDef_getType;
-	callback->WeaponDef_getDescription = &skirmishAiCallback_WeaponDef_getDescription;
-	callback->WeaponDef_getRange = &skirmishAiCallback_WeaponDef_getRange;
-	callback->WeaponDef_getHeightMod = &skirmishAiCallback_WeaponDef_getHeightMod;
-	callback->WeaponDef_getAccuracy = &skirmishAiCallback_WeaponDef_getAccuracy;
-	callback->WeaponDef_getSprayAngle = &skirmishAiCallback_WeaponDef_getSprayAngle;
-	callback->WeaponDef_getMovingAccuracy = &skirmishAiCallback_WeaponDef_getMovingAccuracy;
-	callback->WeaponDef_getTargetMoveError = &skirmishAiCallback_WeaponDef_getTargetMoveError;
-	callback->WeaponDef_getLeadLimit = &skirmishAiCallback_WeaponDef_getLeadLimit;
-	callback->WeaponDef_getLeadBonus = &skirmishAiCallback_WeaponDef_getLeadBonus;
-	callback->WeaponDef_getPredictBoost = &skirmishAiCallback_WeaponDef_getPredictBoost;
-	callback->WeaponDef_getNumDamageTypes = &skirmishAiCallback_WeaponDef_getNumDamageTypes;
-	callback->WeaponDef_Damage_getParalyzeDamageTime = &skirmishAiCallback_WeaponDef_Damage_getParalyzeDamageTime;
-	callback->WeaponDef_Damage_getImpulseFactor = &skirmishAiCallback_WeaponDef_Damage_getImpulseFactor;
-	callback->WeaponDef_Damage_getImpulseBoost = &skirmishAiCallback_WeaponDef_Damage_getImpulseBoost;
-	callback->WeaponDef_Damage_getCraterMult = &skirmishAiCallback_WeaponDef_Damage_getCraterMult;
-	callback->WeaponDef_Damage_getCraterBoost = &skirmishAiCallback_WeaponDef_Damage_getCraterBoost;
-	callback->WeaponDef_Damage_getTypes = &skirmishAiCallback_WeaponDef_Damage_getTypes;
-	callback->WeaponDef_getAreaOfEffect = &skirmishAiCallback_WeaponDef_getAreaOfEffect;
-	callback->WeaponDef_isNoSelfDamage = &skirmishAiCallback_WeaponDef_isNoSelfDamage;
-	callback->WeaponDef_getFireStarter = &skirmishAiCallback_WeaponDef_getFireStarter;
-	callback->WeaponDef_getEdgeEffectiveness = &skirmishAiCallback_WeaponDef_getEdgeEffectiveness;
-	callback->WeaponDef_getSize = &skirmishAiCallback_WeaponDef_getSize;
-	callback->WeaponDef_getSizeGrowth = &skirmishAiCallback_WeaponDef_getSizeGrowth;
-	callback->WeaponDef_getCollisionSize = &skirmishAiCallback_WeaponDef_getCollisionSize;
-	callback->WeaponDef_getSalvoSize = &skirmishAiCallback_WeaponDef_getSalvoSize;
-	callback->WeaponDef_getSalvoDelay = &skirmishAiCallback_WeaponDef_getSalvoDelay;
-	callback->WeaponDef_getReload = &skirmishAiCallback_WeaponDef_getReload;
-	callback->WeaponDef_getBeamTime = &skirmishAiCallback_WeaponDef_getBeamTime;
-	callback->WeaponDef_isBeamBurst = &skirmishAiCallback_WeaponDef_isBeamBurst;
-	callback->WeaponDef_isWaterBounce = &skirmishAiCallback_WeaponDef_isWaterBounce;
-	callback->WeaponDef_isGroundBounce = &skirmishAiCallback_WeaponDef_isGroundBounce;
-	callback->WeaponDef_getBounceRebound = &skirmishAiCallback_WeaponDef_getBounceRebound;
-	callback->WeaponDef_getBounceSlip = &skirmishAiCallback_WeaponDef_getBounceSlip;
-	callback->WeaponDef_getNumBounce = &skirmishAiCallback_WeaponDef_getNumBounce;
-	callback->WeaponDef_getMaxAngle = &skirmishAiCallback_WeaponDef_getMaxAngle;
-	callback->WeaponDef_getUpTime = &skirmishAiCallback_WeaponDef_getUpTime;
-	callback->WeaponDef_getFlightTime = &skirmishAiCallback_WeaponDef_getFlightTime;
-	callback->WeaponDef_getCost = &skirmishAiCallback_WeaponDef_getCost;
-	callback->WeaponDef_getProjectilesPerShot = &skirmishAiCallback_WeaponDef_getProjectilesPerShot;
-	callback->WeaponDef_isTurret = &skirmishAiCallback_WeaponDef_isTurret;
-	callback->WeaponDef_isOnlyForward = &skirmishAiCallback_WeaponDef_isOnlyForward;
-	callback->WeaponDef_isFixedLauncher = &skirmishAiCallback_WeaponDef_isFixedLauncher;
-	callback->WeaponDef_isWaterWeapon = &skirmishAiCallback_WeaponDef_isWaterWeapon;
-	callback->WeaponDef_isFireSubmersed = &skirmishAiCallback_WeaponDef_isFireSubmersed;
-	callback->WeaponDef_isSubMissile = &skirmishAiCallback_WeaponDef_isSubMissile;
-	callback->WeaponDef_isTracks = &skirmishAiCallback_WeaponDef_isTracks;
-	callback->WeaponDef_isDropped = &skirmishAiCallback_WeaponDef_isDropped;
-	callback->WeaponDef_isParalyzer = &skirmishAiCallback_WeaponDef_isParalyzer;
-	callback->WeaponDef_isImpactOnly = &skirmishAiCallback_WeaponDef_isImpactOnly;
-	callback->WeaponDef_isNoAutoTarget = &skirmishAiCallback_WeaponDef_isNoAutoTarget;
-	callback->WeaponDef_isManualFire = &skirmishAiCallback_WeaponDef_isManualFire;
-	callback->WeaponDef_getInterceptor = &skirmishAiCallback_WeaponDef_getInterceptor;
-	callback->WeaponDef_getTargetable = &skirmishAiCallback_WeaponDef_getTargetable;
-	callback->WeaponDef_isStockpileable = &skirmishAiCallback_WeaponDef_isStockpileable;
-	callback->WeaponDef_getCoverageRange = &skirmishAiCallback_WeaponDef_getCoverageRange;
-	callback->WeaponDef_getStockpileTime = &skirmishAiCallback_WeaponDef_getStockpileTime;
-	callback->WeaponDef_getIntensity = &skirmishAiCallback_WeaponDef_getIntensity;
-	callback->WeaponDef_getDuration = &skirmishAiCallback_WeaponDef_getDuration;
-	callback->WeaponDef_getFalloffRate = &skirmishAiCallback_WeaponDef_getFalloffRate;
-	callback->WeaponDef_isSelfExplode = &skirmishAiCallback_WeaponDef_isSelfExplode;
-	callback->WeaponDef_isGravityAffected = &skirmishAiCallback_WeaponDef_isGravityAffected;
-	callback->WeaponDef_getHighTrajectory = &skirmishAiCallback_WeaponDef_getHighTrajectory;
-	callback->WeaponDef_getMyGravity = &skirmishAiCallback_WeaponDef_getMyGravity;
-	callback->WeaponDef_isNoExplode = &skirmishAiCallback_WeaponDef_isNoExplode;
-	callback->WeaponDef_getStartVelocity = &skirmishAiCallback_WeaponDef_getStartVelocity;
-	callback->WeaponDef_getWeaponAcceleration = &skirmishAiCallback_WeaponDef_getWeaponAcceleration;
-	callback->WeaponDef_getTurnRate = &skirmishAiCallback_WeaponDef_getTurnRate;
-	callback->WeaponDef_getMaxVelocity = &skirmishAiCallback_WeaponDef_getMaxVelocity;
-	callback->WeaponDef_getProjectileSpeed = &skirmishAiCallback_WeaponDef_getProjectileSpeed;
-	callback->WeaponDef_getExplosionSpeed = &skirmishAiCallback_WeaponDef_getExplosionSpeed;
-	callback->WeaponDef_getOnlyTargetCategory = &skirmishAiCallback_WeaponDef_getOnlyTargetCategory;
-	callback->WeaponDef_getWobble = &skirmishAiCallback_WeaponDef_getWobble;
-	callback->WeaponDef_getDance = &skirmishAiCallback_WeaponDef_getDance;
-	callback->WeaponDef_getTrajectoryHeight = &skirmishAiCallback_WeaponDef_getTrajectoryHeight;
-	callback->WeaponDef_isLargeBeamLaser = &skirmishAiCallback_WeaponDef_isLargeBeamLaser;
-	callback->WeaponDef_isShield = &skirmishAiCallback_WeaponDef_isShield;
-	callback->WeaponDef_isShieldRepulser = &skirmishAiCallback_WeaponDef_isShieldRepulser;
-	callback->WeaponDef_isSmartShield = &skirmishAiCallback_WeaponDef_isSmartShield;
-	callback->WeaponDef_isExteriorShield = &skirmishAiCallback_WeaponDef_isExteriorShield;
-	callback->WeaponDef_isVisibleShield = &skirmishAiCallback_WeaponDef_isVisibleShield;
-	callback->WeaponDef_isVisibleShieldRepulse = &skirmishAiCallback_WeaponDef_isVisibleShieldRepulse;
-	callback->WeaponDef_getVisibleShieldHitFrames = &skirmishAiCallback_WeaponDef_getVisibleShieldHitFrames;
-	callback->WeaponDef_Shield_getResourceUse = &skirmishAiCallback_WeaponDef_Shield_getResourceUse;
-	callback->WeaponDef_Shield_getRadius = &skirmishAiCallback_WeaponDef_Shield_getRadius;
-	callback->WeaponDef_Shield_getForce = &skirmishAiCallback_WeaponDef_Shield_getForce;
-	callback->WeaponDef_Shield_getMaxSpeed = &skirmishAiCallback_WeaponDef_Shield_getMaxSpeed;
-	callback->WeaponDef_Shield_getPower = &skirmishAiCallback_WeaponDef_Shield_getPower;
-	callback->WeaponDef_Shield_getPowerRegen = &skirmishAiCallback_WeaponDef_Shield_getPowerRegen;
-	callback->WeaponDef_Shield_getPowerRegenResource = &skirmishAiCallback_WeaponDef_Shield_getPowerRegenResource;
-	callback->WeaponDef_Shield_getStartingPower = &skirmishAiCallback_WeaponDef_Shield_getStartingPower;
-	callback->WeaponDef_Shield_getRechargeDelay = &skirmishAiCallback_WeaponDef_Shield_getRechargeDelay;
-	callback->WeaponDef_Shield_getInterceptType = &skirmishAiCallback_WeaponDef_Shield_getInterceptType;
-	callback->WeaponDef_getInterceptedByShieldType = &skirmishAiCallback_WeaponDef_getInterceptedByShieldType;
-	callback->WeaponDef_isAvoidFriendly = &skirmishAiCallback_WeaponDef_isAvoidFriendly;
-	callback->WeaponDef_isAvoidFeature = &skirmishAiCallback_WeaponDef_isAvoidFeature;
-	callback->WeaponDef_isAvoidNeutral = &skirmishAiCallback_WeaponDef_isAvoidNeutral;
-	callback->WeaponDef_getTargetBorder = &skirmishAiCallback_WeaponDef_getTargetBorder;
-	callback->WeaponDef_getCylinderTargetting = &skirmishAiCallback_WeaponDef_getCylinderTargetting;
-	callback->WeaponDef_getMinIntensity = &skirmishAiCallback_WeaponDef_getMinIntensity;
-	callback->WeaponDef_getHeightBoostFactor = &skirmishAiCallback_WeaponDef_getHeightBoostFactor;
-	callback->WeaponDef_getProximityPriority = &skirmishAiCallback_WeaponDef_getProximityPriority;
-	callback->WeaponDef_getCollisionFlags = &skirmishAiCallback_WeaponDef_getCollisionFlags;
-	callback->WeaponDef_isSweepFire = &skirmishAiCallback_WeaponDef_isSweepFire;
-	callback->WeaponDef_isAbleToAttackGround = &skirmishAiCallback_WeaponDef_isAbleToAttackGround;
-	callback->WeaponDef_getCameraShake = &skirmishAiCallback_WeaponDef_getCameraShake;
-	callback->WeaponDef_getDynDamageExp = &skirmishAiCallback_WeaponDef_getDynDamageExp;
-	callback->WeaponDef_getDynDamageMin = &skirmishAiCallback_WeaponDef_getDynDamageMin;
-	callback->WeaponDef_getDynDamageRange = &skirmishAiCallback_WeaponDef_getDynDamageRange;
-	callback->WeaponDef_isDynDamageInverted = &skirmishAiCallback_WeaponDef_isDynDamageInverted;
-	callback->WeaponDef_getCustomParams = &skirmishAiCallback_WeaponDef_getCustomParams;
-	callback->Unit_Weapon_getDef = &skirmishAiCallback_Unit_Weapon_getDef;
-	callback->Unit_Weapon_getReloadFrame = &skirmishAiCallback_Unit_Weapon_getReloadFrame;
-	callback->Unit_Weapon_getReloadTime = &skirmishAiCallback_Unit_Weapon_getReloadTime;
-	callback->Unit_Weapon_getRange = &skirmishAiCallback_Unit_Weapon_getRange;
-	callback->Unit_Weapon_isShieldEnabled = &skirmishAiCallback_Unit_Weapon_isShieldEnabled;
-	callback->Unit_Weapon_getShieldPower = &skirmishAiCallback_Unit_Weapon_getShieldPower;
-	callback->Debug_GraphDrawer_isEnabled = &skirmishAiCallback_Debug_GraphDrawer_isEnabled;
+	callback->Engine_handleCommand = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_handleCommand);
+	callback->Engine_executeCommand = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_executeCommand);
+
+	callback->Engine_Version_getMajor = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getMajor);
+	callback->Engine_Version_getMinor = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getMinor);
+	callback->Engine_Version_getPatchset = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getPatchset);
+	callback->Engine_Version_getCommits = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getCommits);
+	callback->Engine_Version_getHash = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getHash);
+	callback->Engine_Version_getBranch = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getBranch);
+	callback->Engine_Version_getAdditional = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getAdditional);
+	callback->Engine_Version_getBuildTime = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getBuildTime);
+	callback->Engine_Version_isRelease = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_isRelease);
+	callback->Engine_Version_getNormal = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getNormal);
+	callback->Engine_Version_getSync = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getSync);
+	callback->Engine_Version_getFull = SERIALIZED_CALLBACK(skirmishAiCallback_Engine_Version_getFull);
+	callback->Teams_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_Teams_getSize);
+	callback->SkirmishAIs_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAIs_getSize);
+	callback->SkirmishAIs_getMax = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAIs_getMax);
+	callback->SkirmishAI_getTeamId = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_getTeamId);
+	callback->SkirmishAI_Info_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_Info_getSize);
+	callback->SkirmishAI_Info_getKey = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_Info_getKey);
+	callback->SkirmishAI_Info_getValue = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_Info_getValue);
+	callback->SkirmishAI_Info_getDescription = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_Info_getDescription);
+	callback->SkirmishAI_Info_getValueByKey = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_Info_getValueByKey);
+	callback->SkirmishAI_OptionValues_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_OptionValues_getSize);
+	callback->SkirmishAI_OptionValues_getKey = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_OptionValues_getKey);
+	callback->SkirmishAI_OptionValues_getValue = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_OptionValues_getValue);
+	callback->SkirmishAI_OptionValues_getValueByKey = SERIALIZED_CALLBACK(skirmishAiCallback_SkirmishAI_OptionValues_getValueByKey);
+	callback->Log_log = SERIALIZED_CALLBACK(skirmishAiCallback_Log_log);
+	callback->Log_exception = SERIALIZED_CALLBACK(skirmishAiCallback_Log_exception);
+	callback->DataDirs_getPathSeparator = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_getPathSeparator);
+	callback->DataDirs_getConfigDir = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_getConfigDir);
+	callback->DataDirs_getWriteableDir = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_getWriteableDir);
+	callback->DataDirs_locatePath = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_locatePath);
+	callback->DataDirs_allocatePath = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_allocatePath);
+	callback->DataDirs_Roots_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_Roots_getSize);
+	callback->DataDirs_Roots_getDir = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_Roots_getDir);
+	callback->DataDirs_Roots_locatePath = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_Roots_locatePath);
+	callback->DataDirs_Roots_allocatePath = SERIALIZED_CALLBACK(skirmishAiCallback_DataDirs_Roots_allocatePath);
+	callback->Game_getCurrentFrame = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getCurrentFrame);
+	callback->Game_getAiInterfaceVersion = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getAiInterfaceVersion);
+	callback->Game_getMyTeam = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getMyTeam);
+	callback->Game_getMyAllyTeam = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getMyAllyTeam);
+	callback->Game_getPlayerTeam = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getPlayerTeam);
+	callback->Game_getTeams = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeams);
+	callback->Game_getTeamSide = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamSide);
+	callback->Game_getTeamColor = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamColor);
+	callback->Game_getTeamIncomeMultiplier = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamIncomeMultiplier);
+	callback->Game_getTeamAllyTeam = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamAllyTeam);
+	callback->Game_getTeamResourceCurrent = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceCurrent);
+	callback->Game_getTeamResourceIncome = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceIncome);
+	callback->Game_getTeamResourceUsage = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceUsage);
+	callback->Game_getTeamResourceStorage = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceStorage);
+	callback->Game_getTeamResourcePull = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourcePull);
+	callback->Game_getTeamResourceShare = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceShare);
+	callback->Game_getTeamResourceSent = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceSent);
+	callback->Game_getTeamResourceReceived = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceReceived);
+	callback->Game_getTeamResourceExcess = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getTeamResourceExcess);
+	callback->Game_isAllied = SERIALIZED_CALLBACK(skirmishAiCallback_Game_isAllied);
+	callback->Game_isDebugModeEnabled = SERIALIZED_CALLBACK(skirmishAiCallback_Game_isDebugModeEnabled);
+	callback->Game_isPaused = SERIALIZED_CALLBACK(skirmishAiCallback_Game_isPaused);
+	callback->Game_getSpeedFactor = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getSpeedFactor);
+	callback->Game_getSetupScript = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getSetupScript);
+	callback->Game_getCategoryFlag = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getCategoryFlag);
+	callback->Game_getCategoriesFlag = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getCategoriesFlag);
+	callback->Game_getCategoryName = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getCategoryName);
+	callback->Game_getRulesParamFloat = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getRulesParamFloat);
+	callback->Game_getRulesParamString = SERIALIZED_CALLBACK(skirmishAiCallback_Game_getRulesParamString);
+	callback->Gui_getViewRange = SERIALIZED_CALLBACK(skirmishAiCallback_Gui_getViewRange);
+	callback->Gui_getScreenX = SERIALIZED_CALLBACK(skirmishAiCallback_Gui_getScreenX);
+	callback->Gui_getScreenY = SERIALIZED_CALLBACK(skirmishAiCallback_Gui_getScreenY);
+	callback->Gui_Camera_getDirection = SERIALIZED_CALLBACK(skirmishAiCallback_Gui_Camera_getDirection);
+	callback->Gui_Camera_getPosition = SERIALIZED_CALLBACK(skirmishAiCallback_Gui_Camera_getPosition);
+	callback->Cheats_isEnabled = SERIALIZED_CALLBACK(skirmishAiCallback_Cheats_isEnabled);
+	callback->Cheats_setEnabled = SERIALIZED_CALLBACK(skirmishAiCallback_Cheats_setEnabled);
+	callback->Cheats_setEventsEnabled = SERIALIZED_CALLBACK(skirmishAiCallback_Cheats_setEventsEnabled);
+	callback->Cheats_isOnlyPassive = SERIALIZED_CALLBACK(skirmishAiCallback_Cheats_isOnlyPassive);
+	callback->getResources = SERIALIZED_CALLBACK(skirmishAiCallback_getResources);
+	callback->getResourceByName = SERIALIZED_CALLBACK(skirmishAiCallback_getResourceByName);
+	callback->Resource_getName = SERIALIZED_CALLBACK(skirmishAiCallback_Resource_getName);
+	callback->Resource_getOptimum = SERIALIZED_CALLBACK(skirmishAiCallback_Resource_getOptimum);
+	callback->Economy_getCurrent = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getCurrent);
+	callback->Economy_getIncome = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getIncome);
+	callback->Economy_getUsage = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getUsage);
+	callback->Economy_getStorage = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getStorage);
+	callback->Economy_getPull = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getPull);
+	callback->Economy_getShare = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getShare);
+	callback->Economy_getSent = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getSent);
+	callback->Economy_getReceived = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getReceived);
+	callback->Economy_getExcess = SERIALIZED_CALLBACK(skirmishAiCallback_Economy_getExcess);
+	callback->File_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_File_getSize);
+	callback->File_getContent = SERIALIZED_CALLBACK(skirmishAiCallback_File_getContent);
+	callback->getUnitDefs = SERIALIZED_CALLBACK(skirmishAiCallback_getUnitDefs);
+	callback->getUnitDefByName = SERIALIZED_CALLBACK(skirmishAiCallback_getUnitDefByName);
+	callback->UnitDef_getHeight = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getHeight);
+	callback->UnitDef_getRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getRadius);
+	callback->UnitDef_getName = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getName);
+	callback->UnitDef_getHumanName = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getHumanName);
+	callback->UnitDef_getUpkeep = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getUpkeep);
+	callback->UnitDef_getResourceMake = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getResourceMake);
+	callback->UnitDef_getMakesResource = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMakesResource);
+	callback->UnitDef_getCost = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCost);
+	callback->UnitDef_getExtractsResource = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getExtractsResource);
+	callback->UnitDef_getResourceExtractorRange = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getResourceExtractorRange);
+	callback->UnitDef_getWindResourceGenerator = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWindResourceGenerator);
+	callback->UnitDef_getTidalResourceGenerator = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTidalResourceGenerator);
+	callback->UnitDef_getStorage = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getStorage);
+	callback->UnitDef_getBuildTime = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getBuildTime);
+	callback->UnitDef_getAutoHeal = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getAutoHeal);
+	callback->UnitDef_getIdleAutoHeal = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getIdleAutoHeal);
+	callback->UnitDef_getIdleTime = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getIdleTime);
+	callback->UnitDef_getPower = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getPower);
+	callback->UnitDef_getHealth = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getHealth);
+	callback->UnitDef_getCategory = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCategory);
+	callback->UnitDef_getSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSpeed);
+	callback->UnitDef_getTurnRate = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTurnRate);
+	callback->UnitDef_isTurnInPlace = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isTurnInPlace);
+	callback->UnitDef_getTurnInPlaceDistance = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTurnInPlaceDistance);
+	callback->UnitDef_getTurnInPlaceSpeedLimit = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTurnInPlaceSpeedLimit);
+	callback->UnitDef_isUpright = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isUpright);
+	callback->UnitDef_isCollide = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isCollide);
+	callback->UnitDef_getLosRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getLosRadius);
+	callback->UnitDef_getAirLosRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getAirLosRadius);
+	callback->UnitDef_getLosHeight = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getLosHeight);
+	callback->UnitDef_getRadarRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getRadarRadius);
+	callback->UnitDef_getSonarRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSonarRadius);
+	callback->UnitDef_getJammerRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getJammerRadius);
+	callback->UnitDef_getSonarJamRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSonarJamRadius);
+	callback->UnitDef_getSeismicRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSeismicRadius);
+	callback->UnitDef_getSeismicSignature = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSeismicSignature);
+	callback->UnitDef_isStealth = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isStealth);
+	callback->UnitDef_isSonarStealth = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isSonarStealth);
+	callback->UnitDef_isBuildRange3D = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isBuildRange3D);
+	callback->UnitDef_getBuildDistance = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getBuildDistance);
+	callback->UnitDef_getBuildSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getBuildSpeed);
+	callback->UnitDef_getReclaimSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getReclaimSpeed);
+	callback->UnitDef_getRepairSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getRepairSpeed);
+	callback->UnitDef_getMaxRepairSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxRepairSpeed);
+	callback->UnitDef_getResurrectSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getResurrectSpeed);
+	callback->UnitDef_getCaptureSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCaptureSpeed);
+	callback->UnitDef_getTerraformSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTerraformSpeed);
+	callback->UnitDef_getMass = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMass);
+	callback->UnitDef_isPushResistant = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isPushResistant);
+	callback->UnitDef_isStrafeToAttack = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isStrafeToAttack);
+	callback->UnitDef_getMinCollisionSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMinCollisionSpeed);
+	callback->UnitDef_getSlideTolerance = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSlideTolerance);
+	callback->UnitDef_getMaxHeightDif = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxHeightDif);
+	callback->UnitDef_getMinWaterDepth = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMinWaterDepth);
+	callback->UnitDef_getWaterline = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWaterline);
+	callback->UnitDef_getMaxWaterDepth = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxWaterDepth);
+	callback->UnitDef_getArmoredMultiple = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getArmoredMultiple);
+	callback->UnitDef_getArmorType = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getArmorType);
+	callback->UnitDef_FlankingBonus_getMode = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_FlankingBonus_getMode);
+	callback->UnitDef_FlankingBonus_getDir = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_FlankingBonus_getDir);
+	callback->UnitDef_FlankingBonus_getMax = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_FlankingBonus_getMax);
+	callback->UnitDef_FlankingBonus_getMin = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_FlankingBonus_getMin);
+	callback->UnitDef_FlankingBonus_getMobilityAdd = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_FlankingBonus_getMobilityAdd);
+	callback->UnitDef_getMaxWeaponRange = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxWeaponRange);
+	callback->UnitDef_getTooltip = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTooltip);
+	callback->UnitDef_getWreckName = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWreckName);
+	callback->UnitDef_getDeathExplosion = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getDeathExplosion);
+	callback->UnitDef_getSelfDExplosion = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSelfDExplosion);
+	callback->UnitDef_getCategoryString = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCategoryString);
+	callback->UnitDef_isAbleToSelfD = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToSelfD);
+	callback->UnitDef_getSelfDCountdown = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSelfDCountdown);
+	callback->UnitDef_isAbleToSubmerge = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToSubmerge);
+	callback->UnitDef_isAbleToFly = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToFly);
+	callback->UnitDef_isAbleToMove = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToMove);
+	callback->UnitDef_isAbleToHover = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToHover);
+	callback->UnitDef_isFloater = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isFloater);
+	callback->UnitDef_isBuilder = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isBuilder);
+	callback->UnitDef_isActivateWhenBuilt = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isActivateWhenBuilt);
+	callback->UnitDef_isOnOffable = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isOnOffable);
+	callback->UnitDef_isFullHealthFactory = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isFullHealthFactory);
+	callback->UnitDef_isFactoryHeadingTakeoff = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isFactoryHeadingTakeoff);
+	callback->UnitDef_isReclaimable = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isReclaimable);
+	callback->UnitDef_isCapturable = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isCapturable);
+	callback->UnitDef_isAbleToRestore = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToRestore);
+	callback->UnitDef_isAbleToRepair = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToRepair);
+	callback->UnitDef_isAbleToSelfRepair = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToSelfRepair);
+	callback->UnitDef_isAbleToReclaim = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToReclaim);
+	callback->UnitDef_isAbleToAttack = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToAttack);
+	callback->UnitDef_isAbleToPatrol = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToPatrol);
+	callback->UnitDef_isAbleToFight = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToFight);
+	callback->UnitDef_isAbleToGuard = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToGuard);
+	callback->UnitDef_isAbleToAssist = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToAssist);
+	callback->UnitDef_isAssistable = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAssistable);
+	callback->UnitDef_isAbleToRepeat = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToRepeat);
+	callback->UnitDef_isAbleToFireControl = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToFireControl);
+	callback->UnitDef_getFireState = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFireState);
+	callback->UnitDef_getMoveState = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMoveState);
+	callback->UnitDef_getWingDrag = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWingDrag);
+	callback->UnitDef_getWingAngle = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWingAngle);
+	callback->UnitDef_getFrontToSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFrontToSpeed);
+	callback->UnitDef_getSpeedToFront = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getSpeedToFront);
+	callback->UnitDef_getMyGravity = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMyGravity);
+	callback->UnitDef_getMaxBank = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxBank);
+	callback->UnitDef_getMaxPitch = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxPitch);
+	callback->UnitDef_getTurnRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTurnRadius);
+	callback->UnitDef_getWantedHeight = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWantedHeight);
+	callback->UnitDef_getVerticalSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getVerticalSpeed);
+
+	callback->UnitDef_isHoverAttack = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isHoverAttack);
+	callback->UnitDef_isAirStrafe = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAirStrafe);
+
+	callback->UnitDef_getDlHoverFactor = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getDlHoverFactor);
+	callback->UnitDef_getMaxAcceleration = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxAcceleration);
+	callback->UnitDef_getMaxDeceleration = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxDeceleration);
+	callback->UnitDef_getMaxAileron = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxAileron);
+	callback->UnitDef_getMaxElevator = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxElevator);
+	callback->UnitDef_getMaxRudder = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxRudder);
+	callback->UnitDef_getYardMap = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getYardMap);
+	callback->UnitDef_getXSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getXSize);
+	callback->UnitDef_getZSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getZSize);
+	callback->UnitDef_getLoadingRadius = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getLoadingRadius);
+	callback->UnitDef_getUnloadSpread = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getUnloadSpread);
+	callback->UnitDef_getTransportCapacity = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTransportCapacity);
+	callback->UnitDef_getTransportSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTransportSize);
+	callback->UnitDef_getMinTransportSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMinTransportSize);
+	callback->UnitDef_isAirBase = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAirBase);
+	callback->UnitDef_isFirePlatform = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isFirePlatform);
+	callback->UnitDef_getTransportMass = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTransportMass);
+	callback->UnitDef_getMinTransportMass = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMinTransportMass);
+	callback->UnitDef_isHoldSteady = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isHoldSteady);
+	callback->UnitDef_isReleaseHeld = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isReleaseHeld);
+	callback->UnitDef_isNotTransportable = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isNotTransportable);
+	callback->UnitDef_isTransportByEnemy = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isTransportByEnemy);
+	callback->UnitDef_getTransportUnloadMethod = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getTransportUnloadMethod);
+	callback->UnitDef_getFallSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFallSpeed);
+	callback->UnitDef_getUnitFallSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getUnitFallSpeed);
+	callback->UnitDef_isAbleToCloak = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToCloak);
+	callback->UnitDef_isStartCloaked = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isStartCloaked);
+	callback->UnitDef_getCloakCost = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCloakCost);
+	callback->UnitDef_getCloakCostMoving = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCloakCostMoving);
+	callback->UnitDef_getDecloakDistance = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getDecloakDistance);
+	callback->UnitDef_isDecloakSpherical = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isDecloakSpherical);
+	callback->UnitDef_isDecloakOnFire = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isDecloakOnFire);
+	callback->UnitDef_isAbleToKamikaze = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToKamikaze);
+	callback->UnitDef_getKamikazeDist = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getKamikazeDist);
+	callback->UnitDef_isTargetingFacility = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isTargetingFacility);
+	callback->UnitDef_canManualFire = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_canManualFire);
+	callback->UnitDef_isNeedGeo = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isNeedGeo);
+	callback->UnitDef_isFeature = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isFeature);
+	callback->UnitDef_isHideDamage = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isHideDamage);
+	callback->UnitDef_isShowPlayerName = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isShowPlayerName);
+	callback->UnitDef_isAbleToResurrect = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToResurrect);
+	callback->UnitDef_isAbleToCapture = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToCapture);
+	callback->UnitDef_getHighTrajectoryType = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getHighTrajectoryType);
+	callback->UnitDef_getNoChaseCategory = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getNoChaseCategory);
+	callback->UnitDef_isAbleToDropFlare = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToDropFlare);
+	callback->UnitDef_getFlareReloadTime = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareReloadTime);
+	callback->UnitDef_getFlareEfficiency = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareEfficiency);
+	callback->UnitDef_getFlareDelay = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareDelay);
+	callback->UnitDef_getFlareDropVector = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareDropVector);
+	callback->UnitDef_getFlareTime = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareTime);
+	callback->UnitDef_getFlareSalvoSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareSalvoSize);
+	callback->UnitDef_getFlareSalvoDelay = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getFlareSalvoDelay);
+	callback->UnitDef_isAbleToLoopbackAttack = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isAbleToLoopbackAttack);
+	callback->UnitDef_isLevelGround = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isLevelGround);
+	callback->UnitDef_getMaxThisUnit = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getMaxThisUnit);
+	callback->UnitDef_getDecoyDef = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getDecoyDef);
+	callback->UnitDef_isDontLand = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isDontLand);
+	callback->UnitDef_getShieldDef = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getShieldDef);
+	callback->UnitDef_getStockpileDef = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getStockpileDef);
+	callback->UnitDef_getBuildOptions = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getBuildOptions);
+	callback->UnitDef_getCustomParams = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getCustomParams);
+	callback->UnitDef_isMoveDataAvailable = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_isMoveDataAvailable);
+	callback->UnitDef_MoveData_getXSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getXSize);
+	callback->UnitDef_MoveData_getZSize = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getZSize);
+	callback->UnitDef_MoveData_getDepth = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getDepth);
+	callback->UnitDef_MoveData_getMaxSlope = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getMaxSlope);
+	callback->UnitDef_MoveData_getSlopeMod = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getSlopeMod);
+	callback->UnitDef_MoveData_getDepthMod = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getDepthMod);
+	callback->UnitDef_MoveData_getPathType = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getPathType);
+	callback->UnitDef_MoveData_getCrushStrength = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getCrushStrength);
+	callback->UnitDef_MoveData_getSpeedModClass = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getSpeedModClass);
+	callback->UnitDef_MoveData_getTerrainClass = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getTerrainClass);
+	callback->UnitDef_MoveData_getFollowGround = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getFollowGround);
+	callback->UnitDef_MoveData_isSubMarine = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_isSubMarine);
+	callback->UnitDef_MoveData_getName = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_MoveData_getName);
+	callback->UnitDef_getWeaponMounts = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_getWeaponMounts);
+	callback->UnitDef_WeaponMount_getName = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getName);
+	callback->UnitDef_WeaponMount_getWeaponDef = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getWeaponDef);
+	callback->UnitDef_WeaponMount_getSlavedTo = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getSlavedTo);
+	callback->UnitDef_WeaponMount_getMainDir = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getMainDir);
+	callback->UnitDef_WeaponMount_getMaxAngleDif = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getMaxAngleDif);
+	callback->UnitDef_WeaponMount_getBadTargetCategory = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getBadTargetCategory);
+	callback->UnitDef_WeaponMount_getOnlyTargetCategory = SERIALIZED_CALLBACK(skirmishAiCallback_UnitDef_WeaponMount_getOnlyTargetCategory);
+	callback->Unit_getLimit = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getLimit);
+	callback->Unit_getMax = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getMax);
+	callback->getEnemyUnits = SERIALIZED_CALLBACK(skirmishAiCallback_getEnemyUnits);
+	callback->getEnemyUnitsIn = SERIALIZED_CALLBACK(skirmishAiCallback_getEnemyUnitsIn);
+	callback->getEnemyUnitsInRadarAndLos = SERIALIZED_CALLBACK(skirmishAiCallback_getEnemyUnitsInRadarAndLos);
+	callback->getFriendlyUnits = SERIALIZED_CALLBACK(skirmishAiCallback_getFriendlyUnits);
+	callback->getFriendlyUnitsIn = SERIALIZED_CALLBACK(skirmishAiCallback_getFriendlyUnitsIn);
+	callback->getNeutralUnits = SERIALIZED_CALLBACK(skirmishAiCallback_getNeutralUnits);
+	callback->getNeutralUnitsIn = SERIALIZED_CALLBACK(skirmishAiCallback_getNeutralUnitsIn);
+	callback->getTeamUnits = SERIALIZED_CALLBACK(skirmishAiCallback_getTeamUnits);
+	callback->getSelectedUnits = SERIALIZED_CALLBACK(skirmishAiCallback_getSelectedUnits);
+	callback->Unit_getDef = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getDef);
+	callback->Unit_getRulesParamFloat = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getRulesParamFloat);
+	callback->Unit_getRulesParamString = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getRulesParamString);
+	callback->Unit_getTeam = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getTeam);
+	callback->Unit_getAllyTeam = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getAllyTeam);
+	callback->Unit_getStockpile = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getStockpile);
+	callback->Unit_getStockpileQueued = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getStockpileQueued);
+	callback->Unit_getMaxSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getMaxSpeed);
+	callback->Unit_getMaxRange = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getMaxRange);
+	callback->Unit_getMaxHealth = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getMaxHealth);
+	callback->Unit_getExperience = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getExperience);
+	callback->Unit_getGroup = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getGroup);
+	callback->Unit_getCurrentCommands = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getCurrentCommands);
+	callback->Unit_CurrentCommand_getType = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_CurrentCommand_getType);
+	callback->Unit_CurrentCommand_getId = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_CurrentCommand_getId);
+	callback->Unit_CurrentCommand_getOptions = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_CurrentCommand_getOptions);
+	callback->Unit_CurrentCommand_getTag = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_CurrentCommand_getTag);
+	callback->Unit_CurrentCommand_getTimeOut = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_CurrentCommand_getTimeOut);
+	callback->Unit_CurrentCommand_getParams = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_CurrentCommand_getParams);
+	callback->Unit_getSupportedCommands = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getSupportedCommands);
+	callback->Unit_SupportedCommand_getId = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_SupportedCommand_getId);
+	callback->Unit_SupportedCommand_getName = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_SupportedCommand_getName);
+	callback->Unit_SupportedCommand_getToolTip = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_SupportedCommand_getToolTip);
+	callback->Unit_SupportedCommand_isShowUnique = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_SupportedCommand_isShowUnique);
+	callback->Unit_SupportedCommand_isDisabled = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_SupportedCommand_isDisabled);
+	callback->Unit_SupportedCommand_getParams = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_SupportedCommand_getParams);
+	callback->Unit_getHealth = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getHealth);
+	callback->Unit_getParalyzeDamage = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getParalyzeDamage);
+	callback->Unit_getCaptureProgress = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getCaptureProgress);
+	callback->Unit_getBuildProgress = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getBuildProgress);
+	callback->Unit_getSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getSpeed);
+	callback->Unit_getPower = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getPower);
+	callback->Unit_getResourceUse = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getResourceUse);
+	callback->Unit_getResourceMake = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getResourceMake);
+	callback->Unit_getPos = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getPos);
+	callback->Unit_getVel = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getVel);
+	callback->Unit_isActivated = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_isActivated);
+	callback->Unit_isBeingBuilt = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_isBeingBuilt);
+	callback->Unit_isCloaked = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_isCloaked);
+	callback->Unit_isParalyzed = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_isParalyzed);
+	callback->Unit_isNeutral = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_isNeutral);
+	callback->Unit_getBuildingFacing = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getBuildingFacing);
+	callback->Unit_getLastUserOrderFrame = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getLastUserOrderFrame);
+	callback->Unit_getWeapons = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getWeapons);
+	callback->Unit_getWeapon = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_getWeapon);
+	callback->Team_hasAIController = SERIALIZED_CALLBACK(skirmishAiCallback_Team_hasAIController);
+	callback->getEnemyTeams = SERIALIZED_CALLBACK(skirmishAiCallback_getEnemyTeams);
+	callback->getAllyTeams = SERIALIZED_CALLBACK(skirmishAiCallback_getAllyTeams);
+	callback->Team_getRulesParamFloat = SERIALIZED_CALLBACK(skirmishAiCallback_Team_getRulesParamFloat);
+	callback->Team_getRulesParamString = SERIALIZED_CALLBACK(skirmishAiCallback_Team_getRulesParamString);
+	callback->getGroups = SERIALIZED_CALLBACK(skirmishAiCallback_getGroups);
+	callback->Group_getSupportedCommands = SERIALIZED_CALLBACK(skirmishAiCallback_Group_getSupportedCommands);
+	callback->Group_SupportedCommand_getId = SERIALIZED_CALLBACK(skirmishAiCallback_Group_SupportedCommand_getId);
+	callback->Group_SupportedCommand_getName = SERIALIZED_CALLBACK(skirmishAiCallback_Group_SupportedCommand_getName);
+	callback->Group_SupportedCommand_getToolTip = SERIALIZED_CALLBACK(skirmishAiCallback_Group_SupportedCommand_getToolTip);
+	callback->Group_SupportedCommand_isShowUnique = SERIALIZED_CALLBACK(skirmishAiCallback_Group_SupportedCommand_isShowUnique);
+	callback->Group_SupportedCommand_isDisabled = SERIALIZED_CALLBACK(skirmishAiCallback_Group_SupportedCommand_isDisabled);
+	callback->Group_SupportedCommand_getParams = SERIALIZED_CALLBACK(skirmishAiCallback_Group_SupportedCommand_getParams);
+	callback->Group_OrderPreview_getId = SERIALIZED_CALLBACK(skirmishAiCallback_Group_OrderPreview_getId);
+	callback->Group_OrderPreview_getOptions = SERIALIZED_CALLBACK(skirmishAiCallback_Group_OrderPreview_getOptions);
+	callback->Group_OrderPreview_getTag = SERIALIZED_CALLBACK(skirmishAiCallback_Group_OrderPreview_getTag);
+	callback->Group_OrderPreview_getTimeOut = SERIALIZED_CALLBACK(skirmishAiCallback_Group_OrderPreview_getTimeOut);
+	callback->Group_OrderPreview_getParams = SERIALIZED_CALLBACK(skirmishAiCallback_Group_OrderPreview_getParams);
+	callback->Group_isSelected = SERIALIZED_CALLBACK(skirmishAiCallback_Group_isSelected);
+	callback->Mod_getFileName = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getFileName);
+	callback->Mod_getHash = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getHash);
+	callback->Mod_getHumanName = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getHumanName);
+	callback->Mod_getShortName = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getShortName);
+	callback->Mod_getVersion = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getVersion);
+	callback->Mod_getMutator = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getMutator);
+	callback->Mod_getDescription = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getDescription);
+	callback->Mod_getConstructionDecay = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getConstructionDecay);
+	callback->Mod_getConstructionDecayTime = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getConstructionDecayTime);
+	callback->Mod_getConstructionDecaySpeed = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getConstructionDecaySpeed);
+	callback->Mod_getMultiReclaim = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getMultiReclaim);
+	callback->Mod_getReclaimMethod = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimMethod);
+	callback->Mod_getReclaimUnitMethod = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimUnitMethod);
+	callback->Mod_getReclaimUnitEnergyCostFactor = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimUnitEnergyCostFactor);
+	callback->Mod_getReclaimUnitEfficiency = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimUnitEfficiency);
+	callback->Mod_getReclaimFeatureEnergyCostFactor = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimFeatureEnergyCostFactor);
+	callback->Mod_getReclaimAllowEnemies = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimAllowEnemies);
+	callback->Mod_getReclaimAllowAllies = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getReclaimAllowAllies);
+	callback->Mod_getRepairEnergyCostFactor = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getRepairEnergyCostFactor);
+	callback->Mod_getResurrectEnergyCostFactor = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getResurrectEnergyCostFactor);
+	callback->Mod_getCaptureEnergyCostFactor = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getCaptureEnergyCostFactor);
+	callback->Mod_getTransportGround = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getTransportGround);
+	callback->Mod_getTransportHover = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getTransportHover);
+	callback->Mod_getTransportShip = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getTransportShip);
+	callback->Mod_getTransportAir = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getTransportAir);
+	callback->Mod_getFireAtKilled = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getFireAtKilled);
+	callback->Mod_getFireAtCrashing = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getFireAtCrashing);
+	callback->Mod_getFlankingBonusModeDefault = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getFlankingBonusModeDefault);
+	callback->Mod_getLosMipLevel = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getLosMipLevel);
+	callback->Mod_getAirMipLevel = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getAirMipLevel);
+	callback->Mod_getRadarMipLevel = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getRadarMipLevel);
+	callback->Mod_getRequireSonarUnderWater = SERIALIZED_CALLBACK(skirmishAiCallback_Mod_getRequireSonarUnderWater);
+	callback->Map_getChecksum = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getChecksum);
+	callback->Map_getStartPos = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getStartPos);
+	callback->Map_getMousePos = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getMousePos);
+	callback->Map_isPosInCamera = SERIALIZED_CALLBACK(skirmishAiCallback_Map_isPosInCamera);
+	callback->Map_getWidth = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getWidth);
+	callback->Map_getHeight = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getHeight);
+	callback->Map_getHeightMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getHeightMap);
+	callback->Map_getCornersHeightMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getCornersHeightMap);
+	callback->Map_getMinHeight = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getMinHeight);
+	callback->Map_getMaxHeight = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getMaxHeight);
+	callback->Map_getSlopeMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getSlopeMap);
+	callback->Map_getLosMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getLosMap);
+	callback->Map_getAirLosMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getAirLosMap);
+	callback->Map_getRadarMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getRadarMap);
+	callback->Map_getSonarMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getSonarMap);
+	callback->Map_getSeismicMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getSeismicMap);
+	callback->Map_getJammerMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getJammerMap);
+	callback->Map_getSonarJammerMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getSonarJammerMap);
+	callback->Map_getResourceMapRaw = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getResourceMapRaw);
+	callback->Map_getResourceMapSpotsPositions = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getResourceMapSpotsPositions);
+	callback->Map_getResourceMapSpotsAverageIncome = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getResourceMapSpotsAverageIncome);
+	callback->Map_getResourceMapSpotsNearest = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getResourceMapSpotsNearest);
+	callback->Map_getHash = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getHash);
+	callback->Map_getName = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getName);
+	callback->Map_getHumanName = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getHumanName);
+	callback->Map_getElevationAt = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getElevationAt);
+	callback->Map_getMaxResource = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getMaxResource);
+	callback->Map_getExtractorRadius = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getExtractorRadius);
+	callback->Map_getMinWind = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getMinWind);
+	callback->Map_getMaxWind = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getMaxWind);
+	callback->Map_getCurWind = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getCurWind);
+	callback->Map_getTidalStrength = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getTidalStrength);
+	callback->Map_getGravity = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getGravity);
+	callback->Map_getWaterDamage = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getWaterDamage);
+	callback->Map_isDeformable = SERIALIZED_CALLBACK(skirmishAiCallback_Map_isDeformable);
+	callback->Map_getHardness = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getHardness);
+	callback->Map_getHardnessModMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getHardnessModMap);
+	callback->Map_getSpeedModMap = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getSpeedModMap);
+	callback->Map_getPoints = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getPoints);
+	callback->Map_Point_getPosition = SERIALIZED_CALLBACK(skirmishAiCallback_Map_Point_getPosition);
+	callback->Map_Point_getColor = SERIALIZED_CALLBACK(skirmishAiCallback_Map_Point_getColor);
+	callback->Map_Point_getLabel = SERIALIZED_CALLBACK(skirmishAiCallback_Map_Point_getLabel);
+	callback->Map_getLines = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getLines);
+	callback->Map_Line_getFirstPosition = SERIALIZED_CALLBACK(skirmishAiCallback_Map_Line_getFirstPosition);
+	callback->Map_Line_getSecondPosition = SERIALIZED_CALLBACK(skirmishAiCallback_Map_Line_getSecondPosition);
+	callback->Map_Line_getColor = SERIALIZED_CALLBACK(skirmishAiCallback_Map_Line_getColor);
+	callback->Map_isPossibleToBuildAt = SERIALIZED_CALLBACK(skirmishAiCallback_Map_isPossibleToBuildAt);
+	callback->Map_findClosestBuildSite = SERIALIZED_CALLBACK(skirmishAiCallback_Map_findClosestBuildSite);
+	callback->getFeatureDefs = SERIALIZED_CALLBACK(skirmishAiCallback_getFeatureDefs);
+	callback->FeatureDef_getName = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getName);
+	callback->FeatureDef_getDescription = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getDescription);
+	callback->FeatureDef_getContainedResource = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getContainedResource);
+	callback->FeatureDef_getMaxHealth = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getMaxHealth);
+	callback->FeatureDef_getReclaimTime = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getReclaimTime);
+	callback->FeatureDef_getMass = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getMass);
+	callback->FeatureDef_isUpright = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isUpright);
+	callback->FeatureDef_getDrawType = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getDrawType);
+	callback->FeatureDef_getModelName = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getModelName);
+	callback->FeatureDef_getResurrectable = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getResurrectable);
+	callback->FeatureDef_getSmokeTime = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getSmokeTime);
+	callback->FeatureDef_isDestructable = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isDestructable);
+	callback->FeatureDef_isReclaimable = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isReclaimable);
+	callback->FeatureDef_isBlocking = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isBlocking);
+	callback->FeatureDef_isBurnable = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isBurnable);
+	callback->FeatureDef_isFloating = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isFloating);
+	callback->FeatureDef_isNoSelect = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isNoSelect);
+	callback->FeatureDef_isGeoThermal = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_isGeoThermal);
+	callback->FeatureDef_getXSize = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getXSize);
+	callback->FeatureDef_getZSize = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getZSize);
+	callback->FeatureDef_getCustomParams = SERIALIZED_CALLBACK(skirmishAiCallback_FeatureDef_getCustomParams);
+	callback->getFeatures = SERIALIZED_CALLBACK(skirmishAiCallback_getFeatures);
+	callback->getFeaturesIn = SERIALIZED_CALLBACK(skirmishAiCallback_getFeaturesIn);
+	callback->Feature_getDef = SERIALIZED_CALLBACK(skirmishAiCallback_Feature_getDef);
+	callback->Feature_getHealth = SERIALIZED_CALLBACK(skirmishAiCallback_Feature_getHealth);
+	callback->Feature_getReclaimLeft = SERIALIZED_CALLBACK(skirmishAiCallback_Feature_getReclaimLeft);
+	callback->Feature_getPosition = SERIALIZED_CALLBACK(skirmishAiCallback_Feature_getPosition);
+	callback->Feature_getRulesParamFloat = SERIALIZED_CALLBACK(skirmishAiCallback_Feature_getRulesParamFloat);
+	callback->Feature_getRulesParamString = SERIALIZED_CALLBACK(skirmishAiCallback_Feature_getRulesParamString);
+	callback->getWeaponDefs = SERIALIZED_CALLBACK(skirmishAiCallback_getWeaponDefs);
+	callback->getWeaponDefByName = SERIALIZED_CALLBACK(skirmishAiCallback_getWeaponDefByName);
+	callback->WeaponDef_getName = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getName);
+	callback->WeaponDef_getType = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getType);
+	callback->WeaponDef_getDescription = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getDescription);
+	callback->WeaponDef_getRange = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getRange);
+	callback->WeaponDef_getHeightMod = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getHeightMod);
+	callback->WeaponDef_getAccuracy = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getAccuracy);
+	callback->WeaponDef_getSprayAngle = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getSprayAngle);
+	callback->WeaponDef_getMovingAccuracy = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getMovingAccuracy);
+	callback->WeaponDef_getTargetMoveError = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getTargetMoveError);
+	callback->WeaponDef_getLeadLimit = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getLeadLimit);
+	callback->WeaponDef_getLeadBonus = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getLeadBonus);
+	callback->WeaponDef_getPredictBoost = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getPredictBoost);
+	callback->WeaponDef_getNumDamageTypes = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getNumDamageTypes);
+	callback->WeaponDef_Damage_getParalyzeDamageTime = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Damage_getParalyzeDamageTime);
+	callback->WeaponDef_Damage_getImpulseFactor = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Damage_getImpulseFactor);
+	callback->WeaponDef_Damage_getImpulseBoost = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Damage_getImpulseBoost);
+	callback->WeaponDef_Damage_getCraterMult = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Damage_getCraterMult);
+	callback->WeaponDef_Damage_getCraterBoost = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Damage_getCraterBoost);
+	callback->WeaponDef_Damage_getTypes = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Damage_getTypes);
+	callback->WeaponDef_getAreaOfEffect = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getAreaOfEffect);
+	callback->WeaponDef_isNoSelfDamage = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isNoSelfDamage);
+	callback->WeaponDef_getFireStarter = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getFireStarter);
+	callback->WeaponDef_getEdgeEffectiveness = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getEdgeEffectiveness);
+	callback->WeaponDef_getSize = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getSize);
+	callback->WeaponDef_getSizeGrowth = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getSizeGrowth);
+	callback->WeaponDef_getCollisionSize = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCollisionSize);
+	callback->WeaponDef_getSalvoSize = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getSalvoSize);
+	callback->WeaponDef_getSalvoDelay = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getSalvoDelay);
+	callback->WeaponDef_getReload = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getReload);
+	callback->WeaponDef_getBeamTime = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getBeamTime);
+	callback->WeaponDef_isBeamBurst = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isBeamBurst);
+	callback->WeaponDef_isWaterBounce = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isWaterBounce);
+	callback->WeaponDef_isGroundBounce = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isGroundBounce);
+	callback->WeaponDef_getBounceRebound = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getBounceRebound);
+	callback->WeaponDef_getBounceSlip = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getBounceSlip);
+	callback->WeaponDef_getNumBounce = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getNumBounce);
+	callback->WeaponDef_getMaxAngle = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getMaxAngle);
+	callback->WeaponDef_getUpTime = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getUpTime);
+	callback->WeaponDef_getFlightTime = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getFlightTime);
+	callback->WeaponDef_getCost = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCost);
+	callback->WeaponDef_getProjectilesPerShot = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getProjectilesPerShot);
+	callback->WeaponDef_isTurret = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isTurret);
+	callback->WeaponDef_isOnlyForward = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isOnlyForward);
+	callback->WeaponDef_isFixedLauncher = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isFixedLauncher);
+	callback->WeaponDef_isWaterWeapon = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isWaterWeapon);
+	callback->WeaponDef_isFireSubmersed = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isFireSubmersed);
+	callback->WeaponDef_isSubMissile = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isSubMissile);
+	callback->WeaponDef_isTracks = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isTracks);
+	callback->WeaponDef_isDropped = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isDropped);
+	callback->WeaponDef_isParalyzer = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isParalyzer);
+	callback->WeaponDef_isImpactOnly = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isImpactOnly);
+	callback->WeaponDef_isNoAutoTarget = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isNoAutoTarget);
+	callback->WeaponDef_isManualFire = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isManualFire);
+	callback->WeaponDef_getInterceptor = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getInterceptor);
+	callback->WeaponDef_getTargetable = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getTargetable);
+	callback->WeaponDef_isStockpileable = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isStockpileable);
+	callback->WeaponDef_getCoverageRange = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCoverageRange);
+	callback->WeaponDef_getStockpileTime = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getStockpileTime);
+	callback->WeaponDef_getIntensity = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getIntensity);
+	callback->WeaponDef_getDuration = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getDuration);
+	callback->WeaponDef_getFalloffRate = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getFalloffRate);
+	callback->WeaponDef_isSelfExplode = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isSelfExplode);
+	callback->WeaponDef_isGravityAffected = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isGravityAffected);
+	callback->WeaponDef_getHighTrajectory = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getHighTrajectory);
+	callback->WeaponDef_getMyGravity = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getMyGravity);
+	callback->WeaponDef_isNoExplode = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isNoExplode);
+	callback->WeaponDef_getStartVelocity = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getStartVelocity);
+	callback->WeaponDef_getWeaponAcceleration = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getWeaponAcceleration);
+	callback->WeaponDef_getTurnRate = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getTurnRate);
+	callback->WeaponDef_getMaxVelocity = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getMaxVelocity);
+	callback->WeaponDef_getProjectileSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getProjectileSpeed);
+	callback->WeaponDef_getExplosionSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getExplosionSpeed);
+	callback->WeaponDef_getOnlyTargetCategory = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getOnlyTargetCategory);
+	callback->WeaponDef_getWobble = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getWobble);
+	callback->WeaponDef_getDance = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getDance);
+	callback->WeaponDef_getTrajectoryHeight = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getTrajectoryHeight);
+	callback->WeaponDef_isLargeBeamLaser = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isLargeBeamLaser);
+	callback->WeaponDef_isShield = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isShield);
+	callback->WeaponDef_isShieldRepulser = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isShieldRepulser);
+	callback->WeaponDef_isSmartShield = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isSmartShield);
+	callback->WeaponDef_isExteriorShield = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isExteriorShield);
+	callback->WeaponDef_isVisibleShield = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isVisibleShield);
+	callback->WeaponDef_isVisibleShieldRepulse = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isVisibleShieldRepulse);
+	callback->WeaponDef_getVisibleShieldHitFrames = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getVisibleShieldHitFrames);
+	callback->WeaponDef_Shield_getResourceUse = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getResourceUse);
+	callback->WeaponDef_Shield_getRadius = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getRadius);
+	callback->WeaponDef_Shield_getForce = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getForce);
+	callback->WeaponDef_Shield_getMaxSpeed = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getMaxSpeed);
+	callback->WeaponDef_Shield_getPower = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getPower);
+	callback->WeaponDef_Shield_getPowerRegen = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getPowerRegen);
+	callback->WeaponDef_Shield_getPowerRegenResource = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getPowerRegenResource);
+	callback->WeaponDef_Shield_getStartingPower = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getStartingPower);
+	callback->WeaponDef_Shield_getRechargeDelay = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getRechargeDelay);
+	callback->WeaponDef_Shield_getInterceptType = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_Shield_getInterceptType);
+	callback->WeaponDef_getInterceptedByShieldType = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getInterceptedByShieldType);
+	callback->WeaponDef_isAvoidFriendly = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isAvoidFriendly);
+	callback->WeaponDef_isAvoidFeature = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isAvoidFeature);
+	callback->WeaponDef_isAvoidNeutral = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isAvoidNeutral);
+	callback->WeaponDef_getTargetBorder = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getTargetBorder);
+	callback->WeaponDef_getCylinderTargetting = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCylinderTargetting);
+	callback->WeaponDef_getMinIntensity = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getMinIntensity);
+	callback->WeaponDef_getHeightBoostFactor = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getHeightBoostFactor);
+	callback->WeaponDef_getProximityPriority = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getProximityPriority);
+	callback->WeaponDef_getCollisionFlags = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCollisionFlags);
+	callback->WeaponDef_isSweepFire = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isSweepFire);
+	callback->WeaponDef_isAbleToAttackGround = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isAbleToAttackGround);
+	callback->WeaponDef_getCameraShake = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCameraShake);
+	callback->WeaponDef_getDynDamageExp = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getDynDamageExp);
+	callback->WeaponDef_getDynDamageMin = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getDynDamageMin);
+	callback->WeaponDef_getDynDamageRange = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getDynDamageRange);
+	callback->WeaponDef_isDynDamageInverted = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_isDynDamageInverted);
+	callback->WeaponDef_getCustomParams = SERIALIZED_CALLBACK(skirmishAiCallback_WeaponDef_getCustomParams);
+	callback->Unit_Weapon_getDef = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_Weapon_getDef);
+	callback->Unit_Weapon_getReloadFrame = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_Weapon_getReloadFrame);
+	callback->Unit_Weapon_getReloadTime = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_Weapon_getReloadTime);
+	callback->Unit_Weapon_getRange = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_Weapon_getRange);
+	callback->Unit_Weapon_isShieldEnabled = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_Weapon_isShieldEnabled);
+	callback->Unit_Weapon_getShieldPower = SERIALIZED_CALLBACK(skirmishAiCallback_Unit_Weapon_getShieldPower);
+	callback->Debug_GraphDrawer_isEnabled = SERIALIZED_CALLBACK(skirmishAiCallback_Debug_GraphDrawer_isEnabled);
+	callback->Map_getResourceMapSpotsNearestBatch = SERIALIZED_CALLBACK(skirmishAiCallback_Map_getResourceMapSpotsNearestBatch);
+	callback->getUnitStates = SERIALIZED_CALLBACK(skirmishAiCallback_getUnitStates);
+	callback->getUnitStatesIn = SERIALIZED_CALLBACK(skirmishAiCallback_getUnitStatesIn);
 }
 
 SSkirmishAICallback* skirmishAiCallback_GetInstance(CSkirmishAIWrapper* ai)
@@ -5646,3 +5800,17 @@ void skirmishAiCallback_BlockOrders(const CSkirmishAIWrapper* ai)
 	GetCallBack(ai->GetSkirmishAIID())->AllowOrders(false);
 }
 
+void skirmishAiCallback_SetConcurrent(bool enable)
+{
+	AI_CONCURRENT_CALLBACKS = enable;
+
+	for (auto& callbacks: AI_LEGACY_CALLBACKS) {
+		callbacks.first.DeferNetMessages(enable);
+	}
+}
+
+bool skirmishAiCallback_AllowConcurrent(const CSkirmishAIWrapper* ai)
+{
+	return (!skirmishAiCallback_Cheats_isEnabled(ai->GetSkirmishAIID()));
+}
+
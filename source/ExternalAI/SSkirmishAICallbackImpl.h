@@ -660,6 +660,10 @@ EXPORT(int              ) skirmishAiCallback_getTeamUnits(int skirmishAIId, int*
 
 EXPORT(int              ) skirmishAiCallback_getSelectedUnits(int skirmishAIId, int* unitIds, int unitIds_sizeMax);
 
+EXPORT(int              ) skirmishAiCallback_getUnitStates(int skirmishAIId, int* unitIds, int unitIds_size, float* positions_AposF3, float* velocities_AposF3, float* healths, int* unitDefIds, int* teamIds);
+
+EXPORT(int              ) skirmishAiCallback_getUnitStatesIn(int skirmishAIId, int allegiances, float* pos_posF3, float radius, int* unitIds, float* positions_AposF3, float* velocities_AposF3, float* healths, int* unitDefIds, int* teamIds, int unitIds_sizeMax);
+
 EXPORT(int              ) skirmishAiCallback_Unit_getDef(int skirmishAIId, int unitId);
 
 EXPORT(float            ) skirmishAiCallback_Unit_getRulesParamFloat(int skirmishAIId, int unitId, const char* rulesParamName, float defaultValue);
@@ -916,6 +920,8 @@ EXPORT(int              ) skirmishAiCallback_Map_getResourceMapSpotsPositions(in
 
 EXPORT(float            ) skirmishAiCallback_Map_initResourceMapSpotsNearest(int skirmishAIId, int resourceId, float* pos_posF3, float* return_posF3_out);
 
+EXPORT(int              ) skirmishAiCallback_Map_getResourceMapSpotsNearestBatch(int skirmishAIId, int resourceId, int extractorUnitDefId, float* positions_AposF3, int positions_AposF3_size, float* spots_AposF3_out);
+
 EXPORT(int              ) skirmishAiCallback_Map_getHash(int skirmishAIId);
 
 EXPORT(const char*      ) skirmishAiCallback_Map_getName(int skirmishAIId);
@@ -1331,6 +1337,16 @@ void skirmishAiCallback_Release(const CSkirmishAIWrapper* ai);
 
 void skirmishAiCallback_BlockOrders(const CSkirmishAIWrapper* ai);
 
+/**
+ * While enabled, calls into the engine are serialized across all AI's and
+ * their network messages (orders, shares, ...) are held back; disabling it
+ * sends those in AI ID order. Lets AI's handle events concurrently.
+ */
+void skirmishAiCallback_SetConcurrent(bool enable);
+
+/// cheating AI's change sim-state from within callbacks, so can not run concurrently
+bool skirmishAiCallback_AllowConcurrent(const CSkirmishAIWrapper* ai);
+
 #endif // defined __cplusplus && !defined BUILDING_AI
 
 
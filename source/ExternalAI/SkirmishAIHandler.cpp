@@ -10,6 +10,7 @@
 #include "Game/GameSetup.h"
 #include "Game/GlobalUnsynced.h"
 #include "Net/Protocol/NetProtocol.h"
+#include "System/MainDefines.h"
 #include "System/Option.h"
 
 #include "System/creg/STL_Map.h"
@@ -29,7 +30,6 @@ CR_REG_METADATA(CSkirmishAIHandler, (
 	CR_MEMBER(skirmishAIDataMap),
 	CR_MEMBER(luaAIShortNames),
 
-	CR_IGNORED(currentAIId),
 	CR_IGNORED(numSkirmishAIs),
 
 	CR_MEMBER(gameInitialized)
@@ -38,6 +38,9 @@ CR_REG_METADATA(CSkirmishAIHandler, (
 
 CSkirmishAIHandler skirmishAIHandler;
 
+// per-thread since AI's can run their Update event concurrently
+static _threadlocal uint8_t currentAIId = MAX_AIS;
+
 
 void CSkirmishAIHandler::ResetState()
 {
@@ -50,7 +53,6 @@ void CSkirmishAIHandler::ResetState()
 	luaAIShortNames.clear();
 
 	numSkirmishAIs = 0;
-	currentAIId = MAX_AIS;
 
 	gameInitialized = false;
 }
@@ -266,6 +268,10 @@ bool CSkirmishAIHandler::IsLocalSkirmishAI(const SkirmishAIData& aiData) {
 }
 
 
+uint8_t CSkirmishAIHandler::GetCurrentAIID() const { return currentAIId; }
+void CSkirmishAIHandler::SetCurrentAIID(uint8_t id) { currentAIId = id; }
+
+
 void CSkirmishAIHandler::CompleteWithDefaultOptionValues(const size_t skirmishAIId)
 {
 	if (!gameInitialized)
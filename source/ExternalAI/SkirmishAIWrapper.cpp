@@ -22,9 +22,11 @@
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
 #include "System/Platform/SharedLib.h"
+#include "System/Platform/Threading.h"
 #include "System/TimeProfiler.h"
 #include "System/StringUtil.h"
 
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -44,6 +46,10 @@ CR_REG_METADATA(CSkirmishAIWrapper, (
 	CR_MEMBER(skirmishAIId),
 	CR_MEMBER(teamId),
 
+	CR_IGNORED(numUpdates),
+	CR_IGNORED(eventDepth),
+	CR_IGNORED(eventTime),
+
 	// handled in PostLoad
 	CR_IGNORED(initialized),
 	CR_IGNORED(released),
@@ -74,6 +80,10 @@ void CSkirmishAIWrapper::PreInit(int aiID)
 
 		cheatEvents = false;
 		blockEvents = false;
+
+		numUpdates = 0;
+		eventDepth = 0;
+		eventTime = spring_notime;
 	}
 	{
 		const std::string& kn = key.GetShortName();
@@ -192,6 +202,8 @@ void CSkirmishAIWrapper::Kill()
 	// send release event
 	Release(skirmishAIHandler.GetLocalKillFlag(skirmishAIId));
 
+	LOG_L(L_INFO, "[AIWrapper::%s] AI %d on team %d spent %.2fs handling events (%.3fms per frame over %d frames)", __func__, skirmishAIId, teamId, eventTime.toSecsf(), eventTime.toMilliSecsf() / std::max(numUpdates, 1), numUpdates);
+
 	{
 		ScopedTimer timer(GetTimerNameHash());
 
@@ -401,6 +413,8 @@ void CSkirmishAIWrapper::EnemyDamaged(
 void CSkirmishAIWrapper::Update(int frame) {
 	const SUpdateEvent evtData = {frame};
 	HandleEvent(EVENT_UPDATE, &evtData);
+
+	numUpdates += 1;
 }
 
 void CSkirmishAIWrapper::SendChatMessage(const char* msg, int fromPlayerId) {
@@ -449,13 +463,26 @@ void CSkirmishAIWrapper::SeismicPing(
 }
 
 
-int CSkirmishAIWrapper::HandleEvent(int topic, const void* data) const {
-	ScopedTimer timer(GetTimerNameHash());
+int CSkirmishAIWrapper::HandleEvent(int topic, const void* data) {
+	// to prevent log error spam, signal: OK
+	if (blockEvents && (topic != EVENT_RELEASE))
+		return 0;
+
+	const spring_time startTime = spring_gettime();
 
-	if (!blockEvents || (topic == EVENT_RELEASE))
-		return library->HandleEvent(skirmishAIId, topic, data);
+	eventDepth += 1;
+	const int ret = library->HandleEvent(skirmishAIId, topic, data);
+	eventDepth -= 1;
 
-	// to prevent log error spam, signal: OK
-	return 0;
+	// events can nest (e.g. through cheats), only count the outermost
+	if (eventDepth == 0) {
+		const spring_time deltaTime = spring_gettime() - startTime;
+
+		// not a ScopedTimer, Update might be handled on a worker thread
+		profiler.AddTime(GetTimerNameHash(), startTime, deltaTime, false, false, !Threading::IsMainThread());
+		eventTime += deltaTime;
+	}
+
+	return ret;
 }
 
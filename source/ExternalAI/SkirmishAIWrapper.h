@@ -5,6 +5,7 @@
 
 #include "SkirmishAIKey.h"
 #include "System/Object.h"
+#include "System/Misc/SpringTime.h"
 
 class CSkirmishAILibrary;
 struct SSkirmishAICallback;
@@ -103,13 +104,16 @@ public:
 
 	bool Active() const { return (skirmishAIId != -1); }
 
+	/// time spent by the AI handling events (on whichever thread), since Init
+	spring_time GetEventTime() const { return eventTime; }
+
 private:
 	bool InitLibrary(bool postLoad);
 
 	/**
 	 * CAUTION: takes C AI Interface events, not engine C++ ones!
 	 */
-	int HandleEvent(int topic, const void* data) const;
+	int HandleEvent(int topic, const void* data);
 
 	uint32_t GetTimerNameHash() const { return *reinterpret_cast<const uint32_t*>(&timerName[0]); }
 
@@ -129,6 +133,11 @@ private:
 	int skirmishAIId = -1;
 	int teamId = -1;
 
+	int numUpdates = 0;
+	int eventDepth = 0;
+
+	spring_time eventTime;
+
 	bool initialized = false; // true after handling Init event
 	bool    released = false; // true after handling Release event
 	bool libraryInit = false; // CSkirmishAILibrary::Init retval
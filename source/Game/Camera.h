@@ -130,6 +130,7 @@ public:
 
 	void ClipFrustumLines(const float zmin, const float zmax, bool neg);
 	void SetFrustumScales(const float4 scales) { frustum.scales = scales; }
+	const float4& GetFrustumScales() const { return frustum.scales; }
 
 	const FrustumLine* GetPosFrustumLines() const { return &frustumLines[FRUSTUM_SIDE_POS][0]; }
 	const FrustumLine* GetNegFrustumLines() const { return &frustumLines[FRUSTUM_SIDE_NEG][0]; }
@@ -0,0 +1,122 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "DefsCache.h"
+#include "GameSetup.h"
+#include "GameVersion.h"
+#include "Lua/LuaParser.h"
+#include "System/FileSystem/ArchiveScanner.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/MappedFile.h"
+#include "System/Log/ILog.h"
+#include "System/StringUtil.h"
+#include "System/Sync/SHA512.hpp"
+
+
+// bump whenever the blob layout or the post-processing done by Execute changes
+static constexpr std::uint32_t CACHE_VERSION = 1;
+
+
+static void AppendOptions(sha512::msg_vector& msg, const spring::unordered_map<std::string, std::string>& options)
+{
+	std::vector<std::pair<std::string, std::string>> sortedOptions(options.begin(), options.end());
+	std::sort(sortedOptions.begin(), sortedOptions.end());
+
+	for (const auto& pair: sortedOptions) {
+		msg.insert(msg.end(), pair.first.begin(), pair.first.end()); msg.push_back(0);
+		msg.insert(msg.end(), pair.second.begin(), pair.second.end()); msg.push_back(0);
+	}
+
+	msg.push_back(0);
+}
+
+
+std::string DefsCache::GetEntryPath(LuaParser* parser)
+{
+	const std::string& cacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/defs/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	if (cacheDir.empty())
+		return "";
+
+	sha512::msg_vector msg;
+	sha512::raw_digest key;
+	sha512::hex_digest hex;
+
+	const auto AppendString = [&](const std::string& str) { msg.insert(msg.end(), str.begin(), str.end()); msg.push_back(0); };
+	const auto AppendDigest = [&](const sha512::raw_digest& dig) { msg.insert(msg.end(), dig.begin(), dig.end()); };
+
+	AppendString(IntToString(CACHE_VERSION));
+	AppendString(SpringVersion::GetSync());
+	AppendString(parser->fileName);
+
+	// content reachable by the parser (SPRING_VFS_ZIP), including dependencies
+	AppendDigest(archiveScanner->GetArchiveCompleteChecksumBytes(gameSetup->modName));
+	AppendDigest(archiveScanner->GetArchiveCompleteChecksumBytes(gameSetup->mapName));
+
+	AppendOptions(msg, CGameSetup::GetModOptions());
+	AppendOptions(msg, CGameSetup::GetMapOptions());
+
+	// constants exposed to the defs, these also cover modinfo and mapinfo
+	for (const char* name: {"Game", "Engine"}) {
+		if (!parser->SerializeGlobal(name, msg))
+			return "";
+	}
+
+	sha512::calc_digest(msg, key);
+	sha512::dump_digest(key, hex);
+
+	return (cacheDir + hex.data() + ".bin");
+}
+
+
+bool DefsCache::Load(const std::string& entryPath, LuaParser* parser)
+{
+	if (entryPath.empty())
+		return false;
+
+	CMappedFile file(entryPath);
+
+	if (!file.IsOpen())
+		return false;
+
+	// leaves the parser untouched if the entry is corrupt
+	return (parser->ExecuteBlob(file.GetData(), file.GetSize()));
+}
+
+void DefsCache::Save(const std::string& entryPath, LuaParser* parser)
+{
+	if (entryPath.empty())
+		return;
+
+	// the synced RNG state must advance identically on every client
+	if (parser->UsedRandom()) {
+		LOG("[DefsCache::%s] defs use math.random, not caching them", __func__);
+		return;
+	}
+
+	std::vector<std::uint8_t> blob;
+
+	if (!parser->SerializeRoot(blob)) {
+		LOG("[DefsCache::%s] defs contain non-data values, not caching them", __func__);
+		return;
+	}
+
+	// written under a temporary name first since other processes might be reading entries
+	const std::string tmpFilePath = entryPath + ".tmp";
+
+	FILE* file = fopen(tmpFilePath.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	const bool written = (fwrite(blob.data(), 1, blob.size(), file) == blob.size());
+
+	if ((fclose(file) != 0) || !written || (rename(tmpFilePath.c_str(), entryPath.c_str()) != 0))
+		remove(tmpFilePath.c_str());
+}
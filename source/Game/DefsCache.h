@@ -0,0 +1,27 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef DEFS_CACHE_H
+#define DEFS_CACHE_H
+
+#include <string>
+
+class LuaParser;
+
+/**
+ * On-disk cache of the tables returned by gamedata/defs.lua, so the defs
+ * only have to be executed once per game / map / options combination rather
+ * than on every (re)host. Entries are keyed by the engine version, the game
+ * and map archive checksums and everything else the defs environment gets
+ * to see; defs that draw synced random numbers are never cached.
+ */
+namespace DefsCache {
+	/// returns an empty path if the defs environment of <parser> can not be keyed
+	std::string GetEntryPath(LuaParser* parser);
+
+	/// alternative to parser->Execute(), fails on a miss
+	bool Load(const std::string& entryPath, LuaParser* parser);
+	/// call after a successful parser->Execute()
+	void Save(const std::string& entryPath, LuaParser* parser);
+}
+
+#endif // DEFS_CACHE_H
@@ -8,6 +8,7 @@
 #include "ChatMessage.h"
 #include "CommandMessage.h"
 #include "ConsoleHistory.h"
+#include "DefsCache.h"
 #include "GameHelper.h"
 #include "GameSetup.h"
 #include "GlobalUnsynced.h"
@@ -111,6 +112,7 @@
 #include "System/SpringExitCode.h"
 #include "System/SpringMath.h"
 #include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/VFSHandler.h"
 #include "System/LoadSave/LoadSaveHandler.h"
 #include "System/LoadSave/DemoRecorder.h"
 #include "System/Log/ILog.h"
@@ -303,6 +305,17 @@ CGame::~CGame()
 }
 
 
+float CGame::GetGarbageCollectSlackTime(float callRate) const
+{
+	// wall-clock milliseconds per second not spent on sim or draw frames,
+	// half of which is offered to Lua GC, spread over <callRate> calls
+	const float simTime = gu->avgSimFrameTime * gu->simFPS;
+	const float drawTime = gu->avgDrawFrameTime * globalRendering->FPS;
+	const float idleTime = std::max(0.0f, 1000.0f - simTime - drawTime);
+
+	return ((idleTime * 0.5f) / std::max(callRate, 1.0f));
+}
+
 void CGame::AddTimedJobs()
 {
 	{
@@ -317,7 +330,7 @@ void CGame::AddTimedJobs()
 			// SimFrame handles gc when not paused, this all other cases
 			// do not check the global synced state, never true in demos
 			if (luaGCControl == 1 || simFrameDeltaTime > gcForcedDeltaTime)
-				eventHandler.CollectGarbage();
+				eventHandler.CollectGarbage(GetGarbageCollectSlackTime(GAME_SPEED));
 
 			CInputReceiver::CollectGarbage();
 			return true;
@@ -497,9 +510,24 @@ void CGame::LoadDefs(LuaParser* defsParser)
 		defsParser->AddFunc("GetMapOptions", LuaSyncedRead::GetMapOptions);
 		defsParser->EndTable();
 
-		// run the parser
-		if (!defsParser->Execute())
-			throw content_error("Defs-Parser: " + defsParser->GetErrorLog());
+		const spring_time startTime = spring_gettime();
+		const std::string& cacheEntry = DefsCache::GetEntryPath(defsParser);
+
+		// run the parser, unless an earlier run with identical inputs was cached
+		if (DefsCache::Load(cacheEntry, defsParser)) {
+			LOG("[Game::%s] loaded cached defs in %.1fms", __func__, (spring_gettime() - startTime).toMilliSecsf());
+		} else {
+			// defs.lua pulls in hundreds of small files, read them in parallel up front
+			for (const char* dir: {"gamedata/", "units/", "weapons/", "features/"}) {
+				vfsHandler->PrefetchFiles(dir, CVFSHandler::Mod);
+			}
+
+			if (!defsParser->Execute())
+				throw content_error("Defs-Parser: " + defsParser->GetErrorLog());
+
+			DefsCache::Save(cacheEntry, defsParser);
+			LOG("[Game::%s] executed defs in %.1fms", __func__, (spring_gettime() - startTime).toMilliSecsf());
+		}
 
 		const LuaTable& root = defsParser->GetRoot();
 
@@ -1195,6 +1223,12 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 	// set camera
 	camHandler->UpdateController(playerHandler.Player(gu->myPlayerNum), gu->fpsMode, fullscreenEdgeMove, windowedEdgeMove);
 
+	// unit draw-state is brought up to date on a worker while the updates
+	// below (which do not touch units) run; anything past FinishUpdate may
+	// read it, including Lua
+	// NOTE: this can not overlap SimFrame, the interpolation needs the state
+	// the sim produces and the timeOffset of this draw-frame; the handoff is
+	// after the sim batch instead
 	unitDrawer->Update();
 	lineDrawer.UpdateLineStipple();
 
@@ -1216,6 +1250,12 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 		sound->UpdateListener(camera->GetPos(), camera->GetDir(), camera->GetUp());
 	}
 
+	{
+		// time the main thread still has to wait, ~0 if the overlap hides the update
+		SCOPED_TIMER("Update::UnitDrawer::Wait");
+		unitDrawer->FinishUpdate();
+	}
+
 
 	if (luaUI != nullptr) {
 		luaUI->CheckStack();
@@ -1522,13 +1562,14 @@ void CGame::SimFrame() {
 			// keep garbage-collection rate tied to sim-speed
 			// (fixed 30Hz gc is not enough while catching up)
 			if (luaGCControl == 0)
-				eventHandler.CollectGarbage();
+				eventHandler.CollectGarbage(GetGarbageCollectSlackTime(gu->simFPS));
 
 			eventHandler.GameFrame(gs->frameNum);
 		}
 
 		helper->Update();
 		mapDamage->Update();
+		smoothGround.Update();
 		pathManager->Update();
 		unitHandler.Update();
 		projectileHandler.Update();
@@ -1544,9 +1585,12 @@ void CGame::SimFrame() {
 		// should probably be split from drawer
 		unitDrawer->UpdateGhostedBuildings();
 		interceptHandler.Update(false);
+		quadField.Update();
 
 		teamHandler.GameFrame(gs->frameNum);
 		playerHandler.GameFrame(gs->frameNum);
+
+		eventHandler.FlushBatchedEvents();
 	}
 
 	lastSimFrameTime = spring_gettime();
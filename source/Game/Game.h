@@ -47,6 +47,7 @@ public:
 
 private:
 	void AddTimedJobs();
+	float GetGarbageCollectSlackTime(float callRate) const;
 
 	void LoadMap(const std::string& mapName);
 	void LoadDefs(LuaParser* defsParser);
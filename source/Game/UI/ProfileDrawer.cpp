@@ -7,6 +7,8 @@
 #include "InputReceiver.h"
 #include "Game/GlobalUnsynced.h"
 #include "Lua/LuaAllocState.h"
+#include "Lua/LuaContextData.h"
+#include "Lua/LuaHandle.h"
 #include "Rendering/GL/myGL.h"
 #include "Rendering/Fonts/glFont.h"
 #include "Rendering/GlobalRendering.h"
@@ -24,6 +26,7 @@
 #include "System/EventHandler.h"
 #include "System/TimeProfiler.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
 #include "lib/lua/include/LuaUser.h" // spring_lua_alloc_get_stats
 
 ProfileDrawer* ProfileDrawer::instance = nullptr;
@@ -167,6 +170,39 @@ static void DrawTimeSlices(
 }
 
 
+static void GetWorkerStatRates(float& stealRate, float& idleRate)
+{
+	// summed over all (sync) workers, sampled every MAX_THREAD_HIST_TIME
+	static ThreadPool::WorkerStats prvStats = {0, 0, 0};
+	static ThreadPool::WorkerStats curStats = {0, 0, 0};
+	static spring_time prvTime = spring_notime;
+	static spring_time curTime = spring_notime;
+
+	const spring_time now = spring_now();
+
+	if ((now - curTime).toSecsf() >= MAX_THREAD_HIST_TIME) {
+		prvStats = curStats;
+		prvTime = curTime;
+		curStats = {0, 0, 0};
+		curTime = now;
+
+		for (int i = 1, n = ThreadPool::GetNumThreads(); i < n; i++) {
+			const ThreadPool::WorkerStats ws = ThreadPool::GetWorkerStats(i, false);
+
+			curStats.numTasksRun += ws.numTasksRun;
+			curStats.numTasksStolen += ws.numTasksStolen;
+			curStats.sumIdleTime += ws.sumIdleTime;
+		}
+	}
+
+	const float dt = std::max((curTime - prvTime).toSecsf(), 0.001f);
+	const float nw = std::max(ThreadPool::GetNumThreads() - 1, 1);
+
+	// counters restart with the pool
+	stealRate = (curStats.numTasksStolen - std::min(prvStats.numTasksStolen, curStats.numTasksStolen)) / dt;
+	idleRate = (curStats.sumIdleTime - std::min(prvStats.sumIdleTime, curStats.sumIdleTime)) * 1e-9f / (dt * nw);
+}
+
 static void DrawThreadBarcode(GL::RenderDataBufferC* buffer)
 {
 	constexpr float    barColor[4] = {0.0f, 0.0f, 0.0f, 0.5f};
@@ -191,7 +227,12 @@ static void DrawThreadBarcode(GL::RenderDataBufferC* buffer)
 	}
 	{
 		// title
-		font->glFormat(drawArea[0], drawArea[3], 0.7f, FONT_TOP | DBG_FONT_FLAGS | FONT_BUFFERED, "ThreadPool (%.1f seconds :: " _STPF_ " threads)", MAX_THREAD_HIST_TIME, numThreads);
+		float stealRate = 0.0f;
+		float idleRate = 0.0f;
+
+		GetWorkerStatRates(stealRate, idleRate);
+
+		font->glFormat(drawArea[0], drawArea[3], 0.7f, FONT_TOP | DBG_FONT_FLAGS | FONT_BUFFERED, "ThreadPool (%.1f seconds :: " _STPF_ " threads :: %.0f steals/s :: %.0f%% idle)", MAX_THREAD_HIST_TIME, numThreads, stealRate, idleRate * 100.0f);
 	}
 	{
 		// need to lock; DrawTimeSlice pop_front()'s old entries from
@@ -434,10 +475,10 @@ static void DrawInfoText(GL::RenderDataBufferC* buffer)
 
 	// background
 	buffer->SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // tl
-	buffer->SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // bl
-	buffer->SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // br
+	buffer->SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // bl
+	buffer->SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // br
 
-	buffer->SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // br
+	buffer->SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // br
 	buffer->SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // tr
 	buffer->SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, {bgColor}}); // tl
 
@@ -453,6 +494,7 @@ static void DrawInfoText(GL::RenderDataBufferC* buffer)
 	const char* luaFmtStr = "[7] Lua-allocated memory: %.1fMB (%.1fK allocs : %.5u usecs : %.1u states)";
 	const char* gpuFmtStr = "[8] GPU-allocated memory: %.1fMB / %.1fMB";
 	const char* sopFmtStr = "[9] SOP-allocated memory: {U,F,P,W}={%.1f/%.1f, %.1f/%.1f, %.1f/%.1f, %.1f/%.1f}KB";
+	const char* lgcFmtStr = "[10] Lua-GC {heap,time}: %s";
 
 	const CProjectileHandler* ph = &projectileHandler;
 	const IPathManager* pm = pathManager;
@@ -519,6 +561,29 @@ static void DrawInfoText(GL::RenderDataBufferC* buffer)
 		weaponMemPool.alloc_size() / 1024.0f,
 		weaponMemPool.freed_size() / 1024.0f
 	);
+
+	{
+		// [0] := unsynced, [1] := synced
+		extern const spring::unsynced_set<const luaContextData*>* LUAHANDLE_CONTEXTS[2];
+
+		char buf[512] = {0};
+		char* ptr = &buf[0];
+
+		for (bool synced: {false, true}) {
+			for (const luaContextData* lcd: *LUAHANDLE_CONTEXTS[synced]) {
+				if (lcd->owner == nullptr)
+					continue;
+
+				const SLuaGarbageCollectCtrl& gcCtrl = lcd->gcCtrl;
+				const size_t numFree = sizeof(buf) - (ptr - &buf[0]);
+				const int numChars = SNPRINTF(ptr, numFree, "%s%s={%.1fMB, %.2fms} ", lcd->owner->GetName().c_str(), synced? "(S)": "", gcCtrl.heapSize / 1024.0f / 1024.0f, gcCtrl.avgRunTime);
+
+				ptr += std::min(size_t(std::max(numChars, 0)), numFree - 1);
+			}
+		}
+
+		font->glFormat(0.01f, 0.20f, 0.5f, DBG_FONT_FLAGS | FONT_BUFFERED, lgcFmtStr, buf);
+	}
 }
 
 
@@ -5,6 +5,8 @@
 
 #include <limits>
 
+#include "System/Misc/SpringTime.h"
+
 struct SLuaGarbageCollectCtrl {
 	// maximum number of lua_gc calls made in each CollectGarbage loop
 	int itersPerBatch = std::numeric_limits<int>::max();
@@ -20,7 +22,30 @@ struct SLuaGarbageCollectCtrl {
 
 	float baseRunTimeMult = 0.0f;
 	float baseMemLoadMult = 0.0f;
+
+	// if true, the loop runtime is derived from the frame slack passed to
+	// CollectGarbage and the observed allocation rate instead of from the
+	// base multipliers above
+	bool adaptive = false;
+
+	// heap size (bytes) right after the previous CollectGarbage call; GC is
+	// stopped in between so all growth since then is new allocations
+	size_t lastHeapSize = 0;
+	// heap size (bytes) at the end of the last completed GC cycle, i.e. live data
+	size_t liveHeapSize = 0;
+	spring_time lastCollectTime = spring_notime;
+
+	// smoothed, in bytes allocated per millisecond of wall-clock time
+	float allocRate = 0.0f;
+	// smoothed, in bytes freed per millisecond spent inside lua_gc
+	float collectRate = 0.0f;
+
+	// bytes allocated since the previous call that have not been paid off yet
+	float allocDebt = 0.0f;
+
+	// statistics, shown by the profiler
+	float avgRunTime = 0.0f; // ms per CollectGarbage call, smoothed
+	size_t heapSize = 0; // bytes, after the last CollectGarbage call
 };
 
 #endif
-
@@ -38,6 +38,7 @@
 #include "System/Rectangle.h"
 #include "System/ScopedFPUSettings.h"
 #include "System/StringUtil.h"
+#include "System/TimeProfiler.h"
 #include "System/Log/ILog.h"
 #include "System/Input/KeyInput.h"
 #include "System/Platform/SDL1_keysym.h"
@@ -54,6 +55,7 @@
 
 CONFIG(float, LuaGarbageCollectionMemLoadMult).defaultValue(1.33f).minimumValue(1.0f).maximumValue(100.0f);
 CONFIG(float, LuaGarbageCollectionRunTimeMult).defaultValue(5.0f).minimumValue(1.0f).description("in milliseconds");
+CONFIG(bool, LuaGarbageCollectionAdaptive).defaultValue(false).description("Fit Lua garbage collection into spare frame time based on each state's allocation rate, instead of using LuaGarbageCollection{MemLoad,RunTime}Mult. Experimental.");
 
 
 static spring::unsynced_set<const luaContextData*>    SYNCED_LUAHANDLE_CONTEXTS;
@@ -107,6 +109,11 @@ CLuaHandle::CLuaHandle(const string& _name, int _order, bool _userMode, bool _sy
 
 	D.gcCtrl.baseMemLoadMult = configHandler->GetFloat("LuaGarbageCollectionMemLoadMult");
 	D.gcCtrl.baseRunTimeMult = configHandler->GetFloat("LuaGarbageCollectionRunTimeMult");
+	D.gcCtrl.adaptive = configHandler->GetBool("LuaGarbageCollectionAdaptive");
+
+	// per-handle profiler entry; synced and unsynced halves share a name
+	gcTimerName = "Lua::GC::" + name + (_synced? "::Synced": "");
+	CTimeProfiler::RegisterTimer(gcTimerName.c_str());
 
 	L = LUA_OPEN(&D);
 	L_GC = lua_newthread(L);
@@ -433,7 +440,7 @@ bool CLuaHandle::RunCallInTraceback(lua_State* L, const LuaHashString& hs, int i
 	if (error == LUA_ERRMEM) {
 		// try to free some memory so other lua states can alloc again
 		for (int i = 0; i < 20; ++i) {
-			CollectGarbage();
+			CollectGarbage(D.gcCtrl.maxLoopRunTime);
 		}
 
 		// kill the entire handle next frame
@@ -1008,6 +1015,72 @@ void CLuaHandle::UnitDamaged(
 	RunCallInTraceback(L, cmdStr, argCount, 0, traceBack.GetErrFuncIdx(), false);
 }
 
+// called once per sim-frame with all UnitDamaged events of that frame as
+// parallel arrays: count, unitIDs, unitDefIDs, unitTeams, damages, paralyzers,
+// weaponDefIDs, projectileIDs[, attackerIDs, attackerDefIDs, attackerTeams]
+// (attacker arrays only for full-read handles, nil entries if no attacker)
+void CLuaHandle::UnitDamagedBatch(const std::vector<SUnitDamageInfo>& events)
+{
+	LUA_CALL_IN_CHECK(L);
+	luaL_checkstack(L, 14, __func__);
+
+	static const LuaHashString cmdStr(__func__);
+	const LuaUtils::ScopedDebugTraceBack traceBack(L);
+
+	if (!cmdStr.GetGlobalFunc(L))
+		return;
+
+	const bool fullRead = GetHandleFullRead(L);
+	const int numArrays = 7 + 3 * fullRead;
+
+	int count = 0;
+
+	for (const SUnitDamageInfo& e: events) {
+		count += CanReadAllyTeam(e.unitAllyTeam);
+	}
+
+	if (count == 0) {
+		lua_pop(L, 1);
+		return;
+	}
+
+	lua_pushnumber(L, count);
+
+	// arrays occupy stack slots [base, base + numArrays)
+	const int base = lua_gettop(L) + 1;
+
+	for (int i = 0; i < numArrays; i++) {
+		lua_createtable(L, count, 0);
+	}
+
+	int n = 0;
+
+	for (const SUnitDamageInfo& e: events) {
+		if (!CanReadAllyTeam(e.unitAllyTeam))
+			continue;
+
+		n += 1;
+
+		lua_pushnumber(L, e.unitID);       lua_rawseti(L, base + 0, n);
+		lua_pushnumber(L, e.unitDefID);    lua_rawseti(L, base + 1, n);
+		lua_pushnumber(L, e.unitTeam);     lua_rawseti(L, base + 2, n);
+		lua_pushnumber(L, e.damage);       lua_rawseti(L, base + 3, n);
+		lua_pushboolean(L, e.paralyzer);   lua_rawseti(L, base + 4, n);
+		lua_pushnumber(L, e.weaponDefID);  lua_rawseti(L, base + 5, n);
+		lua_pushnumber(L, e.projectileID); lua_rawseti(L, base + 6, n);
+
+		if (!fullRead || e.attackerID < 0)
+			continue;
+
+		lua_pushnumber(L, e.attackerID);    lua_rawseti(L, base + 7, n);
+		lua_pushnumber(L, e.attackerDefID); lua_rawseti(L, base + 8, n);
+		lua_pushnumber(L, e.attackerTeam);  lua_rawseti(L, base + 9, n);
+	}
+
+	// call the routine
+	RunCallInTraceback(L, cmdStr, 1 + numArrays, 0, traceBack.GetErrFuncIdx(), false);
+}
+
 void CLuaHandle::UnitStunned(
 	const CUnit* unit,
 	bool stunned)
@@ -2500,46 +2573,109 @@ void CLuaHandle::DownloadProgress(int ID, long downloaded, long total)
 /******************************************************************************/
 /******************************************************************************/
 
-void CLuaHandle::CollectGarbage()
+float CLuaHandle::GetGarbageCollectRunTime(float slackTime)
 {
-	const float gcMemLoadMult = D.gcCtrl.baseMemLoadMult;
-	const float gcRunTimeMult = D.gcCtrl.baseRunTimeMult;
+	SLuaGarbageCollectCtrl& gcCtrl = D.gcCtrl;
 
-	if (spring_lua_alloc_skip_gc(gcMemLoadMult))
-		return;
+	if (!gcCtrl.adaptive) {
+		const float gcMemLoadMult = gcCtrl.baseMemLoadMult;
+		const float gcRunTimeMult = gcCtrl.baseRunTimeMult;
+
+		if (spring_lua_alloc_skip_gc(gcMemLoadMult))
+			return -1.0f;
+
+		// note: total footprint INCLUDING garbage, in KB
+		const int gcMemFootPrint = lua_gc(L_GC, LUA_GCCOUNT, 0);
+
+		// if gc runs at a fixed rate, the upper limit to base runtime will
+		// quickly be reached since Lua's footprint can easily exceed 100MB
+		// and OOM exceptions become a concern when catching up
+		// OTOH if gc is tied to sim-speed the increased number of calls can
+		// mean too much time is spent on it, must weigh the per-call period
+		const float gcSpeedFactor = Clamp(gs->speedFactor * (1 - gs->PreSimFrame()) * (1 - gs->paused), 1.0f, 50.0f);
+		const float gcBaseRunTime = smoothstep(10.0f, 100.0f, gcMemFootPrint / 1024);
+
+		return (Clamp((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor, gcCtrl.minLoopRunTime, gcCtrl.maxLoopRunTime));
+	}
+
+	// GC is stopped between calls, so any growth since the last one was allocated in the meantime
+	const spring_time curTime = spring_gettime();
+	const size_t heapSize = D.allocState.allocedBytes.load();
+
+	if (!spring_istime(gcCtrl.lastCollectTime)) {
+		// first call, no rate known yet; do not treat the initial heap as debt
+		gcCtrl.lastHeapSize = heapSize;
+		gcCtrl.liveHeapSize = heapSize;
+		gcCtrl.lastCollectTime = curTime;
+	}
+
+	const float deltaTime = std::max((curTime - gcCtrl.lastCollectTime).toMilliSecsf(), 1.0f);
+	const float allocSize = std::max(heapSize, gcCtrl.lastHeapSize) - gcCtrl.lastHeapSize;
+
+	gcCtrl.allocRate = mix(gcCtrl.allocRate, allocSize / deltaTime, 0.1f);
+	gcCtrl.allocDebt += allocSize;
+
+	// until a collection rate has been measured, assume the GC clears 1MB per ms
+	const float collectRate = (gcCtrl.collectRate > 0.0f)? gcCtrl.collectRate: (1024.0f * 1024.0f);
+	const float paybackTime = gcCtrl.allocDebt / collectRate;
+	// time needed to keep pace with the smoothed allocation rate over a call
+	// period; keeps collecting after a burst instead of only once it is debt
+	const float keepPaceTime = (gcCtrl.allocRate * deltaTime) / collectRate;
+	const float runTime = std::max(paybackTime, keepPaceTime);
+
+	// spend at most the slack we were given, unless the heap has more than
+	// doubled since the last completed cycle (Lua's own default pause); then
+	// pay the debt off even if the frame overruns since falling further behind
+	// only makes the eventual stall worse. Legitimate growth can trigger this
+	// too, but only until the next completed cycle resets the debt.
+	if (gcCtrl.allocDebt > gcCtrl.liveHeapSize)
+		return (Clamp(runTime, gcCtrl.minLoopRunTime, gcCtrl.maxLoopRunTime));
+
+	return (Clamp(std::min(runTime, slackTime), gcCtrl.minLoopRunTime, gcCtrl.maxLoopRunTime));
+}
+
+void CLuaHandle::CollectGarbage(float slackTime)
+{
+	SLuaGarbageCollectCtrl& gcCtrl = D.gcCtrl;
+
+	ScopedTimer gcTimer(hashString(gcTimerName.c_str()));
 
 	lua_lock(L_GC);
 	SetHandleRunning(L_GC, true);
 
+	const float gcLoopRunTime = GetGarbageCollectRunTime(slackTime);
+
+	if (gcLoopRunTime < 0.0f) {
+		SetHandleRunning(L_GC, false);
+		lua_unlock(L_GC);
+		return;
+	}
+
+	const size_t gcHeapSizeBefore = D.allocState.allocedBytes.load();
+
 	// note: total footprint INCLUDING garbage, in KB
 	int  gcMemFootPrint = lua_gc(L_GC, LUA_GCCOUNT, 0);
 	int  gcItersInBatch = 0;
-	int& gcStepsPerIter = D.gcCtrl.numStepsPerIter;
-
-	// if gc runs at a fixed rate, the upper limit to base runtime will
-	// quickly be reached since Lua's footprint can easily exceed 100MB
-	// and OOM exceptions become a concern when catching up
-	// OTOH if gc is tied to sim-speed the increased number of calls can
-	// mean too much time is spent on it, must weigh the per-call period
-	const float gcSpeedFactor = Clamp(gs->speedFactor * (1 - gs->PreSimFrame()) * (1 - gs->paused), 1.0f, 50.0f);
-	const float gcBaseRunTime = smoothstep(10.0f, 100.0f, gcMemFootPrint / 1024);
-	const float gcLoopRunTime = Clamp((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor, D.gcCtrl.minLoopRunTime, D.gcCtrl.maxLoopRunTime);
+	int& gcStepsPerIter = gcCtrl.numStepsPerIter;
 
 	const spring_time startTime = spring_gettime();
 	const spring_time   endTime = startTime + spring_msecs(gcLoopRunTime);
 
 	// perform GC cycles until time runs out or iteration-limit is reached
-	while (gcItersInBatch < D.gcCtrl.itersPerBatch && spring_gettime() < endTime) {
+	while (gcItersInBatch < gcCtrl.itersPerBatch && spring_gettime() < endTime) {
 		gcItersInBatch++;
 
 		if (!lua_gc(L_GC, LUA_GCSTEP, gcStepsPerIter))
 			continue;
 
-		// garbage-collection cycle finished
+		// garbage-collection cycle finished; whatever survived it is live,
+		// including growth that was counted as debt but never became garbage
 		const int gcMemFootPrintNow = lua_gc(L_GC, LUA_GCCOUNT, 0);
 		const int gcMemFootPrintDif = gcMemFootPrintNow - gcMemFootPrint;
 
 		gcMemFootPrint = gcMemFootPrintNow;
+		gcCtrl.allocDebt = 0.0f;
+		gcCtrl.liveHeapSize = D.allocState.allocedBytes.load();
 
 		// early-exit if cycle didn't free any memory
 		if (gcMemFootPrintDif == 0)
@@ -2553,14 +2689,32 @@ void CLuaHandle::CollectGarbage()
 
 
 	const spring_time finishTime = spring_gettime();
+	const float gcRunTime = (finishTime - startTime).toMilliSecsf();
 
 	if (gcStepsPerIter > 1 && gcItersInBatch > 0) {
 		// runtime optimize number of steps to process in a batch
-		const float avgLoopIterTime = (finishTime - startTime).toMilliSecsf() / gcItersInBatch;
+		const float avgLoopIterTime = gcRunTime / gcItersInBatch;
+		const float gcRunTimeMult = gcCtrl.adaptive? std::max(gcLoopRunTime, 1.0f): gcCtrl.baseRunTimeMult;
 
 		gcStepsPerIter -= (avgLoopIterTime > (gcRunTimeMult * 0.150f));
 		gcStepsPerIter += (avgLoopIterTime < (gcRunTimeMult * 0.075f));
-		gcStepsPerIter  = Clamp(gcStepsPerIter, D.gcCtrl.minStepsPerIter, D.gcCtrl.maxStepsPerIter);
+		gcStepsPerIter  = Clamp(gcStepsPerIter, gcCtrl.minStepsPerIter, gcCtrl.maxStepsPerIter);
+	}
+
+	{
+		const size_t gcHeapSizeAfter = D.allocState.allocedBytes.load();
+		const float gcFreedSize = std::max(gcHeapSizeBefore, gcHeapSizeAfter) - gcHeapSizeAfter;
+
+		// the mark phase frees nothing, only sample when the sweep made progress
+		if (gcFreedSize > 0.0f && gcRunTime > 0.01f)
+			gcCtrl.collectRate = mix(gcCtrl.collectRate, gcFreedSize / gcRunTime, (gcCtrl.collectRate > 0.0f)? 0.1f: 1.0f);
+
+		gcCtrl.allocDebt = std::max(0.0f, gcCtrl.allocDebt - gcFreedSize);
+		gcCtrl.lastHeapSize = gcHeapSizeAfter;
+		gcCtrl.lastCollectTime = finishTime;
+
+		gcCtrl.heapSize = gcHeapSizeAfter;
+		gcCtrl.avgRunTime = mix(gcCtrl.avgRunTime, gcRunTime, 0.05f);
 	}
 
 	eventHandler.DbgTimingInfo(TIMING_GC, startTime, finishTime);
@@ -136,6 +136,7 @@ class CLuaHandle : public CEventClient
 			int projectileID,
 			bool paralyzer
 		) override;
+		void UnitDamagedBatch(const std::vector<SUnitDamageInfo>& events) override;
 		void UnitStunned(const CUnit* unit, bool stunned) override;
 		void UnitExperience(const CUnit* unit, float oldExperience) override;
 		void UnitHarvestStorageFull(const CUnit* unit) override;
@@ -259,7 +260,7 @@ class CLuaHandle : public CEventClient
 
 		//FIXME void MetalMapChanged(const int x, const int z);
 
-		void CollectGarbage() override;
+		void CollectGarbage(float slackTime) override;
 
 		void DownloadQueued(int ID, const std::string& archiveName, const std::string& archiveType) override;
 		void DownloadStarted(int ID) override;
@@ -302,6 +303,9 @@ class CLuaHandle : public CEventClient
 
 		void RunDrawCallIn(const LuaHashString& hs);
 
+		/// milliseconds the next CollectGarbage loop may run, negative to skip it
+		float GetGarbageCollectRunTime(float slackTime);
+
 	protected:
 		bool userMode = false;
 		bool killMe = false; // set for handles that fail to RunCallIn
@@ -313,6 +317,7 @@ class CLuaHandle : public CEventClient
 		luaContextData D;
 
 		std::string killMsg;
+		std::string gcTimerName;
 
 		std::vector<bool> watchUnitDefs;        // callin masks for Unit*Collision, UnitMoveFailed
 		std::vector<bool> watchFeatureDefs;     // callin masks for UnitFeatureCollision
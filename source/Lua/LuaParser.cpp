@@ -288,6 +288,53 @@ bool LuaParser::Execute()
 }
 
 
+bool LuaParser::ExecuteBlob(const std::uint8_t* data, size_t size)
+{
+	if (!IsValid()) {
+		errorLog = "could not initialize Lua library";
+		return false;
+	}
+
+	assert(rootRef == LUA_NOREF);
+	assert(initDepth == 0);
+
+	// unlike Execute, failure leaves the parser as it was
+	if (!LuaUtils::DeserializeTable(L, data, size)) {
+		errorLog = "invalid table blob";
+		return false;
+	}
+
+	initDepth = -1;
+	rootRef = luaL_ref(L, LUA_REGISTRYINDEX);
+	lua_settop(L, 0);
+
+	return (valid = true);
+}
+
+
+bool LuaParser::SerializeRoot(std::vector<std::uint8_t>& blob)
+{
+	if (!IsValid() || rootRef == LUA_NOREF)
+		return false;
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, rootRef);
+	const bool ret = LuaUtils::SerializeTable(blob, L, -1);
+	lua_pop(L, 1);
+	return ret;
+}
+
+bool LuaParser::SerializeGlobal(const std::string& name, std::vector<std::uint8_t>& blob)
+{
+	if (!IsValid())
+		return false;
+
+	lua_getglobal(L, name.c_str());
+	const bool ret = LuaUtils::SerializeTable(blob, L, -1);
+	lua_pop(L, 1);
+	return ret;
+}
+
+
 void LuaParser::AddTable(LuaTable* tbl) { spring::VectorInsertUnique(tables, tbl); }
 void LuaParser::RemoveTable(LuaTable* tbl) { spring::VectorErase(tables, tbl); }
 
@@ -522,6 +569,7 @@ int LuaParser::Random(lua_State* L)
 {
 	// both US and DS depend on LuaParser via MapParser, etc
 	#if (!defined(UNITSYNC) && !defined(DEDICATED))
+	GetLuaParser(L)->usedRandom = true;
 	lua_pushnumber(L, gsRNG.NextFloat());
 	return 1;
 	#else
@@ -3,6 +3,7 @@
 #ifndef LUA_PARSER_H
 #define LUA_PARSER_H
 
+#include <cinttypes>
 #include <string>
 #include <vector>
 
@@ -132,6 +133,9 @@ public:
 	void SetupLua(bool isSyncedCtxt, bool isDefsParser);
 
 	bool Execute();
+	/// alternative to Execute, uses a root table previously saved by SerializeRoot;
+	/// the parser is left untouched (and can still Execute) if this fails
+	bool ExecuteBlob(const std::uint8_t* data, size_t size);
 	bool IsValid() const { return (L != nullptr); } // true if nothing failed during Execute
 	bool NoTable() const { return (errorLog.find("no return table") == 0); } // parser is still valid if true
 
@@ -142,6 +146,13 @@ public:
 
 	const std::string& GetErrorLog() const { return errorLog; }
 
+	// both fail if the table holds anything but booleans, numbers, strings and tables
+	bool SerializeRoot(std::vector<std::uint8_t>& blob);
+	bool SerializeGlobal(const std::string& name, std::vector<std::uint8_t>& blob);
+
+	// true if Execute drew synced random numbers, results then can not be reused
+	bool UsedRandom() const { return usedRandom; }
+
 	// for setting up the initial params table
 	void GetTable(int index,               bool overwrite = false);
 	void GetTable(const std::string& name, bool overwrite = false);
@@ -191,6 +202,7 @@ private:
 	bool valid = false;
 	bool lowerKeys = false; // convert all returned keys to lower case
 	bool lowerCppKeys = false; // convert strings in arguments keys to lower case
+	bool usedRandom = false;
 
 private:
 	// Weird call-outs
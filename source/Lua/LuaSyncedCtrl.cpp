@@ -3990,7 +3990,7 @@ int LuaSyncedCtrl::LevelSmoothMesh(lua_State* L)
 
 	for (int z = z1; z <= z2; z++) {
 		for (int x = x1; x <= x2; x++) {
-			const int index = (z * smoothGround.GetMaxX()) + x;
+			const int index = smoothGround.GetIndex(x, z);
 			smoothGround.SetHeight(index, height);
 		}
 	}
@@ -4005,7 +4005,7 @@ int LuaSyncedCtrl::AdjustSmoothMesh(lua_State* L)
 
 	for (int z = z1; z <= z2; z++) {
 		for (int x = x1; x <= x2; x++) {
-			const int index = (z * smoothGround.GetMaxX()) + x;
+			const int index = smoothGround.GetIndex(x, z);
 			smoothGround.AddHeight(index, height);
 		}
 	}
@@ -4025,7 +4025,7 @@ int LuaSyncedCtrl::RevertSmoothMesh(lua_State* L)
 	if (origFactor == 1.0f) {
 		for (int z = z1; z <= z2; z++) {
 			for (int x = x1; x <= x2; x++) {
-				const int idx = (z * smoothGround.GetMaxX()) + x;
+				const int idx = smoothGround.GetIndex(x, z);
 				smoothGround.SetHeight(idx, origMap[idx]);
 			}
 		}
@@ -4034,7 +4034,7 @@ int LuaSyncedCtrl::RevertSmoothMesh(lua_State* L)
 		const float currFactor = (1.0f - origFactor);
 		for (int z = z1; z <= z2; z++) {
 			for (int x = x1; x <= x2; x++) {
-				const int index = (z * smoothGround.GetMaxX()) + x;
+				const int index = smoothGround.GetIndex(x, z);
 				const float ofh = origFactor * origMap[index];
 				const float cfh = currFactor * currMap[index];
 				smoothGround.SetHeight(index, ofh + cfh);
@@ -4066,7 +4066,7 @@ int LuaSyncedCtrl::AddSmoothMesh(lua_State* L)
 		return 0;
 	}
 
-	const int index = (z * smoothGround.GetMaxX()) + x;
+	const int index = smoothGround.GetIndex(x, z);
 	const float oldHeight = smoothGround.GetMeshData()[index];
 	smoothMeshAmountChanged += math::fabsf(h);
 
@@ -4096,7 +4096,7 @@ int LuaSyncedCtrl::SetSmoothMesh(lua_State* L)
 		return 0;
 	}
 
-	const int index = (z * (smoothGround.GetMaxX())) + x;
+	const int index = smoothGround.GetIndex(x, z);
 	const float oldHeight = smoothGround.GetMeshData()[index];
 	float height = oldHeight;
 
@@ -214,6 +214,9 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetUnitDirection);
 	REGISTER_LUA_CFUNC(GetUnitHeading);
 	REGISTER_LUA_CFUNC(GetUnitVelocity);
+	REGISTER_LUA_CFUNC(GetUnitArrayPositions);
+	REGISTER_LUA_CFUNC(GetUnitArrayVelocities);
+	REGISTER_LUA_CFUNC(GetUnitArrayHealths);
 	REGISTER_LUA_CFUNC(GetUnitBuildFacing);
 	REGISTER_LUA_CFUNC(GetUnitIsBuilding);
 	REGISTER_LUA_CFUNC(GetUnitCurrentBuildPower);
@@ -2140,7 +2143,7 @@ int LuaSyncedRead::GetTeamUnitCount(lua_State* L)
 // Macro Requirements:
 //   unit
 //   readTeam   for MY_UNIT_TEST
-//   allegiance for SIMPLE_TEAM_TEST and VISIBLE_TEAM_TEST
+//   allegiance for SIMPLE_TEAM_TEST
 
 #define NULL_TEST  ;  // always passes
 
@@ -2150,20 +2153,9 @@ int LuaSyncedRead::GetTeamUnitCount(lua_State* L)
 #define SIMPLE_TEAM_TEST \
 	if (unit->team != allegiance) { continue; }
 
-#define VISIBLE_TEAM_TEST \
-	if (unit->team != allegiance) { continue; } \
-	if (!IsUnitVisible(L, unit)) { continue; }
-
 #define MY_UNIT_TEST \
 	if (unit->team != readTeam) { continue; }
 
-#define ALLY_UNIT_TEST \
-	if (unit->allyteam != CLuaHandle::GetHandleReadAllyTeam(L)) { continue; }
-
-#define ENEMY_UNIT_TEST \
-	if (unit->allyteam == CLuaHandle::GetHandleReadAllyTeam(L)) { continue; } \
-	if (!IsUnitVisible(L, unit)) { continue; }
-
 
 static int ParseAllegiance(lua_State* L, const char* caller, int index)
 {
@@ -2185,6 +2177,55 @@ static int ParseAllegiance(lua_State* L, const char* caller, int index)
 	return teamID;
 }
 
+// the quadfield walks only the allyteams <allegiance> can match, and
+// does the IsUnitVisible test for the ones that are not allied
+static QuadFieldAllyFilter GetAllegianceFilter(lua_State* L, int allegiance)
+{
+	QuadFieldAllyFilter filter;
+
+	const int readAllyTeam = CLuaHandle::GetHandleReadAllyTeam(L);
+
+	if (readAllyTeam < 0) {
+		if (!CLuaHandle::GetHandleFullRead(L))
+			return filter;
+		// no unit is in the AllAccessTeam allyteam, so AllyUnits stays empty
+		if (allegiance == AllyUnits)
+			return filter;
+
+		for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+			filter.Include(t);
+		}
+
+		return filter;
+	}
+
+	filter.SetLosTest(readAllyTeam, LOS_INLOS | LOS_INRADAR);
+
+	if (allegiance >= 0) {
+		filter.Include(teamHandler.AllyTeam(allegiance), !IsAlliedTeam(L, allegiance));
+		return filter;
+	}
+
+	switch (allegiance) {
+		case MyUnits:
+		case AllyUnits: {
+			filter.Include(readAllyTeam);
+		} break;
+		case EnemyUnits:
+		case AllUnits: {
+			for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+				if (t != readAllyTeam) {
+					filter.Include(t, true);
+				} else if (allegiance == AllUnits) {
+					filter.Include(t);
+				}
+			}
+		} break;
+	}
+
+	return filter;
+}
+
 
 int LuaSyncedRead::GetUnitsInRectangle(lua_State* L)
 {
@@ -2201,28 +2242,18 @@ int LuaSyncedRead::GetUnitsInRectangle(lua_State* L)
 #define RECTANGLE_TEST ; // no test, GetUnitsExact is sufficient
 
 	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, mins, maxs);
+	quadField.GetUnitsExact(qfQuery, mins, maxs, GetAllegianceFilter(L, allegiance));
 	const auto& units = (*qfQuery.units);
 
 	if (allegiance >= 0) {
-		if (IsAlliedTeam(L, allegiance)) {
-			LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, RECTANGLE_TEST, true);
-		} else {
-			LOOP_UNIT_CONTAINER(VISIBLE_TEAM_TEST, RECTANGLE_TEST, true);
-		}
+		LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, RECTANGLE_TEST, true);
 	}
 	else if (allegiance == MyUnits) {
 		const int readTeam = CLuaHandle::GetHandleReadTeam(L);
 		LOOP_UNIT_CONTAINER(MY_UNIT_TEST, RECTANGLE_TEST, true);
 	}
-	else if (allegiance == AllyUnits) {
-		LOOP_UNIT_CONTAINER(ALLY_UNIT_TEST, RECTANGLE_TEST, true);
-	}
-	else if (allegiance == EnemyUnits) {
-		LOOP_UNIT_CONTAINER(ENEMY_UNIT_TEST, RECTANGLE_TEST, true);
-	}
-	else { // AllUnits
-		LOOP_UNIT_CONTAINER(VISIBLE_TEST, RECTANGLE_TEST, true);
+	else { // AllyUnits, EnemyUnits, AllUnits
+		LOOP_UNIT_CONTAINER(NULL_TEST, RECTANGLE_TEST, true);
 	}
 
 	return 1;
@@ -2250,28 +2281,18 @@ int LuaSyncedRead::GetUnitsInBox(lua_State* L)
 	}
 
 	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, mins, maxs);
+	quadField.GetUnitsExact(qfQuery, mins, maxs, GetAllegianceFilter(L, allegiance));
 	const auto& units = (*qfQuery.units);
 
 	if (allegiance >= 0) {
-		if (IsAlliedTeam(L, allegiance)) {
-			LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, BOX_TEST, true);
-		} else {
-			LOOP_UNIT_CONTAINER(VISIBLE_TEAM_TEST, BOX_TEST, true);
-		}
+		LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, BOX_TEST, true);
 	}
 	else if (allegiance == MyUnits) {
 		const int readTeam = CLuaHandle::GetHandleReadTeam(L);
 		LOOP_UNIT_CONTAINER(MY_UNIT_TEST, BOX_TEST, true);
 	}
-	else if (allegiance == AllyUnits) {
-		LOOP_UNIT_CONTAINER(ALLY_UNIT_TEST, BOX_TEST, true);
-	}
-	else if (allegiance == EnemyUnits) {
-		LOOP_UNIT_CONTAINER(ENEMY_UNIT_TEST, BOX_TEST, true);
-	}
-	else { // AllUnits
-		LOOP_UNIT_CONTAINER(VISIBLE_TEST, BOX_TEST, true);
+	else { // AllyUnits, EnemyUnits, AllUnits
+		LOOP_UNIT_CONTAINER(NULL_TEST, BOX_TEST, true);
 	}
 
 	return 1;
@@ -2300,28 +2321,18 @@ int LuaSyncedRead::GetUnitsInCylinder(lua_State* L)
 	}                                           \
 
 	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, mins, maxs);
+	quadField.GetUnitsExact(qfQuery, mins, maxs, GetAllegianceFilter(L, allegiance));
 	const auto& units = (*qfQuery.units);
 
 	if (allegiance >= 0) {
-		if (IsAlliedTeam(L, allegiance)) {
-			LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, CYLINDER_TEST, true);
-		} else {
-			LOOP_UNIT_CONTAINER(VISIBLE_TEAM_TEST, CYLINDER_TEST, true);
-		}
+		LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, CYLINDER_TEST, true);
 	}
 	else if (allegiance == MyUnits) {
 		const int readTeam = CLuaHandle::GetHandleReadTeam(L);
 		LOOP_UNIT_CONTAINER(MY_UNIT_TEST, CYLINDER_TEST, true);
 	}
-	else if (allegiance == AllyUnits) {
-		LOOP_UNIT_CONTAINER(ALLY_UNIT_TEST, CYLINDER_TEST, true);
-	}
-	else if (allegiance == EnemyUnits) {
-		LOOP_UNIT_CONTAINER(ENEMY_UNIT_TEST, CYLINDER_TEST, true);
-	}
-	else { // AllUnits
-		LOOP_UNIT_CONTAINER(VISIBLE_TEST, CYLINDER_TEST, true);
+	else { // AllyUnits, EnemyUnits, AllUnits
+		LOOP_UNIT_CONTAINER(NULL_TEST, CYLINDER_TEST, true);
 	}
 
 	return 1;
@@ -2354,28 +2365,18 @@ int LuaSyncedRead::GetUnitsInSphere(lua_State* L)
 	}                                           \
 
 	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, mins, maxs);
+	quadField.GetUnitsExact(qfQuery, mins, maxs, GetAllegianceFilter(L, allegiance));
 	const auto& units = (*qfQuery.units);
 
 	if (allegiance >= 0) {
-		if (IsAlliedTeam(L, allegiance)) {
-			LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, SPHERE_TEST, true);
-		} else {
-			LOOP_UNIT_CONTAINER(VISIBLE_TEAM_TEST, SPHERE_TEST, true);
-		}
+		LOOP_UNIT_CONTAINER(SIMPLE_TEAM_TEST, SPHERE_TEST, true);
 	}
 	else if (allegiance == MyUnits) {
 		const int readTeam = CLuaHandle::GetHandleReadTeam(L);
 		LOOP_UNIT_CONTAINER(MY_UNIT_TEST, SPHERE_TEST, true);
 	}
-	else if (allegiance == AllyUnits) {
-		LOOP_UNIT_CONTAINER(ALLY_UNIT_TEST, SPHERE_TEST, true);
-	}
-	else if (allegiance == EnemyUnits) {
-		LOOP_UNIT_CONTAINER(ENEMY_UNIT_TEST, SPHERE_TEST, true);
-	}
-	else { // AllUnits
-		LOOP_UNIT_CONTAINER(VISIBLE_TEST, SPHERE_TEST, true);
+	else { // AllyUnits, EnemyUnits, AllUnits
+		LOOP_UNIT_CONTAINER(NULL_TEST, SPHERE_TEST, true);
 	}
 
 	return 1;
@@ -2970,25 +2971,33 @@ int LuaSyncedRead::GetUnitNeutral(lua_State* L)
 }
 
 
+// returns the health scale (decoy-adjusted) visible to L, or 0 if damage is hidden
+static float GetUnitHealthScale(lua_State* L, const CUnit* unit)
+{
+	const UnitDef* ud = unit->unitDef;
+	const bool enemyUnit = IsEnemyUnit(L, unit);
+
+	if (ud->hideDamage && enemyUnit)
+		return 0.0f;
+	if (!enemyUnit || (ud->decoyDef == nullptr))
+		return 1.0f;
+
+	return (ud->decoyDef->health / ud->health);
+}
+
 int LuaSyncedRead::GetUnitHealth(lua_State* L)
 {
 	const CUnit* unit = ParseInLosUnit(L, __func__, 1);
 	if (unit == nullptr)
 		return 0;
 
-	const UnitDef* ud = unit->unitDef;
-	const bool enemyUnit = IsEnemyUnit(L, unit);
+	const float scale = GetUnitHealthScale(L, unit);
 
-	if (ud->hideDamage && enemyUnit) {
+	if (scale == 0.0f) {
 		lua_pushnil(L);
 		lua_pushnil(L);
 		lua_pushnil(L);
-	} else if (!enemyUnit || (ud->decoyDef == nullptr)) {
-		lua_pushnumber(L, unit->health);
-		lua_pushnumber(L, unit->maxHealth);
-		lua_pushnumber(L, unit->paralyzeDamage);
 	} else {
-		const float scale = (ud->decoyDef->health / ud->health);
 		lua_pushnumber(L, scale * unit->health);
 		lua_pushnumber(L, scale * unit->maxHealth);
 		lua_pushnumber(L, scale * unit->paralyzeDamage);
@@ -3155,6 +3164,220 @@ int LuaSyncedRead::GetUnitVelocity(lua_State* L)
 }
 
 
+/******************************************************************************/
+//
+//  Bulk Unit Queries
+//
+//  GetUnitArray*(unitIDs | allegiance [, outTable [, ...]]) -> outTable, count [, unitIDs]
+//
+//  Values for the i-th unit are stored at outTable[stride * (i - 1) + k]
+//  (k = 1 .. stride). If unitIDs is a table, entries of units that do not
+//  exist or fail the same visibility test as the matching per-unit getter
+//  are set to nil. Otherwise the argument is parsed as an allegiance like
+//  GetUnitsInRectangle's; only units passing it are stored and their IDs
+//  are returned in a third table. Passing the previous outTable back in
+//  avoids creating a new one per call; entries past the new values are
+//  cleared and outTable.n is set to the number of values stored.
+//
+//  Strides: positions {x, y, z}, velocities {x, y, z, speed},
+//  healths {health, maxHealth, paralyzeDamage, buildProgress}.
+//
+
+static bool IsUnitInAllegiance(lua_State* L, const CUnit* unit, int allegiance)
+{
+	switch (allegiance) {
+		case AllUnits  : { return (IsUnitVisible(L, unit)); } break;
+		case MyUnits   : { return (unit->team == CLuaHandle::GetHandleReadTeam(L)); } break;
+		case AllyUnits : { return (unit->allyteam == CLuaHandle::GetHandleReadAllyTeam(L)); } break;
+		case EnemyUnits: { return (unit->allyteam != CLuaHandle::GetHandleReadAllyTeam(L) && IsUnitVisible(L, unit)); } break;
+		default        : {} break;
+	}
+
+	return (unit->team == allegiance && (IsAlliedTeam(L, allegiance) || IsUnitVisible(L, unit)));
+}
+
+// pushes the caller-supplied out-table (or a new one) and returns the number of values it held
+static int PushArrayTable(lua_State* L, int numValues)
+{
+	if (!lua_istable(L, 2)) {
+		lua_createtable(L, numValues, 1);
+		return 0;
+	}
+
+	lua_pushvalue(L, 2);
+	lua_getfield(L, -1, "n");
+
+	const int prevNumValues = lua_isnumber(L, -1)? lua_toint(L, -1): 0;
+
+	lua_pop(L, 1);
+	return prevNumValues;
+}
+
+// nils whatever a previous call left in the out-table at <tableIdx> past
+// <numValues> and records the new length in its "n" field
+static void TrimArrayTable(lua_State* L, int tableIdx, int prevNumValues, int numValues)
+{
+	for (int i = numValues + 1; ; i++) {
+		lua_rawgeti(L, tableIdx, i);
+
+		const bool isNil = lua_isnil(L, -1);
+
+		lua_pop(L, 1);
+
+		// entries up to the old "n" may be nil holes (invalid units), keep going past those
+		if (isNil && i > prevNumValues)
+			break;
+
+		lua_pushnil(L);
+		lua_rawseti(L, tableIdx, i);
+	}
+
+	lua_pushnumber(L, numValues);
+	lua_setfield(L, tableIdx, "n");
+}
+
+template<typename UnitTest, typename StoreValues>
+static int GetUnitArrayValues(lua_State* L, const char* caller, int stride, UnitTest&& unitTest, StoreValues&& storeValues)
+{
+	if (lua_istable(L, 1)) {
+		const int numUnits = lua_objlen(L, 1);
+		const int prevNumValues = PushArrayTable(L, numUnits * stride);
+		const int outTableIdx = lua_gettop(L);
+
+		int numValid = 0;
+
+		for (int i = 0; i < numUnits; i++) {
+			lua_rawgeti(L, 1, i + 1);
+
+			const CUnit* unit = nullptr;
+
+			if (lua_isnumber(L, -1))
+				unit = unitHandler.GetUnit(lua_toint(L, -1));
+			if (unit != nullptr && !unitTest(unit))
+				unit = nullptr;
+
+			lua_pop(L, 1);
+
+			if (unit == nullptr) {
+				for (int k = 1; k <= stride; k++) {
+					lua_pushnil(L);
+					lua_rawseti(L, -2, i * stride + k);
+				}
+				continue;
+			}
+
+			storeValues(unit, i * stride);
+			numValid++;
+		}
+
+		TrimArrayTable(L, outTableIdx, prevNumValues, numUnits * stride);
+
+		lua_pushnumber(L, numValid);
+		return 2;
+	}
+
+	const int allegiance = ParseAllegiance(L, caller, 1);
+	const auto& units = (allegiance >= 0)? unitHandler.GetUnitsByTeam(allegiance): unitHandler.GetActiveUnits();
+
+	const int prevNumValues = PushArrayTable(L, units.size() * stride);
+	const int outTableIdx = lua_gettop(L);
+
+	int numValid = 0;
+
+	lua_createtable(L, units.size(), 0);
+
+	for (const CUnit* unit: units) {
+		if (!IsUnitInAllegiance(L, unit, allegiance))
+			continue;
+		if (!unitTest(unit))
+			continue;
+
+		lua_pushnumber(L, unit->id);
+		lua_rawseti(L, -2, numValid + 1);
+
+		// values go into the out-table below the ID-table
+		lua_pushvalue(L, -2);
+		storeValues(unit, numValid * stride);
+		lua_pop(L, 1);
+
+		numValid++;
+	}
+
+	TrimArrayTable(L, outTableIdx, prevNumValues, numValid * stride);
+
+	lua_pushnumber(L, numValid);
+	lua_insert(L, -2);
+	return 3;
+}
+
+static inline void SetArrayValue(lua_State* L, int index, float value)
+{
+	lua_pushnumber(L, value);
+	lua_rawseti(L, -2, index);
+}
+
+
+int LuaSyncedRead::GetUnitArrayPositions(lua_State* L)
+{
+	const bool returnMidPos = luaL_optboolean(L, 3, false);
+	const int readAllyTeam = CLuaHandle::GetHandleReadAllyTeam(L);
+	const bool fullRead = CLuaHandle::GetHandleFullRead(L);
+
+	const auto unitTest = [&](const CUnit* unit) { return (IsUnitVisible(L, unit)); };
+	const auto storeValues = [&](const CUnit* unit, int i) {
+		float3 errorVec;
+
+		// same error as GetUnitPosition
+		if (!IsAllyUnit(L, unit))
+			errorVec = unit->GetLuaErrorVector(readAllyTeam, fullRead);
+
+		const float3 pos = (returnMidPos? float3(unit->midPos): float3(unit->pos)) + errorVec;
+
+		SetArrayValue(L, i + 1, pos.x);
+		SetArrayValue(L, i + 2, pos.y);
+		SetArrayValue(L, i + 3, pos.z);
+	};
+
+	return (GetUnitArrayValues(L, __func__, 3, unitTest, storeValues));
+}
+
+int LuaSyncedRead::GetUnitArrayVelocities(lua_State* L)
+{
+	const auto unitTest = [&](const CUnit* unit) { return (::IsUnitInLos(L, unit)); };
+	const auto storeValues = [&](const CUnit* unit, int i) {
+		SetArrayValue(L, i + 1, unit->speed.x);
+		SetArrayValue(L, i + 2, unit->speed.y);
+		SetArrayValue(L, i + 3, unit->speed.z);
+		SetArrayValue(L, i + 4, unit->speed.w);
+	};
+
+	return (GetUnitArrayValues(L, __func__, 4, unitTest, storeValues));
+}
+
+int LuaSyncedRead::GetUnitArrayHealths(lua_State* L)
+{
+	// units with hidden damage pass the LOS test but get nil health values, like GetUnitHealth
+	const auto unitTest = [&](const CUnit* unit) { return (::IsUnitInLos(L, unit)); };
+	const auto storeValues = [&](const CUnit* unit, int i) {
+		const float scale = GetUnitHealthScale(L, unit);
+
+		if (scale == 0.0f) {
+			lua_pushnil(L); lua_rawseti(L, -2, i + 1);
+			lua_pushnil(L); lua_rawseti(L, -2, i + 2);
+			lua_pushnil(L); lua_rawseti(L, -2, i + 3);
+		} else {
+			SetArrayValue(L, i + 1, scale * unit->health);
+			SetArrayValue(L, i + 2, scale * unit->maxHealth);
+			SetArrayValue(L, i + 3, scale * unit->paralyzeDamage);
+		}
+
+		SetArrayValue(L, i + 4, unit->buildProgress);
+	};
+
+	return (GetUnitArrayValues(L, __func__, 4, unitTest, storeValues));
+}
+
+
 int LuaSyncedRead::GetUnitBuildFacing(lua_State* L)
 {
 	const CUnit* unit = ParseInLosUnit(L, __func__, 1);
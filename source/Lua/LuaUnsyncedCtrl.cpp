@@ -3038,6 +3038,8 @@ int LuaUnsyncedCtrl::GarbageCollectCtrl(lua_State* L) {
 	gcCtrl.baseRunTimeMult = std::max(0.0f, luaL_optfloat(L, 7, gcCtrl.baseRunTimeMult));
 	gcCtrl.baseMemLoadMult = std::max(0.0f, luaL_optfloat(L, 8, gcCtrl.baseMemLoadMult));
 
+	gcCtrl.adaptive = luaL_optboolean(L, 9, gcCtrl.adaptive);
+
 	return 0;
 }
 
@@ -302,6 +302,254 @@ int LuaUtils::Restore(const std::vector<LuaUtils::DataDump>& backup, lua_State*
 }
 
 
+/******************************************************************************/
+
+// a table is serialized as its header, its key-value pairs and an END tag
+enum {
+	BLOB_TAG_END   = 0,
+	BLOB_TAG_FALSE = 1,
+	BLOB_TAG_TRUE  = 2,
+	BLOB_TAG_NUM   = 3,
+	BLOB_TAG_STR   = 4,
+	BLOB_TAG_TABLE = 5, // followed by the array- and hash-part sizes
+	BLOB_TAG_REF   = 6, // followed by the index of an earlier table
+};
+
+// far deeper than any sane data table, far from the C stack limit
+static const int maxBlobDepth = 256;
+
+class BlobReader {
+public:
+	BlobReader(const std::uint8_t* data, size_t size): pos(data), end(data + size) {}
+
+	template<typename T> bool Read(T& value) {
+		if (size_t(end - pos) < sizeof(T))
+			return false;
+
+		memcpy(&value, pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	bool ReadString(const char*& str, std::uint32_t& len) {
+		if (!Read(len) || size_t(end - pos) < len)
+			return false;
+
+		str = reinterpret_cast<const char*>(pos);
+		pos += len;
+		return true;
+	}
+
+	bool AtEnd() const { return (pos == end); }
+
+private:
+	const std::uint8_t* pos;
+	const std::uint8_t* end;
+};
+
+template<typename T> static void AppendBlob(std::vector<std::uint8_t>& blob, T value) {
+	const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+	blob.insert(blob.end(), bytes, bytes + sizeof(T));
+}
+
+
+static bool SerializeBlobTable(std::vector<std::uint8_t>& blob, lua_State* src, int table, int depth, spring::unsynced_map<const void*, std::uint32_t>& tableIndices);
+static bool SerializeBlobData(std::vector<std::uint8_t>& blob, lua_State* src, int index, int depth, spring::unsynced_map<const void*, std::uint32_t>& tableIndices)
+{
+	switch (lua_type(src, index)) {
+		case LUA_TBOOLEAN: {
+			AppendBlob<std::uint8_t>(blob, lua_toboolean(src, index)? BLOB_TAG_TRUE: BLOB_TAG_FALSE);
+		} break;
+
+		case LUA_TNUMBER: {
+			AppendBlob<std::uint8_t>(blob, BLOB_TAG_NUM);
+			AppendBlob<lua_Number>(blob, lua_tonumber(src, index));
+		} break;
+
+		case LUA_TSTRING: {
+			size_t len = 0;
+			const char* str = lua_tolstring(src, index, &len);
+
+			AppendBlob<std::uint8_t>(blob, BLOB_TAG_STR);
+			AppendBlob<std::uint32_t>(blob, len);
+			blob.insert(blob.end(), str, str + len);
+		} break;
+
+		case LUA_TTABLE: {
+			return (SerializeBlobTable(blob, src, PosAbsLuaIndex(src, index), depth, tableIndices));
+		} break;
+
+		default: {
+			// functions, userdata, etc. can not be stored
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool SerializeBlobTable(std::vector<std::uint8_t>& blob, lua_State* src, int table, int depth, spring::unsynced_map<const void*, std::uint32_t>& tableIndices)
+{
+	const void* p = lua_topointer(src, table);
+	const auto it = tableIndices.find(p);
+
+	// shared (and recursive) tables are stored once
+	if (it != tableIndices.end()) {
+		AppendBlob<std::uint8_t>(blob, BLOB_TAG_REF);
+		AppendBlob<std::uint32_t>(blob, it->second);
+		return true;
+	}
+
+	if (depth++ > maxBlobDepth || !lua_checkstack(src, 3))
+		return false;
+
+	const std::uint32_t tableIndex = tableIndices.size();
+	const std::uint32_t arraySize = lua_objlen(src, table);
+	const size_t headerPos = blob.size();
+
+	std::uint32_t numEntries = 0;
+
+	tableIndices[p] = tableIndex;
+
+	// the sizes let the table be recreated with the same array-part, '#' depends on it
+	AppendBlob<std::uint8_t>(blob, BLOB_TAG_TABLE);
+	AppendBlob<std::uint32_t>(blob, arraySize);
+	AppendBlob<std::uint32_t>(blob, 0);
+
+	for (lua_pushnil(src); lua_next(src, table) != 0; lua_pop(src, 1)) {
+		if (!SerializeBlobData(blob, src, -2, depth, tableIndices))
+			return false;
+		if (!SerializeBlobData(blob, src, -1, depth, tableIndices))
+			return false;
+
+		numEntries += 1;
+	}
+
+	AppendBlob<std::uint8_t>(blob, BLOB_TAG_END);
+
+	const std::uint32_t hashSize = numEntries - std::min(numEntries, arraySize);
+	memcpy(&blob[headerPos + 1 + sizeof(arraySize)], &hashSize, sizeof(hashSize));
+	return true;
+}
+
+
+static bool DeserializeBlobData(lua_State* dst, BlobReader& reader, std::uint8_t tag, int depth, int tablesIndex, std::uint32_t& numTables)
+{
+	switch (tag) {
+		case BLOB_TAG_FALSE: {
+			lua_pushboolean(dst, false);
+		} break;
+		case BLOB_TAG_TRUE: {
+			lua_pushboolean(dst, true);
+		} break;
+
+		case BLOB_TAG_NUM: {
+			lua_Number num = 0;
+
+			if (!reader.Read(num))
+				return false;
+
+			lua_pushnumber(dst, num);
+		} break;
+
+		case BLOB_TAG_STR: {
+			const char* str = nullptr;
+			std::uint32_t len = 0;
+
+			if (!reader.ReadString(str, len))
+				return false;
+
+			lua_pushlstring(dst, str, len);
+		} break;
+
+		case BLOB_TAG_REF: {
+			std::uint32_t tableIndex = 0;
+
+			if (!reader.Read(tableIndex) || tableIndex >= numTables)
+				return false;
+
+			lua_rawgeti(dst, tablesIndex, tableIndex + 1);
+		} break;
+
+		case BLOB_TAG_TABLE: {
+			std::uint32_t arraySize = 0;
+			std::uint32_t hashSize = 0;
+
+			if (!reader.Read(arraySize) || !reader.Read(hashSize))
+				return false;
+			if (depth++ > maxBlobDepth || !lua_checkstack(dst, 4))
+				return false;
+
+			lua_createtable(dst, arraySize, hashSize);
+			lua_pushvalue(dst, -1);
+			lua_rawseti(dst, tablesIndex, ++numTables);
+
+			for (std::uint8_t keyTag = BLOB_TAG_END, valTag = BLOB_TAG_END; reader.Read(keyTag); ) {
+				if (keyTag == BLOB_TAG_END)
+					return true;
+
+				if (!DeserializeBlobData(dst, reader, keyTag, depth, tablesIndex, numTables))
+					return false;
+				// NaN keys would raise a Lua error
+				if (lua_isnumber(dst, -1) && lua_tonumber(dst, -1) != lua_tonumber(dst, -1))
+					return false;
+
+				if (!reader.Read(valTag) || !DeserializeBlobData(dst, reader, valTag, depth, tablesIndex, numTables))
+					return false;
+
+				lua_rawset(dst, -3);
+			}
+
+			// blob ended without closing the table
+			return false;
+		} break;
+
+		default: {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+bool LuaUtils::SerializeTable(std::vector<std::uint8_t>& blob, lua_State* src, int index)
+{
+	spring::unsynced_map<const void*, std::uint32_t> tableIndices;
+
+	const int srcTop = lua_gettop(src);
+	const size_t blobSize = blob.size();
+
+	if (lua_istable(src, index) && SerializeBlobTable(blob, src, PosAbsLuaIndex(src, index), 0, tableIndices))
+		return true;
+
+	lua_settop(src, srcTop);
+	blob.resize(blobSize);
+	return false;
+}
+
+bool LuaUtils::DeserializeTable(lua_State* dst, const std::uint8_t* data, size_t size)
+{
+	BlobReader reader(data, size);
+
+	const int dstTop = lua_gettop(dst);
+
+	std::uint32_t numTables = 0;
+	std::uint8_t tag = BLOB_TAG_END;
+
+	// maps (1-based) table indices to the tables recreated so far, for refs
+	lua_newtable(dst);
+
+	if (reader.Read(tag) && tag == BLOB_TAG_TABLE && DeserializeBlobData(dst, reader, tag, 0, dstTop + 1, numTables) && reader.AtEnd()) {
+		lua_remove(dst, dstTop + 1);
+		return true;
+	}
+
+	lua_settop(dst, dstTop);
+	return false;
+}
+
+
 /******************************************************************************/
 /******************************************************************************/
 
@@ -3,6 +3,7 @@
 #ifndef LUA_UTILS_H
 #define LUA_UTILS_H
 
+#include <cinttypes>
 #include <string>
 #include <vector>
 
@@ -72,6 +73,12 @@ class LuaUtils {
 		static int Backup(std::vector<DataDump> &backup, lua_State* src, int count);
 		static int Restore(const std::vector<DataDump> &backup, lua_State* dst);
 
+		// Serializes the table at <index> (which may only hold booleans, numbers,
+		// strings and tables) into a binary blob, and pushes a copy rebuilt from
+		// one; shared and recursive tables keep their identity
+		static bool SerializeTable(std::vector<std::uint8_t>& blob, lua_State* src, int index);
+		static bool DeserializeTable(lua_State* dst, const std::uint8_t* data, size_t size);
+
 		// Copies lua data between 2 lua_States
 		static int CopyData(lua_State* dst, lua_State* src, int count);
 
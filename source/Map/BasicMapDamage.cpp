@@ -52,6 +52,11 @@ void CBasicMapDamage::Init()
 	explosionUpdateQueue.clear();
 	explosionUpdateQueue.reserve(64);
 
+	deltaRows.clear();
+	deltaRows.resize(mapDims.mapyp1);
+	deltaRowsMin = mapDims.mapyp1;
+	deltaRowsMax = -1;
+
 	std::fill(explosionSquaresPool.begin(), explosionSquaresPool.end(), 0.0f);
 }
 
@@ -215,58 +220,142 @@ void CBasicMapDamage::Explosion(const float3& pos, float strength, float radius)
 void CBasicMapDamage::RecalcArea(int x1, int x2, int y1, int y2)
 {
 	readMap->UpdateHeightMapSynced(SRectangle(x1, y1, x2, y2));
-	featureHandler.TerrainChanged(x1, y1, x2, y2);
+	TerrainChanged(SRectangle(x1, y1, x2, y2));
+}
+
+void CBasicMapDamage::TerrainChanged(const SRectangle& rect)
+{
+	// derived heightmaps must already be up-to-date, path layers read the slopemap
+	featureHandler.TerrainChanged(rect.x1, rect.z1, rect.x2, rect.z2);
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Los");
-		losHandler->UpdateHeightMapSynced(SRectangle(x1, y1, x2, y2));
+		losHandler->UpdateHeightMapSynced(rect);
 	}
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Path");
-		pathManager->TerrainChange(x1, y1, x2, y2, TERRAINCHANGE_DAMAGE_RECALCULATION);
+		pathManager->TerrainChange(rect.x1, rect.z1, rect.x2, rect.z2, TERRAINCHANGE_DAMAGE_RECALCULATION);
 	}
 }
 
 
+void CBasicMapDamage::AddDeltaSpan(int z, int x1, int x2)
+{
+	DeltaRow& row = deltaRows[z];
+
+	row.x1 = std::min(row.x1, x1);
+	row.x2 = std::max(row.x2, x2);
+
+	deltaRowsMin = std::min(deltaRowsMin, z);
+	deltaRowsMax = std::max(deltaRowsMax, z);
+}
+
 void CBasicMapDamage::Update()
 {
 	SCOPED_TIMER("Sim::BasicMapDamage");
 
+	// gather the span of corners each row receives deltas for; buildings can stick out of their crater
 	for (unsigned int i = explUpdateQueueIdx, n = explosionUpdateQueue.size(); i < n; i++) {
-		Explo& e = explosionUpdateQueue[i];
+		const Explo& e = explosionUpdateQueue[i];
 
-		if ((e.ttl--) <= 0)
+		if (e.ttl <= 0)
 			continue;
 
-
-		unsigned int expSquarePoolIdx = e.idx;
-
 		for (int y = e.y1; y <= e.y2; ++y) {
-			for (int x = e.x1; x <= e.x2; ++x) {
-				readMap->AddHeight(y * mapDims.mapxp1 + x, explosionSquaresPool[ (expSquarePoolIdx++) % explosionSquaresPool.size() ]);
+			AddDeltaSpan(y, e.x1, e.x2);
+		}
+
+		for (const ExploBuilding& b: e.buildings) {
+			for (int z = b.tz1; z < b.tz2; z++) {
+				AddDeltaSpan(z, b.tx1, b.tx2 - 1);
 			}
 		}
+	}
 
+	if (deltaRowsMin <= deltaRowsMax) {
+		size_t numDeltas = 0;
 
-		for (const ExploBuilding& b: e.buildings) {
-			CUnit* unit = unitHandler.GetUnit(b.id);
+		for (int z = deltaRowsMin; z <= deltaRowsMax; z++) {
+			DeltaRow& row = deltaRows[z];
 
-			if (unit == nullptr)
+			if (row.x1 > row.x2)
 				continue;
 
-			// only change ground level if building is still here
-			for (int z = b.tz1; z < b.tz2; z++) {
-				for (int x = b.tx1; x < b.tx2; x++) {
-					readMap->AddHeight(z * mapDims.mapxp1 + x, b.dif);
+			row.offset = numDeltas - row.x1;
+			numDeltas += (row.x2 - row.x1 + 1);
+		}
+
+		heightDeltas.clear();
+		heightDeltas.resize(numDeltas, 0.0f);
+
+		for (unsigned int i = explUpdateQueueIdx, n = explosionUpdateQueue.size(); i < n; i++) {
+			Explo& e = explosionUpdateQueue[i];
+
+			if ((e.ttl--) <= 0)
+				continue;
+
+
+			unsigned int expSquarePoolIdx = e.idx;
+
+			for (int y = e.y1; y <= e.y2; ++y) {
+				const size_t offset = deltaRows[y].offset;
+
+				for (int x = e.x1; x <= e.x2; ++x) {
+					heightDeltas[offset + x] += explosionSquaresPool[ (expSquarePoolIdx++) % explosionSquaresPool.size() ];
+				}
+			}
+
+
+			for (const ExploBuilding& b: e.buildings) {
+				CUnit* unit = unitHandler.GetUnit(b.id);
+
+				if (unit == nullptr)
+					continue;
+
+				// only change ground level if building is still here
+				for (int z = b.tz1; z < b.tz2; z++) {
+					const size_t offset = deltaRows[z].offset;
+
+					for (int x = b.tx1; x < b.tx2; x++) {
+						heightDeltas[offset + x] += b.dif;
+					}
 				}
+
+				unit->Move(UpVector * b.dif, true);
 			}
 
-			unit->Move(UpVector * b.dif, true);
+			if (e.ttl != 0)
+				continue;
+
+			recalcAreas.emplace_back(e.x1 - 1, e.y1 - 1, e.x2 + 1, e.y2 + 1);
 		}
 
-		if (e.ttl != 0)
-			continue;
+		for (int z = deltaRowsMin; z <= deltaRowsMax; z++) {
+			DeltaRow& row = deltaRows[z];
+
+			if (row.x1 > row.x2)
+				continue;
+
+			readMap->AddHeights(SRectangle(row.x1, z, row.x2, z), &heightDeltas[row.offset + row.x1]);
+			row = {};
+		}
+
+		deltaRowsMin = mapDims.mapyp1;
+		deltaRowsMax = -1;
+	}
+
+	// craters finishing this frame often overlap; recalculate their union once
+	if (!recalcAreas.empty()) {
+		for (const SRectangle& rect: recalcAreas) {
+			readMap->QueueHeightMapUpdate(rect);
+		}
+
+		readMap->FlushHeightMapUpdates();
+
+		for (const SRectangle& rect: recalcAreas) {
+			TerrainChanged(rect);
+		}
 
-		RecalcArea(e.x1 - 1, e.x2 + 1, e.y1 - 1, e.y2 + 1);
+		recalcAreas.clear();
 	}
 
 
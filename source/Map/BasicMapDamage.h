@@ -4,7 +4,9 @@
 #define _BASIC_MAP_DAMAGE_H
 
 #include "MapDamage.h"
+#include "System/Rectangle.h"
 
+#include <limits>
 #include <vector>
 
 class CBasicMapDamage : public IMapDamage
@@ -21,6 +23,9 @@ public:
 	bool Disabled() const override { return false; }
 
 private:
+	void TerrainChanged(const SRectangle& rect);
+	void AddDeltaSpan(int z, int x1, int x2);
+
 	void SetExplosionSquare(float v) {
 		explosionSquaresPool[explSquaresPoolIdx] = v;
 
@@ -58,8 +63,20 @@ private:
 		std::vector<ExploBuilding> buildings;
 	};
 
+	struct DeltaRow {
+		// inclusive span of corners touched this frame; offset is relative to x=0
+		int x1 = std::numeric_limits<int>::max();
+		int x2 = -1;
+
+		size_t offset = 0;
+	};
+
 	std::vector<float> explosionSquaresPool;
 	std::vector<Explo> explosionUpdateQueue;
+	std::vector<SRectangle> recalcAreas;
+	// per-frame sum of all crater and building height changes, packed row by row
+	std::vector<float> heightDeltas;
+	std::vector<DeltaRow> deltaRows;
 
 	static constexpr unsigned int CRATER_TABLE_SIZE = 200;
 	static constexpr unsigned int EXPLOSION_LIFETIME = 10;
@@ -67,6 +84,9 @@ private:
 	unsigned int explSquaresPoolIdx = 0;
 	unsigned int explUpdateQueueIdx = 0;
 
+	int deltaRowsMin = 0;
+	int deltaRowsMax = -1;
+
 	float craterTable[CRATER_TABLE_SIZE + 1];
 	float rawHardness[/*CMapInfo::NUM_TERRAIN_TYPES*/ 256];
 	float invHardness[/*CMapInfo::NUM_TERRAIN_TYPES*/ 256];
@@ -11,6 +11,7 @@
 #include "Rendering/Env/MapRendering.h"
 #include "SMF/SMFReadMap.h"
 #include "Game/LoadScreen.h"
+#include "Sim/Misc/SmoothHeightMesh.h"
 #include "System/bitops.h"
 #include "System/EventHandler.h"
 #include "System/Exceptions.h"
@@ -31,6 +32,27 @@
 
 #define MAX_UHM_RECTS_PER_FRAME static_cast<size_t>(128)
 
+// rectangles smaller than this (in squares) are updated on the calling thread,
+// a single crater is cheaper to process inline than to hand to the pool
+#define MIN_PARALLEL_UPDATE_AREA 4096
+
+
+template<typename F>
+static void ForEachRow(int z1, int z2, int width, F&& f)
+{
+	if (((z2 - z1) * width) < MIN_PARALLEL_UPDATE_AREA) {
+		for (int z = z1; z < z2; z++) {
+			f(z);
+		}
+
+		return;
+	}
+
+	// each chunk covers whole rows, so workers stream contiguous memory; make
+	// narrow rectangles take several rows per chunk s.t. it is worth a task
+	parallel_for(z1, z2, std::max(ThreadPool::GetDefaultGrainSize(z2 - z1), (MIN_PARALLEL_UPDATE_AREA / 4) / width), f);
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -88,6 +110,7 @@ CR_REG_METADATA(CReadMap, (
 	CR_IGNORED(sharedCenterNormals),
 	CR_IGNORED(sharedSlopeMaps),
 
+	CR_IGNORED(syncedHeightMapUpdates),
 	CR_IGNORED(unsyncedHeightMapUpdates),
 	CR_IGNORED(unsyncedHeightMapUpdatesTemp),
 
@@ -485,6 +508,40 @@ void CReadMap::UpdateDraw(bool firstCall)
 
 
 void CReadMap::UpdateHeightMapSynced(SRectangle hmRect, bool initialize)
+{
+	QueueHeightMapUpdate(hmRect);
+	FlushHeightMapUpdates(initialize);
+}
+
+void CReadMap::AddHeights(const SRectangle& rect, const float* deltas)
+{
+	float* heightMap = heightMapSyncedPtr->data();
+
+	const int numCols = rect.x2 - rect.x1 + 1;
+
+	float minHeight = currHeightBounds.x;
+	float maxHeight = currHeightBounds.y;
+
+	for (int z = rect.z1; z <= rect.z2; z++) {
+		float* heights = &heightMap[z * mapDims.mapxp1 + rect.x1];
+		const float* rowDeltas = &deltas[(z - rect.z1) * numCols];
+
+		for (int x = 0; x < numCols; x++) {
+			heights[x] += rowDeltas[x];
+		}
+
+		// untouched corners are already within bounds
+		for (int x = 0; x < numCols; x++) {
+			minHeight = std::min(minHeight, heights[x]);
+			maxHeight = std::max(maxHeight, heights[x]);
+		}
+	}
+
+	currHeightBounds.x = minHeight;
+	currHeightBounds.y = maxHeight;
+}
+
+void CReadMap::QueueHeightMapUpdate(SRectangle hmRect)
 {
 	// do not bother with zero-area updates
 	if (hmRect.GetArea() <= 0)
@@ -495,11 +552,45 @@ void CReadMap::UpdateHeightMapSynced(SRectangle hmRect, bool initialize)
 	hmRect.x2 = std::min(mapDims.mapxm1, hmRect.x2 + 1);
 	hmRect.z2 = std::min(mapDims.mapym1, hmRect.z2 + 1);
 
-	UpdateCenterHeightmap(hmRect, initialize);
-	UpdateMipHeightmaps(hmRect, initialize);
-	UpdateFaceNormals(hmRect, initialize);
-	UpdateSlopemap(hmRect, initialize); // must happen after UpdateFaceNormals()!
+	syncedHeightMapUpdates.push_back(hmRect);
+}
+
+void CReadMap::FlushHeightMapUpdates(bool initialize)
+{
+	if (syncedHeightMapUpdates.empty())
+		return;
+
+	// merge and split overlapping rectangles; every derived value is a pure
+	// function of the corner heightmap, so processing the union once gives
+	// the same maps as processing each rectangle right after its change
+	if (syncedHeightMapUpdates.size() > 1)
+		syncedHeightMapUpdates.Process();
 
+	// stage-major so no stage reads inputs another rectangle has yet to update
+	for (const SRectangle& hmRect: syncedHeightMapUpdates) {
+		UpdateCenterHeightmap(hmRect, initialize);
+	}
+	for (const SRectangle& hmRect: syncedHeightMapUpdates) {
+		UpdateMipHeightmaps(hmRect, initialize);
+	}
+	for (const SRectangle& hmRect: syncedHeightMapUpdates) {
+		UpdateFaceNormals(hmRect, initialize);
+	}
+	for (const SRectangle& hmRect: syncedHeightMapUpdates) {
+		UpdateSlopemap(hmRect, initialize); // must happen after UpdateFaceNormals()!
+	}
+	for (const SRectangle& hmRect: syncedHeightMapUpdates) {
+		PushHeightMapUpdateUnsynced(hmRect, initialize);
+	}
+	for (const SRectangle& hmRect: syncedHeightMapUpdates) {
+		smoothGround.MapChanged(hmRect);
+	}
+
+	syncedHeightMapUpdates.clear();
+}
+
+void CReadMap::PushHeightMapUpdateUnsynced(const SRectangle& hmRect, bool initialize)
+{
 	#ifdef USE_UNSYNCED_HEIGHTMAP
 	// push the unsynced update; initial one without LOS check
 	if (initialize) {
@@ -534,7 +625,7 @@ void CReadMap::UpdateCenterHeightmap(const SRectangle& rect, bool initialize)
 {
 	const float* heightmapSynced = GetCornerHeightMapSynced();
 
-	for (int y = rect.z1; y <= rect.z2; y++) {
+	ForEachRow(rect.z1, rect.z2 + 1, rect.x2 + 1 - rect.x1, [&](const int y) {
 		for (int x = rect.x1; x <= rect.x2; x++) {
 			const int idxTL = (y    ) * mapDims.mapxp1 + x;
 			const int idxTR = (y    ) * mapDims.mapxp1 + x + 1;
@@ -548,7 +639,7 @@ void CReadMap::UpdateCenterHeightmap(const SRectangle& rect, bool initialize)
 				heightmapSynced[idxBR];
 			centerHeightMap[y * mapDims.mapx + x] = height * 0.25f;
 		}
-	}
+	});
 }
 
 
@@ -564,7 +655,10 @@ void CReadMap::UpdateMipHeightmaps(const SRectangle& rect, bool initialize)
 		float* topMipMap = mipPointerHeightMaps[i];
 		float* subMipMap = mipPointerHeightMaps[i + 1];
 
-		for (int y = sy; y < ey; y += 2) {
+		// iterate over rows of the sub-level; levels depend on each other and stay serial
+		ForEachRow(0, (ey - sy + 1) / 2, (ex - sx) * 2, [&](const int row) {
+			const int y = sy + row * 2;
+
 			for (int x = sx; x < ex; x += 2) {
 				const float height =
 					topMipMap[(x    ) + (y    ) * hmapx] +
@@ -573,7 +667,7 @@ void CReadMap::UpdateMipHeightmaps(const SRectangle& rect, bool initialize)
 					topMipMap[(x + 1) + (y + 1) * hmapx];
 				subMipMap[(x / 2) + (y / 2) * hmapx / 2] = height * 0.25f;
 			}
-		}
+		});
 	}
 }
 
@@ -587,7 +681,7 @@ void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
 	const int z2 = std::min(mapDims.mapym1, rect.z2 + 1);
 	const int x2 = std::min(mapDims.mapxm1, rect.x2 + 1);
 
-	for_mt(z1, z2+1, [&](const int y) {
+	ForEachRow(z1, z2 + 1, x2 + 1 - x1, [&](const int y) {
 		float3 fnTL;
 		float3 fnBR;
 
@@ -655,7 +749,8 @@ void CReadMap::UpdateSlopemap(const SRectangle& rect, bool initialize)
 	const int sy = std::max(0,                 (rect.z1 / 2) - 1);
 	const int ey = std::min(mapDims.hmapy - 1, (rect.z2 / 2) + 1);
 
-	for (int y = sy; y <= ey; y++) {
+	// slope squares cover 2x2 heightmap squares, weigh the row width accordingly
+	ForEachRow(sy, ey + 1, (ex + 1 - sx) * 4, [&](const int y) {
 		for (int x = sx; x <= ex; x++) {
 			const int idx0 = (y*2    ) * (mapDims.mapx) + x*2;
 			const int idx1 = (y*2 + 1) * (mapDims.mapx) + x*2;
@@ -686,7 +781,7 @@ void CReadMap::UpdateSlopemap(const SRectangle& rect, bool initialize)
 
 			slopeMap[y * mapDims.hmapx + x] = 1.0f - slope;
 		}
-	}
+	});
 }
 
 
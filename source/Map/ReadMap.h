@@ -95,6 +95,14 @@ public:
 	 * such as normals, centerheightmap and slopemap
 	 */
 	void UpdateHeightMapSynced(SRectangle hmRect, bool initialize = false);
+	/**
+	 * like UpdateHeightMapSynced, but only records the change; overlapping
+	 * rectangles are merged and the derived maps recalculated once by the
+	 * next FlushHeightMapUpdates, which must happen before anything reads
+	 * them
+	 */
+	void QueueHeightMapUpdate(SRectangle hmRect);
+	void FlushHeightMapUpdates(bool initialize = false);
 	void UpdateLOS(const SRectangle& hmRect);
 	void BecomeSpectator();
 	void UpdateDraw(bool firstCall);
@@ -186,6 +194,8 @@ public:
 	/// if you modify the heightmap through these, call UpdateHeightMapSynced
 	float SetHeight(const int idx, const float h, const int add = 0);
 	float AddHeight(const int idx, const float a);
+	/// adds a row-major block of deltas (one per corner in <rect>, inclusive) in a single pass
+	void AddHeights(const SRectangle& rect, const float* deltas);
 
 
 	float GetInitMinHeight() const { return initHeightBounds.x; }
@@ -207,6 +217,7 @@ public:
 	unsigned int CalcTypemapChecksum();
 
 private:
+	void PushHeightMapUpdateUnsynced(const SRectangle& hmRect, bool initialize);
 	void UpdateCenterHeightmap(const SRectangle& rect, bool initialize);
 	void UpdateMipHeightmaps(const SRectangle& rect, bool initialize);
 	void UpdateFaceNormals(const SRectangle& rect, bool initialize);
@@ -250,6 +261,7 @@ protected:
 	static std::vector<float3> centerNormals2D;
 
 
+	CRectangleOverlapHandler syncedHeightMapUpdates;
 	CRectangleOverlapHandler unsyncedHeightMapUpdates;
 	CRectangleOverlapHandler unsyncedHeightMapUpdatesTemp;
 
@@ -401,7 +401,7 @@ void CSMFReadMap::UpdateVertexNormalsUnsynced(const SRectangle& update)
 	const int maxx = std::min(update.x2 + 1, W - 1);
 	const int maxz = std::min(update.y2 + 1, H - 1);
 
-	for_mt(minz, maxz+1, [&](const int z) {
+	parallel_for(minz, maxz + 1, [&](const int z) {
 		for (int x = minx; x <= maxx; x++) {
 			const int vIdxTL = (z    ) * W + x;
 
@@ -567,7 +567,7 @@ void CSMFReadMap::UpdateShadingTexture(const SRectangle& update)
 		shadingPixels.clear();
 		shadingPixels.resize(xsize * ysize * 4, 0.0f);
 
-		for_mt(0, ysize, [&](const int y) {
+		parallel_for(0, ysize, [&](const int y) {
 			const int idx1 = (y + y1) * mapDims.mapx + x1;
 			const int idx2 = (y + y1) * mapDims.mapx + x2;
 			UpdateShadingTexPart(idx1, idx2, &shadingPixels[y * xsize * 4]);
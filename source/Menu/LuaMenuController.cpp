@@ -89,7 +89,8 @@ bool CLuaMenuController::Draw()
 	// we should not become the active controller unless this holds (see ::Activate)
 	assert(luaMenu != nullptr);
 
-	eventHandler.CollectGarbage();
+	// no sim-frame to measure slack against, allow about a millisecond per draw
+	eventHandler.CollectGarbage(1.0f);
 	infoConsole->PushNewLinesToEventHandler();
 	mouse->Update();
 	mouse->UpdateCursors();
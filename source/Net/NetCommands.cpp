@@ -23,6 +23,7 @@
 #include "Lua/LuaHandle.h"
 #include "Net/Protocol/NetProtocol.h"
 #include "Rendering/GlobalRendering.h"
+#include "Rendering/UnitDrawer.h"
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Path/IPathManager.h"
@@ -954,6 +955,8 @@ void CGame::ClientReadNet()
 					unpack >> data;
 
 					CLuaHandle::HandleLuaMsg(playerNum, script, mode, data);
+					// synced handlers may have moved units between sim frames
+					unitDrawer->SetDrawStatesDirty();
 					AddTraffic(playerNum, packetCode, dataLength);
 				} catch (const netcode::UnpackPacketException& ex) {
 					LOG_L(L_ERROR, "[Game::%s][NETMSG_LUAMSG] exception \"%s\"", __func__, ex.what());
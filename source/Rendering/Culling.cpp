@@ -0,0 +1,110 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cassert>
+
+#include "Culling.h"
+#include "Game/Camera.h"
+#include "System/Threading/ThreadPool.h"
+
+// spheres per worker task; large enough to amortize claiming a chunk
+static constexpr size_t CULL_CHUNK_SIZE = 1024;
+
+
+Culling::Frustum::Frustum(const CCamera* cam)
+{
+	const float4& scales = cam->GetFrustumScales();
+
+	const float3 normals[NUM_PLANES] = {
+		cam->GetFrustumPlane(CCamera::FRUSTUM_PLANE_LFT),
+		cam->GetFrustumPlane(CCamera::FRUSTUM_PLANE_RGT),
+		cam->GetFrustumPlane(CCamera::FRUSTUM_PLANE_TOP),
+		cam->GetFrustumPlane(CCamera::FRUSTUM_PLANE_BOT),
+		cam->GetFrustumPlane(CCamera::FRUSTUM_PLANE_BCK),
+	};
+	const float offsets[NUM_PLANES] = {scales.x, scales.x, scales.y, scales.y, scales.w};
+
+	*this = Frustum(cam->GetPos(), normals, offsets);
+}
+
+Culling::Frustum::Frustum(const float3& pos, const float3* normals, const float* offsets)
+{
+	// fold the origin into the plane distances so the
+	// kernel does not have to subtract it per sphere
+	for (unsigned int i = 0; i < NUM_PLANES; i++) {
+		nx[i] = normals[i].x;
+		ny[i] = normals[i].y;
+		nz[i] = normals[i].z;
+		ds[i] = offsets[i] + normals[i].dot(pos);
+	}
+}
+
+bool Culling::Frustum::IntersectSphere(const float3& p, float r) const
+{
+	for (unsigned int i = 0; i < NUM_PLANES; i++) {
+		if ((p.x * nx[i] + p.y * ny[i] + p.z * nz[i]) > (ds[i] + r))
+			return false;
+	}
+
+	return true;
+}
+
+
+void Culling::TestSpheres(const Frustum& f, const Spheres& s, std::uint8_t* mask, size_t beg, size_t end)
+{
+	const float* xs = s.xs.data();
+	const float* ys = s.ys.data();
+	const float* zs = s.zs.data();
+	const float* rs = s.rs.data();
+
+	// branch-free over the planes so the loop can be vectorized
+	for (size_t i = beg; i < end; i++) {
+		std::uint8_t inside = 1;
+
+		for (unsigned int j = 0; j < Frustum::NUM_PLANES; j++) {
+			inside &= ((xs[i] * f.nx[j] + ys[i] * f.ny[j] + zs[i] * f.nz[j]) <= (f.ds[j] + rs[i]));
+		}
+
+		mask[i] &= inside;
+	}
+}
+
+void Culling::CullSpheres(const Frustum& f, const Spheres& s, std::vector<std::uint8_t>& mask)
+{
+	const size_t numSpheres = s.Size();
+	const size_t numChunks = (numSpheres + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+
+	assert(mask.size() == numSpheres);
+
+	// a single chunk is run inline
+	parallel_for(0, numChunks, 1, [&](const int i) {
+		TestSpheres(f, s, mask.data(), i * CULL_CHUNK_SIZE, std::min((i + 1) * CULL_CHUNK_SIZE, numSpheres));
+	});
+}
+
+bool Culling::CheckSpheres(const CCamera* cam, const Spheres& s)
+{
+	const Frustum f(cam);
+
+	// the kernel folds the camera position into the planes, so results may
+	// differ from InView for spheres within rounding distance of a plane;
+	// those are the ones whose InView result flips when nudging the radius
+	constexpr float eps = 1.0f;
+
+	std::vector<std::uint8_t> mask(s.Size(), 1);
+	TestSpheres(f, s, mask.data(), 0, s.Size());
+
+	for (size_t i = 0, n = s.Size(); i < n; i++) {
+		const float3 p = {s.xs[i], s.ys[i], s.zs[i]};
+		const float r = s.rs[i];
+
+		if (mask[i] == cam->InView(p, r))
+			continue;
+		if (cam->InView(p, r + eps) != cam->InView(p, r - eps))
+			continue;
+
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,82 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _CULLING_H
+#define _CULLING_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "System/float3.h"
+
+class CCamera;
+
+/**
+ * CPU frustum culling of bounding spheres. Nothing here touches GL or any
+ * engine globals, so the kernel can be exercised (and timed) in isolation;
+ * the drawers feed it the draw-positions and -radii of their objects once
+ * per camera per frame (see VisibleObjectLists.h).
+ */
+namespace Culling {
+	struct Frustum {
+	public:
+		// side-planes (LRTB) and the far-plane, like CCamera::InView
+		enum { NUM_PLANES = 5 };
+
+	public:
+		Frustum() = default;
+		Frustum(const CCamera* cam);
+		/// <normals> point out of the volume, <offsets> are relative to <pos>
+		Frustum(const float3& pos, const float3* normals, const float* offsets);
+
+		bool operator == (const Frustum& f) const { return (std::memcmp(this, &f, sizeof(*this)) == 0); }
+		bool operator != (const Frustum& f) const { return (!(*this == f)); }
+
+		/// scalar reference test, equivalent to one iteration of TestSpheres
+		bool IntersectSphere(const float3& p, float r) const;
+
+	public:
+		// planes as (nx, ny, nz, d), a point is outside if dot(n, p) > d + r
+		float nx[NUM_PLANES] = {0.0f};
+		float ny[NUM_PLANES] = {0.0f};
+		float nz[NUM_PLANES] = {0.0f};
+		float ds[NUM_PLANES] = {0.0f};
+	};
+
+	struct Spheres {
+	public:
+		void Clear() { Resize(0); }
+		void Resize(size_t n) {
+			xs.resize(n);
+			ys.resize(n);
+			zs.resize(n);
+			rs.resize(n);
+		}
+
+		void Set(size_t i, const float3& p, float r) {
+			xs[i] = p.x;
+			ys[i] = p.y;
+			zs[i] = p.z;
+			rs[i] = r;
+		}
+
+		size_t Size() const { return (xs.size()); }
+
+	public:
+		std::vector<float> xs;
+		std::vector<float> ys;
+		std::vector<float> zs;
+		std::vector<float> rs;
+	};
+
+	/// clears mask[i] for every sphere in [beg, end) that lies outside <f>
+	void TestSpheres(const Frustum& f, const Spheres& s, std::uint8_t* mask, size_t beg, size_t end);
+	/// TestSpheres over all of <s> (one mask entry each), split across worker threads
+	void CullSpheres(const Frustum& f, const Spheres& s, std::vector<std::uint8_t>& mask);
+
+	/// checks TestSpheres against CCamera::InView for all of <s>, for use in assertions
+	bool CheckSpheres(const CCamera* cam, const Spheres& s);
+}
+
+#endif // _CULLING_H
@@ -4,6 +4,8 @@
 #include "ProjectileDrawer.h"
 
 #include <algorithm>
+#include <cassert>
+#include <limits>
 
 #include "Game/Camera.h"
 #include "Game/GlobalUnsynced.h"
@@ -39,6 +41,7 @@
 #include "System/Log/ILog.h"
 #include "System/SafeUtil.h"
 #include "System/StringUtil.h"
+#include "System/Threading/ThreadPool.h"
 
 
 CProjectileDrawer* projectileDrawer = nullptr;
@@ -48,6 +51,13 @@ CProjectileDrawer* projectileDrawer = nullptr;
 // ~EventClient)
 static uint8_t projectileDrawerMem[sizeof(CProjectileDrawer)];
 
+// projectiles per block of a depth-sort pass
+static constexpr size_t SORT_BLOCK_SIZE = 4096;
+static constexpr size_t SORT_RADIX_BITS = 8;
+static constexpr size_t SORT_RADIX_SIZE = 1 << SORT_RADIX_BITS;
+// minimum number of particles per worker when building fxBuffer
+static constexpr size_t PARTICLE_CHUNK_SIZE = 1024;
+
 
 void CProjectileDrawer::InitStatic() {
 	if (projectileDrawer == nullptr)
@@ -261,6 +271,8 @@ void CProjectileDrawer::Init() {
 		modelRenderers[modelType].Init();
 	}
 
+	visibleProjectiles.Init();
+
 	LoadWeaponTextures();
 }
 
@@ -276,12 +288,21 @@ void CProjectileDrawer::Kill() {
 		modelRenderers[modelType].Kill();
 	}
 
+	visibleProjectiles.Kill();
+
 	smokeTextures.clear();
 
 	renderProjectiles.clear();
 	sortedProjectiles[0].clear();
 	sortedProjectiles[1].clear();
 
+	particleChunks.clear();
+	sortBuffer.clear();
+	sortKeys[0].clear();
+	sortKeys[1].clear();
+	sortCounts.clear();
+	sortRanges.clear();
+
 	perlinNoiseFBO.Kill();
 	flyingPieceVAO.Delete();
 
@@ -426,14 +447,31 @@ void CProjectileDrawer::LoadWeaponTextures() {
 
 
 
+void CProjectileDrawer::UpdateVisibleProjectiles(const CCamera* cam)
+{
+	const auto preFilter = [](const CProjectile* p) { return (CanDrawProjectile(p, p->owner())); };
+	const auto getSphere = [](CProjectile* p) {
+		// each projectile is touched by one thread only, so this is safe
+		p->drawPos = p->GetDrawPos(globalRendering->timeOffset);
+		return (float4(p->drawPos, p->GetDrawRadius()));
+	};
+
+	visibleProjectiles.Update(cam, modelRenderers, &renderProjectiles, preFilter, getSphere);
+}
+
 void CProjectileDrawer::DrawProjectiles(int modelType, bool drawReflection, bool drawRefraction)
 {
 	const auto& mdlRenderer = modelRenderers[modelType];
 	// const auto& projBinKeys = mdlRenderer.GetObjectBinKeys();
 
 	for (unsigned int i = 0, n = mdlRenderer.GetNumObjectBins(); i < n; i++) {
+		const auto& projBin = visibleProjectiles.GetModelBin(camera, modelType, i);
+
+		if (projBin.empty())
+			continue;
+
 		CUnitDrawer::BindModelTypeTexture(modelType, mdlRenderer.GetObjectBinKey(i));
-		DrawProjectilesSet(mdlRenderer.GetObjectBin(i), drawReflection, drawRefraction);
+		DrawProjectilesSet(projBin, drawReflection, drawRefraction);
 	}
 
 	DrawFlyingPieces(modelType);
@@ -455,20 +493,12 @@ bool CProjectileDrawer::CanDrawProjectile(const CProjectile* pro, const CSolidOb
 
 void CProjectileDrawer::DrawProjectileNow(CProjectile* pro, bool drawReflection, bool drawRefraction)
 {
-	pro->drawPos = pro->GetDrawPos(globalRendering->timeOffset);
-
-	if (!CanDrawProjectile(pro, pro->owner()))
-		return;
-
-
+	// drawPos, LOS and frustum were handled by UpdateVisibleProjectiles
 	if (drawRefraction && (pro->drawPos.y > pro->GetDrawRadius()) /*!pro->IsInWater()*/)
 		return;
 	if (drawReflection && !CUnitDrawer::ObjectVisibleReflection(pro->drawPos, camera->GetPos(), pro->GetDrawRadius()))
 		return;
 
-	if (!camera->InView(pro->drawPos, pro->GetDrawRadius()))
-		return;
-
 	// no-op if no model
 	DrawProjectileModel(pro);
 
@@ -484,7 +514,7 @@ void CProjectileDrawer::DrawProjectilesShadow(int modelType)
 	// const auto& projBinKeys = mdlRenderer.GetObjectBinKeys();
 
 	for (unsigned int i = 0, n = mdlRenderer.GetNumObjectBins(); i < n; i++) {
-		DrawProjectilesSetShadow(mdlRenderer.GetObjectBin(i));
+		DrawProjectilesSetShadow(visibleProjectiles.GetModelBin(camera, modelType, i));
 	}
 
 	DrawFlyingPieces(modelType);
@@ -499,12 +529,6 @@ void CProjectileDrawer::DrawProjectilesSetShadow(const std::vector<CProjectile*>
 
 void CProjectileDrawer::DrawProjectileShadow(const CProjectile* p)
 {
-	if (!CanDrawProjectile(p, p->owner()))
-		return;
-
-	if (!camera->InView(p->drawPos, p->GetDrawRadius()))
-		return;
-
 	// if this returns false, then projectile is
 	// neither weapon nor piece, or has no model
 	if (DrawProjectileModel(p))
@@ -594,6 +618,7 @@ void CProjectileDrawer::DrawFlyingPieces(int modelType)
 
 void CProjectileDrawer::DrawProjectilePass(Shader::IProgramObject*, bool drawReflection, bool drawRefraction)
 {
+	UpdateVisibleProjectiles(camera);
 	unitDrawer->SetupOpaqueDrawing(false);
 
 	for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_OTHER; modelType++) {
@@ -606,18 +631,197 @@ void CProjectileDrawer::DrawProjectilePass(Shader::IProgramObject*, bool drawRef
 
 	// note: model-less projectiles are NOT drawn by this call but
 	// only z-sorted (if the projectiles indicate they want to be)
-	DrawProjectilesSet(renderProjectiles, drawReflection, drawRefraction);
+	DrawProjectilesSet(visibleProjectiles.GetUnsortedBin(camera), drawReflection, drawRefraction);
 
 	// empty if !drawSorted
-	std::sort(sortedProjectiles[1].begin(), sortedProjectiles[1].end(), zSortCmp);
+	SortProjectiles(sortedProjectiles[1]);
+	DrawParticles();
+}
+
+
+void CProjectileDrawer::SortProjectiles(std::vector<CProjectile*>& projectiles)
+{
+	const size_t numProjs = projectiles.size();
+	const size_t numBlocks = (numProjs + SORT_BLOCK_SIZE - 1) / SORT_BLOCK_SIZE;
+
+	if (numProjs < 2)
+		return;
+
+	sortBuffer.resize(numProjs);
+	sortKeys[0].resize(numProjs);
+	sortKeys[1].resize(numProjs);
+	sortCounts.resize(numBlocks * SORT_RADIX_SIZE);
+	sortRanges.resize(numBlocks);
+
+	const auto BlockEnd = [&](size_t i) { return (std::min((i + 1) * SORT_BLOCK_SIZE, numProjs)); };
+
+	parallel_for(0, numBlocks, 1, [&](const int i) {
+		float2& range = sortRanges[i];
+
+		range = {std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()};
+
+		for (size_t j = i * SORT_BLOCK_SIZE, n = BlockEnd(i); j < n; j++) {
+			range.x = std::min(range.x, projectiles[j]->GetSortDist());
+			range.y = std::max(range.y, projectiles[j]->GetSortDist());
+		}
+	});
+
+	float2 distRange = sortRanges[0];
+
+	for (const float2& range: sortRanges) {
+		distRange.x = std::min(distRange.x, range.x);
+		distRange.y = std::max(distRange.y, range.y);
+	}
+
+	// quantize such that the farthest projectile gets the smallest key,
+	// ascending key order is then back-to-front like the old comparator
+	const float distScale = (distRange.y > distRange.x)? (std::numeric_limits<std::uint16_t>::max() / (distRange.y - distRange.x)): 0.0f;
+
+	parallel_for(0, numBlocks, 1, [&](const int i) {
+		for (size_t j = i * SORT_BLOCK_SIZE, n = BlockEnd(i); j < n; j++) {
+			sortKeys[0][j] = (distRange.y - projectiles[j]->GetSortDist()) * distScale;
+		}
+	});
+
+	CProjectile** srcProjs = projectiles.data();
+	CProjectile** dstProjs = sortBuffer.data();
+
+	std::uint16_t* srcKeys = sortKeys[0].data();
+	std::uint16_t* dstKeys = sortKeys[1].data();
+
+	// stable LSD passes; each block counts and then scatters its own range
+	// into the slots reserved for it per digit, preserving the input order
+	// among equal keys (i.e. projectiles at the same quantized depth)
+	for (unsigned int shift = 0; shift < 16; shift += SORT_RADIX_BITS) {
+		parallel_for(0, numBlocks, 1, [&](const int i) {
+			std::uint32_t* counts = &sortCounts[i * SORT_RADIX_SIZE];
+
+			std::fill(counts, counts + SORT_RADIX_SIZE, 0);
+
+			for (size_t j = i * SORT_BLOCK_SIZE, n = BlockEnd(i); j < n; j++) {
+				counts[(srcKeys[j] >> shift) & (SORT_RADIX_SIZE - 1)] += 1;
+			}
+		});
 
+		// exclusive prefix-sum over (digit, block) turns the counts into offsets
+		for (std::uint32_t digit = 0, sum = 0; digit < SORT_RADIX_SIZE; digit++) {
+			for (size_t i = 0; i < numBlocks; i++) {
+				std::uint32_t& count = sortCounts[i * SORT_RADIX_SIZE + digit];
+				std::uint32_t offset = sum;
+
+				sum += count;
+				count = offset;
+			}
+		}
+
+		parallel_for(0, numBlocks, 1, [&](const int i) {
+			std::uint32_t* offsets = &sortCounts[i * SORT_RADIX_SIZE];
+
+			for (size_t j = i * SORT_BLOCK_SIZE, n = BlockEnd(i); j < n; j++) {
+				const std::uint32_t k = offsets[(srcKeys[j] >> shift) & (SORT_RADIX_SIZE - 1)]++;
+
+				dstProjs[k] = srcProjs[j];
+				dstKeys[k] = srcKeys[j];
+			}
+		});
+
+		std::swap(srcProjs, dstProjs);
+		std::swap(srcKeys, dstKeys);
+	}
+
+	// an even number of passes leaves the result in the input
+	static_assert(((16 / SORT_RADIX_BITS) & 1) == 0, "");
+	assert(srcProjs == projectiles.data());
+}
+
+void CProjectileDrawer::DrawParticles()
+{
+	const std::vector<CProjectile*>& sortedProjs = sortedProjectiles[1];
+	const std::vector<CProjectile*>& unsortedProjs = sortedProjectiles[0];
+
+	const size_t numProjs = sortedProjs.size() + unsortedProjs.size();
+	const size_t numChunks = std::min(numProjs / PARTICLE_CHUNK_SIZE, size_t(ThreadPool::GetNumThreads()));
+
+	// sorted ones first, back-to-front
+	const auto GetProjectile = [&](size_t i) {
+		if (i < sortedProjs.size())
+			return sortedProjs[i];
+
+		return unsortedProjs[i - sortedProjs.size()];
+	};
+
+	// more vertices than still fit in fxBuffer could not be submitted anyway
+	const size_t numChunkElems = (numChunks > 1)? fxBuffer->FreeElems() / numChunks: 0;
 
 	// collect the alpha-translucent particle effects in fxBuffer
-	for (CProjectile* p: sortedProjectiles[1]) {
-		p->Draw(fxBuffer);
+	if (numChunkElems == 0) {
+		for (size_t i = 0; i < numProjs; i++) {
+			GetProjectile(i)->Draw(fxBuffer);
+		}
+
+		return;
+	}
+
+	particleChunks.resize(std::max(particleChunks.size(), numChunks));
+
+	for (size_t i = 0; i < numChunks; i++) {
+		ParticleChunk& chunk = particleChunks[i];
+
+		if (chunk.elems.size() >= numChunkElems)
+			continue;
+
+		chunk.elems.resize(numChunkElems);
+		chunk.buffer.SetupClient(chunk.elems.data(), chunk.elems.size());
+	}
+
+	// each worker stages the vertices of a contiguous range of particles
+	parallel_for(0, numChunks, 1, [&](const int i) {
+		ParticleChunk& chunk = particleChunks[i];
+		GL::RenderDataBufferTC& buffer = chunk.buffer;
+
+		chunk.begIdx = (numProjs *  i     ) / numChunks;
+		chunk.endIdx = (numProjs * (i + 1)) / numChunks;
+
+		buffer.Truncate(0);
+
+		for (chunk.drawIdx = chunk.begIdx; chunk.drawIdx < chunk.endIdx; chunk.drawIdx++) {
+			const size_t numElems = buffer.NumElems();
+
+			GetProjectile(chunk.drawIdx)->Draw(&buffer);
+
+			// a full buffer might have dropped some of this particle's
+			// vertices; leave it and the rest to the main thread instead
+			if (buffer.NumElems() < buffer.MaxElems())
+				continue;
+
+			buffer.Truncate(numElems);
+			break;
+		}
+	});
+
+	// concatenate in order so the blending stays back-to-front; particles
+	// left to the main thread can use up the space a later chunk needs, in
+	// which case it and all following ones are drawn directly like in the
+	// serial path (so only the tail is dropped once fxBuffer is full)
+	size_t serialIdx = numProjs;
+
+	for (size_t i = 0; i < numChunks; i++) {
+		ParticleChunk& chunk = particleChunks[i];
+
+		if (chunk.buffer.NumElems() > fxBuffer->FreeElems()) {
+			serialIdx = chunk.begIdx;
+			break;
+		}
+
+		fxBuffer->SafeAppend(chunk.buffer.GetElemsMap(), chunk.buffer.NumElems());
+
+		for (size_t j = chunk.drawIdx; j < chunk.endIdx; j++) {
+			GetProjectile(j)->Draw(fxBuffer);
+		}
 	}
-	for (CProjectile* p: sortedProjectiles[0]) {
-		p->Draw(fxBuffer);
+
+	for (size_t i = serialIdx; i < numProjs; i++) {
+		GetProjectile(i)->Draw(fxBuffer);
 	}
 }
 
@@ -676,12 +880,14 @@ void CProjectileDrawer::DrawProjectileShadowPass(Shader::IProgramObject* po)
 	po->SetUniformMatrix4fv(1, false, shadowHandler.GetShadowViewMatrix());
 	po->SetUniformMatrix4fv(2, false, shadowHandler.GetShadowProjMatrix());
 
+	UpdateVisibleProjectiles(camera);
+
 	for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_OTHER; modelType++) {
 		DrawProjectilesShadow(modelType);
 	}
 
 	// draw the model-less projectiles
-	DrawProjectilesSetShadow(renderProjectiles);
+	DrawProjectilesSetShadow(visibleProjectiles.GetUnsortedBin(camera));
 	po->Disable();
 }
 
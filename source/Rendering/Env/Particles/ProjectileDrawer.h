@@ -4,16 +4,19 @@
 #define PROJECTILE_DRAWER_HDR
 
 #include <array>
+#include <cinttypes>
+#include <vector>
 
 #include "Rendering/GL/myGL.h"
 #include "Rendering/GL/VAO.h"
 #include "Rendering/GL/FBO.h"
-#include "Rendering/GL/RenderDataBufferFwd.hpp"
+#include "Rendering/GL/RenderDataBuffer.hpp"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Models/ModelRenderContainer.h"
-#include "Sim/Projectiles/ProjectileFunctors.h"
+#include "Rendering/VisibleObjectLists.h"
 #include "System/EventClient.h"
 #include "System/UnorderedSet.hpp"
+#include "System/type2.h"
 
 class CSolidObject;
 class CTextureAtlas;
@@ -127,10 +130,16 @@ private:
 	void DrawProjectilesSet(const std::vector<CProjectile*>& projectiles, bool drawReflection, bool drawRefraction);
 	void DrawProjectilesSetShadow(const std::vector<CProjectile*>& projectiles);
 
+	/// builds the visible-projectile lists for <cam> if this has not been done yet this frame
+	void UpdateVisibleProjectiles(const CCamera* cam);
+
 	static bool CanDrawProjectile(const CProjectile* pro, const CSolidObject* owner);
 	void DrawProjectileNow(CProjectile* projectile, bool drawReflection, bool drawRefraction);
 
 	void DrawProjectileShadow(const CProjectile* projectile);
+
+	void SortProjectiles(std::vector<CProjectile*>& projectiles);
+	void DrawParticles();
 	static bool DrawProjectileModel(const CProjectile* projectile);
 
 	void UpdatePerlin();
@@ -154,8 +163,24 @@ private:
 
 	VAO flyingPieceVAO;
 
-	ProjectileDistanceComparator zSortCmp;
+	/// client-side vertex staging for one worker of DrawParticles
+	struct ParticleChunk {
+		std::vector<VA_TYPE_TC> elems;
+		GL::RenderDataBufferTC buffer;
+
+		// range of particles assigned to this chunk and the first one not drawn into it
+		size_t begIdx = 0;
+		size_t endIdx = 0;
+		size_t drawIdx = 0;
+	};
+
+	std::vector<ParticleChunk> particleChunks;
 
+	// radix-sort scratch-space
+	std::vector<CProjectile*> sortBuffer;
+	std::vector<std::uint16_t> sortKeys[2];
+	std::vector<std::uint32_t> sortCounts;
+	std::vector<float2> sortRanges;
 
 	std::vector<const AtlasedTexture*> smokeTextures;
 
@@ -163,6 +188,8 @@ private:
 	std::vector<CProjectile*> renderProjectiles;
 	/// projectiles with a model
 	std::array<ModelRenderContainer<CProjectile>, MODELTYPE_OTHER> modelRenderers;
+	/// per-camera subsets of both of the above that pass the LOS and frustum tests
+	CVisibleObjectLists<CProjectile> visibleProjectiles;
 
 	/// {[0] := unsorted, [1] := distance-sorted} projectiles;
 	/// used to render particle effects in back-to-front order
@@ -31,6 +31,7 @@
 #include "System/EventHandler.h"
 #include "System/SpringMath.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
 
 #define DRAW_QUAD_SIZE 32
 
@@ -157,6 +158,9 @@ void CFeatureDrawer::Init()
 		camVisibleQuad.clear();
 		camVisibleQuad.reserve(256);
 	}
+	for (auto& camVisibleFeature: camVisibleFeatures) {
+		camVisibleFeature.clear();
+	}
 }
 
 void CFeatureDrawer::Kill()
@@ -360,21 +364,10 @@ void CFeatureDrawer::DrawOpaqueFeatures(int modelType)
 
 bool CFeatureDrawer::CanDrawFeature(const CFeature* feature) const
 {
-	if (feature->noDraw)
-		return false;
-	if (feature->IsInVoid())
-		return false;
-	if (!feature->IsInLosForAllyTeam(gu->myAllyTeam) && !gu->spectatingFullView)
-		return false;
-
+	// flagged features already passed the LOS and frustum tests
+	// (for either PLAYER or SHADOW or UWREFL) in CullVisibleFeatures
 	// same cutoff as AT; set during SP too
-	if (feature->drawAlpha <= 0.1f)
-		return false;
-
-	// either PLAYER or SHADOW or UWREFL
-	const CCamera* cam = CCameraHandler::GetActiveCamera();
-
-	return (cam->InView(feature->drawMidPos, feature->GetDrawRadius()));
+	return (feature->drawAlpha > 0.1f);
 }
 
 
@@ -636,49 +629,85 @@ void CFeatureDrawer::FlagVisibleFeatures(
 
 					// clear marker; will be set at most once below
 					f->drawFlag = CFeature::FD_NODRAW_FLAG;
+				}
+			}
+		}
+	}
+
+	// only features that survived culling can be flagged as drawable
+	for (CFeature* f: camVisibleFeatures[cam->GetCamType()]) {
+		assert(f->def->drawType == DRAWTYPE_MODEL);
+
+		if (drawShadowPass) {
+			if (SetFeatureDrawAlpha(f, playerCam, sqFadeDistBegin, sqFadeDistEnd)) {
+				// no shadows for fully alpha-faded features from player's POV
+				f->UpdateTransform(f->drawPos, false);
+				f->drawFlag = CFeature::FD_SHADOW_FLAG;
+			}
+			continue;
+		}
+
+		if (drawRefraction && !f->IsInWater())
+			continue;
 
-					if (f->noDraw)
-						continue;
-					if (f->IsInVoid())
-						continue;
+		if (drawReflection && !CUnitDrawer::ObjectVisibleReflection(f->drawMidPos, cam->GetPos(), f->GetDrawRadius()))
+			continue;
 
-					assert(f->def->drawType == DRAWTYPE_MODEL);
 
-					if (!gu->spectatingFullView && !f->IsInLosForAllyTeam(gu->myAllyTeam))
-						continue;
+		if (SetFeatureDrawAlpha(f, cam, sqFadeDistBegin, sqFadeDistEnd)) {
+			f->UpdateTransform(f->drawPos, false);
+			f->drawFlag += (CFeature::FD_OPAQUE_FLAG * (f->drawAlpha == 1.0f));
+			f->drawFlag += (CFeature::FD_ALPHAF_FLAG * (f->drawAlpha <  1.0f));
+			continue;
+		}
 
+		// note: it looks pretty bad to first alpha-fade and then
+		// draw a fully *opaque* fartex, so restrict impostors to
+		// non-fading features
+		f->drawFlag = CFeature::FD_FARTEX_FLAG * drawFarFeatures * (!f->alphaFade);
+	}
+}
 
-					if (drawShadowPass) {
-						if (SetFeatureDrawAlpha(f, playerCam, sqFadeDistBegin, sqFadeDistEnd)) {
-							// no shadows for fully alpha-faded features from player's POV
-							f->UpdateTransform(f->drawPos, false);
-							f->drawFlag = CFeature::FD_SHADOW_FLAG;
-						}
-						continue;
-					}
+void CFeatureDrawer::CullVisibleFeatures(const CCamera* cam)
+{
+	auto& features = camVisibleFeatures[cam->GetCamType()];
 
-					if (drawRefraction && !f->IsInWater())
-						continue;
+	features.clear();
 
-					if (drawReflection && !CUnitDrawer::ObjectVisibleReflection(f->drawMidPos, cam->GetPos(), f->GetDrawRadius()))
-						continue;
+	for (int quad: camVisibleQuads[cam->GetCamType()]) {
+		const auto& mdlRenderProxy = modelRenderers[quad];
 
+		for (int i = 0; i < MODELTYPE_OTHER; ++i) {
+			const auto& mdlRenderer = mdlRenderProxy.GetRenderer(i);
 
-					if (SetFeatureDrawAlpha(f, cam, sqFadeDistBegin, sqFadeDistEnd)) {
-						f->UpdateTransform(f->drawPos, false);
-						f->drawFlag += (CFeature::FD_OPAQUE_FLAG * (f->drawAlpha == 1.0f));
-						f->drawFlag += (CFeature::FD_ALPHAF_FLAG * (f->drawAlpha <  1.0f));
-						continue;
-					}
+			for (unsigned int j = 0, n = mdlRenderer.GetNumObjectBins(); j < n; j++) {
+				const auto& featureBin = mdlRenderer.GetObjectBin(j);
 
-					// note: it looks pretty bad to first alpha-fade and then
-					// draw a fully *opaque* fartex, so restrict impostors to
-					// non-fading features
-					f->drawFlag = CFeature::FD_FARTEX_FLAG * drawFarFeatures * (!f->alphaFade);
-				}
+				features.insert(features.end(), featureBin.begin(), featureBin.end());
 			}
 		}
 	}
+
+	cullMask.resize(features.size());
+	cullSpheres.Resize(features.size());
+
+	parallel_for(0, features.size(), 256, [&](const int i) {
+		const CFeature* f = features[i];
+
+		cullMask[i] = (!f->noDraw && !f->IsInVoid() && (gu->spectatingFullView || f->IsInLosForAllyTeam(gu->myAllyTeam)));
+		cullSpheres.Set(i, f->drawMidPos, f->GetDrawRadius());
+	});
+
+	Culling::CullSpheres(Culling::Frustum(cam), cullSpheres, cullMask);
+
+	size_t numVisible = 0;
+
+	for (size_t i = 0, n = features.size(); i < n; i++) {
+		features[numVisible] = features[i];
+		numVisible += cullMask[i];
+	}
+
+	features.resize(numVisible);
 }
 
 void CFeatureDrawer::GetVisibleFeatures(CCamera* cam, int extraSize, bool drawFar)
@@ -715,5 +744,6 @@ void CFeatureDrawer::GetVisibleFeatures(CCamera* cam, int extraSize, bool drawFa
 		(drawer.GetRdrProxies()).swap(featureDrawer->modelRenderers);
 	}
 
+	CullVisibleFeatures(cam);
 	FlagVisibleFeatures(cam, inShadowPass, water->DrawReflectionPass(), water->DrawRefractionPass(), drawFar);
 }
@@ -3,10 +3,12 @@
 #ifndef FEATUREDRAWER_H_
 #define FEATUREDRAWER_H_
 
+#include <cinttypes>
 #include <vector>
 #include <array>
 
 #include "Game/Camera.h"
+#include "Rendering/Culling.h"
 #include "Rendering/Models/ModelRenderContainer.h"
 #include "System/creg/creg_cond.h"
 #include "System/EventClient.h"
@@ -92,6 +94,7 @@ private:
 		bool drawFar
 	);
 	void GetVisibleFeatures(CCamera*, int, bool drawFar);
+	void CullVisibleFeatures(const CCamera*);
 
 private:
 	int drawQuadsX;
@@ -130,8 +133,14 @@ private:
 	std::vector<RdrContProxy> modelRenderers;
 	std::array< std::vector<int>, CCamera::CAMTYPE_ENVMAP> camVisibleQuads;
 	std::array<unsigned int, CCamera::CAMTYPE_ENVMAP> camVisDrawFrames;
+	/// features in camVisibleQuads that also pass the LOS and frustum tests
+	std::array< std::vector<CFeature*>, CCamera::CAMTYPE_ENVMAP> camVisibleFeatures;
 	std::vector<CFeature*> unsortedFeatures;
 
+	// scratch-space for CullVisibleFeatures
+	Culling::Spheres cullSpheres;
+	std::vector<std::uint8_t> cullMask;
+
 	GL::GeometryBuffer* geomBuffer;
 };
 
@@ -436,6 +436,9 @@ namespace GL {
 		) {
 			rawBuffer = buffer;
 		}
+		void SetupClient(VertexArrayType* elems, size_t numElems) {
+			rawBuffer = nullptr;
+		}
 
 
 		VertexArrayType* BindMapElems(bool r = false, bool w = true) { return (static_cast<VertexArrayType*>(nullptr)); }
@@ -450,6 +453,7 @@ namespace GL {
 
 		void Reset() { Reset(0, 0); }
 		void Reset(size_t elemsPos, size_t indcsPos) {}
+		void Truncate(size_t numElems) {}
 
 
 		bool CheckSizeE(size_t ne, size_t pos) const { return false; }
@@ -488,6 +492,9 @@ namespace GL {
 		size_t SumElems() const { return 0; }
 		size_t SumIndcs() const { return 0; }
 		size_t NumSubmits(bool indexed) const { return 0; }
+		size_t MaxElems() const { return 0; }
+		size_t FreeElems() const { return 0; }
+		size_t MaxIndcs() const { return 0; }
 
 		GL::RenderDataBuffer* GetBuffer() { return rawBuffer; }
 		Shader::IProgramObject* GetShader() { return &(rawBuffer->GetShader()); }
@@ -528,6 +535,8 @@ namespace GL {
 			std::swap(numSubmits[0], trdb.numSubmits[0]);
 			std::swap(numSubmits[1], trdb.numSubmits[1]);
 
+			std::swap(numClientElems, trdb.numClientElems);
+
 			std::swap(glSyncObj, trdb.glSyncObj);
 			return *this;
 		}
@@ -560,6 +569,22 @@ namespace GL {
 			rawBuffer->TUpload<VertexArrayType, IndexArrayType, Shader::ShaderInput>(numElems, numIndcs, attribs->size(),  nullptr, nullptr, attribs->data());
 		}
 
+		// backs the buffer by caller-owned memory instead of a GL object; such
+		// a buffer can only be appended to (e.g. by worker threads) and read
+		// back through GetElemsMap, never bound or submitted
+		void SetupClient(VertexArrayType* elems, size_t numElems) {
+			rawBuffer = nullptr;
+
+			elemsMap = elems;
+			indcsMap = nullptr;
+
+			prvElemPos = 0;
+			curElemPos = 0;
+			sumElemPos = 0;
+
+			numClientElems = numElems;
+		}
+
 
 		VertexArrayType* BindMapElems(bool r = false, bool w = true) { assert(!rawBuffer->IsPinned()); return (elemsMap = rawBuffer->MapElems<VertexArrayType>(true, false, r, w)); }
 		 IndexArrayType* BindMapIndcs(bool r = false, bool w = true) { assert(!rawBuffer->IsPinned()); return (indcsMap = rawBuffer->MapIndcs< IndexArrayType>(true, false, r, w)); }
@@ -624,10 +649,17 @@ namespace GL {
 			curIndxPos = indcsPos;
 			sumIndxPos = indcsPos;
 		}
+		// drops everything appended to a client buffer past its first <numElems> elements
+		void Truncate(size_t numElems) {
+			assert(rawBuffer == nullptr);
+			assert(numElems <= NumElems());
+
+			curElemPos = prvElemPos + numElems;
+		}
 
 
-		bool CheckSizeE(size_t ne, size_t pos) const { return (ne > 0 && ((pos + (ne - 1)) < rawBuffer->GetNumElems<VertexArrayType>())); }
-		bool CheckSizeI(size_t ni, size_t pos) const { return (ni > 0 && ((pos + (ni - 1)) < rawBuffer->GetNumIndcs< IndexArrayType>())); }
+		bool CheckSizeE(size_t ne, size_t pos) const { return (ne > 0 && ((pos + (ne - 1)) < MaxElems())); }
+		bool CheckSizeI(size_t ni, size_t pos) const { return (ni > 0 && ((pos + (ni - 1)) < MaxIndcs())); }
 
 		void AssertSizeE(size_t ne, size_t pos) const { assert(CheckSizeE(ne, pos)); }
 		void AssertSizeI(size_t ni, size_t pos) const { assert(CheckSizeI(ni, pos)); }
@@ -698,6 +730,9 @@ namespace GL {
 		size_t SumElems() const { return sumElemPos; }
 		size_t SumIndcs() const { return sumIndxPos; }
 		size_t NumSubmits(bool indexed) const { return numSubmits[indexed]; }
+		size_t MaxElems() const { return ((rawBuffer != nullptr)? rawBuffer->GetNumElems<VertexArrayType>(): numClientElems); }
+		size_t FreeElems() const { return (MaxElems() - curElemPos); }
+		size_t MaxIndcs() const { return ((rawBuffer != nullptr)? rawBuffer->GetNumIndcs< IndexArrayType>(): 0); }
 
 		GL::RenderDataBuffer* GetBuffer() { return rawBuffer; }
 		Shader::IProgramObject* GetShader() { return &(rawBuffer->GetShader()); }
@@ -722,6 +757,8 @@ namespace GL {
 
 		// [0] := non-indexed, [1] := indexed
 		size_t numSubmits[2] = {0, 0};
+		// capacity of elemsMap if set up by SetupClient
+		size_t numClientElems = 0;
 
 		GLsync glSyncObj = 0;
 	};
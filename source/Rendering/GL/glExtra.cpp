@@ -86,7 +86,7 @@ static void glBallisticCircle(
 	const float wdHeightMod = weaponDef->heightmod;
 	const float wdProjGravity = mix(params.z, -weaponDef->myGravity, weaponDef->myGravity != 0.0f);
 
-	for_mt(0, circleRes, [&](const int i) {
+	parallel_for(0, circleRes, [&](const int i) {
 		const float radians = math::TWOPI * (float)i / (float)circleRes;
 
 		const float sinR = fastmath::sin(radians);
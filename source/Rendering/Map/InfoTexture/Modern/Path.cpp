@@ -245,7 +245,7 @@ void CPathTexture::Update()
 			}
 		}
 	} else if (md != nullptr) {
-		for_mt(start, updateProcess, [&](const int y) {
+		parallel_for(start, updateProcess, [&](const int y) {
 			for (int x = 0; x < texSize.x; ++x) {
 				const int2 sq = int2(x << 1, y << 1);
 				const int idx = y * texSize.x + x;
@@ -4,6 +4,7 @@
 #include "3DModel.h"
 #include "3DModelLog.h"
 #include "AssIO.h"
+#include "ModelCache.h"
 
 #include "Lua/LuaParser.h"
 #include "Sim/Misc/CollisionVolume.h"
@@ -43,6 +44,10 @@ static constexpr unsigned int ASS_POSTPROCESS_OPTIONS =
 	//| aiProcess_ImproveCacheLocality // FIXME crashes in an assert in VertexTriangleAdjancency.h (date 04/2011)
 	| aiProcess_SplitLargeMeshes;
 
+// texture-preload options from the metafile, stored with cached models
+static constexpr std::uint32_t ASS_TEXFLAG_FLIP      = 1;
+static constexpr std::uint32_t ASS_TEXFLAG_INVERT_TC = 2;
+
 static constexpr unsigned int ASS_IMPORTER_OPTIONS =
 	aiComponent_CAMERAS |
 	aiComponent_LIGHTS |
@@ -158,6 +163,38 @@ S3DModel CAssParser::Load(const std::string& modelFilePath)
 	const std::string& modelPath = FileSystem::GetDirectory(modelFilePath);
 	const std::string& modelName = FileSystem::GetBasename(modelFilePath);
 
+	// either metafile candidate appearing or changing has to invalidate a cached model
+	const std::vector<std::string> metaFileNames = {modelFilePath + ".lua", modelPath + modelName + ".lua"};
+
+	const auto AllocCachedPiece = [this](const SVertexData* verts, size_t numVerts, const unsigned int* indcs, size_t numIndcs) {
+		SAssPiece* piece = AllocPiece();
+		piece->vertices.assign(verts, verts + numVerts);
+		piece->indices.assign(indcs, indcs + numIndcs);
+		return piece;
+	};
+
+	S3DModel model;
+	CModelCache::Entry cacheEntry;
+
+	std::uint32_t texFlags = 0;
+
+	if (modelCache.Load(modelFilePath, metaFileNames, AllocCachedPiece, model, texFlags, cacheEntry)) {
+		textureHandlerS3O.PreloadTexture(&model, (texFlags & ASS_TEXFLAG_FLIP) != 0, (texFlags & ASS_TEXFLAG_INVERT_TC) != 0);
+		LOG_SL(LOG_SECTION_MODEL, L_INFO, "Model %s loaded from cache.", model.name.c_str());
+		return model;
+	}
+
+	model = std::move(ParseModel(modelFilePath, texFlags));
+
+	modelCache.Save(cacheEntry, model, texFlags);
+	return model;
+}
+
+S3DModel CAssParser::ParseModel(const std::string& modelFilePath, std::uint32_t& texFlags)
+{
+	const std::string& modelPath = FileSystem::GetDirectory(modelFilePath);
+	const std::string& modelName = FileSystem::GetBasename(modelFilePath);
+
 	CFileHandler file(modelFilePath, SPRING_VFS_ZIP);
 
 	std::vector<unsigned char> fileBuf;
@@ -233,7 +270,10 @@ S3DModel CAssParser::Load(const std::string& modelFilePath)
 	FindTextures(&model, scene, modelTable, modelPath, modelName);
 	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Loading textures. Tex1: '%s' Tex2: '%s'", model.texs[0].c_str(), model.texs[1].c_str());
 
-	textureHandlerS3O.PreloadTexture(&model, modelTable.GetBool("fliptextures", true), modelTable.GetBool("invertteamcolor", true));
+	texFlags  = ASS_TEXFLAG_FLIP      * modelTable.GetBool("fliptextures", true);
+	texFlags |= ASS_TEXFLAG_INVERT_TC * modelTable.GetBool("invertteamcolor", true);
+
+	textureHandlerS3O.PreloadTexture(&model, (texFlags & ASS_TEXFLAG_FLIP) != 0, (texFlags & ASS_TEXFLAG_INVERT_TC) != 0);
 
 	// Load all pieces in the model
 	LOG_SL(LOG_SECTION_MODEL, L_INFO, "Loading pieces from root node '%s'", scene->mRootNode->mName.data);
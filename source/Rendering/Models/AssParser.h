@@ -76,6 +76,8 @@ public:
 	S3DModel Load(const std::string& modelFileName) override;
 
 private:
+	S3DModel ParseModel(const std::string& modelFilePath, std::uint32_t& texFlags);
+
 	static void PreProcessFileBuffer(std::vector<unsigned char>& fileBuffer);
 
 	static void SetPieceName(
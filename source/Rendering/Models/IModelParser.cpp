@@ -4,6 +4,7 @@
 #include "3DOParser.h"
 #include "S3OParser.h"
 #include "AssParser.h"
+#include "ModelCache.h"
 #include "Game/GlobalUnsynced.h"
 #include "Rendering/Textures/S3OTextureHandler.h"
 #include "Net/Protocol/NetProtocol.h" // NETLOG
@@ -126,6 +127,8 @@ void CModelLoader::Init()
 	RegisterModelFormats(formats);
 	InitParsers();
 
+	modelCache.Init();
+
 	models.clear();
 	models.resize(MAX_MODEL_OBJECTS);
 
@@ -150,6 +153,8 @@ void CModelLoader::Kill()
 	KillModels();
 	KillParsers();
 
+	modelCache.Kill();
+
 	cache.clear();
 	formats.clear();
 }
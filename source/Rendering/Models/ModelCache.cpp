@@ -0,0 +1,463 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "ModelCache.h"
+#include "3DModel.h"
+#include "Sim/Misc/CollisionVolume.h"
+#include "System/FileSystem/ArchiveScanner.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileHandler.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/FileSystem/MappedFile.h"
+#include "System/Log/ILog.h"
+#include "System/StringUtil.h"
+
+
+// bump whenever the layout below or the processing done by any cached parser changes
+static constexpr std::uint32_t CACHE_VERSION = 1;
+static constexpr std::uint32_t CACHE_MAGIC = 0x43444D53; // "SMDC"
+
+// vertex and index arrays start at multiples of this, mappings are page-aligned
+static constexpr size_t ARRAY_ALIGNMENT = 16;
+
+static_assert(std::is_trivially_copyable<SVertexData>::value, "SVertexData must be trivially copyable");
+
+
+CModelCache modelCache;
+
+
+namespace {
+	struct CacheHeader {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t vertexSize; // the cache is machine-local, but builds can differ
+		std::uint32_t userData;
+
+		sha512::raw_digest key;
+	};
+
+	struct CachedPiece {
+		std::string name;
+
+		std::int32_t parentIndex;
+		std::int32_t colvolType;
+		std::int32_t colvolAxis;
+		std::int32_t colvolContHitTest;
+
+		float3 offset;
+		float3 goffset;
+		float3 scales;
+		float3 mins;
+		float3 maxs;
+		float3 colvolScales;
+		float3 colvolOffsets;
+
+		CMatrix44f bakedMatrix;
+
+		const SVertexData* verts;
+		const unsigned int* indcs;
+
+		std::uint32_t numVerts;
+		std::uint32_t numIndcs;
+	};
+
+
+	class CacheWriter {
+	public:
+		void Write(const void* data, size_t size) {
+			const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(data);
+			buffer.insert(buffer.end(), bytes, bytes + size);
+		}
+
+		template<typename T> void Write(const T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "");
+			Write(&value, sizeof(T));
+		}
+
+		template<typename T> void WriteArray(const std::vector<T>& values) {
+			Write(static_cast<std::uint32_t>(values.size()));
+			Align();
+			Write(values.data(), values.size() * sizeof(T));
+		}
+
+		void WriteString(const std::string& str) {
+			Write(static_cast<std::uint32_t>(str.size()));
+			Write(str.data(), str.size());
+		}
+
+		void Align() { buffer.resize((buffer.size() + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1), 0); }
+
+		const std::vector<std::uint8_t>& GetBuffer() const { return buffer; }
+
+	private:
+		std::vector<std::uint8_t> buffer;
+	};
+
+	// every read is bounds-checked, cache files can be truncated or garbage
+	class CacheReader {
+	public:
+		CacheReader(const std::uint8_t* data, size_t size): beg(data), pos(data), end(data + size) {}
+
+		bool Read(void* data, size_t size) {
+			if (size_t(end - pos) < size)
+				return false;
+
+			memcpy(data, pos, size);
+			pos += size;
+			return true;
+		}
+
+		template<typename T> bool Read(T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "");
+			return (Read(&value, sizeof(T)));
+		}
+
+		template<typename T> bool ReadArray(const T*& values, std::uint32_t& count) {
+			if (!Read(count) || !Align())
+				return false;
+			if ((size_t(end - pos) / sizeof(T)) < count)
+				return false;
+
+			// aligned wrt. the page-aligned mapping, so can be used in place
+			values = reinterpret_cast<const T*>(pos);
+			pos += (count * sizeof(T));
+			return true;
+		}
+
+		bool ReadString(std::string& str) {
+			std::uint32_t size = 0;
+
+			if (!Read(size) || size_t(end - pos) < size)
+				return false;
+
+			str.assign(reinterpret_cast<const char*>(pos), size);
+			pos += size;
+			return true;
+		}
+
+		bool Align() {
+			const size_t offset = ((pos - beg) + ARRAY_ALIGNMENT - 1) & ~(ARRAY_ALIGNMENT - 1);
+
+			if (offset > size_t(end - beg))
+				return false;
+
+			pos = beg + offset;
+			return true;
+		}
+
+		bool AtEnd() const { return (pos == end); }
+
+	private:
+		const std::uint8_t* beg;
+		const std::uint8_t* pos;
+		const std::uint8_t* end;
+	};
+}
+
+
+static bool GetArchiveChecksum(const std::string& filePath, sha512::raw_digest& checksum)
+{
+	// loose files are not covered by any checksum (and shadow archived ones)
+	if (CFileHandler::FileExists(filePath, SPRING_VFS_RAW))
+		return false;
+
+	const std::string& archiveName = CFileHandler::GetArchiveContainingFile(filePath, SPRING_VFS_ZIP);
+
+	if (archiveName.empty())
+		return false;
+
+	const std::string& archiveFile = archiveScanner->ArchiveFromName(archiveName);
+	const std::string& archivePath = archiveScanner->GetArchivePath(archiveFile) + archiveFile;
+
+	checksum = archiveScanner->GetArchiveSingleChecksumBytes(archivePath);
+	return (std::find_if(checksum.begin(), checksum.end(), [](std::uint8_t b) { return (b != 0); }) != checksum.end());
+}
+
+
+
+void CModelCache::Init()
+{
+	cacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/models/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	numLoads[0] = 0;
+	numLoads[1] = 0;
+	loadTimes[0] = spring_notime;
+	loadTimes[1] = spring_notime;
+
+	if (cacheDir.empty())
+		LOG_L(L_WARNING, "[ModelCache::%s] could not create cache-dir, models will not be cached", __func__);
+}
+
+void CModelCache::Kill()
+{
+	const char* fmt = "[ModelCache::%s] %u models loaded from cache in %.1fms (%.2fms avg), %u parsed in %.1fms (%.2fms avg)";
+
+	const float warmTime = loadTimes[0].toMilliSecsf();
+	const float coldTime = loadTimes[1].toMilliSecsf();
+
+	LOG(fmt, __func__,
+		numLoads[0], warmTime, warmTime / std::max(numLoads[0], 1u),
+		numLoads[1], coldTime, coldTime / std::max(numLoads[1], 1u)
+	);
+}
+
+
+bool CModelCache::GetKey(const std::string& name, const std::vector<std::string>& deps, sha512::raw_digest& key) const
+{
+	sha512::msg_vector msg;
+	sha512::raw_digest checksum;
+
+	const auto AppendString = [&](const std::string& str) { msg.insert(msg.end(), str.begin(), str.end()); msg.push_back(0); };
+	const auto AppendDigest = [&](const sha512::raw_digest& dig) { msg.insert(msg.end(), dig.begin(), dig.end()); };
+
+	AppendString(IntToString(CACHE_VERSION));
+	AppendString(name);
+
+	if (!GetArchiveChecksum(name, checksum))
+		return false;
+
+	AppendDigest(checksum);
+
+	for (const std::string& dep: deps) {
+		AppendString(dep);
+
+		// a missing dependency is valid, but appearing later must change the key
+		if (!CFileHandler::FileExists(dep, SPRING_VFS_RAW_FIRST)) {
+			msg.push_back(0);
+			continue;
+		}
+
+		if (!GetArchiveChecksum(dep, checksum))
+			return false;
+
+		msg.push_back(1);
+		AppendDigest(checksum);
+	}
+
+	sha512::calc_digest(msg, key);
+	return true;
+}
+
+
+bool CModelCache::Load(
+	const std::string& name,
+	const std::vector<std::string>& deps,
+	const PieceAllocFunc& allocPiece,
+	S3DModel& model,
+	std::uint32_t& userData,
+	Entry& entry
+) {
+	entry.startTime = spring_gettime();
+	entry.filePath.clear();
+
+	if (cacheDir.empty())
+		return false;
+	if (!GetKey(name, deps, entry.key))
+		return false;
+
+	sha512::hex_digest hexKey;
+	sha512::dump_digest(entry.key, hexKey);
+
+	// half the digest is plenty to name the file, the header holds all of it
+	entry.filePath = cacheDir + std::string(hexKey.data(), sha512::SHA_LEN) + ".smc";
+
+	if (!ReadModel(entry, allocPiece, model, userData))
+		return false;
+
+	std::lock_guard<spring::mutex> lock(statsMutex);
+	numLoads[0] += 1;
+	loadTimes[0] += (spring_gettime() - entry.startTime);
+	return true;
+}
+
+bool CModelCache::ReadModel(const Entry& entry, const PieceAllocFunc& allocPiece, S3DModel& model, std::uint32_t& userData) const
+{
+	CMappedFile file(entry.filePath);
+
+	if (!file.IsOpen())
+		return false;
+
+	file.Prefetch(0, file.GetSize());
+
+	CacheReader reader(file.GetData(), file.GetSize());
+	CacheHeader header;
+
+	if (!reader.Read(header))
+		return false;
+	if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.vertexSize != sizeof(SVertexData))
+		return false;
+	if (header.key != entry.key)
+		return false;
+
+	std::int32_t modelType = 0;
+	std::int32_t numPieces = 0;
+	std::uint32_t numPieceObjects = 0;
+
+	bool valid = true;
+
+	valid &= reader.ReadString(model.name);
+	valid &= reader.ReadString(model.texs[0]);
+	valid &= reader.ReadString(model.texs[1]);
+	valid &= reader.Read(modelType);
+	valid &= reader.Read(numPieces);
+	valid &= reader.Read(model.radius);
+	valid &= reader.Read(model.height);
+	valid &= reader.Read(model.mins);
+	valid &= reader.Read(model.maxs);
+	valid &= reader.Read(model.relMidPos);
+	valid &= reader.Read(numPieceObjects);
+
+	if (!valid || numPieceObjects == 0 || modelType < 0 || modelType >= MODELTYPE_OTHER)
+		return false;
+
+	// validate everything before allocating any (pooled) pieces
+	std::vector<CachedPiece> cachedPieces(numPieceObjects);
+
+	for (size_t i = 0; i < cachedPieces.size(); i++) {
+		CachedPiece& cp = cachedPieces[i];
+
+		valid &= reader.ReadString(cp.name);
+		valid &= reader.Read(cp.parentIndex);
+		valid &= reader.Read(cp.offset);
+		valid &= reader.Read(cp.goffset);
+		valid &= reader.Read(cp.scales);
+		valid &= reader.Read(cp.mins);
+		valid &= reader.Read(cp.maxs);
+		valid &= reader.Read(cp.bakedMatrix.m, sizeof(cp.bakedMatrix.m));
+		valid &= reader.Read(cp.colvolType);
+		valid &= reader.Read(cp.colvolAxis);
+		valid &= reader.Read(cp.colvolContHitTest);
+		valid &= reader.Read(cp.colvolScales);
+		valid &= reader.Read(cp.colvolOffsets);
+		valid &= reader.ReadArray(cp.verts, cp.numVerts);
+		valid &= reader.ReadArray(cp.indcs, cp.numIndcs);
+
+		if (!valid)
+			return false;
+
+		// pieces are stored in pre-order, parents always come first
+		if (i == 0 && cp.parentIndex != -1)
+			return false;
+		if (i > 0 && (cp.parentIndex < 0 || cp.parentIndex >= std::int32_t(i)))
+			return false;
+
+		for (std::uint32_t j = 0; j < cp.numIndcs; j++) {
+			if (cp.indcs[j] >= cp.numVerts)
+				return false;
+		}
+	}
+
+	if (!reader.AtEnd())
+		return false;
+
+	std::vector<S3DModelPiece*> pieces(numPieceObjects, nullptr);
+
+	for (size_t i = 0; i < cachedPieces.size(); i++) {
+		CachedPiece& cp = cachedPieces[i];
+		S3DModelPiece* piece = allocPiece(cp.verts, cp.numVerts, cp.indcs, cp.numIndcs);
+
+		CollisionVolume colvol;
+		colvol.InitShape(cp.colvolScales, cp.colvolOffsets, cp.colvolType, cp.colvolContHitTest, cp.colvolAxis);
+
+		piece->name = std::move(cp.name);
+		piece->offset = cp.offset;
+		piece->goffset = cp.goffset;
+		piece->scales = cp.scales;
+		piece->mins = cp.mins;
+		piece->maxs = cp.maxs;
+
+		piece->SetBakedMatrix(cp.bakedMatrix);
+		piece->SetCollisionVolume(colvol);
+
+		if ((pieces[i] = piece) == pieces[0])
+			continue;
+
+		piece->parent = pieces[cp.parentIndex];
+		piece->parent->children.push_back(piece);
+	}
+
+	model.type = static_cast<ModelType>(modelType);
+	model.numPieces = numPieces;
+	model.FlattenPieceTree(pieces[0]);
+
+	userData = header.userData;
+	return true;
+}
+
+
+void CModelCache::Save(const Entry& entry, const S3DModel& model, std::uint32_t userData)
+{
+	{
+		// count every cold load, including models that can not be cached
+		std::lock_guard<spring::mutex> lock(statsMutex);
+		numLoads[1] += 1;
+		loadTimes[1] += (spring_gettime() - entry.startTime);
+	}
+
+	if (entry.filePath.empty())
+		return;
+
+	CacheWriter writer;
+	CacheHeader header;
+
+	header.magic = CACHE_MAGIC;
+	header.version = CACHE_VERSION;
+	header.vertexSize = sizeof(SVertexData);
+	header.userData = userData;
+	header.key = entry.key;
+
+	writer.Write(header);
+	writer.WriteString(model.name);
+	writer.WriteString(model.texs[0]);
+	writer.WriteString(model.texs[1]);
+	writer.Write(static_cast<std::int32_t>(model.type));
+	writer.Write(static_cast<std::int32_t>(model.numPieces));
+	writer.Write(model.radius);
+	writer.Write(model.height);
+	writer.Write(model.mins);
+	writer.Write(model.maxs);
+	writer.Write(model.relMidPos);
+	writer.Write(static_cast<std::uint32_t>(model.pieceObjects.size()));
+
+	for (const S3DModelPiece* piece: model.pieceObjects) {
+		const auto pieceIter = std::find(model.pieceObjects.begin(), model.pieceObjects.end(), piece->parent);
+		const CollisionVolume* colvol = piece->GetCollisionVolume();
+
+		writer.WriteString(piece->name);
+		writer.Write(static_cast<std::int32_t>((piece->parent == nullptr)? -1: (pieceIter - model.pieceObjects.begin())));
+		writer.Write(piece->offset);
+		writer.Write(piece->goffset);
+		writer.Write(piece->scales);
+		writer.Write(piece->mins);
+		writer.Write(piece->maxs);
+		writer.Write(piece->bakedMatrix.m, sizeof(piece->bakedMatrix.m));
+		writer.Write(static_cast<std::int32_t>(colvol->GetVolumeType()));
+		writer.Write(static_cast<std::int32_t>(colvol->GetPrimaryAxis()));
+		writer.Write(static_cast<std::int32_t>(colvol->UseContHitTest()? CollisionVolume::COLVOL_HITTEST_CONT: CollisionVolume::COLVOL_HITTEST_DISC));
+		writer.Write(colvol->GetScales());
+		writer.Write(colvol->GetOffsets());
+		writer.WriteArray(piece->GetVertexElements());
+		writer.WriteArray(piece->GetVertexIndices());
+	}
+
+	// entries are written under a temporary name first since other processes
+	// might be reading them, and two threads can race to parse the same model
+	const std::vector<std::uint8_t>& buffer = writer.GetBuffer();
+	const std::string tmpFilePath = entry.filePath + IntToString(std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xFFFF, ".%04x");
+
+	FILE* file = fopen(tmpFilePath.c_str(), "wb");
+
+	if (file != nullptr) {
+		const bool written = (fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size());
+
+		// rename fails if the entry already exists on some platforms, which is fine
+		if ((fclose(file) != 0) || !written || (rename(tmpFilePath.c_str(), entry.filePath.c_str()) != 0))
+			remove(tmpFilePath.c_str());
+	}
+}
@@ -0,0 +1,77 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include <cinttypes>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+#include "System/Sync/SHA512.hpp"
+#include "System/Threading/SpringThreading.h"
+
+struct S3DModel;
+struct S3DModelPiece;
+struct SVertexData;
+
+/**
+ * On-disk cache of fully processed (S3O and Assimp) models, so each one only
+ * has to be parsed once rather than on every launch. Entries are keyed by the
+ * model path and the checksums of the archives that provide it and the files
+ * it depends on; changed content therefore never hits a stale entry.
+ *
+ * Cache files are read through a memory mapping, with piece geometry copied
+ * straight from it into the (pooled) pieces.
+ */
+class CModelCache
+{
+public:
+	/// creates a piece from geometry read out of a cache file
+	typedef std::function<S3DModelPiece*(const SVertexData*, size_t, const unsigned int*, size_t)> PieceAllocFunc;
+
+	struct Entry {
+		sha512::raw_digest key;
+		std::string filePath; // empty if the model can not be cached
+
+		spring_time startTime;
+	};
+
+public:
+	void Init();
+	void Kill();
+
+	/**
+	 * Looks up model <name>, whose processed form also depends on (VFS)
+	 * files <deps>. On a hit fills <model> and the parser-defined <userData>
+	 * stored with it; bind-pose matrices are left to the caller as usual.
+	 * On a miss <entry> should be passed to Save once the model is parsed.
+	 */
+	bool Load(
+		const std::string& name,
+		const std::vector<std::string>& deps,
+		const PieceAllocFunc& allocPiece,
+		S3DModel& model,
+		std::uint32_t& userData,
+		Entry& entry
+	);
+	void Save(const Entry& entry, const S3DModel& model, std::uint32_t userData);
+
+private:
+	bool GetKey(const std::string& name, const std::vector<std::string>& deps, sha512::raw_digest& key) const;
+	bool ReadModel(const Entry& entry, const PieceAllocFunc& allocPiece, S3DModel& model, std::uint32_t& userData) const;
+
+private:
+	std::string cacheDir;
+
+	spring::mutex statsMutex;
+
+	// warm (cached) and cold (parsed) loads
+	unsigned int numLoads[2] = {0, 0};
+	spring_time loadTimes[2] = {spring_notime, spring_notime};
+};
+
+extern CModelCache modelCache;
+
+#endif /* MODEL_CACHE_H */
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include "S3OParser.h"
+#include "ModelCache.h"
 #include "s3o.h"
 #include "Game/GlobalUnsynced.h"
 #include "Rendering/GlobalRendering.h"
@@ -33,6 +34,23 @@ void CS3OParser::Kill() {
 
 S3DModel CS3OParser::Load(const std::string& name)
 {
+	S3DModel model;
+	CModelCache::Entry cacheEntry;
+
+	const auto AllocCachedPiece = [this](const SVertexData* verts, size_t numVerts, const unsigned int* indcs, size_t numIndcs) {
+		SS3OPiece* piece = AllocPiece();
+		piece->vertices.assign(verts, verts + numVerts);
+		piece->indices.assign(indcs, indcs + numIndcs);
+		return piece;
+	};
+
+	std::uint32_t cacheData = 0;
+
+	if (modelCache.Load(name, {}, AllocCachedPiece, model, cacheData, cacheEntry)) {
+		textureHandlerS3O.PreloadTexture(&model);
+		return model;
+	}
+
 	CFileHandler file(name);
 	std::vector<uint8_t> fileBuf;
 
@@ -53,14 +71,13 @@ S3DModel CS3OParser::Load(const std::string& name)
 	memcpy(&header, fileBuf.data(), sizeof(header));
 	header.swap();
 
-	S3DModel model;
-		model.name = name;
-		model.type = MODELTYPE_S3O;
-		model.numPieces = 0;
-		model.texs[0] = (header.texture1 == 0)? "" : (char*) &fileBuf[header.texture1];
-		model.texs[1] = (header.texture2 == 0)? "" : (char*) &fileBuf[header.texture2];
-		model.mins = DEF_MIN_SIZE;
-		model.maxs = DEF_MAX_SIZE;
+	model.name = name;
+	model.type = MODELTYPE_S3O;
+	model.numPieces = 0;
+	model.texs[0] = (header.texture1 == 0)? "" : (char*) &fileBuf[header.texture1];
+	model.texs[1] = (header.texture2 == 0)? "" : (char*) &fileBuf[header.texture2];
+	model.mins = DEF_MIN_SIZE;
+	model.maxs = DEF_MAX_SIZE;
 
 	textureHandlerS3O.PreloadTexture(&model);
 
@@ -71,6 +88,7 @@ S3DModel CS3OParser::Load(const std::string& name)
 	model.height = (header.height <= 0.01f)? model.CalcDrawHeight(): header.height;
 	model.relMidPos = float3(header.midx, header.midy, header.midz);
 
+	modelCache.Save(cacheEntry, model, cacheData);
 	return model;
 }
 
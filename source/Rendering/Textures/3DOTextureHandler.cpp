@@ -20,6 +20,7 @@
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/SimpleParser.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -192,22 +193,30 @@ std::vector<TexFile> C3DOTextureHandler::LoadTexFiles()
 	tgaFiles.insert(tgaFiles.end(), bmpFiles.begin(), bmpFiles.end());
 	texFiles.reserve(tgaFiles.size() + CTAPalette::NUM_PALETTE_ENTRIES);
 
+	std::vector< std::pair<const std::string*, std::string> > texNames;
+	texNames.reserve(tgaFiles.size());
+
 	for (const std::string& s: tgaFiles) {
-		const std::string s2 = StringToLower(FileSystem::GetBasename(s));
+		std::string s2 = StringToLower(FileSystem::GetBasename(s));
 
 		// avoid duplicate names and give tga images priority
 		if (usedNames.find(s2) != usedNames.end())
 			continue;
 
 		usedNames.insert(s2);
-
-		if (teamTexes.find(s2) == teamTexes.end()) {
-			texFiles.push_back(CreateTex(s, s2, false));
-		} else {
-			texFiles.push_back(CreateTex(s, s2, true));
-		}
+		texNames.emplace_back(&s, std::move(s2));
 	}
 
+	// decoding is thread-safe, create the textures in parallel
+	texFiles.resize(texNames.size());
+
+	for_mt(0, texNames.size(), [&](const int i) {
+		const std::string& s = *texNames[i].first;
+		const std::string& s2 = texNames[i].second;
+
+		texFiles[i] = std::move(CreateTex(s, s2, teamTexes.find(s2) != teamTexes.end()));
+	});
+
 	palette.Init(paletteFile);
 
 	for (unsigned a = 0; a < CTAPalette::NUM_PALETTE_ENTRIES; ++a) {
@@ -13,6 +13,7 @@
 #endif
 
 #include "Bitmap.h"
+#include "ImageDecoders.h"
 #include "Rendering/GlobalRendering.h"
 #include "System/bitops.h"
 #include "System/ScopedFPUSettings.h"
@@ -479,7 +480,27 @@ bool CBitmap::Load(const std::string& filename, uint8_t defaultAlpha)
 	}
 
 
-	{
+	// common formats are decoded natively and in parallel; only the copy into
+	// the pool takes its lock, DevIL (which needs it throughout) is fallback
+	if (!loadDDS) {
+		static thread_local ImageDecoders::Image image;
+
+		if (ImageDecoders::Decode(buffer.data(), buffer.size(), image)) {
+			xsize = image.xsize;
+			ysize = image.ysize;
+
+			texMemPool.Free(GetRawMem(), curMemSize);
+			memIdx = texMemPool.AllocIdx(GetMemSize());
+
+			std::memcpy(GetRawMem(), image.pixels.data(), GetMemSize());
+
+			isLoaded = true;
+			isValid = true;
+			noAlpha = !image.hasAlpha;
+		}
+	}
+
+	if (!isValid) {
 		std::lock_guard<spring::mutex> lck(texMemPool.GetMutex());
 
 		// do not preserve the image origin since IL does not
@@ -1090,7 +1111,7 @@ void CBitmap::Blur(int iterations, float weight)
 		const uint8_t* srcMem = src->GetRawMem();
 		      uint8_t* dstMem = dst->GetRawMem();
 
-		for_mt(0, ysize, [&](const int y) {
+		parallel_for(0, ysize, [&](const int y) {
 			for (int x = 0; x < xsize; x++) {
 				for (int j = 0; j < channels; j++) {
 					kernelBlur(dstMem, srcMem, xsize, ysize, channels, x, y, j, weight);
@@ -0,0 +1,355 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <cstdlib>
+#include <cstring>
+#include <zlib.h>
+
+#include "ImageDecoders.h"
+
+// larger images are left to DevIL, which also guards against size overflows
+static constexpr int MAX_IMAGE_SIZE = 1 << 14;
+
+// inflated PNG scanlines, reused between images decoded by the same thread
+static thread_local std::vector<std::uint8_t> scanlineArena;
+
+
+static inline std::uint32_t ReadBE32(const std::uint8_t* p) { return ((std::uint32_t(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]); }
+static inline std::uint16_t ReadLE16(const std::uint8_t* p) { return (p[0] | (p[1] << 8)); }
+
+static bool IsValidImageSize(int xsize, int ysize) {
+	return (xsize > 0 && ysize > 0 && xsize <= MAX_IMAGE_SIZE && ysize <= MAX_IMAGE_SIZE);
+}
+
+
+
+bool ImageDecoders::DecodeTGA(const std::uint8_t* data, size_t size, Image& image)
+{
+	if (size < 18)
+		return false;
+
+	const int idLength     = data[0];
+	const int colorMapType = data[1];
+	const int imageType    = data[2];
+	const int colorMapLen  = ReadLE16(&data[5]);
+	const int colorMapBits = data[7];
+	const int xsize        = ReadLE16(&data[12]);
+	const int ysize        = ReadLE16(&data[14]);
+	const int pixelDepth   = data[16];
+	const int descriptor   = data[17];
+
+	// truecolor or grayscale, optionally RLE-compressed; no color-mapped images
+	if (colorMapType > 1)
+		return false;
+	if (imageType != 2 && imageType != 3 && imageType != 10 && imageType != 11)
+		return false;
+	if (!IsValidImageSize(xsize, ysize))
+		return false;
+	// right-to-left pixel order is not handled
+	if ((descriptor & 0x10) != 0)
+		return false;
+
+	const bool isGray = ((imageType & 3) == 3);
+	const bool isRLE = ((imageType & 8) != 0);
+
+	if (isGray && pixelDepth != 8)
+		return false;
+	if (!isGray && pixelDepth != 24 && pixelDepth != 32)
+		return false;
+
+	const int bpp = pixelDepth >> 3;
+	const bool topFirst = ((descriptor & 0x20) != 0);
+
+	size_t pos = 18 + idLength + colorMapType * colorMapLen * ((colorMapBits + 7) >> 3);
+
+	image.xsize = xsize;
+	image.ysize = ysize;
+	image.hasAlpha = (bpp == 4);
+	image.pixels.resize(size_t(xsize) * ysize * 4);
+
+	const auto WritePixel = [&](int idx, const std::uint8_t* src) {
+		// file order is BGR(A) for truecolor
+		const int y = idx / xsize;
+		const int x = idx - y * xsize;
+
+		std::uint8_t* dst = &image.pixels[((size_t(topFirst? y: (ysize - 1 - y)) * xsize) + x) * 4];
+
+		if (isGray) {
+			dst[0] = src[0];
+			dst[1] = src[0];
+			dst[2] = src[0];
+			dst[3] = 255;
+		} else {
+			dst[0] = src[2];
+			dst[1] = src[1];
+			dst[2] = src[0];
+			dst[3] = (bpp == 4)? src[3]: 255;
+		}
+	};
+
+	const int numPixels = xsize * ysize;
+
+	if (!isRLE) {
+		if (pos > size || (size - pos) < size_t(numPixels * bpp))
+			return false;
+
+		for (int i = 0; i < numPixels; ++i) {
+			WritePixel(i, &data[pos + i * bpp]);
+		}
+
+		return true;
+	}
+
+	for (int i = 0; i < numPixels; ) {
+		if (pos >= size)
+			return false;
+
+		const int header = data[pos++];
+		const int count = (header & 0x7F) + 1;
+
+		if ((i + count) > numPixels)
+			return false;
+
+		if ((header & 0x80) != 0) {
+			// run of one repeated pixel
+			if ((size - pos) < size_t(bpp))
+				return false;
+
+			for (int j = 0; j < count; ++j) {
+				WritePixel(i++, &data[pos]);
+			}
+
+			pos += bpp;
+		} else {
+			// run of raw pixels
+			if ((size - pos) < size_t(count * bpp))
+				return false;
+
+			for (int j = 0; j < count; ++j, pos += bpp) {
+				WritePixel(i++, &data[pos]);
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+static inline std::uint8_t PaethPredictor(int a, int b, int c)
+{
+	const int p = a + b - c;
+	const int pa = std::abs(p - a);
+	const int pb = std::abs(p - b);
+	const int pc = std::abs(p - c);
+
+	if (pa <= pb && pa <= pc)
+		return a;
+	if (pb <= pc)
+		return b;
+
+	return c;
+}
+
+static bool UnfilterScanlines(std::uint8_t* lines, int numLines, int lineSize, int bpp)
+{
+	const std::uint8_t* prev = nullptr;
+
+	for (int y = 0; y < numLines; ++y) {
+		const int filter = lines[size_t(y) * (lineSize + 1)];
+
+		std::uint8_t* line = &lines[size_t(y) * (lineSize + 1) + 1];
+
+		switch (filter) {
+			case 0: {
+			} break;
+			case 1: {
+				for (int i = bpp; i < lineSize; ++i)
+					line[i] += line[i - bpp];
+			} break;
+			case 2: {
+				for (int i = 0; prev != nullptr && i < lineSize; ++i)
+					line[i] += prev[i];
+			} break;
+			case 3: {
+				for (int i = 0; i < lineSize; ++i) {
+					const int a = (i >= bpp)? line[i - bpp]: 0;
+					const int b = (prev != nullptr)? prev[i]: 0;
+
+					line[i] += ((a + b) >> 1);
+				}
+			} break;
+			case 4: {
+				for (int i = 0; i < lineSize; ++i) {
+					const int a = (i >= bpp)? line[i - bpp]: 0;
+					const int b = (prev != nullptr)? prev[i]: 0;
+					const int c = (i >= bpp && prev != nullptr)? prev[i - bpp]: 0;
+
+					line[i] += PaethPredictor(a, b, c);
+				}
+			} break;
+			default: {
+				return false;
+			} break;
+		}
+
+		prev = line;
+	}
+
+	return true;
+}
+
+bool ImageDecoders::DecodePNG(const std::uint8_t* data, size_t size, Image& image)
+{
+	static constexpr std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+	if (size < sizeof(signature) || std::memcmp(data, signature, sizeof(signature)) != 0)
+		return false;
+
+	int xsize = 0;
+	int ysize = 0;
+	int bitDepth = 0;
+	int colorType = -1;
+
+	const std::uint8_t* palette = nullptr;
+	size_t paletteSize = 0;
+
+	// zlib stream split across IDAT chunks; only copied if there is more than one
+	const std::uint8_t* idatData = nullptr;
+	size_t idatSize = 0;
+	std::vector<std::uint8_t> idatBuffer;
+
+	for (size_t pos = sizeof(signature); ; ) {
+		if ((size - pos) < 12)
+			return false;
+
+		const size_t chunkSize = ReadBE32(&data[pos]);
+		const std::uint8_t* chunkType = &data[pos + 4];
+		const std::uint8_t* chunkData = &data[pos + 8];
+
+		if ((size - pos - 12) < chunkSize)
+			return false;
+
+		pos += (chunkSize + 12);
+
+		if (std::memcmp(chunkType, "IHDR", 4) == 0) {
+			if (chunkSize != 13)
+				return false;
+
+			xsize = ReadBE32(&chunkData[0]);
+			ysize = ReadBE32(&chunkData[4]);
+			bitDepth = chunkData[8];
+			colorType = chunkData[9];
+
+			// compression and filter methods must be 0, no interlacing
+			if (chunkData[10] != 0 || chunkData[11] != 0 || chunkData[12] != 0)
+				return false;
+
+			continue;
+		}
+
+		if (std::memcmp(chunkType, "PLTE", 4) == 0) {
+			palette = chunkData;
+			paletteSize = chunkSize / 3;
+			continue;
+		}
+
+		if (std::memcmp(chunkType, "IDAT", 4) == 0) {
+			if (idatData == nullptr) {
+				idatData = chunkData;
+				idatSize = chunkSize;
+				continue;
+			}
+
+			if (idatBuffer.empty())
+				idatBuffer.assign(idatData, idatData + idatSize);
+
+			idatBuffer.insert(idatBuffer.end(), chunkData, chunkData + chunkSize);
+			idatData = idatBuffer.data();
+			idatSize = idatBuffer.size();
+			continue;
+		}
+
+		if (std::memcmp(chunkType, "IEND", 4) == 0)
+			break;
+
+		// DevIL turns tRNS into an alpha channel and applies gAMA;
+		// leave both to it so the results stay identical
+		if (std::memcmp(chunkType, "tRNS", 4) == 0)
+			return false;
+		if (std::memcmp(chunkType, "gAMA", 4) == 0)
+			return false;
+	}
+
+	if (!IsValidImageSize(xsize, ysize) || bitDepth != 8 || idatData == nullptr)
+		return false;
+
+	int bpp = 0;
+
+	switch (colorType) {
+		case 0: { bpp = 1; } break; // gray
+		case 2: { bpp = 3; } break; // RGB
+		case 3: { bpp = 1; } break; // palette
+		case 4: { bpp = 2; } break; // gray + alpha
+		case 6: { bpp = 4; } break; // RGBA
+		default: { return false; } break;
+	}
+
+	if (colorType == 3 && palette == nullptr)
+		return false;
+
+	const int lineSize = xsize * bpp;
+
+	uLongf rawSize = uLongf(lineSize + 1) * ysize;
+
+	scanlineArena.resize(rawSize);
+
+	if (uncompress(scanlineArena.data(), &rawSize, idatData, idatSize) != Z_OK)
+		return false;
+	if (rawSize != scanlineArena.size())
+		return false;
+	if (!UnfilterScanlines(scanlineArena.data(), ysize, lineSize, bpp))
+		return false;
+
+	image.xsize = xsize;
+	image.ysize = ysize;
+	image.hasAlpha = (bpp == 4);
+	image.pixels.resize(size_t(xsize) * ysize * 4);
+
+	for (int y = 0; y < ysize; ++y) {
+		const std::uint8_t* src = &scanlineArena[size_t(y) * (lineSize + 1) + 1];
+		      std::uint8_t* dst = &image.pixels[size_t(y) * xsize * 4];
+
+		for (int x = 0; x < xsize; ++x, src += bpp, dst += 4) {
+			switch (colorType) {
+				case 0: { dst[0] = src[0]; dst[1] = src[0]; dst[2] = src[0]; dst[3] =    255; } break;
+				case 2: { dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] =    255; } break;
+				case 4: { dst[0] = src[0]; dst[1] = src[0]; dst[2] = src[0]; dst[3] = src[1]; } break;
+				case 6: { dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3]; } break;
+				case 3: {
+					if (src[0] >= paletteSize)
+						return false;
+
+					const std::uint8_t* entry = &palette[src[0] * 3];
+
+					dst[0] = entry[0];
+					dst[1] = entry[1];
+					dst[2] = entry[2];
+					dst[3] = 255;
+				} break;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+
+bool ImageDecoders::Decode(const std::uint8_t* data, size_t size, Image& image)
+{
+	// PNG has a signature, TGA does not; try the former first
+	if (DecodePNG(data, size, image))
+		return true;
+
+	return (DecodeTGA(data, size, image));
+}
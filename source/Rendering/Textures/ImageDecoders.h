@@ -0,0 +1,40 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _IMAGE_DECODERS_H
+#define _IMAGE_DECODERS_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Thread-safe decoders for the image formats most content ships with.
+ * Unlike DevIL they keep no global state, so CBitmap can call them from
+ * any number of loader threads at once without taking its lock.
+ *
+ * Only the variants DevIL would load identically are handled; for
+ * anything else (interlaced or 16-bit PNGs, PNGs with gamma or tRNS
+ * chunks, color-mapped or 16-bit TGAs, ...) Decode returns false and the
+ * caller is expected to fall back to DevIL.
+ */
+namespace ImageDecoders {
+	struct Image {
+		int xsize = 0;
+		int ysize = 0;
+
+		// true if the source had four bytes per pixel; DevIL-loaded
+		// images without one get their alpha replaced by the caller
+		bool hasAlpha = false;
+
+		// RGBA8, top row first
+		std::vector<std::uint8_t> pixels;
+	};
+
+	bool DecodeTGA(const std::uint8_t* data, size_t size, Image& image);
+	bool DecodePNG(const std::uint8_t* data, size_t size, Image& image);
+
+	/// tries every decoder above (by signature); <image> is unspecified on failure
+	bool Decode(const std::uint8_t* data, size_t size, Image& image);
+}
+
+#endif // _IMAGE_DECODERS_H
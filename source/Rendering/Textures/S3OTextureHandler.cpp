@@ -65,19 +65,17 @@ void CS3OTextureHandler::Kill()
 
 void CS3OTextureHandler::PreloadTexture(S3DModel* model, bool invertAxis, bool invertAlpha)
 {
-	cacheMutex.lock();
-	LoadAndCacheTexture(model, 0, invertAxis, invertAlpha, true);
-	LoadAndCacheTexture(model, 1, invertAxis,       false, true); // never invert alpha for tex2
-	cacheMutex.unlock();
+	PreloadBitmap(model, 0, invertAxis, invertAlpha);
+	PreloadBitmap(model, 1, invertAxis,       false); // never invert alpha for tex2
 }
 
 
 void CS3OTextureHandler::LoadTexture(S3DModel* model)
 {
-	cacheMutex.lock();
+	std::unique_lock<spring::mutex> lock(cacheMutex);
 
-	const unsigned int tex1ID = LoadAndCacheTexture(model, 0, false, false, false);
-	const unsigned int tex2ID = LoadAndCacheTexture(model, 1, false, false, false);
+	const unsigned int tex1ID = LoadAndCacheTexture(model, 0, lock);
+	const unsigned int tex2ID = LoadAndCacheTexture(model, 1, lock);
 
 	const auto texTableIter = textureTable.find(TEX_MAT_UID(tex1ID, tex2ID));
 
@@ -88,70 +86,96 @@ void CS3OTextureHandler::LoadTexture(S3DModel* model)
 	} else {
 		model->textureType = texTableIter->second;
 	}
-
-	cacheMutex.unlock();
 }
 
-unsigned int CS3OTextureHandler::LoadAndCacheTexture(
+
+void CS3OTextureHandler::PreloadBitmap(
 	const S3DModel* model,
 	unsigned int texNum,
 	bool invertAxis,
-	bool invertAlpha,
-	bool preloadCall
+	bool invertAlpha
 ) {
-	CBitmap* bitmap = nullptr;
+	const auto& textureName = model->texs[texNum];
+
+	{
+		std::lock_guard<spring::mutex> lock(cacheMutex);
+
+		if (textureCache.find(textureName) != textureCache.end())
+			return;
+		if (bitmapCache.find(textureName) != bitmapCache.end())
+			return;
+
+		// claim the name, so concurrent preloads do not decode it twice
+		if (!pendingBitmaps.insert(textureName).second)
+			return;
+	}
+
+	// decode outside the lock; this is what lets preload threads overlap
+	CBitmap bitmap;
+
+	if (!bitmap.Load(textureName) && !bitmap.Load("unittextures/" + textureName)) {
+		if (texNum == 0)
+			LOG_L(L_WARNING, "[%s] could not load primary texture \"%s\" from model \"%s\"", __func__, textureName.c_str(), model->name.c_str());
+
+		// file not found (or headless build), set a single pixel so model is visible
+		bitmap.AllocDummy(SColor(255 * (texNum == 0), 0, 0, 255 * (1 - invertAlpha)));
+	}
+
+	if (invertAxis)
+		bitmap.ReverseYAxis();
+	if (invertAlpha)
+		bitmap.InvertAlpha();
+
+	{
+		std::lock_guard<spring::mutex> lock(cacheMutex);
 
+		bitmapCache.emplace(textureName, std::move(bitmap));
+		pendingBitmaps.erase(textureName);
+	}
+
+	pendingBitmapsCond.notify_all();
+}
+
+unsigned int CS3OTextureHandler::LoadAndCacheTexture(
+	const S3DModel* model,
+	unsigned int texNum,
+	std::unique_lock<spring::mutex>& lock
+) {
 	const auto& textureName = model->texs[texNum];
 	const auto textureIt = textureCache.find(textureName);
 
 	if (textureIt != textureCache.end())
 		return textureIt->second.texID;
 
-	const auto bitmapIt = bitmapCache.find(textureName);
-
-	if (bitmapIt != bitmapCache.end()) {
-		// bitmap was previously preloaded but not yet loaded
-		// if !preloading, we will now turn the bitmap into a
-		// texture and cache it
-		bitmap = &(bitmapIt->second);
-	} else {
-		// bitmap was not yet preloaded, meaning we are the
-		// first to (all non-3DO model textures are always
-		// preloaded)
-		assert(preloadCall);
-
-		auto pair = bitmapCache.emplace(textureName, {});
-		auto iter = pair.first;
-
-		bitmap = &(iter->second);
+	const auto IsPending = [&]() { return (pendingBitmaps.find(textureName) != pendingBitmaps.end()); };
 
-		if (!bitmap->Load(textureName) && !bitmap->Load("unittextures/" + textureName)) {
-			if (texNum == 0)
-				LOG_L(L_WARNING, "[%s] could not load primary texture \"%s\" from model \"%s\"", __func__, textureName.c_str(), model->name.c_str());
+	auto bitmapIt = bitmapCache.end();
 
-			// file not found (or headless build), set a single pixel so model is visible
-			bitmap->AllocDummy(SColor(255 * (texNum == 0), 0, 0, 255 * (1 - invertAlpha)));
+	// all non-3DO model textures are preloaded, but possibly
+	// by a thread (working on another model) still decoding
+	while ((bitmapIt = bitmapCache.find(textureName)) == bitmapCache.end()) {
+		if (IsPending()) {
+			pendingBitmapsCond.wait(lock, [&]() { return !IsPending(); });
+			continue;
 		}
 
-		if (invertAxis)
-			bitmap->ReverseYAxis();
-		if (invertAlpha)
-			bitmap->InvertAlpha();
+		// not preloaded at all (should not happen), decode it here
+		lock.unlock();
+		PreloadBitmap(model, texNum, false, false);
+		lock.lock();
 	}
 
-	// don't generate a texture yet, just save the bitmap for later
-	if (preloadCall)
-		return 0;
-
-	const unsigned int texID = bitmap->CreateMipMapTexture();
+	// turn the preloaded bitmap into a texture and cache it
+	const CBitmap& bitmap = bitmapIt->second;
+	const unsigned int texID = bitmap.CreateMipMapTexture();
 
 	textureCache[textureName] = {
 		texID,
-		static_cast<unsigned int>(bitmap->xsize),
-		static_cast<unsigned int>(bitmap->ysize)
+		static_cast<unsigned int>(bitmap.xsize),
+		static_cast<unsigned int>(bitmap.ysize)
 	};
 
-	bitmapCache.erase(textureName);
+	bitmapCache.erase(bitmapIt);
 	return texID;
 }
 
@@ -3,12 +3,14 @@
 #ifndef S3O_TEXTURE_HANDLER_H
 #define S3O_TEXTURE_HANDLER_H
 
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "Bitmap.h"
 #include "System/Threading/SpringThreading.h"
 #include "System/UnorderedMap.hpp"
+#include "System/UnorderedSet.hpp"
 
 struct S3DModel;
 class CBitmap;
@@ -50,12 +52,16 @@ public:
 	}
 
 private:
-	unsigned int LoadAndCacheTexture(
+	void PreloadBitmap(
 		const S3DModel* model,
 		unsigned int texNum,
 		bool invertAxis,
-		bool invertAlpha,
-		bool preloadCall
+		bool invertAlpha
+	);
+	unsigned int LoadAndCacheTexture(
+		const S3DModel* model,
+		unsigned int texNum,
+		std::unique_lock<spring::mutex>& lock
 	);
 	unsigned int InsertTextureMat(const S3DModel* model);
 
@@ -68,7 +74,11 @@ private:
 	TextureTable textureTable; // stores (primary, secondary) texture-pairs by unique ident
 	BitmapCache bitmapCache;
 
+	// names of bitmaps currently being decoded by a preload thread
+	spring::unordered_set<std::string> pendingBitmaps;
+
 	spring::mutex cacheMutex;
+	spring::condition_variable_any pendingBitmapsCond;
 
 	std::vector<S3OTexMat> textures;
 };
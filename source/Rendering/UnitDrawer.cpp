@@ -31,6 +31,7 @@
 #include "Rendering/Textures/S3OTextureHandler.h"
 
 #include "Sim/Features/Feature.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Projectiles/ExplosionGenerator.h"
@@ -46,6 +47,7 @@
 #include "System/EventHandler.h"
 #include "System/MemPoolTypes.h"
 #include "System/SpringMath.h"
+#include "System/Threading/ThreadPool.h"
 
 
 CONFIG(int, UnitLodDist).defaultValue(1000).headlessValue(0);
@@ -68,6 +70,9 @@ static uint8_t unitDrawerMem[sizeof(CUnitDrawer)];
 
 static FixedDynMemPool<sizeof(GhostSolidObject), MAX_UNITS / 1000, MAX_UNITS / 32> ghostMemPool;
 
+// minimum number of units per draw-state update slice
+static constexpr size_t UPDATE_SLICE_SIZE = 1024;
+
 
 static void LoadUnitExplosionGenerators() {
 	using F = decltype(&UnitDef::AddModelExpGenID);
@@ -274,6 +279,11 @@ void CUnitDrawer::Init() {
 		alphaModelRenderers[modelType].Init();
 	}
 
+	opaqueVisibleUnits.Init();
+	alphaVisibleUnits.Init();
+
+	drawStates.dirty = true;
+
 	unitsByIcon.reserve(unitDefHandler->NumUnitDefs());
 	unitIcons.resize(unitHandler.MaxUnits(), nullptr);
 
@@ -311,6 +321,8 @@ void CUnitDrawer::Init() {
 
 void CUnitDrawer::Kill()
 {
+	FinishUpdate();
+
 	eventHandler.RemoveClient(this);
 	autoLinkedEvents.clear();
 
@@ -357,6 +369,9 @@ void CUnitDrawer::Kill()
 		alphaModelRenderers[modelType].Kill();
 	}
 
+	opaqueVisibleUnits.Kill();
+	alphaVisibleUnits.Kill();
+
 	unsortedUnits.clear();
 	unitsByIcon.clear();
 	unitIcons.clear();
@@ -382,18 +397,13 @@ void CUnitDrawer::SetUnitIconDist(float dist)
 
 void CUnitDrawer::Update()
 {
+	assert(pendingUpdates.empty());
+
 	for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_OTHER; modelType++) {
 		UpdateTempDrawUnits(tempOpaqueUnits[modelType]);
 		UpdateTempDrawUnits(tempAlphaUnits[modelType]);
 	}
 
-	{
-		for (CUnit* unit: unsortedUnits) {
-			UpdateUnitIconState(unit);
-			UpdateUnitDrawPos(unit);
-		}
-	}
-
 	if ((useDistToGroundForIcons = (camHandler->GetCurrentController()).GetUseDistToGroundForIcons())) {
 		const float3& camPos = camera->GetPos();
 		// use the height at the current camera position
@@ -404,6 +414,132 @@ void CUnitDrawer::Update()
 
 		sqCamDistToGroundForIcons = overGround * overGround;
 	}
+
+	// the sim does not run again before FinishUpdate and the slices only write
+	// draw-state, so they can overlap the GL-bound updates the main thread does
+	// in the meantime; bind the camera since the active one might change
+	const CCamera* cam = camera;
+	const Culling::Frustum frustum(cam);
+
+	// the mirror only has to follow the sim (and unit creation or destruction);
+	// while paused synced Lua can still move units without advancing frameNum
+	const bool refresh = (drawStates.dirty || drawStates.simFrame != gs->frameNum || gs->paused);
+
+	const size_t numUnits = unsortedUnits.size();
+	const size_t numSlices = Clamp((numUnits + UPDATE_SLICE_SIZE - 1) / UPDATE_SLICE_SIZE, size_t(1), size_t(ThreadPool::GetNumThreads()));
+	const size_t sliceSize = (numUnits + numSlices - 1) / numSlices;
+
+	if (refresh)
+		drawStates.Resize(numUnits);
+
+	assert(drawStates.posX.size() == numUnits);
+
+	drawStates.simFrame = gs->frameNum;
+	drawStates.dirty = false;
+
+	for (size_t beg = 0; beg < numUnits; beg += sliceSize) {
+		const size_t end = std::min(beg + sliceSize, numUnits);
+
+		pendingUpdates.push_back(ThreadPool::Enqueue([this, cam, frustum, beg, end, refresh]() {
+			UpdateUnitDrawStates(cam, frustum, beg, end, refresh);
+		}));
+	}
+}
+
+void CUnitDrawer::FinishUpdate()
+{
+	for (const auto& pendingUpdate: pendingUpdates) {
+		pendingUpdate->wait();
+	}
+
+	pendingUpdates.clear();
+}
+
+
+void CUnitDrawer::UnitDrawStates::Resize(size_t n)
+{
+	for (auto* v: {&posX, &posY, &posZ, &spdX, &spdY, &spdZ, &midX, &midY, &midZ, &iconDists, &drawX, &drawY, &drawZ}) {
+		v->resize(n);
+	}
+
+	drawMidSpheres.Resize(n);
+	inViewMask.resize(n);
+	farIconMask.resize(n);
+}
+
+void CUnitDrawer::RefreshUnitDrawStates(size_t beg, size_t end)
+{
+	UnitDrawStates& ds = drawStates;
+
+	for (size_t i = beg; i < end; i++) {
+		const CUnit* u = unsortedUnits[i];
+		const CUnit* t = u->GetTransporter();
+
+		const float3& spd = (t != nullptr)? t->speed: u->speed;
+		const float3  mid = u->GetMdlDrawRelMidPos();
+
+		ds.posX[i] = u->pos.x; ds.posY[i] = u->pos.y; ds.posZ[i] = u->pos.z;
+		ds.spdX[i] =    spd.x; ds.spdY[i] =    spd.y; ds.spdZ[i] =    spd.z;
+		ds.midX[i] =    mid.x; ds.midY[i] =    mid.y; ds.midZ[i] =    mid.z;
+
+		ds.iconDists[i] = u->unitDef->iconType->GetDistanceSqr();
+		ds.drawMidSpheres.rs[i] = u->GetDrawRadius();
+	}
+}
+
+void CUnitDrawer::UpdateUnitDrawStates(const CCamera* cam, const Culling::Frustum& frustum, size_t beg, size_t end, bool refresh)
+{
+	if (refresh)
+		RefreshUnitDrawStates(beg, end);
+
+	UnitDrawStates& ds = drawStates;
+	Culling::Spheres& dms = ds.drawMidSpheres;
+
+	const float3& camPos = cam->GetPos();
+	const float timeOffset = globalRendering->timeOffset;
+
+	// the loops below only touch the mirror (and are vectorizable), unit
+	// state that can change without a sim-frame is tested in the last one
+	for (size_t i = beg; i < end; i++) {
+		ds.drawX[i] = ds.posX[i] + ds.spdX[i] * timeOffset;
+		ds.drawY[i] = ds.posY[i] + ds.spdY[i] * timeOffset;
+		ds.drawZ[i] = ds.posZ[i] + ds.spdZ[i] * timeOffset;
+
+		dms.xs[i] = ds.drawX[i] + ds.midX[i];
+		dms.ys[i] = ds.drawY[i] + ds.midY[i];
+		dms.zs[i] = ds.drawZ[i] + ds.midZ[i];
+	}
+
+	for (size_t i = beg; i < end; i++) {
+		const float dx = ds.posX[i] - camPos.x;
+		const float dy = ds.posY[i] - camPos.y;
+		const float dz = ds.posZ[i] - camPos.z;
+
+		const float iconRefCamDist = mix(dx * dx + dy * dy + dz * dz, sqCamDistToGroundForIcons, useDistToGroundForIcons);
+
+		ds.farIconMask[i] = (iconRefCamDist > (iconLength * ds.iconDists[i]));
+		ds.inViewMask[i] = 1;
+	}
+
+	// drawing icons is cheap but not free, avoid a perf-hit when many are offscreen
+	Culling::TestSpheres(frustum, dms, ds.inViewMask.data(), beg, end);
+
+	for (size_t i = beg; i < end; i++) {
+		CUnit* u = unsortedUnits[i];
+
+		u->drawPos    = {ds.drawX[i], ds.drawY[i], ds.drawZ[i]};
+		u->drawMidPos = {dms.xs[i], dms.ys[i], dms.zs[i]};
+
+		const unsigned short losStatus = u->losStatus[gu->myAllyTeam];
+
+		// reset
+		u->isIcon = ((losStatus & LOS_INRADAR) != 0);
+
+		if ((losStatus & LOS_INLOS) == 0 && !gu->spectatingFullView)
+			continue;
+
+		u->isIcon = (ds.farIconMask[i] && ds.inViewMask[i] && !u->noDraw && !u->IsInVoid());
+	}
 }
 
 
@@ -427,6 +563,7 @@ void CUnitDrawer::Draw()
 
 void CUnitDrawer::DrawOpaquePass(bool deferredPass)
 {
+	UpdateVisibleUnits(CCameraHandler::GetActiveCamera());
 	SetupOpaqueDrawing(deferredPass);
 
 	// cubemap reflections do not include units
@@ -458,11 +595,17 @@ void CUnitDrawer::DrawOpaqueUnits(int modelType, bool drawReflection, bool drawR
 {
 	const auto& mdlRenderer = opaqueModelRenderers[modelType];
 	// const auto& unitBinKeys = mdlRenderer.GetObjectBinKeys();
+	const CCamera* cam = CCameraHandler::GetActiveCamera();
 
 	for (unsigned int i = 0, n = mdlRenderer.GetNumObjectBins(); i < n; i++) {
+		const auto& unitBin = opaqueVisibleUnits.GetModelBin(cam, modelType, i);
+
+		if (unitBin.empty())
+			continue;
+
 		BindModelTypeTexture(modelType, mdlRenderer.GetObjectBinKey(i));
 
-		for (CUnit* unit: mdlRenderer.GetObjectBin(i)) {
+		for (CUnit* unit: unitBin) {
 			DrawOpaqueUnit(unit, drawReflection, drawRefraction);
 		}
 	}
@@ -582,6 +725,30 @@ void CUnitDrawer::DrawUnitIcons()
 /******************************************************************************/
 /******************************************************************************/
 
+void CUnitDrawer::UpdateVisibleUnits(const CCamera* cam)
+{
+	const auto getSphere = [](const CUnit* unit) { return (float4(unit->drawMidPos, unit->GetDrawRadius())); };
+
+	// tests shared by every opaque pass; the pass-specific ones are left to
+	// CanDrawOpaqueUnit{Shadow}, the frustum is tested by the lists' kernel
+	const auto opaqueFilter = [](const CUnit* unit) {
+		if (unit->noDraw)
+			return false;
+		if (unit->IsInVoid())
+			return false;
+		// unit will be drawn as icon instead (no shadow either then)
+		if (unit->isIcon)
+			return false;
+
+		return ((unit->losStatus[gu->myAllyTeam] & LOS_INLOS) || gu->spectatingFullView);
+	};
+	// DrawAlphaUnit does its own (radar-aware) LOS tests
+	const auto alphaFilter = [](const CUnit*) { return true; };
+
+	opaqueVisibleUnits.Update(cam, opaqueModelRenderers, nullptr, opaqueFilter, getSphere);
+	alphaVisibleUnits.Update(cam, alphaModelRenderers, nullptr, alphaFilter, getSphere);
+}
+
 bool CUnitDrawer::CanDrawOpaqueUnit(
 	const CUnit* unit,
 	bool drawReflection,
@@ -589,16 +756,6 @@ bool CUnitDrawer::CanDrawOpaqueUnit(
 ) const {
 	if (unit == (drawReflection? nullptr: (gu->GetMyPlayer())->fpsController.GetControllee()))
 		return false;
-	if (unit->noDraw)
-		return false;
-	if (unit->IsInVoid())
-		return false;
-	// unit will be drawn as icon instead
-	if (unit->isIcon)
-		return false;
-
-	if (!(unit->losStatus[gu->myAllyTeam] & LOS_INLOS) && !gu->spectatingFullView)
-		return false;
 
 	// either PLAYER or UWREFL
 	const CCamera* cam = CCameraHandler::GetActiveCamera();
@@ -606,30 +763,12 @@ bool CUnitDrawer::CanDrawOpaqueUnit(
 	if (drawRefraction && !unit->IsInWater())
 		return false;
 
-	if (drawReflection && !ObjectVisibleReflection(unit->drawMidPos, cam->GetPos(), unit->GetDrawRadius()))
-		return false;
-
-	return (cam->InView(unit->drawMidPos, unit->GetDrawRadius()));
+	return (!drawReflection || ObjectVisibleReflection(unit->drawMidPos, cam->GetPos(), unit->GetDrawRadius()));
 }
 
 bool CUnitDrawer::CanDrawOpaqueUnitShadow(const CUnit* unit) const
 {
-	if (unit->noDraw)
-		return false;
-	if (unit->IsInVoid())
-		return false;
-	// no shadow if unit is already an icon from player's POV
-	if (unit->isIcon)
-		return false;
-	if (unit->isCloaked)
-		return false;
-
-	const CCamera* cam = CCameraHandler::GetActiveCamera();
-
-	const bool unitInLOS = ((unit->losStatus[gu->myAllyTeam] & LOS_INLOS) || gu->spectatingFullView);
-	const bool unitInView = cam->InView(unit->drawMidPos, unit->GetDrawRadius());
-
-	return (unitInLOS && unitInView);
+	return (!unit->isCloaked);
 }
 
 
@@ -649,13 +788,19 @@ void CUnitDrawer::DrawOpaqueUnitShadow(CUnit* unit) {
 void CUnitDrawer::DrawOpaqueUnitsShadow(int modelType) {
 	const auto& mdlRenderer = opaqueModelRenderers[modelType];
 	// const auto& unitBinKeys = mdlRenderer.GetObjectBinKeys();
+	const CCamera* cam = CCameraHandler::GetActiveCamera();
 
 	for (unsigned int i = 0, n = mdlRenderer.GetNumObjectBins(); i < n; i++) {
+		const auto& unitBin = opaqueVisibleUnits.GetModelBin(cam, modelType, i);
+
+		if (unitBin.empty())
+			continue;
+
 		// only need to bind the atlas once for 3DO's, but KISS
 		assert((modelType != MODELTYPE_3DO) || (mdlRenderer.GetObjectBinKey(i) == 0));
 		shadowTexBindFuncs[modelType](textureHandlerS3O.GetTexture(mdlRenderer.GetObjectBinKey(i)));
 
-		for (CUnit* unit: mdlRenderer.GetObjectBin(i)) {
+		for (CUnit* unit: unitBin) {
 			DrawOpaqueUnitShadow(unit);
 		}
 
@@ -677,6 +822,8 @@ void CUnitDrawer::DrawShadowPass()
 	{
 		assert((CCameraHandler::GetActiveCamera())->GetCamType() == CCamera::CAMTYPE_SHADOW);
 
+		UpdateVisibleUnits(CCameraHandler::GetActiveCamera());
+
 		// 3DO's have clockwise-wound faces and
 		// (usually) holes, so disable backface
 		// culling for them
@@ -703,7 +850,7 @@ void CUnitDrawer::DrawShadowPass()
 
 void CUnitDrawer::DrawUnitIcon(CUnit* unit, GL::RenderDataBufferTC* buffer, bool useDefaultIcon)
 {
-	// should never draw icons for void-space units, see UpdateUnitIconState
+	// should never draw icons for void-space units, see UpdateUnitDrawStates
 	assert(!unit->IsInVoid());
 
 	// If the icon is to be drawn as a radar blip, we want to get the default icon.
@@ -801,6 +948,7 @@ void CUnitDrawer::ResetAlphaDrawing(bool deferredPass)
 void CUnitDrawer::DrawAlphaPass(bool aboveWater)
 {
 	{
+		UpdateVisibleUnits(CCameraHandler::GetActiveCamera());
 		SetupAlphaDrawing(false, aboveWater);
 
 		for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_OTHER; modelType++) {
@@ -822,11 +970,17 @@ void CUnitDrawer::DrawAlphaUnits(int modelType)
 	{
 		const auto& mdlRenderer = alphaModelRenderers[modelType];
 		// const auto& unitBinKeys = mdlRenderer.GetObjectBinKeys();
+		const CCamera* cam = CCameraHandler::GetActiveCamera();
 
 		for (unsigned int i = 0, n = mdlRenderer.GetNumObjectBins(); i < n; i++) {
+			const auto& unitBin = alphaVisibleUnits.GetModelBin(cam, modelType, i);
+
+			if (unitBin.empty())
+				continue;
+
 			BindModelTypeTexture(modelType, mdlRenderer.GetObjectBinKey(i));
 
-			for (CUnit* unit: mdlRenderer.GetObjectBin(i)) {
+			for (CUnit* unit: unitBin) {
 				DrawAlphaUnit(unit, modelType, false);
 			}
 		}
@@ -838,7 +992,8 @@ void CUnitDrawer::DrawAlphaUnits(int modelType)
 }
 
 inline void CUnitDrawer::DrawAlphaUnit(CUnit* unit, int modelType, bool drawGhostBuildingsPass) {
-	if (!camera->InView(unit->drawMidPos, unit->GetDrawRadius()))
+	// cloaked units were already frustum-tested by UpdateVisibleUnits
+	if (drawGhostBuildingsPass && !camera->InView(unit->drawMidPos, unit->GetDrawRadius()))
 		return;
 
 	if (LuaObjectDrawer::AddAlphaMaterialObject(unit, LUAOBJ_UNIT))
@@ -1497,49 +1652,6 @@ void CUnitDrawer::DrawUnitDefTrans(const CUnit* unit, bool lodCall, bool noLuaCa
 
 
 
-inline void CUnitDrawer::UpdateUnitIconState(CUnit* unit) {
-	const unsigned short losStatus = unit->losStatus[gu->myAllyTeam];
-
-	// reset
-	unit->isIcon = ((losStatus & LOS_INRADAR) != 0);
-
-	if ((losStatus & LOS_INLOS) != 0 || gu->spectatingFullView)
-		unit->isIcon = DrawAsIcon(unit, (unit->pos - camera->GetPos()).SqLength());
-}
-
-inline void CUnitDrawer::UpdateUnitDrawPos(CUnit* u) {
-	const CUnit* t = u->GetTransporter();
-
-	if (t != nullptr) {
-		u->drawPos = u->GetDrawPos(t->speed, globalRendering->timeOffset);
-	} else {
-		u->drawPos = u->GetDrawPos(          globalRendering->timeOffset);
-	}
-
-	u->drawMidPos = u->GetMdlDrawMidPos();
-}
-
-
-
-bool CUnitDrawer::DrawAsIcon(const CUnit* unit, const float sqUnitCamDist) const {
-
-	const float sqIconDistMult = unit->unitDef->iconType->GetDistanceSqr();
-	const float realIconLength = iconLength * sqIconDistMult;
-	const float iconRefCamDist = mix(sqUnitCamDist, sqCamDistToGroundForIcons, useDistToGroundForIcons);
-
-	bool asIcon = (iconRefCamDist > realIconLength);
-
-	asIcon &= (!unit->noDraw);
-	asIcon &= (!unit->IsInVoid());
-	// drawing icons is cheap but not free, avoid a perf-hit when many are offscreen
-	asIcon &= (camera->InView(unit->drawMidPos, unit->GetDrawRadius()));
-
-	return asIcon;
-}
-
-
-
-
 void CUnitDrawer::SetupShowUnitBuildSquares(bool onMiniMap, bool testCanBuild)
 {
 	if (!testCanBuild)
@@ -1824,6 +1936,8 @@ void CUnitDrawer::RenderUnitCreated(const CUnit* u, int cloaked) {
 
 	UpdateUnitMiniMapIcon(u, false, false);
 	unsortedUnits.push_back(unit);
+
+	drawStates.dirty = true;
 }
 
 void CUnitDrawer::RenderUnitDestroyed(const CUnit* unit) {
@@ -1875,6 +1989,8 @@ void CUnitDrawer::RenderUnitDestroyed(const CUnit* unit) {
 
 	spring::VectorErase(unsortedUnits, u);
 
+	drawStates.dirty = true;
+
 	UpdateUnitMiniMapIcon(unit, false, true);
 	LuaObjectDrawer::SetObjectLOD(u, LUAOBJ_UNIT, 0);
 }
@@ -4,15 +4,20 @@
 #define UNIT_DRAWER_H
 
 #include <array>
+#include <cinttypes>
 #include <vector>
 #include <functional>
+#include <future>
+#include <memory>
 
+#include "Rendering/Culling.h"
 #include "Rendering/GL/LightHandler.h"
 #include "Rendering/GL/RenderDataBufferFwd.hpp"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Models/ModelRenderContainer.h"
 #include "Rendering/UnitDrawerState.hpp"
 #include "Rendering/UnitDefImage.h"
+#include "Rendering/VisibleObjectLists.h"
 #include "System/EventClient.h"
 #include "System/type2.h"
 #include "System/UnorderedMap.hpp"
@@ -21,6 +26,7 @@ struct SolidObjectDef;
 struct UnitDef;
 struct S3DModel;
 
+class CCamera;
 class CSolidObject;
 class CUnit;
 
@@ -95,7 +101,12 @@ public:
 	void Init();
 	void Kill();
 
+	/// starts updating unit draw-state (icons, interpolated positions) on worker threads
 	void Update();
+	/// waits for the update started by Update; must be called before draw-state is read
+	void FinishUpdate();
+	/// units were changed by synced code outside of SimFrame (e.g. LuaRules handling a Lua message)
+	void SetDrawStatesDirty() { drawStates.dirty = true; }
 
 	void UpdateGhostedBuildings();
 
@@ -200,8 +211,13 @@ public:
 	void UpdateTempDrawUnits(std::vector<TempDrawUnit>& tempDrawUnits);
 
 private:
-	/// Returns true if the given unit should be drawn as icon in the current frame.
-	bool DrawAsIcon(const CUnit* unit, const float sqUnitCamDist) const;
+	/// copies the sim-state of unsortedUnits[beg, end) into drawStates
+	void RefreshUnitDrawStates(size_t beg, size_t end);
+	/// interpolates draw-positions and picks icons for unsortedUnits[beg, end)
+	void UpdateUnitDrawStates(const CCamera* cam, const Culling::Frustum& frustum, size_t beg, size_t end, bool refresh);
+
+	/// builds the visible-unit lists for <cam> if this has not been done yet this frame
+	void UpdateVisibleUnits(const CCamera* cam);
 
 	bool CanDrawOpaqueUnit(const CUnit* unit, bool drawReflection, bool drawRefraction) const;
 	bool CanDrawOpaqueUnitShadow(const CUnit* unit) const;
@@ -228,10 +244,8 @@ public:
 
 private:
 	void UpdateUnitMiniMapIcon(const CUnit* unit, bool forced, bool killed);
-	void UpdateUnitIconState(CUnit* unit);
 
 	static void DrawUnitIcon(CUnit* unit, GL::RenderDataBufferTC* buffer, bool asRadarBlip);
-	static void UpdateUnitDrawPos(CUnit* unit);
 
 public:
 	static void BindModelTypeTexture(int mdlType, int texType);
@@ -299,9 +313,41 @@ private:
 	std::array<ModelRenderContainer<CUnit>, MODELTYPE_OTHER> opaqueModelRenderers;
 	std::array<ModelRenderContainer<CUnit>, MODELTYPE_OTHER> alphaModelRenderers;
 
+	/// per-camera subsets of the above that pass the frustum (and LOS) tests
+	CVisibleObjectLists<CUnit> opaqueVisibleUnits;
+	CVisibleObjectLists<CUnit> alphaVisibleUnits;
+
 	/// units being rendered (note that this is a completely
 	/// unsorted set of 3DO, S3O, opaque, and cloaked models!)
 	std::vector<CUnit*> unsortedUnits;
+	/// draw-state update slices in flight between Update and FinishUpdate
+	std::vector< std::shared_ptr< std::future<void> > > pendingUpdates;
+
+	/// SoA mirror of the unit state Update interpolates from, in
+	/// unsortedUnits order; only refreshed once per simulated frame
+	struct UnitDrawStates {
+		void Resize(size_t n);
+
+		std::vector<float> posX, posY, posZ;
+		// speed, or that of the unit's transporter
+		std::vector<float> spdX, spdY, spdZ;
+		// model mid-position relative to pos, in world-space
+		std::vector<float> midX, midY, midZ;
+		// icon draw-distance multipliers (squared)
+		std::vector<float> iconDists;
+
+		// interpolated draw-positions and (with draw-radii) -midpoints
+		std::vector<float> drawX, drawY, drawZ;
+		Culling::Spheres drawMidSpheres;
+
+		std::vector<std::uint8_t> inViewMask;
+		std::vector<std::uint8_t> farIconMask;
+
+		int simFrame = -1;
+		bool dirty = true;
+	};
+
+	UnitDrawStates drawStates;
 
 	/// AI unit ghosts
 	std::array< std::vector<TempDrawUnit>, MODELTYPE_OTHER> tempOpaqueUnits;
@@ -0,0 +1,181 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef VISIBLE_OBJECT_LISTS_HDR
+#define VISIBLE_OBJECT_LISTS_HDR
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cinttypes>
+#include <vector>
+
+#include "Game/Camera.h"
+#include "Rendering/Culling.h"
+#include "Rendering/GlobalRendering.h"
+#include "Rendering/Models/ModelRenderContainer.h"
+#include "System/float4.h"
+#include "System/Threading/ThreadPool.h"
+
+/**
+ * Per-camera subsets of a drawer's ModelRenderContainer bins (plus at most
+ * one unsorted bin) that pass the drawer's cheap per-object tests and the
+ * frustum. Built at most once per camera-type per frame: all objects are
+ * gathered into SoA spheres and culled in parallel, each pass that renders
+ * through the same camera (e.g. the opaque and refraction passes) then just
+ * walks the per-bin lists in texture order.
+ */
+template<typename TObject>
+class CVisibleObjectLists {
+public:
+	typedef std::vector<TObject*> ObjectBin;
+	typedef std::array<ModelRenderContainer<TObject>, MODELTYPE_OTHER> ModelContainers;
+
+private:
+	// PLAYER, UWREFL and SHADOW get a slot each, anything else shares one
+	static constexpr unsigned int CAM_LISTS_CNT = CCamera::CAMTYPE_ENVMAP + 1;
+	static constexpr int GATHER_GRAIN_SIZE = 256;
+
+	// first flattened bin of each container, [MODELTYPE_OTHER] is the unsorted one
+	typedef std::array<size_t, MODELTYPE_OTHER + 1> BinOffsets;
+
+public:
+	void Init() {
+		for (CamLists& camLists: camObjectLists) {
+			camLists.drawFrame = -1u;
+
+			for (ObjectBin& bin: camLists.bins) {
+				bin.clear();
+			}
+		}
+	}
+	void Kill() {}
+
+	/**
+	 * Rebuilds the lists for <cam> unless that already happened this frame
+	 * for the same frustum. <preFilter> is a bool(const TObject*) predicate,
+	 * <getSphere> a float4(TObject*) returning the (draw-)position and radius;
+	 * both are run in parallel and must only read shared state.
+	 */
+	template<typename PreFilter, typename GetSphere>
+	void Update(
+		const CCamera* cam,
+		const ModelContainers& containers,
+		const ObjectBin* unsortedBin,
+		PreFilter preFilter,
+		GetSphere getSphere
+	) {
+		CamLists& camLists = camObjectLists[std::min(cam->GetCamType(), CAM_LISTS_CNT - 1u)];
+		const Culling::Frustum frustum(cam);
+
+		if (camLists.drawFrame == globalRendering->drawFrame && camLists.frustum == frustum)
+			return;
+
+		camLists.drawFrame = globalRendering->drawFrame;
+		camLists.frustum = frustum;
+
+		GatherObjects(containers, unsortedBin, camLists.modelBinOffsets);
+
+		mask.resize(objects.size());
+		spheres.Resize(objects.size());
+
+		parallel_for(0, objects.size(), GATHER_GRAIN_SIZE, [&](const int i) {
+			const float4 sphere = getSphere(objects[i]);
+
+			mask[i] = preFilter(objects[i]);
+			spheres.Set(i, sphere, sphere.w);
+		});
+
+		Culling::CullSpheres(frustum, spheres, mask);
+		assert(Culling::CheckSpheres(cam, spheres));
+
+		camLists.bins.resize(binOffsets.size() - 1);
+
+		for (size_t i = 0, n = binOffsets.size() - 1; i < n; i++) {
+			ObjectBin& bin = camLists.bins[i];
+
+			bin.clear();
+
+			for (size_t j = binOffsets[i]; j < binOffsets[i + 1]; j++) {
+				if (mask[j] == 0)
+					continue;
+
+				bin.push_back(objects[j]);
+			}
+		}
+	}
+
+	/// visible subset of GetObjectBin(<binIdx>) of the <modelType> container
+	const ObjectBin& GetModelBin(const CCamera* cam, int modelType, unsigned int binIdx) const {
+		return (GetBin(cam, modelType, binIdx));
+	}
+	/// visible subset of the unsorted bin passed to Update
+	const ObjectBin& GetUnsortedBin(const CCamera* cam) const {
+		return (GetBin(cam, MODELTYPE_OTHER, 0));
+	}
+
+private:
+	void GatherObjects(const ModelContainers& containers, const ObjectBin* unsortedBin, BinOffsets& modelBinOffsets) {
+		objects.clear();
+		binOffsets.clear();
+
+		for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_OTHER; modelType++) {
+			const ModelRenderContainer<TObject>& container = containers[modelType];
+
+			modelBinOffsets[modelType] = binOffsets.size();
+
+			for (unsigned int i = 0, n = container.GetNumObjectBins(); i < n; i++) {
+				const ObjectBin& bin = container.GetObjectBin(i);
+
+				binOffsets.push_back(objects.size());
+				objects.insert(objects.end(), bin.begin(), bin.end());
+			}
+		}
+
+		modelBinOffsets[MODELTYPE_OTHER] = binOffsets.size();
+
+		if (unsortedBin != nullptr) {
+			binOffsets.push_back(objects.size());
+			objects.insert(objects.end(), unsortedBin->begin(), unsortedBin->end());
+		}
+
+		binOffsets.push_back(objects.size());
+	}
+
+	const ObjectBin& GetBin(const CCamera* cam, int modelType, unsigned int binIdx) const {
+		const CamLists& camLists = camObjectLists[std::min(cam->GetCamType(), CAM_LISTS_CNT - 1u)];
+
+		// lists from an earlier frame may hold dead objects
+		if (camLists.drawFrame != globalRendering->drawFrame)
+			return emptyBin;
+
+		binIdx += camLists.modelBinOffsets[modelType];
+
+		// bins added since Update (or the unsorted one if none was passed)
+		if (binIdx >= camLists.bins.size())
+			return emptyBin;
+
+		return camLists.bins[binIdx];
+	}
+
+private:
+	struct CamLists {
+		Culling::Frustum frustum;
+		BinOffsets modelBinOffsets = {};
+
+		unsigned int drawFrame = -1u;
+
+		std::vector<ObjectBin> bins;
+	};
+
+	std::array<CamLists, CAM_LISTS_CNT> camObjectLists;
+
+	// scratch-space shared by all cameras
+	std::vector<TObject*> objects;
+	std::vector<size_t> binOffsets;
+	std::vector<std::uint8_t> mask;
+
+	Culling::Spheres spheres;
+	ObjectBin emptyBin;
+};
+
+#endif
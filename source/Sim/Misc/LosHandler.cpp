@@ -686,6 +686,8 @@ void CLosHandler::Init()
 	baseRadarErrorSize = defBaseRadarErrorSize;
 	baseRadarErrorMult = defBaseRadarErrorMult;
 
+	CLosMap::InitThreadTables();
+
 	los.Init(modInfo.losMipLevel, ILosType::LOS_TYPE_LOS);
 	airLos.Init(modInfo.airMipLevel, ILosType::LOS_TYPE_AIRLOS);
 	radar.Init(modInfo.radarMipLevel, ILosType::LOS_TYPE_RADAR);
@@ -19,10 +19,11 @@ constexpr float LOS_BONUS_HEIGHT = 5.0f;
 
 
 
-static std::array<std::vector<float>, ThreadPool::MAX_THREADS> RADIUS_ISQRT_TABLES;
+// all per-thread, sized by CLosMap::InitThreadTables
+static std::vector<std::vector<float>> RADIUS_ISQRT_TABLES;
 
-static std::array<std::vector<float>, ThreadPool::MAX_THREADS> RAYCAST_ANGLE_TABLES;
-static std::array<std::vector< char>, ThreadPool::MAX_THREADS> LOSRAY_SQUARE_TABLES; // visible squares per instance
+static std::vector<std::vector<float>> RAYCAST_ANGLE_TABLES;
+static std::vector<std::vector< char>> LOSRAY_SQUARE_TABLES; // visible squares per instance
 
 
 static float isqrtTableLookup(unsigned r, int threadNum)
@@ -148,7 +149,21 @@ private:
 	static void Debug(const LosTable& losRays, const std::vector<int2>& points, int radius);
 };
 
-static std::array<CLosTableHelper, ThreadPool::MAX_THREADS> losTableHelpers;
+static std::vector<CLosTableHelper> losTableHelpers;
+
+
+
+void CLosMap::InitThreadTables()
+{
+	// never shrinks; tables generated so far stay valid across reloads
+	const size_t numThreads = std::max(losTableHelpers.size(), size_t(ThreadPool::GetMaxThreads()));
+
+	RADIUS_ISQRT_TABLES.resize(numThreads);
+	RAYCAST_ANGLE_TABLES.resize(numThreads);
+	LOSRAY_SQUARE_TABLES.resize(numThreads);
+
+	losTableHelpers.resize(numThreads);
+}
 
 
 
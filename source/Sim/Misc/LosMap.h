@@ -33,6 +33,9 @@ public:
 
 	void Kill() {}
 
+	/// sizes the per-thread raycasting tables to the ThreadPool, call before any Add*
+	static void InitThreadTables();
+
 public:
 	/// circular area, for airLosMap, circular radar maps, jammer maps, ...
 	void AddCircle(SLosInstance* instance, int amount);
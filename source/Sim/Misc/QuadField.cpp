@@ -9,6 +9,9 @@
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "System/ContainerUtil.h"
+#include "System/UnorderedSet.hpp"
+#include "System/Log/ILog.h"
+#include "System/Platform/Threading.h"
 
 #ifndef UNIT_TEST
 	#include "Sim/Features/Feature.h"
@@ -48,49 +51,48 @@ CQuadField quadField;
 
 
 #ifndef UNIT_TEST
-/*
-void CQuadField::Resize(int quad_size)
-{
-	CQuadField* oldQuadField = &quadField;
-	CQuadField newQuadField;
-
-	newQuadField.Init(int2(mapDims.mapx, mapDims.mapy), quad_size);
-
-	for (int zq = 0; zq < oldQuadField->GetNumQuadsZ(); zq++) {
-		for (int xq = 0; xq < oldQuadField->GetNumQuadsX(); xq++) {
-			const CQuadField::Quad& quad = oldQuadField->GetQuadAt(xq, zq);
-
-			// COPY the object lists because the Remove* functions modify them
-			// NOTE:
-			//   teamUnits is updated internally by RemoveUnit and MovedUnit
-			//
-			//   if a unit exists in multiple quads in the old field, it will
-			//   be removed from all of them and there is no danger of double
-			//   re-insertion (important if new grid has higher resolution)
-			const std::vector<CUnit*      > units       = quad.units;
-			const std::vector<CFeature*   > features    = quad.features;
-			const std::vector<CProjectile*> projectiles = quad.projectiles;
-
-			for (auto it = units.cbegin(); it != units.cend(); ++it) {
-				oldQuadField->RemoveUnit(*it);
-				newQuadField->MovedUnit(*it); // handles addition
-			}
+namespace {
+	// Objects overlapping several quads must only be returned once. On the
+	// main thread they are marked with a fresh tempNum while being collected;
+	// since that mark is shared, queries from other threads leave it alone
+	// and remove duplicates from their results afterwards.
+	class QueryMarker {
+	public:
+		QueryMarker()
+			: mainThread(Threading::IsMainThread())
+			, tempNum(mainThread? gs->GetTempNum(): 0)
+		{}
+
+		template<typename T> bool Mark(T* object) const {
+			if (!mainThread)
+				return true;
+			if (object->tempNum == tempNum)
+				return false;
+
+			object->tempNum = tempNum;
+			return true;
+		}
 
-			for (auto it = features.cbegin(); it != features.cend(); ++it) {
-				oldQuadField->RemoveFeature(*it);
-				newQuadField->AddFeature(*it);
-			}
+		template<typename T> void RemoveDuplicates(std::vector<T*>& objects, size_t first = 0) const {
+			if (mainThread)
+				return;
 
-			for (auto it = projectiles.cbegin(); it != projectiles.cend(); ++it) {
-				oldQuadField->RemoveProjectile(*it);
-				newQuadField->AddProjectile(*it);
-			}
+			// keep the first occurrence of each object, so the result is in
+			// the same (deterministic) order a main-thread query would have
+			static thread_local spring::unsynced_set<const void*> seen;
+
+			seen.clear();
+			seen.reserve(objects.size() - first);
+
+			const auto pred = [](const T* object) { return !seen.insert(object).second; };
+			objects.erase(std::remove_if(objects.begin() + first, objects.end(), pred), objects.end());
 		}
-	}
 
-	quadField = std::move(newQuadField);
+	private:
+		const bool mainThread;
+		const int tempNum;
+	};
 }
-*/
 #endif
 
 
@@ -118,8 +120,6 @@ void CQuadField::Init(int2 mapDims, int quadSize)
 	assert((mapDims.y * SQUARE_SIZE) % quadSize == 0);
 
 	baseQuads.resize(numQuadsX * numQuadsZ);
-	tempQuads.ReserveAll(numQuadsX * numQuadsZ);
-	tempQuads.ReleaseAll();
 
 #ifndef UNIT_TEST
 	for (Quad& quad: baseQuads) {
@@ -144,6 +144,119 @@ void CQuadField::Kill()
 }
 
 
+#ifndef UNIT_TEST
+void CQuadField::Update()
+{
+	if ((gs->frameNum % RESIZE_CHECK_RATE) != 0)
+		return;
+
+	size_t numObjects = 0;
+	size_t numLoadedQuads = 0;
+
+	for (const Quad& quad: baseQuads) {
+		const size_t n = quad.units.size() + quad.features.size() + quad.projectiles.size();
+
+		numObjects += n;
+		numLoadedQuads += (n > 0);
+	}
+
+	if (numLoadedQuads == 0)
+		return;
+
+	const float meanLoad = numObjects * 1.0f / numLoadedQuads;
+
+	// halving the size spreads the load over about four times as many
+	// quads, which stays above MIN_QUAD_LOAD so this does not oscillate
+	if (meanLoad > MAX_QUAD_LOAD && quadSizeX > MIN_QUAD_SIZE) {
+		Resize(quadSizeX / 2);
+		return;
+	}
+	if (meanLoad < MIN_QUAD_LOAD && quadSizeX < BASE_QUAD_SIZE) {
+		Resize(quadSizeX * 2);
+		return;
+	}
+}
+
+void CQuadField::Resize(int quadSize)
+{
+	const int2 mapSize = {numQuadsX * quadSizeX, numQuadsZ * quadSizeZ};
+
+	if (quadSize == quadSizeX)
+		return;
+	if ((mapSize.x % quadSize) != 0 || (mapSize.y % quadSize) != 0)
+		return;
+
+	std::vector<CUnit*> units;
+	std::vector<CFeature*> features;
+	std::vector<CProjectile*> projectiles;
+	std::vector<CPlasmaRepulser*> repulsers;
+
+	{
+		// collect every object once, in quad order to keep this deterministic
+		const QueryMarker marker;
+
+		for (Quad& quad: baseQuads) {
+			for (CUnit* u: quad.units) {
+				if (marker.Mark(u))
+					units.push_back(u);
+			}
+			for (CFeature* f: quad.features) {
+				if (marker.Mark(f))
+					features.push_back(f);
+			}
+			for (CProjectile* p: quad.projectiles) {
+				if (marker.Mark(p))
+					projectiles.push_back(p);
+			}
+			for (CPlasmaRepulser* r: quad.repulsers) {
+				if (marker.Mark(r))
+					repulsers.push_back(r);
+			}
+
+			quad.Clear();
+		}
+	}
+
+	// the quad indices cached by the objects refer to the old layout
+	for (CUnit* u: units) {
+		u->quads.clear();
+	}
+	for (CProjectile* p: projectiles) {
+		p->quads.clear();
+	}
+	for (CPlasmaRepulser* r: repulsers) {
+		r->ClearQuads();
+	}
+
+	quadSizeX = quadSize;
+	quadSizeZ = quadSize;
+	numQuadsX = mapSize.x / quadSize;
+	numQuadsZ = mapSize.y / quadSize;
+
+	baseQuads.resize(numQuadsX * numQuadsZ);
+
+	for (Quad& quad: baseQuads) {
+		quad.Resize(teamHandler.ActiveAllyTeams());
+	}
+
+	for (CUnit* u: units) {
+		MovedUnit(u);
+	}
+	for (CFeature* f: features) {
+		AddFeature(f);
+	}
+	for (CProjectile* p: projectiles) {
+		AddProjectile(p);
+	}
+	for (CPlasmaRepulser* r: repulsers) {
+		MovedRepulser(r);
+	}
+
+	LOG("[QuadField::%s] %dx%d quads of size %d", __func__, numQuadsX, numQuadsZ, quadSize);
+}
+#endif
+
+
 int2 CQuadField::WorldPosToQuadField(const float3 p) const
 {
 	return int2(
@@ -466,36 +579,32 @@ void CQuadField::GetUnits(QuadFieldQuery& qfq, const float3& pos, float radius)
 {
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.units = tempUnits.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
+			if (!marker.Mark(u))
 				continue;
-
-			u->tempNum = tempNum;
 			qfq.units->push_back(u);
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.units);
 }
 
 void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float radius, bool spherical)
 {
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.units = tempUnits.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
+			if (!marker.Mark(u))
 				continue;
 
-			u->tempNum = tempNum;
-
 			const float totRad       = radius + u->radius;
 			const float totRadSq     = totRad * totRad;
 			const float posUnitDstSq = spherical?
@@ -509,24 +618,22 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float rad
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.units);
 }
 
 void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs)
 {
 	QuadFieldQuery qfQuery;
 	GetQuadsRectangle(qfQuery, mins, maxs);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.units = tempUnits.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* unit: baseQuads[qi].units) {
 
-			if (unit->tempNum == tempNum)
+			if (!marker.Mark(unit))
 				continue;
 
-			unit->tempNum = tempNum;
-
 			const float3& pos = unit->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
 				continue;
@@ -537,7 +644,72 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const fl
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.units);
+}
+
+
+template<typename UnitTest>
+static void GetAllyTeamUnits(
+	const std::vector<CQuadField::Quad>& quads,
+	const std::vector<int>& quadIndices,
+	const QuadFieldAllyFilter& filter,
+	std::vector<CUnit*>& units,
+	UnitTest unitTest
+) {
+	const QueryMarker marker;
+
+	for (const int qi: quadIndices) {
+		const auto& teamUnits = quads[qi].teamUnits;
+
+		for (size_t t = 0; t < teamUnits.size(); ++t) {
+			if (!filter.Includes(t))
+				continue;
+
+			const bool needLos = filter.NeedsLos(t);
+
+			for (CUnit* u: teamUnits[t]) {
+				if (!marker.Mark(u))
+					continue;
+
+				if (needLos && (u->losStatus[filter.losAllyTeam] & filter.losBits) == 0)
+					continue;
+				if (!unitTest(u))
+					continue;
+
+				units.push_back(u);
+			}
+		}
+	}
+
+	marker.RemoveDuplicates(units);
+}
+
+void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float radius, bool spherical, const QuadFieldAllyFilter& filter)
+{
+	QuadFieldQuery qfQuery;
+	GetQuads(qfQuery, pos, radius);
+	qfq.units = tempUnits.ReserveVector();
+
+	GetAllyTeamUnits(baseQuads, *qfQuery.quads, filter, *qfq.units, [&](const CUnit* u) {
+		const float totRad       = radius + u->radius;
+		const float posUnitDstSq = spherical?
+			pos.SqDistance(u->pos):
+			pos.SqDistance2D(u->pos);
+
+		return (posUnitDstSq < (totRad * totRad));
+	});
+}
+
+void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs, const QuadFieldAllyFilter& filter)
+{
+	QuadFieldQuery qfQuery;
+	GetQuadsRectangle(qfQuery, mins, maxs);
+	qfq.units = tempUnits.ReserveVector();
+
+	GetAllyTeamUnits(baseQuads, *qfQuery.quads, filter, *qfq.units, [&](const CUnit* u) {
+		const float3& pos = u->pos;
+		return (pos.x >= mins.x && pos.x <= maxs.x && pos.z >= mins.z && pos.z <= maxs.z);
+	});
 }
 
 
@@ -545,16 +717,14 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& pos, float
 {
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.features = tempFeatures.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CFeature* f: baseQuads[qi].features) {
-			if (f->tempNum == tempNum)
+			if (!marker.Mark(f))
 				continue;
 
-			f->tempNum = tempNum;
-
 			const float totRad       = radius + f->radius;
 			const float totRadSq     = totRad * totRad;
 			const float posDstSq = spherical?
@@ -568,23 +738,21 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& pos, float
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.features);
 }
 
 void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs)
 {
 	QuadFieldQuery qfQuery;
 	GetQuadsRectangle(qfQuery, mins, maxs);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.features = tempFeatures.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CFeature* feature: baseQuads[qi].features) {
-			if (feature->tempNum == tempNum)
+			if (!marker.Mark(feature))
 				continue;
 
-			feature->tempNum = tempNum;
-
 			const float3& pos = feature->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
 				continue;
@@ -595,7 +763,7 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& mins, const
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.features);
 }
 
 
@@ -604,16 +772,14 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& pos, flo
 {
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.projectiles = tempProjectiles.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CProjectile* p: baseQuads[qi].projectiles) {
-			if (p->tempNum == tempNum)
+			if (!marker.Mark(p))
 				continue;
 
-			p->tempNum = tempNum;
-
 			if (pos.SqDistance(p->pos) >= Square(radius + p->radius))
 				continue;
 
@@ -621,23 +787,21 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& pos, flo
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.projectiles);
 }
 
 void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs)
 {
 	QuadFieldQuery qfQuery;
 	GetQuadsRectangle(qfQuery, mins, maxs);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.projectiles = tempProjectiles.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CProjectile* p: baseQuads[qi].projectiles) {
-			if (p->tempNum == tempNum)
+			if (!marker.Mark(p))
 				continue;
 
-			p->tempNum = tempNum;
-
 			const float3& pos = p->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
 				continue;
@@ -648,7 +812,7 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& mins, co
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.projectiles);
 }
 
 
@@ -662,16 +826,14 @@ void CQuadField::GetSolidsExact(
 ) {
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 	qfq.solids = tempSolids.ReserveVector();
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
+			if (!marker.Mark(u))
 				continue;
 
-			u->tempNum = tempNum;
-
 			if (!u->HasPhysicalStateBit(physicalStateBits))
 				continue;
 			if (!u->HasCollidableStateBit(collisionStateBits))
@@ -683,11 +845,9 @@ void CQuadField::GetSolidsExact(
 		}
 
 		for (CFeature* f: baseQuads[qi].features) {
-			if (f->tempNum == tempNum)
+			if (!marker.Mark(f))
 				continue;
 
-			f->tempNum = tempNum;
-
 			if (!f->HasPhysicalStateBit(physicalStateBits))
 				continue;
 			if (!f->HasCollidableStateBit(collisionStateBits))
@@ -699,7 +859,7 @@ void CQuadField::GetSolidsExact(
 		}
 	}
 
-	return;
+	marker.RemoveDuplicates(*qfq.solids);
 }
 
 
@@ -711,15 +871,13 @@ bool CQuadField::NoSolidsExact(
 ) {
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
+			if (!marker.Mark(u))
 				continue;
 
-			u->tempNum = tempNum;
-
 			if (!u->HasPhysicalStateBit(physicalStateBits))
 				continue;
 			if (!u->HasCollidableStateBit(collisionStateBits))
@@ -731,11 +889,9 @@ bool CQuadField::NoSolidsExact(
 		}
 
 		for (CFeature* f: baseQuads[qi].features) {
-			if (f->tempNum == tempNum)
+			if (!marker.Mark(f))
 				continue;
 
-			f->tempNum = tempNum;
-
 			if (!f->HasPhysicalStateBit(physicalStateBits))
 				continue;
 			if (!f->HasCollidableStateBit(collisionStateBits))
@@ -759,22 +915,23 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 	std::vector<CFeature*>& features,
 	std::vector<CPlasmaRepulser*>* repulsers
 ) {
-	const int tempNum = gs->GetTempNum();
+	const QueryMarker marker;
 
 	QuadFieldQuery qfQuery;
 	GetQuads(qfQuery, pos, radius);
 	// start counting from the previous object-cache sizes
+	const size_t numUnits = units.size();
+	const size_t numFeatures = features.size();
+	const size_t numRepulsers = (repulsers != nullptr)? repulsers->size(): 0;
 
 	for (const int qi: *qfQuery.quads) {
 		const Quad& quad = baseQuads[qi];
 
 		for (CUnit* u: quad.units) {
 			// prevent double adding
-			if (u->tempNum == tempNum)
+			if (!marker.Mark(u))
 				continue;
 
-			u->tempNum = tempNum;
-
 			const auto* colvol = &u->collisionVolume;
 			const float totRad = radius + colvol->GetBoundingRadius();
 
@@ -786,11 +943,9 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 
 		for (CFeature* f: quad.features) {
 			// prevent double adding
-			if (f->tempNum == tempNum)
+			if (!marker.Mark(f))
 				continue;
 
-			f->tempNum = tempNum;
-
 			const auto* colvol = &f->collisionVolume;
 			const float totRad = radius + colvol->GetBoundingRadius();
 
@@ -802,11 +957,9 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 		if (repulsers != nullptr) {
 			for (CPlasmaRepulser* r: quad.repulsers) {
 				// prevent double adding
-				if (r->tempNum == tempNum)
+				if (!marker.Mark(r))
 					continue;
 
-				r->tempNum = tempNum;
-
 				const auto* colvol = &r->collisionVolume;
 				const float totRad = radius + colvol->GetBoundingRadius();
 
@@ -817,5 +970,11 @@ void CQuadField::GetUnitsAndFeaturesColVol(
 			}
 		}
 	}
+
+	marker.RemoveDuplicates(units, numUnits);
+	marker.RemoveDuplicates(features, numFeatures);
+
+	if (repulsers != nullptr)
+		marker.RemoveDuplicates(*repulsers, numRepulsers);
 }
 #endif // UNIT_TEST
@@ -5,9 +5,13 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
+#include <deque>
 #include <vector>
 
+#include "Sim/Misc/GlobalConstants.h"
 #include "System/Misc/NonCopyable.h"
+#include "System/Threading/SpringThreading.h"
 #include "System/creg/creg_cond.h"
 #include "System/float3.h"
 #include "System/type2.h"
@@ -19,36 +23,63 @@ class CSolidObject;
 class CPlasmaRepulser;
 struct QuadFieldQuery;
 
+/**
+ * Selects the per-allyteam unit buckets (Quad::teamUnits) walked by the
+ * masked GetUnitsExact overloads, so queries for eg. enemy units never
+ * have to look at (and filter out) friendly ones.
+ */
+struct QuadFieldAllyFilter {
+public:
+	/// includes the units of <allyTeam>, requiring them to be in <losAllyTeam>'s sensors if <needLos>
+	void Include(int allyTeam, bool needLos = false) {
+		allyTeams.set(allyTeam);
+		losAllyTeams.set(allyTeam, needLos);
+	}
+
+	/// units from ally-teams included with needLos must have one of <bits> (LOS_IN*) set for <allyTeam>
+	void SetLosTest(int allyTeam, unsigned short bits) {
+		losAllyTeam = allyTeam;
+		losBits = bits;
+	}
+
+	bool Includes(int allyTeam) const { return allyTeams.test(allyTeam); }
+	bool NeedsLos(int allyTeam) const { return losAllyTeams.test(allyTeam); }
+
+public:
+	std::bitset<MAX_TEAMS> allyTeams;
+	std::bitset<MAX_TEAMS> losAllyTeams;
+
+	int losAllyTeam = 0;
+	unsigned short losBits = 0;
+};
+
 template<typename T>
 class QueryVectorCache {
 public:
 	typedef std::pair<bool, std::vector<T>> PairType;
 
-	std::vector<T>* ReserveVector(size_t base = 0, size_t capa = 1024) {
-		const auto pred = [](const PairType& p) { return (!p.first); };
-		const auto iter = std::find_if(vectors.begin() + base, vectors.end(), pred);
+	std::vector<T>* ReserveVector(size_t capa = 1024) {
+		std::lock_guard<spring::spinlock> lock(mutex);
 
-		if (iter != vectors.end()) {
-			iter->first = true;
-			iter->second.clear();
-			iter->second.reserve(capa);
-			return &iter->second;
-		}
+		const auto pred = [](const PairType& p) { return (!p.first); };
+		const auto iter = std::find_if(vectors.begin(), vectors.end(), pred);
 
-		assert(false);
-		return nullptr;
-	}
+		// grow on demand, there is no fixed limit on concurrent queries
+		// (deque elements keep their addresses when more are added)
+		PairType& pair = (iter != vectors.end())? *iter: *vectors.emplace(vectors.end());
 
-	void ReserveAll(size_t capa) {
-		for (size_t i = 0; i < vectors.size(); ++i) {
-			ReserveVector(i, capa);
-		}
+		pair.first = true;
+		pair.second.clear();
+		pair.second.reserve(capa);
+		return &pair.second;
 	}
 
 	void ReleaseVector(const std::vector<T>* released) {
 		if (released == nullptr)
 			return;
 
+		std::lock_guard<spring::spinlock> lock(mutex);
+
 		const auto pred = [&](const PairType& p) { return (&p.second == released); };
 		const auto iter = std::find_if(vectors.begin(), vectors.end(), pred);
 
@@ -60,15 +91,17 @@ public:
 		iter->first = false;
 	}
 	void ReleaseAll() {
+		std::lock_guard<spring::spinlock> lock(mutex);
+
 		for (auto& pair: vectors) {
-			ReleaseVector(&pair.second);
+			pair.first = false;
 		}
 	}
 private:
-	// There should at most be 2 concurrent users of each vector type
-	// using 3 to be safe, increase this number if the assertions below
-	// fail
-	std::array<PairType, 3> vectors = {{{false, {}}, {false, {}}, {false, {}}}};
+	// queries may come from any thread
+	spring::spinlock mutex;
+
+	std::deque<PairType> vectors;
 };
 
 
@@ -80,18 +113,19 @@ class CQuadField : spring::noncopyable
 
 public:
 
-	/*
-	needed to support dynamic resizing (not used yet)
-	in large games the average loading factor (number of objects per quad)
-	can grow too large to maintain amortized constant performance so more
-	quads are needed
-
-	static void Resize(int quadSize);
-	*/
-
 	void Init(int2 mapDims, int quadSize);
 	void Kill();
 
+	/**
+	 * In large games the average loading factor (number of objects per
+	 * quad) can grow too large to maintain amortized constant performance,
+	 * so every RESIZE_CHECK_RATE frames this halves or doubles the quad
+	 * size within [MIN_QUAD_SIZE, BASE_QUAD_SIZE] as needed.
+	 * Quad indices obtained before a call are invalid after it.
+	 */
+	void Update();
+	void Resize(int quadSize);
+
 	void GetQuads(QuadFieldQuery& qfq, float3 pos, float radius);
 	void GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, const float3& maxs);
 	void GetQuadsOnRay(QuadFieldQuery& qfq, const float3& start, const float3& dir, float length);
@@ -120,6 +154,12 @@ public:
 	 * mins and maxs, which extends infinitely along the y-axis
 	 */
 	void GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs);
+	/**
+	 * As above, but only walks the buckets of the ally-teams included
+	 * in @c filter and applies its sensor test
+	 */
+	void GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float radius, bool spherical, const QuadFieldAllyFilter& filter);
+	void GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const float3& maxs, const QuadFieldAllyFilter& filter);
 	/**
 	 * Returns all features within @c radius of @c pos,
 	 * takes the 3D model radius of each feature into account,
@@ -226,6 +266,13 @@ public:
 	int GetQuadSizeZ() const { return quadSizeZ; }
 
 	constexpr static unsigned int BASE_QUAD_SIZE = 128;
+	constexpr static unsigned int MIN_QUAD_SIZE = BASE_QUAD_SIZE / 4;
+
+	// mean number of objects per non-empty quad that triggers halving (doubling) the quad size
+	constexpr static float MAX_QUAD_LOAD = 32.0f;
+	constexpr static float MIN_QUAD_LOAD = 4.0f;
+
+	constexpr static int RESIZE_CHECK_RATE = GAME_SPEED * 10;
 
 private:
 	int2 WorldPosToQuadField(const float3 p) const;
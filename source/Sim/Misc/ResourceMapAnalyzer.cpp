@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
 #include <string>
 #include <cstdio>
 
@@ -18,14 +19,18 @@ using std::fclose;
 #include "Game/GameSetup.h"
 #include "Map/MapInfo.h"
 #include "Map/MetalMap.h"
+#include "Map/ReadMap.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/SpringMath.h"
 
 #include <stdexcept>
 
 static constexpr float3 ERRORVECTOR(-1, 0, 0);
+// world-space size of a spot-grid cell
+static constexpr float SPOT_GRID_CELL_SIZE = SQUARE_SIZE * 64.0f;
 static std::string CACHE_BASE("");
 
 CResourceMapAnalyzer::CResourceMapAnalyzer(int resourceId)
@@ -71,41 +76,116 @@ float3 CResourceMapAnalyzer::GetNearestSpot(int builderUnitId, const UnitDef* ex
 }
 
 float3 CResourceMapAnalyzer::GetNearestSpot(float3 fromPos, int team, const UnitDef* extractor) const {
+	return (FindNearestSpot(fromPos, team, extractor, nullptr));
+}
+
+void CResourceMapAnalyzer::GetNearestSpots(const std::vector<float3>& fromPositions, int team, const UnitDef* extractor, std::vector<float3>& nearestSpots) const {
+	BuildSiteCache cache;
+	cache.sites.resize(vectoredSpots.size());
+	cache.tested.resize(vectoredSpots.size(), false);
+
+	nearestSpots.clear();
+	nearestSpots.reserve(fromPositions.size());
+
+	for (const float3& fromPos: fromPositions) {
+		nearestSpots.push_back(FindNearestSpot(fromPos, team, extractor, &cache));
+	}
+}
+
+float3 CResourceMapAnalyzer::FindNearestSpot(const float3& fromPos, int team, const UnitDef* extractor, BuildSiteCache* cache) const {
+	struct Candidate {
+		bool operator < (const Candidate& c) const { return (score < c.score); }
 
-	float tempScore = 0.0f;
-	float maxDivergence = 16.0f;
-	float3 spotCoords = ERRORVECTOR;
+		float score; // upper bound
+		int index;   // grid-cell if isCell, else spot
+		bool isCell;
+	};
+
+	constexpr float maxDivergence = 16.0f;
+	constexpr float distanceBias = 150.0f;
+
+	// furthest a build-site returned by ClosestBuildSite can be from its spot (with snapping)
+	const float siteSlack = (extractor != nullptr)? ((maxDivergence + SQUARE_SIZE * 2) * math::SQRT2): 0.0f;
+
+	const auto BoundScore = [&](float income, float distance) {
+		return (income / (std::max(0.0f, distance - siteSlack) + distanceBias));
+	};
+
+	float bestScore = 0.0f;
+	int bestIndex = -1;
 	float3 bestSpot = ERRORVECTOR;
 
-	for (size_t i = 0; i < vectoredSpots.size(); ++i) {
-		if (extractor != nullptr) {
-			spotCoords = CGameHelper::ClosestBuildSite(team, extractor, vectoredSpots[i], maxDivergence, 2);
-		} else {
-			spotCoords = vectoredSpots[i];
+	std::vector<Candidate> queue;
+	queue.reserve(spotGridIncomes.size());
+
+	for (int z = 0; z < spotGridSizeZ; z++) {
+		for (int x = 0; x < spotGridSizeX; x++) {
+			const int cellIdx = z * spotGridSizeX + x;
+
+			if (spotGridOffsets[cellIdx] == spotGridOffsets[cellIdx + 1])
+				continue;
+
+			const float cx = Clamp(fromPos.x, x * SPOT_GRID_CELL_SIZE, (x + 1) * SPOT_GRID_CELL_SIZE);
+			const float cz = Clamp(fromPos.z, z * SPOT_GRID_CELL_SIZE, (z + 1) * SPOT_GRID_CELL_SIZE);
+
+			queue.push_back({BoundScore(spotGridIncomes[cellIdx], fromPos.distance2D(float3(cx, 0.0f, cz))), cellIdx, true});
 		}
+	}
+
+	std::make_heap(queue.begin(), queue.end());
+
+	// best-first; a candidate whose bound can not beat the current best ends
+	// the search (equal scores go to the lower spot index, as before)
+	while (!queue.empty() && queue.front().score >= bestScore) {
+		std::pop_heap(queue.begin(), queue.end());
+		const Candidate c = queue.back();
+		queue.pop_back();
+
+		if (c.isCell) {
+			for (int i = spotGridOffsets[c.index]; i < spotGridOffsets[c.index + 1]; i++) {
+				const int spotIdx = spotGridIndices[i];
+				const float3& spot = vectoredSpots[spotIdx];
 
-		if (spotCoords.x >= 0.0f) {
-			float distance = spotCoords.distance2D(fromPos) + 150;
-			//float myThreat = ai->tm->ThreatAtThisPoint(vectoredSpots[i]);
-			float spotScore = vectoredSpots[i].y / distance/* / (myThreat + 10)*/;
-			//int numEnemies = ai->cheat->GetEnemyUnits(&ai->unitIDs[0], vectoredSpots[i], xtractorRadius * 2);
-
-			// NOTE: threat at vectoredSpots[i] is determined
-			// by presence of ARMED enemy units or buildings
-			bool b1 = (tempScore < spotScore);
-// 			bool b2 = (numEnemies == 0);
-// 			bool b3 = (myThreat <= (ai->tm->GetAverageThreat() * 1.5));
-// 			bool b4 = (ai->unitHandler.TaskPlanExist(spotCoords, extractor));
-
-			if (b1/* && b2 && b3 && !b4*/) {
-				tempScore = spotScore;
-				bestSpot = spotCoords;
-				bestSpot.y = vectoredSpots[i].y;
+				queue.push_back({BoundScore(spot.y, spot.distance2D(fromPos)), spotIdx, false});
+				std::push_heap(queue.begin(), queue.end());
 			}
+
+			continue;
 		}
+
+		const float3& spot = vectoredSpots[c.index];
+		float3 spotCoords = spot;
+
+		if (extractor != nullptr) {
+			if (cache == nullptr) {
+				spotCoords = CGameHelper::ClosestBuildSite(team, extractor, spot, maxDivergence, 2);
+			} else {
+				if (!cache->tested[c.index]) {
+					cache->sites[c.index] = CGameHelper::ClosestBuildSite(team, extractor, spot, maxDivergence, 2);
+					cache->tested[c.index] = true;
+				}
+
+				spotCoords = cache->sites[c.index];
+			}
+		}
+
+		if (spotCoords.x < 0.0f)
+			continue;
+
+		const float spotScore = spot.y / (spotCoords.distance2D(fromPos) + distanceBias);
+
+		if (spotScore < bestScore)
+			continue;
+		if (spotScore == bestScore && (bestIndex == -1 || c.index > bestIndex))
+			continue;
+
+		bestScore = spotScore;
+		bestIndex = c.index;
+		bestSpot = spotCoords;
+		bestSpot.y = spot.y;
 	}
 
-	// no spot found if tempScore is zero
+	// no spot found if bestScore is zero
 	return bestSpot;
 }
 
@@ -135,6 +215,57 @@ void CResourceMapAnalyzer::Init() {
 		GetResourcePoints();
 		SaveResourceMap();
 	}
+
+	BuildSpotGrid();
+}
+
+void CResourceMapAnalyzer::BuildSpotGrid() {
+	spotGridSizeX = std::max(1, int(math::ceil(mapDims.mapx * SQUARE_SIZE / SPOT_GRID_CELL_SIZE)));
+	spotGridSizeZ = std::max(1, int(math::ceil(mapDims.mapy * SQUARE_SIZE / SPOT_GRID_CELL_SIZE)));
+
+	const int numCells = spotGridSizeX * spotGridSizeZ;
+
+	std::vector<int> spotCells;
+	spotCells.reserve(vectoredSpots.size());
+
+	spotGridOffsets.clear();
+	spotGridOffsets.resize(numCells + 1, 0);
+	spotGridIncomes.clear();
+	spotGridIncomes.resize(numCells, 0.0f);
+
+	for (const float3& spot: vectoredSpots) {
+		// spots without income can never be returned
+		if (spot.y <= 0.0f) {
+			spotCells.push_back(-1);
+			continue;
+		}
+
+		const int x = Clamp(int(spot.x / SPOT_GRID_CELL_SIZE), 0, spotGridSizeX - 1);
+		const int z = Clamp(int(spot.z / SPOT_GRID_CELL_SIZE), 0, spotGridSizeZ - 1);
+		const int cellIdx = z * spotGridSizeX + x;
+
+		spotCells.push_back(cellIdx);
+		spotGridOffsets[cellIdx + 1] += 1;
+		spotGridIncomes[cellIdx] = std::max(spotGridIncomes[cellIdx], spot.y);
+	}
+
+	for (int i = 0; i < numCells; i++) {
+		spotGridOffsets[i + 1] += spotGridOffsets[i];
+	}
+
+	std::vector<int> cellSizes(numCells, 0);
+
+	spotGridIndices.clear();
+	spotGridIndices.resize(spotGridOffsets[numCells]);
+
+	for (size_t i = 0; i < spotCells.size(); i++) {
+		const int cellIdx = spotCells[i];
+
+		if (cellIdx < 0)
+			continue;
+
+		spotGridIndices[spotGridOffsets[cellIdx] + (cellSizes[cellIdx]++)] = i;
+	}
 }
 
 float CResourceMapAnalyzer::GetAverageIncome() const {
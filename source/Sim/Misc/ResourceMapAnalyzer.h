@@ -27,15 +27,28 @@ public:
 
 	float3 GetNearestSpot(float3 fromPos, int team, const UnitDef* extractor = NULL) const;
 	float3 GetNearestSpot(int builderUnitId, const UnitDef* extractor = NULL) const;
+	/**
+	 * Batched GetNearestSpot; per-spot build-site tests are shared between
+	 * all queries, so this is cheaper than calling GetNearestSpot in a loop.
+	 */
+	void GetNearestSpots(const std::vector<float3>& fromPositions, int team, const UnitDef* extractor, std::vector<float3>& nearestSpots) const;
 	float GetAverageIncome() const;
 
 	// equal to vectoredSpots.size() after Init, otherwise -1
 	int GetNumSpots() const { return numSpotsFound; }
 
 private:
+	struct BuildSiteCache {
+		std::vector<float3> sites;
+		std::vector<bool> tested;
+	};
+
 	void GetResourcePoints();
 	void SaveResourceMap();
 	bool LoadResourceMap();
+	void BuildSpotGrid();
+
+	float3 FindNearestSpot(const float3& fromPos, int team, const UnitDef* extractor, BuildSiteCache* cache) const;
 
 	std::string GetCacheFileName() const;
 
@@ -74,6 +87,16 @@ private:
 	std::vector<int> tempAverage;
 
 	std::vector<float3> vectoredSpots;
+
+	// uniform grid over vectoredSpots; cell c holds the (ascending) indices
+	// spotGridIndices[spotGridOffsets[c] .. spotGridOffsets[c + 1]) and the
+	// highest income among them in spotGridIncomes[c]
+	std::vector<int> spotGridOffsets;
+	std::vector<int> spotGridIndices;
+	std::vector<float> spotGridIncomes;
+
+	int spotGridSizeX = 0;
+	int spotGridSizeZ = 0;
 };
 
 #endif // _RESOURCE_MAP_ANALYZER_H
@@ -2,38 +2,45 @@
 
 #include <vector>
 #include <cassert>
+#include <cstring>
 #include <limits>
 
 #include "SmoothHeightMesh.h"
 
-#include "Map/Ground.h"
 #include "Map/ReadMap.h"
 #include "System/float3.h"
 #include "System/SpringMath.h"
 #include "System/TimeProfiler.h"
+#include "System/Log/ILog.h"
 #include "System/Threading/ThreadPool.h"
 
 
 
 SmoothHeightMesh smoothGround;
 
+static constexpr int BLUR_SIZE = 3;
+static constexpr int NUM_BLURS = 3;
+// distance over which the blur passes spread a change (and edge errors)
+static constexpr int BLUR_MARGIN = BLUR_SIZE * NUM_BLURS;
+
 
 static float Interpolate(float x, float y, const int maxx, const int maxy, const float res, const float* heightmap)
 {
-	x = Clamp(x / res, 0.0f, maxx - 1.0f);
-	y = Clamp(y / res, 0.0f, maxy - 1.0f);
+	x = Clamp(x / res, 0.0f, maxx * 1.0f);
+	y = Clamp(y / res, 0.0f, maxy * 1.0f);
 	const int sx = x;
 	const int sy = y;
 	const float dx = (x - sx);
 	const float dy = (y - sy);
 
-	const int sxp1 = std::min(sx + 1, maxx - 1);
-	const int syp1 = std::min(sy + 1, maxy - 1);
+	const int sxp1 = std::min(sx + 1, maxx);
+	const int syp1 = std::min(sy + 1, maxy);
+	const int lineSize = maxx + 1;
 
-	const float& h1 = heightmap[sx   + sy   * maxx];
-	const float& h2 = heightmap[sxp1 + sy   * maxx];
-	const float& h3 = heightmap[sx   + syp1 * maxx];
-	const float& h4 = heightmap[sxp1 + syp1 * maxx];
+	const float& h1 = heightmap[sx   + sy   * lineSize];
+	const float& h2 = heightmap[sxp1 + sy   * lineSize];
+	const float& h3 = heightmap[sx   + syp1 * lineSize];
+	const float& h4 = heightmap[sxp1 + syp1 * lineSize];
 
 	const float hi1 = mix(h1, h2, dx);
 	const float hi2 = mix(h3, h4, dx);
@@ -41,6 +48,172 @@ static float Interpolate(float x, float y, const int maxx, const int maxy, const
 }
 
 
+
+static SRectangle ExpandRect(const SRectangle& r, int n, int maxx, int maxy)
+{
+	return (SRectangle(std::max(r.x1 - n, 0), std::max(r.z1 - n, 0), std::min(r.x2 + n, maxx), std::min(r.z2 + n, maxy)));
+}
+
+static bool RectsOverlap(const SRectangle& a, const SRectangle& b)
+{
+	return (a.x1 <= b.x2 && b.x1 <= a.x2 && a.z1 <= b.z2 && b.z1 <= a.z2);
+}
+
+template<typename F>
+static void ForEachLine(int beg, int end, bool parallel, F&& f)
+{
+	if (parallel) {
+		parallel_for(beg, end, f);
+		return;
+	}
+
+	for (int i = beg; i < end; ++i) {
+		f(i);
+	}
+}
+
+
+
+/**
+ * Sliding-window maximum over samples [beg, end] for every output
+ * i in [outBeg, outEnd], window [i - win, i + win] clipped to [beg, end].
+ * The queue keeps indices of a strictly decreasing run of samples, so
+ * every sample is pushed and popped at most once.
+ */
+template<typename Sample, typename Store>
+static void MaxFilterLine(int beg, int end, int outBeg, int outEnd, int win, std::vector<int>& queue, Sample&& sample, Store&& store)
+{
+	size_t head = 0;
+	int next = beg;
+
+	queue.clear();
+
+	for (int i = outBeg; i <= outEnd; ++i) {
+		for (const int last = std::min(end, i + win); next <= last; ++next) {
+			const float h = sample(next);
+
+			while (queue.size() > head && sample(queue.back()) <= h)
+				queue.pop_back();
+
+			queue.push_back(next);
+		}
+
+		while (queue[head] < (i - win))
+			++head;
+
+		store(i, sample(queue[head]));
+	}
+}
+
+
+/**
+ * Box-blurs <src> into <dst> along one axis; both cover <rect>. Windows
+ * are clipped to the rectangle, which matches the map-border behavior
+ * where the rectangle touches the border and only disturbs samples less
+ * than BLUR_SIZE away from the edge elsewhere.
+ */
+static void BlurRegion(
+	const SRectangle& rect,
+	const SRectangle& inRect,
+	const float maxHeight,
+	const bool vertical,
+	const bool parallel,
+	const std::vector<float>& heights,
+	const std::vector<float>& src,
+	      std::vector<float>& dst
+) {
+	const int lineSize = rect.x2 - rect.x1 + 1;
+	const int inLineSize = inRect.x2 - inRect.x1 + 1;
+
+	ForEachLine(rect.z1, rect.z2 + 1, parallel, [&](const int z) {
+		for (int x = rect.x1; x <= rect.x2; ++x) {
+			const int beg = vertical? std::max(z - BLUR_SIZE, rect.z1): std::max(x - BLUR_SIZE, rect.x1);
+			const int end = vertical? std::min(z + BLUR_SIZE, rect.z2): std::min(x + BLUR_SIZE, rect.x2);
+
+			float sum = 0.0f;
+
+			if (vertical) {
+				for (int i = beg; i <= end; ++i) {
+					sum += src[(i - rect.z1) * lineSize + (x - rect.x1)];
+				}
+			} else {
+				for (int i = beg; i <= end; ++i) {
+					sum += src[(z - rect.z1) * lineSize + (i - rect.x1)];
+				}
+			}
+
+			const float gh = heights[(z - inRect.z1) * inLineSize + (x - inRect.x1)];
+			const float sh = sum / (end - beg + 1);
+
+			dst[(z - rect.z1) * lineSize + (x - rect.x1)] = std::min(maxHeight, std::max(gh, sh));
+		}
+	});
+}
+
+
+/**
+ * Computes the smoothed mesh for <region.outRect> from the height samples
+ * covering <region.inRect>, which must contain the output rectangle grown
+ * by BLUR_MARGIN + winSize (clipped to the map). Reads nothing else, so it
+ * can run on any thread; the full-map build is the special case where all
+ * rectangles span the whole mesh.
+ */
+void SmoothHeightMesh::SmoothRegion(int maxx, int maxy, int winSize, bool parallel, Region& region)
+{
+	const SRectangle& inRect = region.inRect;
+	const SRectangle& outRect = region.outRect;
+	const SRectangle midRect = ExpandRect(outRect, BLUR_MARGIN, maxx, maxy);
+
+	SampleRegion(parallel, region);
+
+	const int inLineSize = inRect.x2 - inRect.x1 + 1;
+	const int midLineSize = midRect.x2 - midRect.x1 + 1;
+	const int midNumLines = midRect.z2 - midRect.z1 + 1;
+
+	std::vector<float> colsMaxima(inLineSize * midNumLines);
+	std::vector<float> maxima(midLineSize * midNumLines);
+	std::vector<float> blurred(midLineSize * midNumLines);
+
+	const std::vector<float>& heights = region.heights;
+
+	// vertical pass: per column of inRect, the maximum over rows [z - winSize, z + winSize]
+	ForEachLine(inRect.x1, inRect.x2 + 1, parallel, [&](const int x) {
+		std::vector<int> queue;
+
+		const auto sample = [&](int z) { return heights[(z - inRect.z1) * inLineSize + (x - inRect.x1)]; };
+		const auto store = [&](int z, float h) { colsMaxima[(z - midRect.z1) * inLineSize + (x - inRect.x1)] = h; };
+
+		MaxFilterLine(inRect.z1, inRect.z2, midRect.z1, midRect.z2, winSize, queue, sample, store);
+	});
+
+	// horizontal pass over the column maxima completes the square window
+	ForEachLine(midRect.z1, midRect.z2 + 1, parallel, [&](const int z) {
+		std::vector<int> queue;
+
+		const auto sample = [&](int x) { return colsMaxima[(z - midRect.z1) * inLineSize + (x - inRect.x1)]; };
+		const auto store = [&](int x, float h) { maxima[(z - midRect.z1) * midLineSize + (x - midRect.x1)] = h; };
+
+		MaxFilterLine(inRect.x1, inRect.x2, midRect.x1, midRect.x2, winSize, queue, sample, store);
+	});
+
+	// actually smooth with approximate Gaussian blur passes
+	for (int numBlurs = NUM_BLURS; numBlurs > 0; --numBlurs) {
+		BlurRegion(midRect, inRect, region.maxHeight, false, parallel, heights, maxima, blurred);
+		BlurRegion(midRect, inRect, region.maxHeight,  true, parallel, heights, blurred, maxima);
+	}
+
+	region.result.clear();
+	region.result.reserve((outRect.x2 - outRect.x1 + 1) * (outRect.z2 - outRect.z1 + 1));
+
+	for (int z = outRect.z1; z <= outRect.z2; ++z) {
+		const float* line = &maxima[(z - midRect.z1) * midLineSize + (outRect.x1 - midRect.x1)];
+
+		region.result.insert(region.result.end(), line, line + (outRect.x2 - outRect.x1 + 1));
+	}
+}
+
+
+
 void SmoothHeightMesh::Init(float mx, float my, float res, float smoothRad)
 {
 	maxx = ((fmaxx = mx) / res) + 1;
@@ -48,17 +221,49 @@ void SmoothHeightMesh::Init(float mx, float my, float res, float smoothRad)
 
 	resolution = res;
 	smoothRadius = std::max(1.0f, smoothRad);
+	winSize = smoothRadius / resolution;
 
 	MakeSmoothMesh();
 }
 
 void SmoothHeightMesh::Kill() {
+	if (pendingUpdate != nullptr)
+		pendingUpdate->wait();
+
+	pendingUpdate.reset();
+	pendingRegions.clear();
+	changedAreas.clear();
 
 	mesh.clear();
 	origMesh.clear();
 }
 
 
+void SmoothHeightMesh::Update()
+{
+	SCOPED_TIMER("Sim::SmoothHeightMesh");
+
+	FinishUpdate();
+	StartUpdate();
+}
+
+void SmoothHeightMesh::MapChanged(const SRectangle& hmRect)
+{
+	if (mesh.empty())
+		return;
+
+	// samples sit at multiples of <resolution> and interpolate the corners around them
+	const float scale = SQUARE_SIZE / resolution;
+
+	changedAreas.emplace_back(
+		std::max(int(hmRect.x1 * scale) - 1, 0),
+		std::max(int(hmRect.z1 * scale) - 1, 0),
+		(hmRect.x2 >= mapDims.mapx)? maxx: std::min(int(hmRect.x2 * scale) + 1, maxx),
+		(hmRect.z2 >= mapDims.mapy)? maxy: std::min(int(hmRect.z2 * scale) + 1, maxy)
+	);
+}
+
+
 
 float SmoothHeightMesh::GetHeight(float x, float y)
 {
@@ -91,297 +296,202 @@ float SmoothHeightMesh::SetMaxHeight(int index, float h)
 
 
 
-inline static void FindMaximumColumnHeights(
-	const int maxx,
-	const int maxy,
-	const int winSize,
-	const float resolution,
-	std::vector<float>& colsMaxima,
-	std::vector<int>& maximaRows
-) {
-	// initialize the algorithm: find the maximum
-	// height per column and the corresponding row
-	for (int y = 0; y <= std::min(maxy, winSize); ++y) {
-		for (int x = 0; x <= maxx; ++x)  {
-			const float curx = x * resolution;
-			const float cury = y * resolution;
-			const float curh = CGround::GetHeightAboveWater(curx, cury);
-
-			if (curh > colsMaxima[x]) {
-				colsMaxima[x] = curh;
-				maximaRows[x] = y;
-			}
-		}
-	}
-}
-
-inline static void AdvanceMaximaRows(
-	const int y,
-	const int maxx,
-	const float resolution,
-	const std::vector<float>& colsMaxima,
-	      std::vector<int>& maximaRows
-) {
-	const float cury = y * resolution;
-
-	// try to advance rows if they're equal to current maximum but are further away
-	for (int x = 0; x <= maxx; ++x) {
-		if (maximaRows[x] == (y - 1)) {
-			const float curx = x * resolution;
-			const float curh = CGround::GetHeightAboveWater(curx, cury);
-
-			if (curh == colsMaxima[x]) {
-				maximaRows[x] = y;
-			}
+SmoothHeightMesh::Region SmoothHeightMesh::MakeRegion(const SRectangle& outRect, bool parallel) const
+{
+	Region region;
+	region.outRect = outRect;
+	region.inRect = ExpandRect(outRect, BLUR_MARGIN + winSize, maxx, maxy);
+	region.resolution = resolution;
+	region.maxHeight = readMap->GetCurrMaxHeight();
+
+	const SRectangle& inRect = region.inRect;
+	const auto CornerIdx = [&](int i, float maxPos) { return (int(Clamp(i * resolution, 0.0f, maxPos) / SQUARE_SIZE)); };
+
+	// corners (and the ones right or below them) InterpolateHeight reads for the samples
+	region.hmRect = SRectangle(
+		CornerIdx(inRect.x1, float3::maxxpos),
+		CornerIdx(inRect.z1, float3::maxzpos),
+		std::min(CornerIdx(inRect.x2, float3::maxxpos) + 1, mapDims.mapx),
+		std::min(CornerIdx(inRect.z2, float3::maxzpos) + 1, mapDims.mapy)
+	);
+
+	const SRectangle& hmRect = region.hmRect;
+	const int hmLineSize = hmRect.x2 - hmRect.x1 + 1;
+	const float* cornerHeightMap = readMap->GetCornerHeightMapSynced();
+
+	region.hmRows.resize(hmLineSize * (hmRect.z2 - hmRect.z1 + 1));
+
+	// snapshot, the heightmap keeps changing while the region is being smoothed;
+	// interpolating the samples is left to SampleRegion on the worker
+	ForEachLine(hmRect.z1, hmRect.z2 + 1, parallel, [&](const int z) {
+		std::memcpy(&region.hmRows[(z - hmRect.z1) * hmLineSize], &cornerHeightMap[z * mapDims.mapxp1 + hmRect.x1], hmLineSize * sizeof(float));
+	});
 
-			assert(curh <= colsMaxima[x]);
-		}
-	}
+	return region;
 }
 
+/**
+ * Fills region.heights from the copied heightmap rows; same results as
+ * CGround::GetHeightAboveWater(x * resolution, z * resolution) at the
+ * time the rows were copied.
+ */
+void SmoothHeightMesh::SampleRegion(bool parallel, Region& region)
+{
+	const SRectangle& inRect = region.inRect;
+	const SRectangle& hmRect = region.hmRect;
 
+	const int inLineSize = inRect.x2 - inRect.x1 + 1;
+	const int hmLineSize = hmRect.x2 - hmRect.x1 + 1;
+	const int hmNumLines = hmRect.z2 - hmRect.z1 + 1;
 
-inline static void FindRadialMaximum(
-	int y,
-	int maxx,
-	int winSize,
-	float resolution,
-	const std::vector<float>& colsMaxima,
-	      std::vector<float>& mesh
-) {
-	const float cury = y * resolution;
+	const float* hmRows = region.hmRows.data();
 
-	for (int x = 0; x <= maxx; ++x) {
-		float maxRowHeight = -std::numeric_limits<float>::max();
+	region.heights.resize(inLineSize * (inRect.z2 - inRect.z1 + 1));
 
-		// find current maximum within radius smoothRadius
-		// (in every column stack) along the current row
-		const int startx = std::max(x - winSize, 0);
-		const int endx = std::min(maxx, x + winSize);
+	// see InterpolateHeight (Ground.cpp); at the map edges the neighbor
+	// corners it reads have zero weight, so clamping their index is exact
+	ForEachLine(inRect.z1, inRect.z2 + 1, parallel, [&](const int sz) {
+		for (int sx = inRect.x1; sx <= inRect.x2; ++sx) {
+			const float x = Clamp(sx * region.resolution, 0.0f, float3::maxxpos) / SQUARE_SIZE;
+			const float z = Clamp(sz * region.resolution, 0.0f, float3::maxzpos) / SQUARE_SIZE;
 
-		for (int i = startx; i <= endx; ++i) {
-			assert(i >= 0);
-			assert(i <= maxx);
-			assert(CGround::GetHeightReal(i * resolution, cury) <= colsMaxima[i]);
+			const int isx = x;
+			const int isz = z;
+			const float dx = x - isx;
+			const float dz = z - isz;
 
-			maxRowHeight = std::max(colsMaxima[i], maxRowHeight);
-		}
+			const int hx0 = isx - hmRect.x1;
+			const int hz0 = isz - hmRect.z1;
+			const int hx1 = std::min(hx0 + 1, hmLineSize - 1);
+			const int hz1 = std::min(hz0 + 1, hmNumLines - 1);
 
-#ifndef NDEBUG
-		const float curx = x * resolution;
-		assert(maxRowHeight <= std::max(readMap->GetCurrMaxHeight(), 0.0f));
-		assert(maxRowHeight >= CGround::GetHeightAboveWater(curx, cury));
+			float h = 0.0f;
 
-	#ifdef SMOOTHMESH_CORRECTNESS_CHECK
-		// naive algorithm
-		float maxRowHeightAlt = -std::numeric_limits<float>::max();
+			if (dx + dz < 1.0f) {
+				const float h00 = hmRows[hz0 * hmLineSize + hx0];
+				const float h10 = hmRows[hz0 * hmLineSize + hx1];
+				const float h01 = hmRows[hz1 * hmLineSize + hx0];
 
-		for (float y1 = cury - smoothRadius; y1 <= cury + smoothRadius; y1 += resolution) {
-			for (float x1 = curx - smoothRadius; x1 <= curx + smoothRadius; x1 += resolution) {
-				maxRowHeightAlt = std::max(maxRowHeightAlt, CGround::GetHeightAboveWater(x1, y1));
-			}
-		}
+				h = h00 + dx * (h10 - h00) + dz * (h01 - h00);
+			} else {
+				const float h10 = hmRows[hz0 * hmLineSize + hx1];
+				const float h11 = hmRows[hz1 * hmLineSize + hx1];
+				const float h01 = hmRows[hz1 * hmLineSize + hx0];
 
-		assert(maxRowHeightAlt == maxRowHeight);
-	#endif
-#endif
+				h = h11 + (1.0f - dx) * (h01 - h11) + (1.0f - dz) * (h10 - h11);
+			}
 
-		mesh[x + y * maxx] = maxRowHeight;
-	}
+			region.heights[(sz - inRect.z1) * inLineSize + (sx - inRect.x1)] = std::max(0.0f, h);
+		}
+	});
 }
 
 
+void SmoothHeightMesh::StartUpdate()
+{
+	if (changedAreas.empty())
+		return;
 
-inline static void FixRemainingMaxima(
-	const int y,
-	const int maxx,
-	const int maxy,
-	const int winSize,
-	const float resolution,
-	std::vector<float>& colsMaxima,
-	std::vector<int>& maximaRows
-) {
-	// fix remaining maximums after a pass
-	const int nextrow = y + winSize + 1;
-	const float nextrowy = nextrow * resolution;
-
-	for (int x = 0; x <= maxx; ++x) {
-#ifdef _DEBUG
-		for (int y1 = std::max(0, y - winSize); y1 <= std::min(maxy, y + winSize); ++y1) {
-			assert(CGround::GetHeightReal(x * resolution, y1 * resolution) <= colsMaxima[x]);
-		}
-#endif
-		const float curx = x * resolution;
+	// grow each change by the distance it can propagate, then merge
+	// areas whose outputs overlap so no sample is computed twice
+	for (SRectangle& area: changedAreas) {
+		area = ExpandRect(area, winSize + BLUR_MARGIN, maxx, maxy);
+	}
 
-		if (maximaRows[x] <= (y - winSize)) {
-			// find a new maximum if the old one left the window
-			colsMaxima[x] = -std::numeric_limits<float>::max();
+	for (size_t i = 0; i < changedAreas.size(); ) {
+		bool merged = false;
 
-			for (int y1 = std::max(0, y - winSize + 1); y1 <= std::min(maxy, nextrow); ++y1) {
-				const float h = CGround::GetHeightAboveWater(curx, y1 * resolution);
+		for (size_t j = i + 1; j < changedAreas.size(); ++j) {
+			if (!RectsOverlap(changedAreas[i], changedAreas[j]))
+				continue;
 
-				if (h > colsMaxima[x]) {
-					colsMaxima[x] = h;
-					maximaRows[x] = y1;
-				} else if (colsMaxima[x] == h) {
-					// if equal, move as far down as possible
-					maximaRows[x] = y1;
-				}
-			}
-		} else if (nextrow <= maxy) {
-			// else, just check if a new maximum has entered the window
-			const float h = CGround::GetHeightAboveWater(curx, nextrowy);
+			SRectangle& a = changedAreas[i];
+			const SRectangle& b = changedAreas[j];
 
-			if (h > colsMaxima[x]) {
-				colsMaxima[x] = h;
-				maximaRows[x] = nextrow;
-			}
-		}
+			a = SRectangle(std::min(a.x1, b.x1), std::min(a.z1, b.z1), std::max(a.x2, b.x2), std::max(a.z2, b.z2));
 
-		assert(maximaRows[x] <= nextrow);
-		assert(maximaRows[x] >= y - winSize + 1);
+			changedAreas[j] = changedAreas.back();
+			changedAreas.pop_back();
 
-#ifdef _DEBUG
-		for (int y1 = std::max(0, y - winSize + 1); y1 <= std::min(maxy, y + winSize + 1); ++y1) {
-			assert(colsMaxima[x] >= CGround::GetHeightReal(curx, y1 * resolution));
+			merged = true;
+			break;
 		}
-#endif
+
+		// a grown rectangle can overlap ones checked before, rescan it
+		i += (!merged);
 	}
-}
 
+	pendingRegions.clear();
+	pendingRegions.reserve(changedAreas.size());
 
+	for (const SRectangle& area: changedAreas) {
+		pendingRegions.emplace_back(MakeRegion(area, false));
+	}
 
-inline static void BlurHorizontal(
-	const int maxx,
-	const int maxy,
-	const int blurSize,
-	const float resolution,
-	const std::vector<float>& mesh,
-	      std::vector<float>& smoothed
-) {
-	const float n = 2.0f * blurSize + 1.0f;
-	const float recipn = 1.0f / n;
-	const int lineSize = maxx + 1;
+	changedAreas.clear();
 
-	for_mt(0, maxy+1, [&](const int y) {
-		float avg = 0.0f;
+	const int mx = maxx;
+	const int my = maxy;
+	const int ws = winSize;
 
-		for (int x = 0; x <= 2 * blurSize; ++x) {
-			avg += mesh[x + y * lineSize];
+	pendingUpdate = ThreadPool::Enqueue([this, mx, my, ws]() {
+		for (Region& region: pendingRegions) {
+			SmoothRegion(mx, my, ws, false, region);
 		}
+	});
 
-		for (int x = 0; x <= maxx; ++x) {
-			const int idx = x + y * lineSize;
-
-			if (x <= blurSize || x > (maxx - blurSize)) {
-				// map-border case
-				smoothed[idx] = 0.0f;
-
-				const int xstart = std::max(x - blurSize, 0);
-				const int xend   = std::min(x + blurSize, maxx);
-
-				for (int x1 = xstart; x1 <= xend; ++x1) {
-					smoothed[idx] += mesh[x1 + y * lineSize];
-				}
+#ifdef SMOOTHMESH_CORRECTNESS_CHECK
+	// compare against (and time) a full rebuild from the same heightmap
+	const spring_time t0 = spring_gettime();
+	pendingUpdate->wait();
+	const spring_time t1 = spring_gettime();
 
-				const float gh = CGround::GetHeightAboveWater(x * resolution, y * resolution);
-				const float sh = smoothed[idx] / (xend - xstart + 1);
+	Region fullRegion = MakeRegion(SRectangle(0, 0, maxx, maxy), true);
+	SmoothRegion(maxx, maxy, winSize, true, fullRegion);
 
-				smoothed[idx] = std::min(readMap->GetCurrMaxHeight(), std::max(gh, sh));
-			} else {
-				// non-border case
-				avg += mesh[idx + blurSize] - mesh[idx - blurSize - 1];
+	const spring_time t2 = spring_gettime();
 
-				const float gh = CGround::GetHeightAboveWater(x * resolution, y * resolution);
-				const float sh = recipn * avg;
+	for (const Region& region: pendingRegions) {
+		const int lineSize = region.outRect.x2 - region.outRect.x1 + 1;
 
-				smoothed[idx] = std::min(readMap->GetCurrMaxHeight(), std::max(gh, sh));
+		for (int z = region.outRect.z1; z <= region.outRect.z2; ++z) {
+			for (int x = region.outRect.x1; x <= region.outRect.x2; ++x) {
+				assert(region.result[(z - region.outRect.z1) * lineSize + (x - region.outRect.x1)] == fullRegion.result[GetIndex(x, z)]);
 			}
-
-			assert(smoothed[idx] <= std::max(readMap->GetCurrMaxHeight(), 0.0f));
-			assert(smoothed[idx] >=          readMap->GetCurrMinHeight()       );
-		}
-	});
-}
-
-inline static void BlurVertical(
-	const int maxx,
-	const int maxy,
-	const int blurSize,
-	const float resolution,
-	const std::vector<float>& mesh,
-	      std::vector<float>& smoothed
-) {
-	const float n = 2.0f * blurSize + 1.0f;
-	const float recipn = 1.0f / n;
-	const int lineSize = maxx + 1;
-
-	for_mt(0, maxx+1, [&](const int x) {
-		float avg = 0.0f;
-
-		for (int y = 0; y <= 2 * blurSize; ++y) {
-			avg += mesh[x + y * lineSize];
 		}
+	}
 
-		for (int y = 0; y <= maxy; ++y) {
-			const int idx = x + y * lineSize;
-
-			if (y <= blurSize || y > (maxy - blurSize)) {
-				// map-border case
-				smoothed[idx] = 0.0f;
+	LOG("[SmoothHeightMesh::%s] %u regions in %.3fms, full rebuild %.3fms", __func__, unsigned(pendingRegions.size()), (t1 - t0).toMilliSecsf(), (t2 - t1).toMilliSecsf());
+#endif
+}
 
-				const int ystart = std::max(y - blurSize, 0);
-				const int yend   = std::min(y + blurSize, maxy);
+void SmoothHeightMesh::FinishUpdate()
+{
+	if (pendingUpdate == nullptr)
+		return;
 
-				for (int y1 = ystart; y1 <= yend; ++y1) {
-					smoothed[idx] += mesh[x + y1 * lineSize];
-				}
+	pendingUpdate->wait();
+	pendingUpdate.reset();
 
-				const float gh = CGround::GetHeightAboveWater(x * resolution, y * resolution);
-				const float sh = smoothed[idx] / (yend - ystart + 1);
+	for (const Region& region: pendingRegions) {
+		const SRectangle& rect = region.outRect;
+		const float* result = region.result.data();
 
-				smoothed[idx] = std::min(readMap->GetCurrMaxHeight(), std::max(gh, sh));
-			} else {
-				// non-border case
-				avg += mesh[x + (y + blurSize) * lineSize] - mesh[x + (y - blurSize - 1) * lineSize];
+		for (int z = rect.z1; z <= rect.z2; ++z) {
+			for (int x = rect.x1; x <= rect.x2; ++x) {
+				const int idx = GetIndex(x, z);
+				const float h = *(result++);
 
-				const float gh = CGround::GetHeightAboveWater(x * resolution, y * resolution);
-				const float sh = recipn * avg;
+				// samples modified through Lua keep their value
+				if (mesh[idx] == origMesh[idx])
+					mesh[idx] = h;
 
-				smoothed[idx] = std::min(readMap->GetCurrMaxHeight(), std::max(gh, sh));
+				origMesh[idx] = h;
 			}
-
-			assert(smoothed[idx] <= std::max(readMap->GetCurrMaxHeight(), 0.0f));
-			assert(smoothed[idx] >=          readMap->GetCurrMinHeight()       );
-		}
-	});
-}
-
-
-
-inline static void CheckInvariants(
-	int y,
-	int maxx,
-	int maxy,
-	int winSize,
-	float resolution,
-	const std::vector<float>& colsMaxima,
-	const std::vector<int>& maximaRows
-) {
-	// check invariants
-	if (y < maxy) {
-		for (int x = 0; x <= maxx; ++x) {
-			assert(maximaRows[x] > y - winSize);
-			assert(maximaRows[x] <= maxy);
-			assert(colsMaxima[x] <= std::max(readMap->GetCurrMaxHeight(), 0.0f));
-			assert(colsMaxima[x] >=          readMap->GetCurrMinHeight()       );
-		}
-	}
-	for (int y1 = std::max(0, y - winSize + 1); y1 <= std::min(maxy, y + winSize + 1); ++y1) {
-		for (int x1 = 0; x1 <= maxx; ++x1) {
-			assert(CGround::GetHeightReal(x1 * resolution, y1 * resolution) <= colsMaxima[x1]);
 		}
 	}
+
+	pendingRegions.clear();
 }
 
 
@@ -398,43 +508,16 @@ void SmoothHeightMesh::MakeSmoothMesh()
 	//   row-width (number of height-value corners per row) is (maxx + 1)
 	//   col-height (number of height-value corners per col) is (maxy + 1)
 	//
-	//   1st row has indices [maxx*(  0) + (  0), maxx*(1) + (  0)] inclusive
-	//   2nd row has indices [maxx*(  1) + (  1), maxx*(2) + (  1)] inclusive
-	//   3rd row has indices [maxx*(  2) + (  2), maxx*(3) + (  2)] inclusive
-	//   ...
-	//   Nth row has indices [maxx*(N-1) + (N-1), maxx*(N) + (N-1)] inclusive
-	//
-	// use sliding window of maximums to reduce computational complexity
-	const     int winSize = smoothRadius / resolution;
-	constexpr int blurSize = 3;
-
+	// every sample is the maximum height within a square window of radius
+	// smoothRadius, blurred; both filters are separable and the max-filter
+	// uses a monotonic queue so the cost per sample does not depend on the
+	// window size
 	assert(mesh.empty());
-	mesh.resize((maxx + 1) * (maxy + 1), 0.0f);
-	origMesh.resize((maxx + 1) * (maxy + 1), 0.0f);
-
-	colsMaxima.clear();
-	colsMaxima.resize(maxx + 1, -std::numeric_limits<float>::max());
-	maximaRows.clear();
-	maximaRows.resize(maxx + 1, -1);
-
-	FindMaximumColumnHeights(maxx, maxy, winSize, resolution, colsMaxima, maximaRows);
-
-	for (int y = 0; y <= maxy; ++y) {
-		AdvanceMaximaRows(y, maxx, resolution, colsMaxima, maximaRows);
-		FindRadialMaximum(y, maxx, winSize, resolution, colsMaxima, mesh);
-		FixRemainingMaxima(y, maxx, maxy, winSize, resolution, colsMaxima, maximaRows);
 
-#ifdef _DEBUG
-		CheckInvariants(y, maxx, maxy, winSize, resolution, colsMaxima, maximaRows);
-#endif
-	}
-
-	// actually smooth with approximate Gaussian blur passes
-	for (int numBlurs = 3; numBlurs > 0; --numBlurs) {
-		BlurHorizontal(maxx, maxy, blurSize, resolution, mesh, origMesh); mesh.swap(origMesh);
-		BlurVertical(maxx, maxy, blurSize, resolution, mesh, origMesh); mesh.swap(origMesh);
-	}
+	Region region = MakeRegion(SRectangle(0, 0, maxx, maxy), true);
+	SmoothRegion(maxx, maxy, winSize, true, region);
 
+	mesh.swap(region.result);
 	// <mesh> now contains the final smoothed heightmap, save it in origMesh
-	std::copy(mesh.begin(), mesh.end(), origMesh.begin());
+	origMesh.assign(mesh.begin(), mesh.end());
 }
@@ -3,18 +3,31 @@
 #ifndef SMOOTH_HEIGHT_MESH_H
 #define SMOOTH_HEIGHT_MESH_H
 
+#include <future>
+#include <memory>
 #include <vector>
 
+#include "System/Rectangle.h"
+
 class CGround;
 
 /**
  * Provides a GetHeight(x, y) of its own that smooths the mesh.
+ *
+ * Terrain changes are picked up incrementally: each Update applies the
+ * regions recalculated (on the thread pool) since the previous one and
+ * starts recalculating the regions changed in between. Results always
+ * land exactly one Update after the change, which keeps the mesh synced.
  */
 class SmoothHeightMesh
 {
 public:
 	void Init(float mx, float my, float res, float smoothRad);
 	void Kill();
+	void Update();
+
+	/// queues a recalculation of every sample influenced by heightmap corners <hmRect>
+	void MapChanged(const SRectangle& hmRect);
 
 	float GetHeight(float x, float y);
 	float GetHeightAboveWater(float x, float y);
@@ -24,6 +37,7 @@ public:
 
 	int GetMaxX() const { return maxx; }
 	int GetMaxY() const { return maxy; }
+	int GetIndex(int x, int y) const { return (x + y * (maxx + 1)); }
 	float GetFMaxX() const { return fmaxx; }
 	float GetFMaxY() const { return fmaxy; }
 	float GetResolution() const { return resolution; }
@@ -32,10 +46,31 @@ public:
 	const float* GetOriginalMeshData() const { return &origMesh[0]; }
 
 private:
+	struct Region {
+		SRectangle inRect;  // samples read, interpolated into <heights>
+		SRectangle outRect; // samples written, computed into <result>
+		SRectangle hmRect;  // heightmap corners those samples interpolate, copied into <hmRows>
+
+		float resolution = 0.0f;
+		float maxHeight = 0.0f;
+
+		std::vector<float> hmRows;
+		std::vector<float> heights;
+		std::vector<float> result;
+	};
+
 	void MakeSmoothMesh();
+	void StartUpdate();
+	void FinishUpdate();
+
+	Region MakeRegion(const SRectangle& outRect, bool parallel) const;
+
+	static void SampleRegion(bool parallel, Region& region);
+	static void SmoothRegion(int maxx, int maxy, int winSize, bool parallel, Region& region);
 
 	int maxx = 0;
 	int maxy = 0;
+	int winSize = 0;
 	float fmaxx = 0.0f;
 	float fmaxy = 0.0f;
 	float resolution = 0.0f;
@@ -44,8 +79,11 @@ private:
 	std::vector<float> mesh;
 	std::vector<float> origMesh;
 
-	std::vector<float> colsMaxima;
-	std::vector<int> maximaRows;
+	// changed samples (inclusive) since the last Update
+	std::vector<SRectangle> changedAreas;
+	std::vector<Region> pendingRegions;
+
+	std::shared_ptr< std::future<void> > pendingUpdate;
 };
 
 extern SmoothHeightMesh smoothGround;
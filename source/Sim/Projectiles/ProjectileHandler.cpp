@@ -286,9 +286,9 @@ static void UPDATE_PTR_CONTAINER(T& cont) {
 }
 
 template<class T>
-static void UPDATE_REF_CONTAINER(T& cont) {
+static bool UPDATE_REF_CONTAINER(T& cont) {
 	if (cont.empty())
-		return;
+		return false;
 
 #ifndef NDEBUG
 	const size_t origSize = cont.size();
@@ -309,7 +309,11 @@ static void UPDATE_REF_CONTAINER(T& cont) {
 	// WARNING: see UPDATE_PTR_CONTAINER
 	assert(cont.size() == origSize);
 
+	// removals swap the last element in, breaking any ordering
+	const bool removed = (size != cont.size());
+
 	cont.erase(cont.begin() + size, cont.end());
+	return removed;
 }
 
 
@@ -326,14 +330,15 @@ void CProjectileHandler::Update()
 		// groundflashes
 		UPDATE_PTR_CONTAINER(groundFlashes);
 
-		// flying pieces; sort these every now and then
+		// flying pieces; only resort if additions or removals disturbed the order
 		for (int modelType = 0; modelType < MODELTYPE_OTHER; ++modelType) {
 			auto& fpc = flyingPieces[modelType];
 
-			UPDATE_REF_CONTAINER(fpc);
+			resortFlyingPieces[modelType] |= UPDATE_REF_CONTAINER(fpc);
 
 			if (resortFlyingPieces[modelType]) {
 				std::stable_sort(fpc.begin(), fpc.end());
+				resortFlyingPieces[modelType] = false;
 			}
 		}
 	}
@@ -39,6 +39,30 @@ class LuaMaterial;
 #endif
 
 
+/**
+ * Copy of the UnitDamaged arguments, buffered by the eventHandler during a
+ * sim-frame and handed out in one UnitDamagedBatch call at its end; holds
+ * plain IDs since units may be deleted before the batch is delivered.
+ */
+struct SUnitDamageInfo {
+	int unitID;
+	int unitDefID;
+	int unitTeam;
+	int unitAllyTeam;
+
+	// -1 if there was no attacker
+	int attackerID;
+	int attackerDefID;
+	int attackerTeam;
+
+	int weaponDefID;
+	int projectileID;
+
+	float damage;
+	bool paralyzer;
+};
+
+
 enum DbgTimingInfoType {
 	TIMING_VIDEO,
 	TIMING_SIM,
@@ -140,6 +164,7 @@ class CEventClient
 			int weaponDefID,
 			int projectileID,
 			bool paralyzer) {}
+		virtual void UnitDamagedBatch(const std::vector<SUnitDamageInfo>& events) {}
 		virtual void UnitStunned(const CUnit* unit, bool stunned) {}
 		virtual void UnitExperience(const CUnit* unit, float oldExperience) {}
 		virtual void UnitHarvestStorageFull(const CUnit* unit) {}
@@ -351,7 +376,7 @@ class CEventClient
 		virtual void DrawLoadScreen();
 		virtual void LoadProgress(const std::string& msg, const bool replace_lastline);
 
-		virtual void CollectGarbage() {}
+		virtual void CollectGarbage(float slackTime) {}
 		virtual void DbgTimingInfo(DbgTimingInfoType type, const spring_time start, const spring_time end) {}
 		virtual void Pong(uint8_t pingTag, const spring_time pktSendTime, const spring_time pktRecvTime) {}
 		virtual void MetalMapChanged(const int x, const int z) {}
@@ -5,6 +5,7 @@
 #include "Lua/LuaCallInCheck.h"
 #include "Lua/LuaOpenGL.h"  // FIXME -- should be moved
 
+#include "Sim/Units/UnitDef.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/Platform/Threading.h"
 #include "System/GlobalConfig.h"
@@ -38,6 +39,8 @@ void CEventHandler::ResetState()
 	handles.clear();
 	handles.reserve(16);
 
+	unitDamagedEvents.clear();
+
 	SetupEvents();
 }
 
@@ -540,6 +543,54 @@ void CEventHandler::PlayerRemoved(int playerID, int reason)
 /******************************************************************************/
 /******************************************************************************/
 
+void CEventHandler::QueueUnitDamaged(
+	const CUnit* unit,
+	const CUnit* attacker,
+	float damage,
+	int weaponDefID,
+	int projectileID,
+	bool paralyzer
+) {
+	SUnitDamageInfo info;
+
+	info.unitID = unit->id;
+	info.unitDefID = unit->unitDef->id;
+	info.unitTeam = unit->team;
+	info.unitAllyTeam = unit->allyteam;
+
+	info.attackerID = -1;
+	info.attackerDefID = -1;
+	info.attackerTeam = -1;
+
+	if (attacker != nullptr) {
+		info.attackerID = attacker->id;
+		info.attackerDefID = attacker->unitDef->id;
+		info.attackerTeam = attacker->team;
+	}
+
+	info.weaponDefID = weaponDefID;
+	info.projectileID = projectileID;
+
+	info.damage = damage;
+	info.paralyzer = paralyzer;
+
+	unitDamagedEvents.push_back(info);
+}
+
+void CEventHandler::FlushBatchedEvents()
+{
+	if (unitDamagedEvents.empty())
+		return;
+
+	// clients filter by allyteam themselves, one pass over the
+	// buffer per client is cheaper than building per-team copies
+	ITERATE_EVENTCLIENTLIST(UnitDamagedBatch, unitDamagedEvents);
+
+	// keep the capacity, the next frame will likely need it again
+	unitDamagedEvents.clear();
+}
+
+
 void CEventHandler::UnitHarvestStorageFull(const CUnit* unit)
 {
 	const int unitAllyTeam = unit->allyteam;
@@ -555,9 +606,21 @@ void CEventHandler::UnitHarvestStorageFull(const CUnit* unit)
 /******************************************************************************/
 /******************************************************************************/
 
-void CEventHandler::CollectGarbage()
+void CEventHandler::CollectGarbage(float slackTime)
 {
-	ITERATE_EVENTCLIENTLIST_NA(CollectGarbage);
+	const spring_time startTime = spring_gettime();
+
+	// each client gets whatever its predecessors left over, so the
+	// remaining slack has to be recomputed per call (which rules out
+	// ITERATE_EVENTCLIENTLIST, it evaluates its arguments only once)
+	for (size_t i = 0; i < listCollectGarbage.size(); ) {
+		CEventClient* ec = listCollectGarbage[i];
+
+		ec->CollectGarbage(std::max(0.0f, slackTime - (spring_gettime() - startTime).toMilliSecsf()));
+
+		// the call-in may remove itself from the list
+		i += (i < listCollectGarbage.size() && ec == listCollectGarbage[i]);
+	}
 }
 
 void CEventHandler::DbgTimingInfo(DbgTimingInfoType type, const spring_time start, const spring_time end)
@@ -199,6 +199,9 @@ class CEventHandler
 		);
 
 		bool SyncedActionFallback(const string& line, int playerID);
+
+		/// delivers the events buffered for batched call-ins (UnitDamagedBatch) since the last call
+		void FlushBatchedEvents();
 		/// @}
 
 	public:
@@ -290,7 +293,8 @@ class CEventHandler
 		/// percentage when reconnecting to a running game
 		void GameProgress(int gameFrame);
 
-		void CollectGarbage();
+		/// <slackTime> is the spare frame time (ms) all clients may share
+		void CollectGarbage(float slackTime);
 		void DbgTimingInfo(DbgTimingInfoType type, const spring_time start, const spring_time end);
 		void Pong(uint8_t pingTag, const spring_time pktSendTime, const spring_time pktRecvTime);
 		void MetalMapChanged(const int x, const int z);
@@ -332,6 +336,14 @@ class CEventHandler
 		void ListInsert(EventClientList& ciList, CEventClient* ec);
 		void ListRemove(EventClientList& ciList, CEventClient* ec);
 
+		void QueueUnitDamaged(
+			const CUnit* unit,
+			const CUnit* attacker,
+			float damage,
+			int weaponDefID,
+			int projectileID,
+			bool paralyzer);
+
 	private:
 		CEventClient* mouseOwner;
 
@@ -340,6 +352,9 @@ class CEventHandler
 
 		EventClientList handles;
 
+		// only filled while at least one client wants UnitDamagedBatch
+		std::vector<SUnitDamageInfo> unitDamagedEvents;
+
 	#define SETUP_EVENT(name, props) EventClientList list ## name;
 	#define SETUP_UNMANAGED_EVENT(name, props)
 		#include "Events.def"
@@ -527,6 +542,11 @@ inline void CEventHandler::UnitDamaged(
 	bool paralyzer)
 {
 	ITERATE_UNIT_ALLYTEAM_EVENTCLIENTLIST(UnitDamaged, unit, attacker, damage, weaponDefID, projectileID, paralyzer)
+
+	if (listUnitDamagedBatch.empty())
+		return;
+
+	QueueUnitDamaged(unit, attacker, damage, weaponDefID, projectileID, paralyzer);
 }
 
 inline void CEventHandler::UnitStunned(
@@ -18,6 +18,7 @@
 #include "DataDirsAccess.h"
 #include "FileSystem.h"
 #include "FileQueryFlags.h"
+#include "MappedFile.h"
 #include "Lua/LuaParser.h"
 #include "System/ContainerUtil.h"
 #include "System/StringUtil.h"
@@ -27,6 +28,7 @@
 #include "System/Log/ILog.h"
 #include "System/Threading/SpringThreading.h"
 #include "System/UnorderedMap.hpp"
+#include "System/UnorderedSet.hpp"
 
 #if !defined(DEDICATED) && !defined(UNITSYNC)
 	#include "System/TimeProfiler.h"
@@ -51,7 +53,8 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_ARCHIVESCANNER)
  * but mapping them all, every time to make the list is)
  */
 
-constexpr static int INTERNAL_VER = 15;
+constexpr static int INTERNAL_VER = 16;
+constexpr static uint32_t CACHE_MAGIC = 0x43535341; // "ASSC"
 
 
 /*
@@ -115,6 +118,82 @@ const spring::unordered_map<std::string, int> metaDirClasses = {
 CArchiveScanner* archiveScanner = nullptr;
 
 
+namespace {
+	class CacheWriter {
+	public:
+		template<typename T> void Write(const T& value) {
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+		}
+
+		void WriteString(const std::string& str) {
+			Write(uint32_t(str.size()));
+			buffer.insert(buffer.end(), str.begin(), str.end());
+		}
+
+		void WriteStrings(const std::vector<std::string>& strs) {
+			Write(uint32_t(strs.size()));
+
+			for (const std::string& str: strs) {
+				WriteString(str);
+			}
+		}
+
+		const std::vector<uint8_t>& GetBuffer() const { return buffer; }
+
+	private:
+		std::vector<uint8_t> buffer;
+	};
+
+	// every read is bounds-checked, the cache can be truncated or garbage
+	class CacheReader {
+	public:
+		CacheReader(const uint8_t* data, size_t size): pos(data), end(data + size) {}
+
+		template<typename T> bool Read(T& value) {
+			if (size_t(end - pos) < sizeof(T))
+				return false;
+
+			std::memcpy(&value, pos, sizeof(T));
+			pos += sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string& str) {
+			uint32_t size = 0;
+
+			if (!Read(size) || size_t(end - pos) < size)
+				return false;
+
+			str.assign(reinterpret_cast<const char*>(pos), size);
+			pos += size;
+			return true;
+		}
+
+		bool ReadStrings(std::vector<std::string>& strs) {
+			uint32_t count = 0;
+
+			if (!Read(count) || size_t(end - pos) < (count * sizeof(uint32_t)))
+				return false;
+
+			strs.clear();
+			strs.resize(count);
+
+			for (std::string& str: strs) {
+				if (!ReadString(str))
+					return false;
+			}
+
+			return true;
+		}
+
+	private:
+		const uint8_t* pos;
+		const uint8_t* end;
+	};
+}
+
+
 /*
  * CArchiveScanner::ArchiveData
  */
@@ -171,10 +250,8 @@ CArchiveScanner::ArchiveData::ArchiveData(const LuaTable& archiveTable, bool fro
 	// so they can uniquely identify different versions of the same mod.
 	// (at time of this writing they use name only)
 	//
-	// NOTE when changing this, this function is used both by the code that
-	// reads ArchiveCache.lua and the code that reads modinfo.lua from the mod.
-	// so make sure it doesn't keep adding stuff to the name everytime
-	// Spring/unitsync is loaded.
+	// NOTE when changing this, the result is stored verbatim in ArchiveCache
+	// so bump INTERNAL_VER, otherwise cached names will not be updated.
 	//
 	const std::string& name = GetNameVersioned();
 	const std::string& version = GetVersion();
@@ -380,6 +457,15 @@ static spring::recursive_mutex scannerMutex;
 static std::atomic<uint32_t> numScannedArchives{0};
 
 
+// guards against recursive scans, e.g. via LuaParser
+struct ScanScope {
+	 ScanScope(bool* b) { p = b; *p =  true; }
+	~ScanScope(       ) {        *p = false; }
+
+	bool* p = nullptr;
+};
+
+
 /*
  * CArchiveScanner
  */
@@ -388,7 +474,7 @@ CArchiveScanner::CArchiveScanner()
 {
 	Clear();
 	// the "cache" dir is created in DataDirLocater
-	ReadCacheData(cachefile = FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + IntToString(INTERNAL_VER, "ArchiveCache%i.lua"));
+	ReadCacheData(cachefile = FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + IntToString(INTERNAL_VER, "ArchiveCache%i.bin"));
 	ScanAllDirs();
 }
 
@@ -432,7 +518,7 @@ void CArchiveScanner::Reload()
 
 	// ctor
 	Clear();
-	ReadCacheData(cachefile = FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + IntToString(INTERNAL_VER, "ArchiveCache%i.lua"));
+	ReadCacheData(cachefile = FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + IntToString(INTERNAL_VER, "ArchiveCache%i.bin"));
 	ScanAllDirs();
 }
 
@@ -498,12 +584,49 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 		}
 	}*/
 
-	// Create archiveInfos etc. if not in cache already
+	// Create archiveInfos etc. if not in cache already; the cache is checked
+	// serially (it modifies archiveInfos) while new archives are opened and
+	// inspected concurrently, then merged back in the order they were found
+	std::vector<ScannedArchive> scannedArchives;
+	std::vector<std::string> duplicateArchives;
+
+	spring::unordered_set<std::string> scannedNames;
+
 	for (const std::string& archive: foundArchives) {
+		unsigned modifiedTime = 0;
+
+		if (CheckCachedData(archive, modifiedTime, false))
+			continue;
+
+		// same name found twice (e.g. through links); leave it to CheckCachedData
+		// to decide what to do about the second one once the first is added
+		if (!scannedNames.insert(StringToLower(FileSystem::GetFilename(archive))).second) {
+			duplicateArchives.push_back(archive);
+			continue;
+		}
+
+		scannedArchives.emplace_back();
+		scannedArchives.back().fullName = archive;
+		scannedArchives.back().archiveInfo.modified = modifiedTime;
+	}
+
+	{
+		const ScanScope scanScope(&isInScan);
+
+		for_mt(0, scannedArchives.size(), [&](const int i) {
+			ScanArchiveData(scannedArchives[i]);
+
+			#if !defined(DEDICATED) && !defined(UNITSYNC)
+			Watchdog::ClearTimer(WDT_MAIN);
+			#endif
+		});
+	}
+
+	for (ScannedArchive& sa: scannedArchives) {
+		AddScannedArchive(sa, false);
+	}
+	for (const std::string& archive: duplicateArchives) {
 		ScanArchive(archive, false);
-	#if !defined(DEDICATED) && !defined(UNITSYNC)
-		Watchdog::ClearTimer(WDT_MAIN);
-	#endif
 	}
 
 	// Now we'll have to parse the replaces-stuff found in the mods
@@ -647,29 +770,35 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	if (CheckCachedData(fullName, modifiedTime, doChecksum))
 		return;
 
-	isDirty = true;
-	isInScan = true;
+	ScannedArchive sa;
+	sa.fullName = fullName;
+	sa.archiveInfo.modified = modifiedTime;
 
-	struct ScanScope {
-		 ScanScope(bool* b) { p = b; *p =  true; }
-		~ScanScope(       ) {        *p = false; }
+	{
+		const ScanScope scanScope(&isInScan);
+		ScanArchiveData(sa);
+	}
 
-		bool* p = nullptr;
-	};
+	AddScannedArchive(sa, doChecksum);
+}
 
-	const ScanScope scanScope(&isInScan);
 
+void CArchiveScanner::ScanArchiveData(ScannedArchive& sa)
+{
+	const std::string& fullName = sa.fullName;
 	const std::string& fname = FileSystem::GetFilename(fullName);
 	const std::string& fpath = FileSystem::GetDirectory(fullName);
 	const std::string& lcfn  = StringToLower(fname);
 
+	const uint32_t modifiedTime = sa.archiveInfo.modified;
+
 	std::unique_ptr<IArchive> ar(archiveLoader.OpenArchive(fullName));
 
 	if (ar == nullptr || !ar->IsOpen()) {
 		LOG_L(L_WARNING, "[AS::%s] unable to open archive \"%s\"", __func__, fullName.c_str());
 
 		// record it as broken, so we don't need to look inside everytime
-		BrokenArchive& ba = GetAddBrokenArchive(lcfn);
+		BrokenArchive& ba = sa.brokenArchive;
 		ba.name = lcfn;
 		ba.path = fpath;
 		ba.modified = modifiedTime;
@@ -677,7 +806,8 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		ba.problem = "Unable to open archive";
 
 		// does not count as a scan
-		// numScannedArchives += 1;
+		sa.isBroken = true;
+		sa.isScanned = false;
 		return;
 	}
 
@@ -690,7 +820,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	const bool hasMapInfo = ar->FileExists("mapinfo.lua");
 
 
-	ArchiveInfo ai;
+	ArchiveInfo& ai = sa.archiveInfo;
 	ArchiveData& ad = ai.archiveData;
 
 	// execute the respective .lua, otherwise assume this archive is a map
@@ -713,7 +843,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		LOG_L(L_WARNING, "[AS::%s] failed to scan \"%s\" (%s)", __func__, fullName.c_str(), error.c_str());
 
 		// mark archive as broken, so we don't need to look inside everytime
-		BrokenArchive& ba = GetAddBrokenArchive(lcfn);
+		BrokenArchive& ba = sa.brokenArchive;
 		ba.name = lcfn;
 		ba.path = fpath;
 		ba.modified = modifiedTime;
@@ -721,7 +851,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		ba.problem = error;
 
 		// does count as a scan
-		numScannedArchives += 1;
+		sa.isBroken = true;
 		return;
 	}
 
@@ -753,7 +883,6 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	}
 
 	ai.path = fpath;
-	ai.modified = modifiedTime;
 
 	// Store modinfo.lua/mapinfo.lua modified timestamp for directory archives, as only they can change.
 	if (ar->GetType() == ARCHIVE_TYPE_SDD && !luaInfoFile.empty()) {
@@ -763,7 +892,23 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 
 	ai.origName = fname;
 	ai.updated = true;
-	ai.hashed = doChecksum && GetArchiveChecksum(fullName, ai);
+}
+
+void CArchiveScanner::AddScannedArchive(ScannedArchive& sa, bool doChecksum)
+{
+	const std::string& lcfn = StringToLower(FileSystem::GetFilename(sa.fullName));
+
+	isDirty = true;
+
+	if (sa.isBroken) {
+		GetAddBrokenArchive(lcfn) = std::move(sa.brokenArchive);
+
+		numScannedArchives += sa.isScanned;
+		return;
+	}
+
+	ArchiveInfo& ai = sa.archiveInfo;
+	ai.hashed = doChecksum && GetArchiveChecksum(sa.fullName, ai);
 
 	archiveInfosIndex.insert(lcfn, archiveInfos.size());
 	archiveInfos.emplace_back(std::move(ai));
@@ -923,11 +1068,11 @@ bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, Archive
 
 	// load ignore list, and insert all files to check in lowercase format
 	std::unique_ptr<IFileFilter> ignore(CreateIgnoreFilter(ar.get()));
-	std::vector<std::string> fileNames;
-	std::vector<sha512::raw_digest> fileHashes;
+	std::vector<FileHash> archiveHashes;
+	std::vector<size_t> hashIndices;
 
-	fileNames.reserve(ar->NumFiles());
-	fileHashes.reserve(ar->NumFiles());
+	archiveHashes.reserve(ar->NumFiles());
+	hashIndices.reserve(ar->NumFiles());
 
 	for (unsigned fid = 0; fid != ar->NumFiles(); ++fid) {
 		const std::pair<std::string, int>& info = ar->FileInfo(fid);
@@ -936,28 +1081,48 @@ bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, Archive
 			continue;
 
 		// create case-insensitive hashes
-		fileNames.push_back(StringToLower(info.first));
-		fileHashes.emplace_back();
+		archiveHashes.push_back({StringToLower(info.first), uint32_t(info.second), ar->GetFileStamp(fid), {}});
 	}
 
 	// sort by filename
-	std::stable_sort(fileNames.begin(), fileNames.end());
+	std::stable_sort(archiveHashes.begin(), archiveHashes.end(), [](const FileHash& a, const FileHash& b) { return (a.name < b.name); });
 
-	// compute hashes of the files
-	for_mt(0, fileNames.size(), [&](const int i) {
-		ar->CalcHash(ar->FindFile(fileNames[i]), fileHashes[i].data());
+	{
+		// reuse the hashes of files that did not change since the last scan
+		const std::vector<FileHash>& cachedHashes = fileHashes[StringToLower(FileSystem::GetFilename(archiveName))];
+
+		for (FileHash& fh: archiveHashes) {
+			const auto pred = [](const FileHash& a, const FileHash& b) { return (a.name < b.name); };
+			const auto iter = std::lower_bound(cachedHashes.begin(), cachedHashes.end(), fh, pred);
+
+			if (fh.stamp != 0 && iter != cachedHashes.end() && iter->name == fh.name && iter->size == fh.size && iter->stamp == fh.stamp) {
+				fh.digest = iter->digest;
+				continue;
+			}
+
+			hashIndices.push_back(&fh - &archiveHashes[0]);
+		}
+	}
+
+	// compute hashes of the (changed) files
+	for_mt(0, hashIndices.size(), [&](const int i) {
+		FileHash& fh = archiveHashes[hashIndices[i]];
+
+		ar->CalcHash(ar->FindFile(fh.name), fh.digest.data());
 
 		#if !defined(DEDICATED) && !defined(UNITSYNC)
 		Watchdog::ClearTimer(WDT_MAIN);
 		#endif
 	});
 
+	LOG_S(LOG_SECTION_ARCHIVESCANNER, "[AS::%s] hashed %u of %u files in \"%s\"", __func__, unsigned(hashIndices.size()), unsigned(archiveHashes.size()), archiveName.c_str());
+
 	// combine individual hashes, initialize to hash(name)
-	for (size_t i = 0; i < fileNames.size(); i++) {
-		sha512::calc_digest(reinterpret_cast<const uint8_t*>(fileNames[i].c_str()), fileNames[i].size(), archiveInfo.checksum);
+	for (const FileHash& fh: archiveHashes) {
+		sha512::calc_digest(reinterpret_cast<const uint8_t*>(fh.name.c_str()), fh.name.size(), archiveInfo.checksum);
 
 		for (uint8_t j = 0; j < sha512::SHA_LEN; j++) {
-			archiveInfo.checksum[j] ^= fileHashes[i][j];
+			archiveInfo.checksum[j] ^= fh.digest[j];
 		}
 
 		#if !defined(DEDICATED) && !defined(UNITSYNC)
@@ -965,6 +1130,11 @@ bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, Archive
 		#endif
 	}
 
+	// files without a stamp are rehashed every time, no point in keeping them
+	const auto noStamp = [](const FileHash& fh) { return (fh.stamp == 0); };
+	archiveHashes.erase(std::remove_if(archiveHashes.begin(), archiveHashes.end(), noStamp), archiveHashes.end());
+
+	fileHashes[StringToLower(FileSystem::GetFilename(archiveName))] = std::move(archiveHashes);
 	return true;
 }
 
@@ -977,103 +1147,165 @@ void CArchiveScanner::ReadCacheData(const std::string& filename)
 		return;
 	}
 
-	LuaParser p(filename, SPRING_VFS_RAW, SPRING_VFS_BASE);
-	if (!p.Execute()) {
-		LOG_L(L_ERROR, "[AS::%s] failed to parse ArchiveCache: %s", __func__, p.GetErrorLog().c_str());
+	const CMappedFile cacheFile(filename);
+
+	if (!cacheFile.IsOpen()) {
+		LOG_L(L_ERROR, "[AS::%s] failed to open ArchiveCache %s", __func__, filename.c_str());
 		return;
 	}
 
-	const LuaTable& archiveCacheTbl = p.GetRoot();
-	const LuaTable& archivesTbl = archiveCacheTbl.SubTable("archives");
-	const LuaTable& brokenArchivesTbl = archiveCacheTbl.SubTable("brokenArchives");
+	CacheReader reader(cacheFile.GetData(), cacheFile.GetSize());
+
+	uint32_t magic = 0;
+	uint32_t ver = 0;
+	uint32_t numArchives = 0;
+	uint32_t numBrokenArchives = 0;
+	uint32_t numHashedArchives = 0;
 
 	// Do not load old version caches
-	const int ver = archiveCacheTbl.GetInt("internalver", (INTERNAL_VER + 1));
-	if (ver != INTERNAL_VER)
+	if (!reader.Read(magic) || !reader.Read(ver) || magic != CACHE_MAGIC || ver != INTERNAL_VER)
 		return;
 
-	for (int i = 1; archivesTbl.KeyExists(i); ++i) {
-		const LuaTable& curArchiveTbl = archivesTbl.SubTable(i);
-		const LuaTable& archivedTbl = curArchiveTbl.SubTable("archivedata");
+	const auto ReadError = [&]() {
+		LOG_L(L_ERROR, "[AS::%s] ArchiveCache %s is corrupt, rescanning all archives", __func__, filename.c_str());
+		Clear();
+		cachefile = filename;
+	};
+
+	if (!reader.Read(numArchives))
+		return ReadError();
 
-		const std::string& curArchiveName = curArchiveTbl.GetString("name", "");
-		const std::string& curArchiveNameLC = StringToLower(curArchiveName);
-		const std::string& hexDigestStr = curArchiveTbl.GetString("checksum", "");
+	for (uint32_t i = 0; i < numArchives; ++i) {
+		std::string origName;
+		std::string path;
+		std::string archiveDataPath;
 
-		ArchiveInfo& ai = GetAddArchiveInfo(curArchiveNameLC);
+		uint32_t modified = 0;
+		uint32_t modifiedArchiveData = 0;
+		uint32_t numInfoItems = 0;
+
+		sha512::raw_digest checksum;
+
+		if (!reader.ReadString(origName) || !reader.ReadString(path) || !reader.ReadString(archiveDataPath))
+			return ReadError();
+		if (!reader.Read(modified) || !reader.Read(modifiedArchiveData) || !reader.Read(checksum) || !reader.Read(numInfoItems))
+			return ReadError();
+
+		ArchiveInfo& ai = GetAddArchiveInfo(StringToLower(origName));
 		ArchiveInfo tmp; // used to compare against all-zero hash
+		ArchiveData& ad = ai.archiveData;
 
-		ai.origName 	   = curArchiveName;
-		ai.path     	   = curArchiveTbl.GetString("path", "");
-		ai.archiveDataPath = curArchiveTbl.GetString("archiveDataPath", "");
-
-		// do not use LuaTable.GetInt() for 32-bit integers: the Spring lua
-		// library uses 32-bit floats to represent numbers, which can only
-		// represent 2^24 consecutive integers
-		ai.modified = strtoul(curArchiveTbl.GetString("modified", "0").c_str(), nullptr, 10);
-		ai.modifiedArchiveData = strtoul(curArchiveTbl.GetString("modifiedArchiveData", "0").c_str(), nullptr, 10);
-
-		// convert digest-string back to raw checksum
-		if (hexDigestStr.size() == (sha512::SHA_LEN * 2)) {
-			sha512::hex_digest hexDigest;
-			sha512::raw_digest rawDigest;
-			std::copy(hexDigestStr.begin(), hexDigestStr.end(), hexDigest.data());
-			sha512::read_digest(hexDigest, rawDigest);
-			std::memcpy(ai.checksum, rawDigest.data(), sha512::SHA_LEN);
-		}
+		ai.origName            = origName;
+		ai.path                = path;
+		ai.archiveDataPath     = archiveDataPath;
+		ai.modified            = modified;
+		ai.modifiedArchiveData = modifiedArchiveData;
+
+		std::memcpy(ai.checksum, checksum.data(), sha512::SHA_LEN);
 
 		ai.updated = false;
 		ai.hashed = (memcmp(ai.checksum, tmp.checksum, sha512::SHA_LEN) != 0);
 
-
-		ai.archiveData = CArchiveScanner::ArchiveData(archivedTbl, true);
-		if (ai.archiveData.IsMap()) {
-			AddDependency(ai.archiveData.GetDependencies(), GetMapHelperContentName());
-		} else if (ai.archiveData.IsGame()) {
-			AddDependency(ai.archiveData.GetDependencies(), GetSpringBaseContentName());
+		// items are stored as they were scanned, including the name-version HACK
+		for (uint32_t j = 0; j < numInfoItems; ++j) {
+			std::string key;
+			std::string str;
+
+			uint8_t type = 0;
+
+			int32_t intValue = 0;
+			float fltValue = 0.0f;
+			uint32_t boolValue = 0;
+
+			if (!reader.ReadString(key) || !reader.Read(type))
+				return ReadError();
+
+			switch (type) {
+				case INFO_VALUE_TYPE_STRING: {
+					if (!reader.ReadString(str))
+						return ReadError();
+
+					ad.SetInfoItemValueString(key, str);
+				} break;
+				case INFO_VALUE_TYPE_INTEGER: {
+					if (!reader.Read(intValue))
+						return ReadError();
+
+					ad.SetInfoItemValueInteger(key, intValue);
+				} break;
+				case INFO_VALUE_TYPE_FLOAT: {
+					if (!reader.Read(fltValue))
+						return ReadError();
+
+					ad.SetInfoItemValueFloat(key, fltValue);
+				} break;
+				case INFO_VALUE_TYPE_BOOL: {
+					if (!reader.Read(boolValue))
+						return ReadError();
+
+					ad.SetInfoItemValueBool(key, boolValue != 0);
+				} break;
+				default: {
+					return ReadError();
+				} break;
+			}
 		}
+
+		if (!reader.ReadStrings(ad.GetDependencies()) || !reader.ReadStrings(ad.GetReplaces()))
+			return ReadError();
 	}
 
-	for (int i = 1; brokenArchivesTbl.KeyExists(i); ++i) {
-		const LuaTable& curArchive = brokenArchivesTbl.SubTable(i);
-		const std::string& name = StringToLower(curArchive.GetString("name", ""));
+	if (!reader.Read(numBrokenArchives))
+		return ReadError();
+
+	for (uint32_t i = 0; i < numBrokenArchives; ++i) {
+		std::string name;
+		std::string path;
+		std::string problem;
+
+		uint32_t modified = 0;
+
+		if (!reader.ReadString(name) || !reader.ReadString(path) || !reader.ReadString(problem) || !reader.Read(modified))
+			return ReadError();
 
 		BrokenArchive& ba = GetAddBrokenArchive(name);
 		ba.name = name;
-		ba.path = curArchive.GetString("path", "");
-		ba.modified = strtoul(curArchive.GetString("modified", "0").c_str(), nullptr, 10);
+		ba.path = path;
+		ba.modified = modified;
 		ba.updated = false;
-		ba.problem = curArchive.GetString("problem", "unknown");
+		ba.problem = problem;
 	}
 
-	isDirty = false;
-}
+	if (!reader.Read(numHashedArchives))
+		return ReadError();
 
-static inline void SafeStr(FILE* out, const char* prefix, const std::string& str)
-{
-	if (str.empty())
-		return;
+	for (uint32_t i = 0; i < numHashedArchives; ++i) {
+		std::string name;
+		uint32_t numFiles = 0;
 
-	if ((str.find_first_of("\\\"") != std::string::npos) || (str.find_first_of('\n') != std::string::npos )) {
-		fprintf(out, "%s[[%s]],\n", prefix, str.c_str());
-	} else {
-		fprintf(out, "%s\"%s\",\n", prefix, str.c_str());
+		if (!reader.ReadString(name) || !reader.Read(numFiles))
+			return ReadError();
+
+		std::vector<FileHash>& archiveHashes = fileHashes[name];
+		archiveHashes.resize(numFiles);
+
+		for (FileHash& fh: archiveHashes) {
+			if (!reader.ReadString(fh.name) || !reader.Read(fh.size) || !reader.Read(fh.stamp) || !reader.Read(fh.digest))
+				return ReadError();
+		}
 	}
-}
 
-void FilterDep(std::vector<std::string>& deps, const std::string& exclude)
-{
-	auto it = std::remove_if(deps.begin(), deps.end(), [&](const std::string& dep) { return (dep == exclude); });
-	deps.erase(it, deps.end());
+	isDirty = false;
 }
 
+
 void CArchiveScanner::WriteCacheData(const std::string& filename)
 {
 	std::lock_guard<decltype(scannerMutex)> lck(scannerMutex);
 	if (!isDirty)
 		return;
 
-	FILE* out = fopen(filename.c_str(), "wt");
+	FILE* out = fopen(filename.c_str(), "wb");
 	if (out == nullptr) {
 		LOG_L(L_ERROR, "[AS::%s] failed to write to \"%s\"!", __func__, filename.c_str());
 		return;
@@ -1100,82 +1332,90 @@ void CArchiveScanner::WriteCacheData(const std::string& filename)
 		for (const BrokenArchive& bi: brokenArchives) {
 			brokenArchivesIndex.insert(bi.name, &bi - &brokenArchives[0]);
 		}
+
+		// drop file hashes of archives that no longer exist
+		for (auto iter = fileHashes.begin(); iter != fileHashes.end(); ) {
+			if (archiveInfosIndex.find(iter->first) == archiveInfosIndex.end()) {
+				iter = fileHashes.erase(iter);
+			} else {
+				++iter;
+			}
+		}
 	}
 
+	CacheWriter writer;
 
-	fprintf(out, "local archiveCache = {\n\n");
-	fprintf(out, "\tinternalver = %i,\n\n", INTERNAL_VER);
-	fprintf(out, "\tarchives = {  -- count = %u\n", unsigned(archiveInfos.size()));
+	writer.Write(CACHE_MAGIC);
+	writer.Write(uint32_t(INTERNAL_VER));
+	writer.Write(uint32_t(archiveInfos.size()));
 
 	for (const ArchiveInfo& arcInfo: archiveInfos) {
-		sha512::raw_digest rawDigest;
-		sha512::hex_digest hexDigest;
-
-		std::memcpy(rawDigest.data(), arcInfo.checksum, sha512::SHA_LEN);
-		sha512::dump_digest(rawDigest, hexDigest);
-
-		fprintf(out, "\t\t{\n");
-		SafeStr(out, "\t\t\tname = ",              arcInfo.origName);
-		SafeStr(out, "\t\t\tpath = ",              arcInfo.path);
-		fprintf(out, "\t\t\tmodified = \"%u\",\n", arcInfo.modified);
-		fprintf(out, "\t\t\tchecksum = \"%s\",\n", hexDigest.data());
-		SafeStr(out, "\t\t\treplaced = ",          arcInfo.replaced);
-
-		if (!arcInfo.archiveDataPath.empty()) {
-			SafeStr(out, "\t\t\tarchiveDataPath = ",              arcInfo.archiveDataPath);
-			fprintf(out, "\t\t\tmodifiedArchiveData = \"%u\",\n", arcInfo.modifiedArchiveData);
-		}
+		// replaced-entries are recreated by ScanDirs, as in the Lua cache
+		writer.WriteString(arcInfo.origName);
+		writer.WriteString(arcInfo.path);
+		writer.WriteString(arcInfo.archiveDataPath);
+		writer.Write(arcInfo.modified);
+		writer.Write(arcInfo.modifiedArchiveData);
+		writer.Write(arcInfo.checksum);
 
-		// mod info?
 		const ArchiveData& archData = arcInfo.archiveData;
-		if (!archData.GetName().empty()) {
-			fprintf(out, "\t\t\tarchivedata = {\n");
-
-			for (const auto& ii: archData.GetInfo()) {
-				if (ii.second.valueType == INFO_VALUE_TYPE_STRING) {
-					SafeStr(out, std::string("\t\t\t\t" + ii.first + " = ").c_str(), ii.second.valueTypeString);
-				} else {
-					fprintf(out, "\t\t\t\t%s = %s,\n", ii.first.c_str(), ii.second.GetValueAsString(false).c_str());
-				}
-			}
 
-			std::vector<std::string> deps = archData.GetDependencies();
-			if (archData.IsMap()) {
-				FilterDep(deps, GetMapHelperContentName());
-			} else if (archData.IsGame()) {
-				FilterDep(deps, GetSpringBaseContentName());
-			}
+		// mod info?
+		if (archData.GetName().empty()) {
+			writer.Write(uint32_t(0));
+			writer.WriteStrings({});
+			writer.WriteStrings({});
+			continue;
+		}
 
-			if (!deps.empty()) {
-				fprintf(out, "\t\t\t\tdepend = {\n");
-				for (const auto& dep: deps) {
-					SafeStr(out, "\t\t\t\t\t", dep);
-				}
-				fprintf(out, "\t\t\t\t},\n");
+		writer.Write(uint32_t(archData.GetInfo().size()));
+
+		for (const auto& ii: archData.GetInfo()) {
+			const InfoItem& item = ii.second;
+
+			writer.WriteString(item.key);
+			writer.Write(uint8_t(item.valueType));
+
+			switch (item.valueType) {
+				case INFO_VALUE_TYPE_STRING : { writer.WriteString(item.valueTypeString);            } break;
+				case INFO_VALUE_TYPE_INTEGER: { writer.Write(int32_t(item.value.typeInteger));        } break;
+				case INFO_VALUE_TYPE_FLOAT  : { writer.Write(item.value.typeFloat);                   } break;
+				case INFO_VALUE_TYPE_BOOL   : { writer.Write(uint32_t(item.value.typeBool));          } break;
 			}
-			fprintf(out, "\t\t\t},\n");
 		}
 
-		fprintf(out, "\t\t},\n");
+		writer.WriteStrings(archData.GetDependencies());
+		writer.WriteStrings(archData.GetReplaces());
 	}
 
-	fprintf(out, "\t},\n\n"); // close 'archives'
-	fprintf(out, "\tbrokenArchives = {  -- count = %u\n", unsigned(brokenArchives.size()));
+	writer.Write(uint32_t(brokenArchives.size()));
 
 	for (const BrokenArchive& ba: brokenArchives) {
-		fprintf(out, "\t\t{\n");
-		SafeStr(out, "\t\t\tname = ", ba.name);
-		SafeStr(out, "\t\t\tpath = ", ba.path);
-		fprintf(out, "\t\t\tmodified = \"%u\",\n", ba.modified);
-		SafeStr(out, "\t\t\tproblem = ", ba.problem);
-		fprintf(out, "\t\t},\n");
+		writer.WriteString(ba.name);
+		writer.WriteString(ba.path);
+		writer.WriteString(ba.problem);
+		writer.Write(ba.modified);
+	}
+
+	writer.Write(uint32_t(fileHashes.size()));
+
+	for (const auto& pair: fileHashes) {
+		writer.WriteString(pair.first);
+		writer.Write(uint32_t(pair.second.size()));
+
+		for (const FileHash& fh: pair.second) {
+			writer.WriteString(fh.name);
+			writer.Write(fh.size);
+			writer.Write(fh.stamp);
+			writer.Write(fh.digest);
+		}
 	}
 
-	fprintf(out, "\t},\n"); // close 'brokenArchives'
-	fprintf(out, "}\n\n"); // close 'archiveCache'
-	fprintf(out, "return archiveCache\n");
+	const std::vector<uint8_t>& buffer = writer.GetBuffer();
+
+	const bool written = (fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size());
 
-	if (fclose(out) == EOF)
+	if ((fclose(out) == EOF) || !written)
 		LOG_L(L_ERROR, "[AS::%s] failed to write to \"%s\"!", __func__, filename.c_str());
 
 	isDirty = false;
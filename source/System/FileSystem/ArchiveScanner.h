@@ -184,6 +184,21 @@ private:
 		uint32_t modified = 0;
 		bool updated = false;
 	};
+	struct ScannedArchive {
+		std::string fullName;
+
+		ArchiveInfo archiveInfo;
+		BrokenArchive brokenArchive; // valid iff isBroken
+
+		bool isBroken = false;
+		bool isScanned = true; // whether it counts towards numScannedArchives
+	};
+	struct FileHash {
+		std::string name;         // lower-case
+		uint32_t size;
+		uint32_t stamp;           // IArchive::GetFileStamp
+		sha512::raw_digest digest;
+	};
 
 private:
 	ArchiveInfo& GetAddArchiveInfo(const std::string& lcfn);
@@ -192,6 +207,14 @@ private:
 	void ScanDirs(const std::vector<std::string>& dirs);
 	void ScanDir(const std::string& curPath, std::deque<std::string>& foundArchives);
 
+	/**
+	 * Opens and inspects an archive; does not touch any scanner state so
+	 * multiple archives can be scanned at once. AddScannedArchive has to
+	 * be called (serially) with the result afterwards.
+	 */
+	void ScanArchiveData(ScannedArchive& sa);
+	void AddScannedArchive(ScannedArchive& sa, bool doChecksum);
+
 	/// scan mapinfo / modinfo lua files
 	bool ScanArchiveLua(IArchive* ar, const std::string& fileName, ArchiveInfo& ai, std::string& err);
 
@@ -243,6 +266,10 @@ private:
 	std::vector<ArchiveInfo> archiveInfos;
 	std::vector<BrokenArchive> brokenArchives;
 
+	// hashes of individual files per (lower-case) archive name, so only
+	// changed files have to be rehashed when an archive is modified
+	spring::unordered_map<std::string, std::vector<FileHash>> fileHashes;
+
 	std::string cachefile;
 
 	bool isDirty = false;
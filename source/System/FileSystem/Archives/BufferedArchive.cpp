@@ -5,6 +5,7 @@
 #include "System/MainDefines.h"
 #include "System/Log/ILog.h"
 
+#include <algorithm>
 #include <cassert>
 
 CBufferedArchive::~CBufferedArchive()
@@ -13,12 +14,12 @@ CBufferedArchive::~CBufferedArchive()
 	if (cacheSize <= 1 || fileCount <= 1)
 		return;
 
-	LOG_L(L_INFO, "[%s][name=%s] %u bytes cached in %u files", __func__, archiveFile.c_str(), cacheSize, fileCount);
+	LOG_L(L_INFO, "[%s][name=%s] " _STPF_ " bytes cached in %u files (%u evicted)", __func__, archiveFile.c_str(), cacheSize, fileCount, evictCount);
 }
 
 bool CBufferedArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer)
 {
-	std::lock_guard<spring::mutex> lck(archiveLock);
+	std::unique_lock<spring::mutex> lck(archiveLock);
 	assert(IsFileId(fid));
 
 	int ret = 0;
@@ -44,23 +45,121 @@ bool CBufferedArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buff
 
 	FileBuffer& fb = cache.at(fid);
 
-	if (!fb.populated) {
-		fb.exists = ((ret = GetFileImpl(fid, fb.data)) == 1);
-		fb.populated = true;
-
-		cacheSize += fb.data.size();
-		fileCount += fb.exists;
+	// loop since the entry can be evicted again while waiting for another reader
+	while (!fb.populated) {
+		ret = ReadFile(fid, lck);
 	}
 
+	fb.lastAccess = ++accessCount;
+
 	if (!fb.exists) {
 		LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][!fb.exists] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, fb.data.size());
 		return false;
 	}
 
-	if (buffer.size() != fb.data.size())
-		buffer.resize(fb.data.size());
-
 	// TODO: zero-copy access
-	std::copy(fb.data.begin(), fb.data.end(), buffer.begin());
+	buffer.assign(fb.data.begin(), fb.data.end());
+
+	EvictFiles();
+	return true;
+}
+
+bool CBufferedArchive::PrefetchFile(unsigned int fid)
+{
+	std::unique_lock<spring::mutex> lck(archiveLock);
+	assert(IsFileId(fid));
+
+	if (noCache || !globalConfig.vfsCacheArchiveFiles)
+		return false;
+
+	if (cache.empty())
+		cache.resize(NumFiles());
+
+	const FileBuffer& fb = cache[fid];
+
+	if (fb.populated || fb.pending)
+		return false;
+
+	// never evict (possibly prefetched) files just to make room for more
+	const size_t maxCacheSize = globalConfig.vfsCacheArchiveFilesSize * size_t(1024 * 1024);
+
+	if (maxCacheSize > 0 && (cacheSize + FileInfo(fid).second) > maxCacheSize)
+		return false;
+
+	ReadFile(fid, lck);
 	return true;
 }
+
+
+int CBufferedArchive::ReadFile(unsigned int fid, std::unique_lock<spring::mutex>& lck)
+{
+	FileBuffer& fb = cache[fid];
+
+	int ret = 0;
+
+	if (fb.pending) {
+		archiveCond.wait(lck, [&]() { return (!fb.pending); });
+		return (fb.exists? 1: 0);
+	}
+
+	if (HasThreadSafeReads()) {
+		std::vector<std::uint8_t> data;
+
+		// other files can be read (and cached ones returned) in the meantime
+		fb.pending = true;
+		lck.unlock();
+
+		ret = GetFileImpl(fid, data);
+
+		lck.lock();
+		fb.pending = false;
+		fb.data = std::move(data);
+
+		archiveCond.notify_all();
+	} else {
+		ret = GetFileImpl(fid, fb.data);
+	}
+
+	fb.exists = (ret == 1);
+	fb.populated = true;
+	fb.lastAccess = ++accessCount;
+
+	cacheSize += fb.data.size();
+	fileCount += fb.exists;
+	return ret;
+}
+
+void CBufferedArchive::EvictFiles()
+{
+	const size_t maxCacheSize = globalConfig.vfsCacheArchiveFilesSize * size_t(1024 * 1024);
+
+	if (maxCacheSize == 0 || cacheSize <= maxCacheSize)
+		return;
+
+	// (lastAccess, fid); least recently accessed files go first
+	std::vector<std::pair<uint64_t, unsigned int>> cachedFiles;
+	cachedFiles.reserve(fileCount);
+
+	for (unsigned int fid = 0; fid < cache.size(); fid++) {
+		if (!cache[fid].populated)
+			continue;
+
+		cachedFiles.emplace_back(cache[fid].lastAccess, fid);
+	}
+
+	std::sort(cachedFiles.begin(), cachedFiles.end());
+
+	// go below the limit by some margin so this does not run on every read
+	for (const auto& p: cachedFiles) {
+		if (cacheSize <= ((maxCacheSize / 4) * 3))
+			break;
+
+		FileBuffer& fb = cache[p.second];
+
+		cacheSize -= fb.data.size();
+		fileCount -= fb.exists;
+		evictCount += 1;
+
+		fb = FileBuffer();
+	}
+}
@@ -22,9 +22,13 @@ public:
 	virtual int GetType() const override { return ARCHIVE_TYPE_BUF; }
 
 	bool GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	bool PrefetchFile(unsigned int fid) override;
+	bool HasConcurrentReads() const override { return (HasThreadSafeReads() && !noCache); }
 
 protected:
 	virtual int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) = 0;
+	/// true if GetFileImpl can be called for different files at once (without archiveLock)
+	virtual bool HasThreadSafeReads() const { return false; }
 
 	struct FileBuffer {
 		FileBuffer() = default;
@@ -36,21 +40,33 @@ protected:
 
 		bool populated = false; // files may be empty (0 bytes)
 		bool exists = false;
+		bool pending = false; // being read by another thread
+
+		std::uint64_t lastAccess = 0;
 
 		std::vector<std::uint8_t> data;
 	};
 
+private:
+	int ReadFile(unsigned int fid, std::unique_lock<spring::mutex>& lck);
+	void EvictFiles();
+
+protected:
 	// indexed by file-id
 	std::vector<FileBuffer> cache;
 	// neither 7zip (.sd7) nor minizip (.sdz) are threadsafe
-	// zlib (used to extract pool archive .gz entries) should
-	// not need this, but currently each buffered GetFileImpl
-	// call is protected
+	// zlib (used to extract pool archive .gz entries) is, so
+	// only archives with thread-safe reads release this while
+	// calling GetFileImpl
 	spring::mutex archiveLock;
+	spring::condition_variable_any archiveCond;
 
 private:
-	uint32_t cacheSize = 0;
+	size_t cacheSize = 0;
 	uint32_t fileCount = 0;
+	uint32_t evictCount = 0;
+
+	uint64_t accessCount = 0;
 
 	bool noCache = false;
 };
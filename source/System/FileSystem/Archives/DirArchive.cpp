@@ -9,6 +9,7 @@
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/MappedFile.h"
 #include "System/StringUtil.h"
 
 
@@ -47,19 +48,49 @@ bool CDirArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer)
 	assert(IsFileId(fid));
 
 	const std::string rawpath = dataDirsAccess.LocateFile(dirName + searchFiles[fid]);
+	const CMappedFile mappedFile(rawpath);
+
+	// copy straight out of the page-cache, no intermediate stream buffers
+	if (mappedFile.IsOpen()) {
+		buffer.assign(mappedFile.GetData(), mappedFile.GetData() + mappedFile.GetSize());
+		return true;
+	}
+
+	// empty files can not be mapped, others might fail to be (mapping
+	// limits, special filesystems) and have to be read the slow way
 	std::ifstream ifs(rawpath.c_str(), std::ios::in | std::ios::binary);
 
 	if (ifs.bad() || !ifs.is_open())
 		return false;
 
 	ifs.seekg(0, std::ios_base::end);
-	buffer.resize(ifs.tellg());
+
+	const std::streamoff fileSize = ifs.tellg();
+
+	if (fileSize < 0)
+		return false;
+
+	buffer.resize(fileSize);
 	ifs.seekg(0, std::ios_base::beg);
 	ifs.clear();
 
 	if (!buffer.empty())
-		ifs.read((char*)&buffer[0], buffer.size());
+		ifs.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
 
+	return (!ifs.bad() && ifs.gcount() == std::streamsize(buffer.size()));
+}
+
+bool CDirArchive::PrefetchFile(unsigned int fid)
+{
+	assert(IsFileId(fid));
+
+	const CMappedFile mappedFile(dataDirsAccess.LocateFile(dirName + searchFiles[fid]));
+
+	if (!mappedFile.IsOpen())
+		return false;
+
+	// readahead pages stay in the page-cache after unmapping
+	mappedFile.Prefetch(0, mappedFile.GetSize());
 	return true;
 }
 
@@ -78,3 +109,9 @@ void CDirArchive::FileInfo(unsigned int fid, std::string& name, int& size) const
 		size = 0;
 	}
 }
+
+uint32_t CDirArchive::GetFileStamp(unsigned int fid) const
+{
+	assert(IsFileId(fid));
+	return (FileSystemAbstraction::GetFileModificationTime(dataDirsAccess.LocateFile(dirName + searchFiles[fid])));
+}
@@ -37,7 +37,9 @@ public:
 
 	unsigned int NumFiles() const override { return (searchFiles.size()); }
 	bool GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	bool PrefetchFile(unsigned int fid) override;
 	void FileInfo(unsigned int fid, std::string& name, int& size) const override;
+	uint32_t GetFileStamp(unsigned int fid) const override;
 	const std::string& GetOrigFileName(unsigned int fid) const { return searchFiles[fid]; }
 
 private:
@@ -82,6 +82,20 @@ public:
 	 */
 	bool GetFile(const std::string& name, std::vector<std::uint8_t>& buffer);
 
+	/**
+	 * Reads a file into the archive's cache (if it keeps one) ahead of the
+	 * GetFile call that needs it, or otherwise tells the OS to start reading
+	 * it in the background.
+	 * @return true if anything was done
+	 */
+	virtual bool PrefetchFile(unsigned int fid) { return false; }
+	/**
+	 * Returns true if PrefetchFile can usefully be called for different
+	 * files from multiple threads at once, e.g. for batches of (tiny)
+	 * individually compressed files.
+	 */
+	virtual bool HasConcurrentReads() const { return false; }
+
 	std::pair<std::string, int> FileInfo(unsigned int fid) const {
 		std::pair<std::string, int> info;
 		FileInfo(fid, info.first, info.second);
@@ -121,6 +135,12 @@ public:
 	 * @return true if archive type can be packed solid (which is VERY slow when reading)
 	 */
 	virtual bool CheckForSolid() const { return false; }
+	/**
+	 * Returns a value that changes whenever the contents of a file do, e.g.
+	 * the CRC32 stored in the archive or the file's modification time; 0 if
+	 * there is none. Lets hashes of unchanged files be reused across scans.
+	 */
+	virtual uint32_t GetFileStamp(unsigned int fid) const { return 0; }
 	/**
 	 * Fetches the (SHA512) hash of a file by its ID.
 	 */
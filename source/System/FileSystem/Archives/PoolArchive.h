@@ -97,6 +97,8 @@ public:
 
 protected:
 	int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	// every file is a separate .gz, and FileData/FileStat entries are per-file
+	bool HasThreadSafeReads() const override { return true; }
 
 	std::pair<uint64_t, uint64_t> GetSums() const {
 		std::pair<uint64_t, uint64_t> p;
@@ -43,6 +43,10 @@ public:
 	unsigned int NumFiles() const override;
 	int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
 	void FileInfo(unsigned int fid, std::string& name, int& size) const override;
+	uint32_t GetFileStamp(unsigned int fid) const override {
+		assert(IsFileId(fid));
+		return fileData[fid].crc;
+	}
 	bool HasLowReadingCost(unsigned int fid) const override;
 	#if 0
 	unsigned GetCrc32(unsigned int fid);
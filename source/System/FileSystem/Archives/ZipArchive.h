@@ -39,6 +39,10 @@ public:
 
 	unsigned int NumFiles() const override;
 	void FileInfo(unsigned int fid, std::string& name, int& size) const override;
+	uint32_t GetFileStamp(unsigned int fid) const override {
+		assert(IsFileId(fid));
+		return fileData[fid].crc;
+	}
 	#if 0
 	unsigned int GetCrc32(unsigned int fid);
 	#endif
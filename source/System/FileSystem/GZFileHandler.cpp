@@ -86,7 +86,8 @@ bool CGZFileHandler::UncompressBuffer()
 		zstream.avail_out = BUFFER_SIZE;
 		zstream.next_out = unzipBuffer;
 		const int ret = inflate(&zstream, Z_NO_FLUSH);
-		if (ret != Z_OK) {
+		if (ret != Z_OK && ret != Z_STREAM_END) {
+			inflateEnd(&zstream);
 			fileBuffer.clear();
 			fileSize = -1;
 			return false;
@@ -95,8 +96,13 @@ bool CGZFileHandler::UncompressBuffer()
 		const size_t unzippedBytes = BUFFER_SIZE - zstream.avail_out;
 		fileBuffer.insert(fileBuffer.end(), unzipBuffer, unzipBuffer + unzippedBytes);
 
-		if (ret == Z_STREAM_END)
+		if (ret != Z_STREAM_END)
+			continue;
+		// concatenated members (e.g. chunked savegames), same as gzread
+		if (zstream.avail_in == 0)
 			break;
+
+		inflateReset(&zstream);
 	}
 
 	inflateEnd(&zstream);
@@ -0,0 +1,117 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+bool CMappedFile::Open(const std::string& filePath)
+{
+	Close();
+
+	#ifdef _WIN32
+	HANDLE fh = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	LARGE_INTEGER fileSize;
+
+	if (fh == INVALID_HANDLE_VALUE)
+		return false;
+
+	if (!GetFileSizeEx(fh, &fileSize) || fileSize.QuadPart <= 0) {
+		CloseHandle(fh);
+		return false;
+	}
+
+	HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (mh == nullptr) {
+		CloseHandle(fh);
+		return false;
+	}
+
+	if ((data = reinterpret_cast<const std::uint8_t*>(MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0))) == nullptr) {
+		CloseHandle(mh);
+		CloseHandle(fh);
+		return false;
+	}
+
+	fileHandle = fh;
+	mappingHandle = mh;
+	size = fileSize.QuadPart;
+
+	#else
+	struct stat info;
+
+	if ((fileDesc = open(filePath.c_str(), O_RDONLY)) == -1)
+		return false;
+
+	if (fstat(fileDesc, &info) != 0 || info.st_size <= 0) {
+		Close();
+		return false;
+	}
+
+	void* ptr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fileDesc, 0);
+
+	if (ptr == MAP_FAILED) {
+		Close();
+		return false;
+	}
+
+	data = reinterpret_cast<const std::uint8_t*>(ptr);
+	size = info.st_size;
+	#endif
+
+	return true;
+}
+
+void CMappedFile::Close()
+{
+	#ifdef _WIN32
+	if (data != nullptr)
+		UnmapViewOfFile(data);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if (fileHandle != nullptr)
+		CloseHandle(fileHandle);
+
+	fileHandle = nullptr;
+	mappingHandle = nullptr;
+	#else
+	if (data != nullptr)
+		munmap(const_cast<std::uint8_t*>(data), size);
+	if (fileDesc != -1)
+		close(fileDesc);
+
+	fileDesc = -1;
+	#endif
+
+	data = nullptr;
+	size = 0;
+}
+
+
+void CMappedFile::Prefetch(size_t offset, size_t size) const
+{
+	if (data == nullptr || offset >= this->size)
+		return;
+
+	size = std::min(size, this->size - offset);
+
+	#ifdef _WIN32
+	// PrefetchVirtualMemory needs Windows 8; the first access faults pages in regardless
+	#else
+	// the advised range has to start on a page boundary
+	const size_t pageSize = sysconf(_SC_PAGESIZE);
+	const size_t pageOffset = offset - (offset % pageSize);
+
+	posix_madvise(const_cast<std::uint8_t*>(data + pageOffset), size + (offset - pageOffset), POSIX_MADV_WILLNEED);
+	#endif
+}
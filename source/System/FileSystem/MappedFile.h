@@ -0,0 +1,49 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _MAPPED_FILE_H
+#define _MAPPED_FILE_H
+
+#include <cinttypes>
+#include <cstddef>
+#include <string>
+
+/**
+ * Read-only memory mapping of an entire file. Pages are brought in by the
+ * OS on first access, so (parts of) large files can be read without going
+ * through an intermediate buffer.
+ */
+class CMappedFile
+{
+public:
+	CMappedFile() = default;
+	CMappedFile(const std::string& filePath) { Open(filePath); }
+	CMappedFile(const CMappedFile&) = delete;
+	~CMappedFile() { Close(); }
+
+	CMappedFile& operator = (const CMappedFile&) = delete;
+
+	/// fails for empty and non-existent files
+	bool Open(const std::string& filePath);
+	void Close();
+
+	/// asks the OS to start reading [offset, offset + size) in the background
+	void Prefetch(size_t offset, size_t size) const;
+
+	bool IsOpen() const { return (data != nullptr); }
+
+	const std::uint8_t* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+private:
+	const std::uint8_t* data = nullptr;
+	size_t size = 0;
+
+	#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+	#else
+	int fileDesc = -1;
+	#endif
+};
+
+#endif // _MAPPED_FILE_H
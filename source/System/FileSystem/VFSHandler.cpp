@@ -12,6 +12,7 @@
 #include "System/FileSystem/Archives/IArchive.h"
 #include "System/FileSystem/Archives/DirArchive.h"
 #include "System/Threading/SpringThreading.h"
+#include "System/Threading/ThreadPool.h"
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
 #include "System/SafeUtil.h"
@@ -133,18 +134,19 @@ bool CVFSHandler::AddArchive(const std::string& archiveName, bool overwrite)
 	}
 
 
-	files[Section::Temp].clear();
-	files[Section::Temp].reserve(ar->NumFiles());
+	SectionIndex& index = sections[section];
+	index.entries.reserve(index.entries.size() + ar->NumFiles());
 
 	for (unsigned fid = 0; fid != ar->NumFiles(); ++fid) {
 		std::pair<std::string, int> fi = ar->FileInfo(fid);
 		std::string name = std::move(StringToLower(fi.first));
 
-		if (!overwrite) {
-			const auto pred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-			const auto iter = std::lower_bound(files[section].begin(), files[section].end(), FileEntry{name, FileData{}}, pred);
+		FileSystem::ForwardSlashes(name);
+
+		const std::uint32_t hash = HashPath(name.data(), name.size());
 
-			if (iter != files[section].end() && iter->first == name) {
+		if (!overwrite) {
+			if (FindEntry(index, name.data(), name.size(), hash) >= 0) {
 				LOG_L(L_DEBUG, "[VFSH::%s] skipping \"%s\", exists", __func__, name.c_str());
 				continue;
 			}
@@ -154,16 +156,13 @@ bool CVFSHandler::AddArchive(const std::string& archiveName, bool overwrite)
 			LOG_L(L_DEBUG, "[VFSH::%s] overriding \"%s\"", __func__, name.c_str());
 		}
 
-		// can not add directly to files[section], would break lower_bound
+		// an existing entry with the same name still takes precedence, this
+		// one only becomes visible when the archive providing it is removed
 		// note: this means an archive can *internally* contain duplicates
-		files[Section::Temp].emplace_back(name, FileData{ar, fi.second});
-	}
-
-	for (size_t i = 0, n = files[Section::Temp].size(); i < n; i++) {
-		files[section].emplace_back(std::move(files[Section::Temp][i]));
+		index.entries.push_back(FileEntry{std::move(name), FileData{ar, fid, fi.second}, hash});
+		IndexEntry(index, index.entries.size() - 1);
 	}
 
-	std::stable_sort(files[section].begin(), files[section].end(), [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); });
 	return true;
 }
 
@@ -208,27 +207,28 @@ bool CVFSHandler::RemoveArchive(const std::string& archiveName)
 		return true;
 
 
-	for (auto& pair: files[section]) {
-		auto& name = pair.first;
+	SectionIndex& index = sections[section];
 
-		if ((pair.second).ar != ar)
+	for (const FileEntry& entry: index.entries) {
+		if (entry.data.ar != ar)
 			continue;
 
-		LOG_L(L_DEBUG, "[VFHS::%s] removing \"%s\"", __func__, name.c_str());
-
-		// mark entry for removal
-		name.clear();
+		LOG_L(L_DEBUG, "[VFHS::%s] removing \"%s\"", __func__, entry.name.c_str());
 	}
 
 	{
-		const auto beg = files[section].begin();
-		const auto end = files[section].end();
-		const auto pos = std::remove_if(beg, end, [](const FileEntry& e) { return (e.first.empty()); });
+		const auto beg = index.entries.begin();
+		const auto end = index.entries.end();
+		const auto pos = std::remove_if(beg, end, [&](const FileEntry& e) { return (e.data.ar == ar); });
 
 		// wipe entries belonging to the to-be-deleted archive
-		files[section].erase(pos, end);
+		index.entries.erase(pos, end);
 	}
 
+	// files hidden by those of the removed archive (and the indices of
+	// all entries after its first) have changed; just start over
+	RebuildIndex(index);
+
 
 	delete ar;
 	archives.erase(archivePath);
@@ -249,35 +249,217 @@ void CVFSHandler::DeleteArchives()
 	archives.clear();
 	archives.reserve(8192);
 
-	for (auto& vec: files) {
-		vec.clear();
-		vec.reserve(2048);
+	for (SectionIndex& index: sections) {
+		index.entries.clear();
+		index.entries.reserve(2048);
+
+		ClearIndex(index);
+	}
+}
+
+
+
+static inline char FoldPathChar(char c)
+{
+	// lower-case ASCII only, like StringToLower in the C locale
+	if (c >= 'A' && c <= 'Z')
+		return (c + ('a' - 'A'));
+	if (c == '\\')
+		return '/';
+
+	return c;
+}
+
+static inline bool IsPathSep(char c) { return (c == '/' || c == '\\'); }
+
+// lexicographic comparison of an already folded name with a raw path (component)
+static int CompareFolded(const std::string& name, const char* path, size_t len)
+{
+	for (size_t i = 0, n = std::min(name.size(), len); i < n; i++) {
+		const unsigned char a = name[i];
+		const unsigned char b = FoldPathChar(path[i]);
+
+		if (a != b)
+			return ((a < b)? -1: 1);
+	}
+
+	return ((name.size() < len)? -1: (name.size() > len));
+}
+
+
+std::uint32_t CVFSHandler::HashPath(const char* path, size_t len)
+{
+	// FNV-1a over the folded characters
+	std::uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < len; i++) {
+		hash ^= static_cast<unsigned char>(FoldPathChar(path[i]));
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+
+void CVFSHandler::ClearIndex(SectionIndex& index)
+{
+	index.slots.clear();
+	index.slots.resize(1024, FileSlot{0, 0});
+	index.dirs.clear();
+	index.dirs.emplace_back();
+	index.numVisible = 0;
+}
+
+void CVFSHandler::RebuildIndex(SectionIndex& index)
+{
+	ClearIndex(index);
+
+	for (size_t i = 0, n = index.entries.size(); i < n; i++) {
+		IndexEntry(index, i);
+	}
+}
+
+void CVFSHandler::IndexEntry(SectionIndex& index, std::uint32_t entryIdx)
+{
+	const FileEntry& entry = index.entries[entryIdx];
+
+	if (FindEntry(index, entry.name.data(), entry.name.size(), entry.hash) >= 0)
+		return;
+
+	InsertSlot(index, entry.hash, entryIdx);
+	InsertIntoDirs(index, entryIdx);
+}
+
+void CVFSHandler::InsertSlot(SectionIndex& index, std::uint32_t hash, std::uint32_t entryIdx)
+{
+	// keep the load factor at or below 1/2 so probe sequences stay short
+	if ((index.numVisible + 1) * 2 > index.slots.size()) {
+		std::vector<FileSlot> slots(index.slots.size() * 2, FileSlot{0, 0});
+
+		for (const FileSlot& slot: index.slots) {
+			if (slot.index == 0)
+				continue;
+
+			size_t i = slot.hash & (slots.size() - 1);
+
+			while (slots[i].index != 0) {
+				i = (i + 1) & (slots.size() - 1);
+			}
+
+			slots[i] = slot;
+		}
+
+		index.slots = std::move(slots);
+	}
+
+	size_t i = hash & (index.slots.size() - 1);
+
+	while (index.slots[i].index != 0) {
+		i = (i + 1) & (index.slots.size() - 1);
+	}
+
+	index.slots[i] = {hash, entryIdx + 1};
+	index.numVisible += 1;
+}
+
+void CVFSHandler::InsertIntoDirs(SectionIndex& index, std::uint32_t entryIdx)
+{
+	const std::string& name = index.entries[entryIdx].name;
+
+	std::uint32_t nodeIdx = 0;
+	size_t beg = 0;
+
+	for (size_t end = 0; (end = name.find('/', beg)) != std::string::npos; beg = end + 1) {
+		if (end == beg)
+			continue;
+
+		const char* comp = name.data() + beg;
+		const size_t len = end - beg;
+
+		// nodes can be appended below, refer to them by index only
+		const auto& subDirs = index.dirs[nodeIdx].subDirs;
+		const auto iter = std::lower_bound(subDirs.begin(), subDirs.end(), 0u, [&](std::uint32_t i, std::uint32_t) {
+			return (CompareFolded(index.dirs[i].name, comp, len) < 0);
+		});
+
+		if (iter != subDirs.end() && CompareFolded(index.dirs[*iter].name, comp, len) == 0) {
+			nodeIdx = *iter;
+			continue;
+		}
+
+		const std::uint32_t subDirIdx = index.dirs.size();
+		const size_t subDirPos = iter - subDirs.begin();
+
+		index.dirs.emplace_back();
+		index.dirs.back().name.assign(comp, len);
+		index.dirs[nodeIdx].subDirs.insert(index.dirs[nodeIdx].subDirs.begin() + subDirPos, subDirIdx);
+
+		nodeIdx = subDirIdx;
 	}
+
+	// names ending in a separator (e.g. in zips) only denote the directory
+	if (beg < name.size())
+		index.dirs[nodeIdx].files.push_back(entryIdx);
 }
 
 
+int CVFSHandler::FindEntry(const SectionIndex& index, const char* path, size_t len, std::uint32_t hash)
+{
+	const size_t mask = index.slots.size() - 1;
+
+	for (size_t i = hash & mask; index.slots[i].index != 0; i = (i + 1) & mask) {
+		const FileSlot& slot = index.slots[i];
 
-std::string CVFSHandler::GetNormalizedPath(const std::string& rawPath)
+		if (slot.hash != hash)
+			continue;
+		if (CompareFolded(index.entries[slot.index - 1].name, path, len) != 0)
+			continue;
+
+		return (slot.index - 1);
+	}
+
+	return -1;
+}
+
+int CVFSHandler::FindDir(const SectionIndex& index, const char* path, size_t len)
 {
-	std::string lcPath = std::move(StringToLower(rawPath));
-	std::string nPath = std::move(FileSystem::ForwardSlashes(lcPath));
-	return nPath;
+	std::uint32_t nodeIdx = 0;
+
+	for (size_t beg = 0, end = 0; beg < len; beg = end + 1) {
+		for (end = beg; end < len && !IsPathSep(path[end]); end++);
+
+		// tolerates leading, trailing and repeated separators
+		if (end == beg)
+			continue;
+
+		const auto& subDirs = index.dirs[nodeIdx].subDirs;
+		const auto iter = std::lower_bound(subDirs.begin(), subDirs.end(), 0u, [&](std::uint32_t i, std::uint32_t) {
+			return (CompareFolded(index.dirs[i].name, path + beg, end - beg) < 0);
+		});
+
+		if (iter == subDirs.end() || CompareFolded(index.dirs[*iter].name, path + beg, end - beg) != 0)
+			return -1;
+
+		nodeIdx = *iter;
+	}
+
+	return nodeIdx;
 }
 
 
-CVFSHandler::FileData CVFSHandler::GetFileData(const std::string& normalizedFilePath, Section section)
+CVFSHandler::FileData CVFSHandler::GetFileData(const std::string& filePath, Section section)
 {
 	assert(section < Section::Count);
 	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
 
-	const auto pred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-	const auto iter = std::lower_bound(files[section].begin(), files[section].end(), FileEntry{normalizedFilePath, FileData{}}, pred);
+	const SectionIndex& index = sections[section];
+	const int entryIdx = FindEntry(index, filePath.data(), filePath.size(), HashPath(filePath.data(), filePath.size()));
 
-	if (iter != files[section].end() && iter->first == normalizedFilePath)
-		return {iter->second.ar, iter->second.size};
+	if (entryIdx >= 0)
+		return index.entries[entryIdx].data;
 
 	// file does not exist in the VFS
-	return {nullptr, 0};
+	return {nullptr, 0, 0};
 }
 
 
@@ -286,36 +468,79 @@ int CVFSHandler::LoadFile(const std::string& filePath, std::vector<std::uint8_t>
 {
 	LOG_L(L_DEBUG, "[VFSH::%s(filePath=\"%s\", section=%d)]", __func__, filePath.c_str(), section);
 
-	const std::string& normalizedPath = GetNormalizedPath(filePath);
-	const FileData& fileData = GetFileData(normalizedPath, section);
+	const FileData& fileData = GetFileData(filePath, section);
 
 	if (fileData.ar == nullptr)
 		return -1;
 
 	// 0 or 1
-	return (fileData.ar->GetFile(normalizedPath, buffer));
+	return (fileData.ar->GetFile(fileData.fid, buffer));
+}
+
+void CVFSHandler::PrefetchFiles(const std::string& rawDir, Section section)
+{
+	// prevents archives from being removed while their files are read
+	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
+
+	assert(section < Section::Count);
+
+	LOG_L(L_DEBUG, "[VFSH::%s(rawDir=\"%s\", section=%d)]", __func__, rawDir.c_str(), section);
+
+	std::vector<std::pair<IArchive*, unsigned int>> concFiles;
+	std::vector<std::pair<IArchive*, unsigned int>> serialFiles;
+	std::vector<std::uint32_t> dirStack;
+
+	const SectionIndex& index = sections[section];
+	const int dirIdx = FindDir(index, rawDir.data(), rawDir.size());
+
+	if (dirIdx < 0)
+		return;
+
+	// gather the files in dir and all of its sub-dirs
+	for (dirStack.push_back(dirIdx); !dirStack.empty(); ) {
+		const DirNode& node = index.dirs[dirStack.back()];
+
+		dirStack.pop_back();
+		dirStack.insert(dirStack.end(), node.subDirs.begin(), node.subDirs.end());
+
+		for (const std::uint32_t entryIdx: node.files) {
+			const FileData& fileData = index.entries[entryIdx].data;
+
+			if (fileData.ar->HasConcurrentReads()) {
+				concFiles.emplace_back(fileData.ar, fileData.fid);
+			} else {
+				serialFiles.emplace_back(fileData.ar, fileData.fid);
+			}
+		}
+	}
+
+	for_mt(0, concFiles.size(), [&](const int i) {
+		concFiles[i].first->PrefetchFile(concFiles[i].second);
+	});
+
+	for (const auto& p: serialFiles) {
+		p.first->PrefetchFile(p.second);
+	}
 }
 
 int CVFSHandler::FileExists(const std::string& filePath, Section section)
 {
 	LOG_L(L_DEBUG, "[VFSH::%s(filePath=\"%s\", section=%d)]", __func__, filePath.c_str(), section);
 
-	const std::string& normalizedPath = GetNormalizedPath(filePath);
-	const FileData& fileData = GetFileData(normalizedPath, section);
+	const FileData& fileData = GetFileData(filePath, section);
 
 	if (fileData.ar == nullptr)
 		return -1;
 
 	// 0 or 1
-	return (fileData.ar->FileExists(normalizedPath));
+	return (fileData.ar->IsFileId(fileData.fid));
 }
 
 std::string CVFSHandler::GetFileAbsolutePath(const std::string& filePath, Section section)
 {
 	LOG_L(L_DEBUG, "[VFSH::%s(filePath=\"%s\", section=%d)]", __func__, filePath.c_str(), section);
 
-	const std::string& normalizedPath = GetNormalizedPath(filePath);
-	const FileData& fileData = GetFileData(normalizedPath, section);
+	const FileData& fileData = GetFileData(filePath, section);
 
 	// Only directory archives have an absolute path on disk
 	const auto dirArchive = dynamic_cast<const CDirArchive*>(fileData.ar);
@@ -323,7 +548,7 @@ std::string CVFSHandler::GetFileAbsolutePath(const std::string& filePath, Sectio
 	if (dirArchive == nullptr)
 		return "";
 
-	const std::string& origFilePath = dirArchive->GetOrigFileName(dirArchive->FindFile(filePath));
+	const std::string& origFilePath = dirArchive->GetOrigFileName(fileData.fid);
 	return (fileData.ar->GetArchiveFile() + "/" + origFilePath);
 }
 
@@ -331,8 +556,11 @@ std::string CVFSHandler::GetFileArchiveName(const std::string& filePath, Section
 {
 	LOG_L(L_DEBUG, "[VFSH::%s(filePath=\"%s\", section=%d)]", __func__, filePath.c_str(), section);
 
-	const std::string& normalizedPath = GetNormalizedPath(filePath);
-	const auto& fileData = GetFileData(normalizedPath, section);
+	const auto& fileData = GetFileData(filePath, section);
+
+	if (fileData.ar == nullptr)
+		return "";
+
 	const auto& archiveFile = fileData.ar->GetArchiveFile();
 	const auto& baseName = FileSystem::GetFilename(archiveFile);
 	const auto& archiveName = archiveScanner->NameFromArchive(baseName);
@@ -366,45 +594,26 @@ std::vector<std::string> CVFSHandler::GetFilesInDir(const std::string& rawDir, S
 	LOG_L(L_DEBUG, "[VFSH::%s(rawDir=\"%s\")]", __func__, rawDir.c_str());
 
 	std::vector<std::string> dirFiles;
-	std::string dir = std::move(GetNormalizedPath(rawDir));
-
-
-	const auto filesPred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
 
-	auto& filesVec = files[section];
-	auto  filesBeg = filesVec.begin();
-	auto  filesEnd = filesVec.end();
+	const SectionIndex& index = sections[section];
+	const int dirIdx = FindDir(index, rawDir.data(), rawDir.size());
 
-	// non-empty directories to look in should have a trailing backslash
-	if (!dir.empty()) {
-		if (dir.back() != '/')
-			dir += "/";
+	if (dirIdx < 0)
+		return dirFiles;
 
-		// limit the iterator range; turn '/' into '0' for filesEnd
-		filesBeg = std::lower_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() += 1;
-		filesEnd = std::upper_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() -= 1;
-	}
-
-	dirFiles.reserve(std::distance(filesBeg, filesEnd));
+	const DirNode& node = index.dirs[dirIdx];
 
-	for (; filesBeg != filesEnd; ++filesBeg) {
-		const std::string& path = FileSystem::GetDirectory(filesBeg->first);
+	dirFiles.reserve(node.files.size());
 
-		// Check if this file starts with the dir path
-		if (path.compare(0, dir.length(), dir) != 0)
-			continue;
+	for (const std::uint32_t entryIdx: node.files) {
+		const std::string& path = index.entries[entryIdx].name;
 
-		// strip pathname
-		std::string name = std::move(filesBeg->first.substr(dir.length()));
-
-		// do not return files in subfolders
-		if ((name.find('/') != std::string::npos) || (name.find('\\') != std::string::npos))
-			continue;
-
-		dirFiles.emplace_back(std::move(name));
+		// strip pathname (npos + 1 == 0 for files in the root)
+		dirFiles.emplace_back(path.substr(path.rfind('/') + 1));
 		LOG_L(L_DEBUG, "\t%s", dirFiles[dirFiles.size() - 1].c_str());
 	}
 
+	std::sort(dirFiles.begin(), dirFiles.end());
 	return dirFiles;
 }
 
@@ -418,50 +627,22 @@ std::vector<std::string> CVFSHandler::GetDirsInDir(const std::string& rawDir, Se
 	LOG_L(L_DEBUG, "[VFSH::%s(rawDir=\"%s\")]", __func__, rawDir.c_str());
 
 	std::vector<std::string> dirs;
-	std::vector<std::string>::iterator iter;
-	std::string dir = std::move(GetNormalizedPath(rawDir));
 
+	const SectionIndex& index = sections[section];
+	const int dirIdx = FindDir(index, rawDir.data(), rawDir.size());
 
-	const auto filesPred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
+	if (dirIdx < 0)
+		return dirs;
 
-	auto& filesVec = files[section];
-	auto  filesBeg = filesVec.begin();
-	auto  filesEnd = filesVec.end();
+	const DirNode& node = index.dirs[dirIdx];
 
-	// non-empty directories to look in should have a trailing backslash
-	if (!dir.empty()) {
-		if (dir.back() != '/')
-			dir += "/";
+	dirs.reserve(node.subDirs.size());
 
-		// limit the iterator range (as in GetFilesInDir)
-		filesBeg = std::lower_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() += 1;
-		filesEnd = std::upper_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() -= 1;
+	for (const std::uint32_t subDirIdx: node.subDirs) {
+		dirs.emplace_back(index.dirs[subDirIdx].name + "/");
 	}
 
-	dirs.reserve(std::distance(filesBeg, filesEnd));
-
-	for (; filesBeg != filesEnd; ++filesBeg) {
-		const std::string& path = FileSystem::GetDirectory(filesBeg->first);
-
-		// test if this file starts with the dir path
-		if (path.compare(0, dir.length(), dir) != 0)
-			continue;
-
-		// strip pathname
-		const std::string& name = filesBeg->first.substr(dir.length());
-		const std::string::size_type slash = name.find_first_of("/\\");
-
-		if (slash == std::string::npos)
-			continue;
-
-		dirs.emplace_back(std::move(name.substr(0, slash + 1)));
-	}
-
-	std::stable_sort(dirs.begin(), dirs.end());
-
-	// filter duplicates
-	if ((iter = std::unique(dirs.begin(), dirs.end())) != dirs.end())
-		dirs.erase(iter, dirs.end());
-
+	// subDirs is ordered by name, which differs from the order with '/' appended
+	std::sort(dirs.begin(), dirs.end());
 	return dirs;
 }
@@ -85,6 +85,14 @@ public:
 	 */
 	int LoadFile(const std::string& filePath, std::vector<std::uint8_t>& buffer, Section section);
 
+	/**
+	 * Reads every file in the given (virtual) directory and its sub-dirs
+	 * ahead of time; concurrently for archives that support it, e.g. pool
+	 * archives made up of many small individually compressed files.
+	 * @param dir raw directory path, for example "units/", case-insensitive
+	 */
+	void PrefetchFiles(const std::string& dir, Section section);
+
 
 	/**
 	 * Returns all the files in the given (virtual) directory without the
@@ -130,16 +138,53 @@ public:
 private:
 	struct FileData {
 		IArchive* ar;
+		unsigned int fid;
 		int size;
 	};
-	typedef std::pair<std::string, FileData> FileEntry;
+	struct FileEntry {
+		std::string name; // lower-case
+		FileData data;
+		std::uint32_t hash;
+	};
+	struct FileSlot {
+		std::uint32_t hash;
+		std::uint32_t index; // 1 + index into SectionIndex::entries, 0 if unused
+	};
+	struct DirNode {
+		std::string name; // lower-case, without separator
+		std::vector<std::uint32_t> subDirs; // indices into SectionIndex::dirs, sorted by name
+		std::vector<std::uint32_t> files; // indices into SectionIndex::entries
+	};
+	struct SectionIndex {
+		// every added file in order, including those hidden by an earlier
+		// entry with the same name which become visible again if the archive
+		// providing it is removed
+		std::vector<FileEntry> entries;
+		// open-addressed table over the visible entries (a power-of-two size)
+		std::vector<FileSlot> slots;
+		// directory tree over the visible entries; dirs[0] is the root
+		std::vector<DirNode> dirs;
+
+		size_t numVisible = 0;
+	};
 
-	std::array<std::vector<FileEntry>, Section::Count> files;
+	std::array<SectionIndex, Section::Count> sections;
 	spring::unordered_map<std::string, IArchive*> archives;
 
 private:
-	std::string GetNormalizedPath(const std::string& rawPath);
-	FileData GetFileData(const std::string& normalizedFilePath, Section section);
+	static std::uint32_t HashPath(const char* path, size_t len);
+	static void ClearIndex(SectionIndex& index);
+	static void RebuildIndex(SectionIndex& index);
+	/// makes entries[entryIdx] visible unless an earlier one has its name
+	static void IndexEntry(SectionIndex& index, std::uint32_t entryIdx);
+	static void InsertSlot(SectionIndex& index, std::uint32_t hash, std::uint32_t entryIdx);
+	static void InsertIntoDirs(SectionIndex& index, std::uint32_t entryIdx);
+
+	// both take raw paths, i.e. in any case and with either separator
+	static int FindEntry(const SectionIndex& index, const char* path, size_t len, std::uint32_t hash);
+	static int FindDir(const SectionIndex& index, const char* path, size_t len);
+
+	FileData GetFileData(const std::string& filePath, Section section);
 };
 
 #define vfsHandler (CVFSHandler::GetGlobalInstance())
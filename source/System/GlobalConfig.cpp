@@ -59,6 +59,7 @@ CONFIG(bool, UseNetMessageSmoothingBuffer).defaultValue(true);
 
 CONFIG(bool, LuaWritableConfigFile).defaultValue(true);
 CONFIG(bool, VFSCacheArchiveFiles).defaultValue(true);
+CONFIG(int, VFSCacheArchiveFilesSize).defaultValue(512).minimumValue(0);
 
 
 void GlobalConfig::Init()
@@ -87,6 +88,7 @@ void GlobalConfig::Init()
 	useNetMessageSmoothingBuffer = configHandler->GetBool("UseNetMessageSmoothingBuffer");
 	luaWritableConfigFile = configHandler->GetBool("LuaWritableConfigFile");
 	vfsCacheArchiveFiles = configHandler->GetBool("VFSCacheArchiveFiles");
+	vfsCacheArchiveFilesSize = configHandler->GetInt("VFSCacheArchiveFilesSize");
 
 	teamHighlight = configHandler->GetInt("TeamHighlight");
 }
@@ -106,6 +106,14 @@ public:
 	 */
 	bool vfsCacheArchiveFiles = true;
 
+	/**
+	 * @brief vfsCacheArchiveFilesSize
+	 *
+	 * Maximum size (in MB) of the cached files of each (BufferedArchive)
+	 * archive, least recently accessed files are evicted first; 0 = no limit
+	 */
+	int vfsCacheArchiveFilesSize = 512;
+
 
 	/**
 	 * @brief teamHighlight
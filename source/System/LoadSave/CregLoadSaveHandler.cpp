@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <cstdio>
 #include <sstream>
 #include <zlib.h>
 
@@ -33,6 +34,7 @@
 #include "Sim/Units/Scripts/NullUnitScript.h"
 #include "Sim/Weapons/PlasmaRepulser.h"
 #include "System/SafeUtil.h"
+#include "System/TimeProfiler.h"
 #include "System/Platform/errorhandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileQueryFlags.h"
@@ -154,7 +156,7 @@ static void ReadString(std::istream& s, std::string& str)
 }
 
 
-static void SaveLuaState(CSplitLuaHandle* handle, creg::COutputStreamSerializer& os, std::stringstream& oss)
+static void SaveLuaState(CSplitLuaHandle* handle, creg::COutputStreamSerializer& os, std::ostream& oss)
 {
 	CLuaStateCollector lsc;
 	lsc.valid = (handle != nullptr) && handle->syncedLuaHandle.IsValid();
@@ -167,7 +169,7 @@ static void SaveLuaState(CSplitLuaHandle* handle, creg::COutputStreamSerializer&
 }
 
 
-static void LoadLuaState(CSplitLuaHandle* handle, creg::CInputStreamSerializer& is, std::stringstream& iss)
+static void LoadLuaState(CSplitLuaHandle* handle, creg::CInputStreamSerializer& is, std::istream& iss)
 {
 	void* plsc;
 	creg::Class* plsccls = nullptr;
@@ -188,70 +190,92 @@ static void LoadLuaState(CSplitLuaHandle* handle, creg::CInputStreamSerializer&
 }
 
 
+#ifdef USING_CREG
+static void WriteGameState(std::ostream& oss, CChunkedOutputBuffer& buf, const std::string& modName, const std::string& mapName)
+{
+	// write our own header. SavePackage() will add its own
+	WriteString(oss, SpringVersion::GetSync());
+	WriteString(oss, gameSetup->setupText);
+	WriteString(oss, modName);
+	WriteString(oss, mapName);
+
+	creg::COutputStreamSerializer os;
+
+	// save lua state first as lua unit scripts depend on it
+	const int luaStart = oss.tellp();
+	SaveLuaState(luaGaia, os, oss);
+	SaveLuaState(luaRules, os, oss);
+	PrintSize("Lua", ((int)oss.tellp()) - luaStart);
+	buf.Seal();
+
+	// save creg state
+	const int gameStart = oss.tellp();
+	CGameStateCollector gsc;
+	os.SavePackage(&oss, &gsc, gsc.GetClass());
+	PrintSize("Game", ((int)oss.tellp()) - gameStart);
+	buf.Seal();
+
+
+	// save AI state
+	const int aiStart = oss.tellp();
+
+	for (const auto& ai: skirmishAIHandler.GetAllSkirmishAIs()) {
+		std::stringstream aiData;
+		eoh->Save(&aiData, ai.first);
+
+		std::streamsize aiSize = aiData.tellp();
+		os.SerializeInt(&aiSize, sizeof(aiSize));
+		if (aiSize > 0)
+			oss << aiData.rdbuf();
+	}
+	PrintSize("AIs", ((int)oss.tellp()) - aiStart);
+
+	buf.Finish();
+}
+#endif //USING_CREG
+
+
 void CCregLoadSaveHandler::SaveGame(const std::string& path)
 {
 #ifdef USING_CREG
 	LOG("[LSH::%s] saving game to \"%s\"", __func__, path.c_str());
 
 	try {
-		std::stringstream oss;
-
-		// write our own header. SavePackage() will add its own
-		WriteString(oss, SpringVersion::GetSync());
-		WriteString(oss, gameSetup->setupText);
-		WriteString(oss, modName);
-		WriteString(oss, mapName);
-
+		const spring_time t0 = spring_gettime();
 
-		{
-			creg::COutputStreamSerializer os;
-
-			// save lua state first as lua unit scripts depend on it
-			const int luaStart = oss.tellp();
-			SaveLuaState(luaGaia, os, oss);
-			SaveLuaState(luaRules, os, oss);
-			PrintSize("Lua", ((int)oss.tellp()) - luaStart);
-
-			// save creg state
-			const int gameStart = oss.tellp();
-			CGameStateCollector gsc;
-			os.SavePackage(&oss, &gsc, gsc.GetClass());
-			PrintSize("Game", ((int)oss.tellp()) - gameStart);
-
-
-			// save AI state
-			const int aiStart = oss.tellp();
+		// chunks are deflated on the thread pool as soon as each package is complete
+		std::shared_ptr<CChunkedOutputBuffer> buf = std::make_shared<CChunkedOutputBuffer>(5);
+		std::ostream oss(buf.get());
 
-			for (const auto& ai: skirmishAIHandler.GetAllSkirmishAIs()) {
-				std::stringstream aiData;
-				eoh->Save(&aiData, ai.first);
+		WriteGameState(oss, *buf, modName, mapName);
 
-				std::streamsize aiSize = aiData.tellp();
-				os.SerializeInt(&aiSize, sizeof(aiSize));
-				if (aiSize > 0)
-					oss << aiData.rdbuf();
-			}
-			PrintSize("AIs", ((int)oss.tellp()) - aiStart);
-		}
+		const spring_time t1 = spring_gettime();
+		LOG("[LSH::%s] serialized %u bytes in %ims", __func__, unsigned(buf->GetSize()), int((t1 - t0).toMilliSecsi()));
 
 		{
-			gzFile file = gzopen(dataDirsAccess.LocateFile(path, FileQueryFlags::WRITE).c_str(), "wb5");
+			FILE* file = fopen(dataDirsAccess.LocateFile(path, FileQueryFlags::WRITE).c_str(), "wb");
 
 			if (file == nullptr) {
 				LOG_L(L_ERROR, "[LSH::%s] could not open save-file", __func__);
 				return;
 			}
 
-			std::string data = std::move(oss.str());
-			std::function<void(gzFile, std::string&&)> func = [](gzFile file, std::string&& data) {
-				gzwrite(file, data.c_str(), data.size());
-				gzflush(file, Z_FINISH);
-				gzclose(file);
+			// each chunk is a complete gzip member, gzread handles the concatenation
+			std::function<void(FILE*, std::shared_ptr<CChunkedOutputBuffer>, spring_time)> func = [](FILE* file, std::shared_ptr<CChunkedOutputBuffer> buf, spring_time t0) {
+				const size_t numBytes = buf->WriteCompressed(file);
+				const spring_time t1 = spring_gettime();
+
+				fclose(file);
+
+				if (numBytes == 0) {
+					LOG_L(L_ERROR, "[LSH::SaveGame] could not compress or write save-file");
+				} else {
+					LOG("[LSH::SaveGame] wrote %u compressed bytes in %ims", unsigned(numBytes), int((t1 - t0).toMilliSecsi()));
+				}
 			};
 
-			// gzFile is just a plain typedef (struct gzFile_s {}* gzFile), can be copied
 			// need to keep a reference to the future around or its destructor will block
-			ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(data))));
+			ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::move(buf), t1)));
 		}
 
 		//FIXME add lua state
@@ -275,11 +299,12 @@ void CCregLoadSaveHandler::SaveGame(const std::string& path)
 void CCregLoadSaveHandler::LoadGameStartInfo(const std::string& path)
 {
 	CGZFileHandler saveFile(dataDirsAccess.LocateFile(FindSaveFile(path)), SPRING_VFS_RAW_FIRST);
-	std::stringbuf *sbuf = iss.rdbuf();
-	char buf[4096];
-	int len;
-	while ((len = saveFile.Read(buf, sizeof(buf))) > 0)
-		sbuf->sputn(buf, len);
+
+	// take over the decompressed data instead of copying it into a stringstream
+	issData.clear();
+	issData.swap(saveFile.GetBuffer());
+	issBuffer.SetBuffer(issData.data(), issData.size());
+	iss.clear();
 
 	//Check for compatible save versions
 	std::string saveVersion;
@@ -318,6 +343,7 @@ void CCregLoadSaveHandler::LoadGame()
 #ifdef USING_CREG
 	ENTER_SYNCED_CODE();
 	{
+		ScopedOnceTimer timer("CregLoadSaveHandler::LoadGame");
 		creg::CInputStreamSerializer inputStream;
 
 		// load lua state first, as lua unit scripts depend on it
@@ -340,17 +366,19 @@ void CCregLoadSaveHandler::LoadGame()
 			std::streamsize aiSize;
 			inputStream.SerializeInt(&aiSize, sizeof(aiSize));
 
-			std::vector<char> buffer(aiSize);
-			std::stringstream aiData;
-			iss.read(buffer.data(), buffer.size());
-			aiData.write(buffer.data(), buffer.size());
+			// AI's read their state straight out of the save-buffer
+			CMemoryInputBuffer aiBuffer(issBuffer.GetReadPtr(), std::min(size_t(std::max(aiSize, std::streamsize(0))), issBuffer.GetSize() - issBuffer.GetPos()));
+			std::istream aiData(&aiBuffer);
 
+			iss.seekg(aiBuffer.GetSize(), std::ios_base::cur);
 			eoh->Load(&aiData, ai.first);
 		}
 	}
 
 	// cleanup
-	iss.str("");
+	issBuffer.SetBuffer(nullptr, 0);
+	issData.clear();
+	issData.shrink_to_fit();
 
 	gs->paused = false;
 	if (gameServer != nullptr) {
@@ -4,8 +4,12 @@
 #define CREG_LOAD_SAVE_HANDLER_H
 
 #include <string>
-#include <sstream>
+#include <istream>
+#include <vector>
+#include <cinttypes>
+
 #include "LoadSaveHandler.h"
+#include "StreamBuffers.h"
 
 class CCregLoadSaveHandler : public ILoadSaveHandler
 {
@@ -18,7 +22,10 @@ public:
 	void LoadGame();
 
 protected:
-	std::stringstream iss;
+	// decompressed save-file, parsed in place through iss
+	std::vector<std::uint8_t> issData;
+	CMemoryInputBuffer issBuffer;
+	std::istream iss{&issBuffer};
 };
 
 #endif // CREG_LOAD_SAVE_HANDLER_H
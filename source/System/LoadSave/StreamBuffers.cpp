@@ -0,0 +1,189 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <cassert>
+#include <cstring>
+#include <zlib.h>
+
+#include "StreamBuffers.h"
+#include "System/Threading/ThreadPool.h"
+
+
+constexpr size_t CChunkedOutputBuffer::CHUNK_SIZE;
+
+
+static CChunkedOutputBuffer::CompressedChunk DeflateChunk(const char* data, size_t size, int level)
+{
+	CChunkedOutputBuffer::CompressedChunk out;
+
+	z_stream zs;
+	memset(&zs, 0, sizeof(zs));
+
+	// +16 writes a gzip header and trailer, making each chunk a standalone member
+	if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return out;
+
+	out.resize(deflateBound(&zs, size));
+
+	zs.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	zs.avail_in  = size;
+	zs.next_out  = out.data();
+	zs.avail_out = out.size();
+
+	// deflateBound guarantees a single call suffices
+	if (deflate(&zs, Z_FINISH) != Z_STREAM_END)
+		out.clear();
+	else
+		out.resize(zs.total_out);
+
+	deflateEnd(&zs);
+	return out;
+}
+
+
+
+void CChunkedOutputBuffer::SetChunk(size_t idx)
+{
+	while (chunks.size() <= idx)
+		chunks.emplace_back(new char[CHUNK_SIZE]);
+
+	curChunk = idx;
+
+	char* beg = chunks[idx].get();
+	setp(beg, beg + CHUNK_SIZE);
+}
+
+CChunkedOutputBuffer::int_type CChunkedOutputBuffer::overflow(int_type c)
+{
+	if (traits_type::eq_int_type(c, traits_type::eof()))
+		return (traits_type::not_eof(c));
+
+	UpdateSize();
+	SetChunk(curChunk + 1);
+
+	*pptr() = traits_type::to_char_type(c);
+	pbump(1);
+	return c;
+}
+
+CChunkedOutputBuffer::pos_type CChunkedOutputBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	UpdateSize();
+
+	switch (dir) {
+		case std::ios_base::beg: { return (seekpos(off                      , which)); } break;
+		case std::ios_base::cur: { return (seekpos(off + off_type(GetPos()) , which)); } break;
+		case std::ios_base::end: { return (seekpos(off + off_type(dataSize) , which)); } break;
+		default: {} break;
+	}
+
+	return (pos_type(off_type(-1)));
+}
+
+CChunkedOutputBuffer::pos_type CChunkedOutputBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	if ((which & std::ios_base::out) == 0)
+		return (pos_type(off_type(-1)));
+
+	UpdateSize();
+
+	const off_type off = pos;
+
+	// sealed chunks might already be in the hands of a compression task
+	if (off < off_type(sealedSize) || off > off_type(dataSize))
+		return (pos_type(off_type(-1)));
+
+	// a position exactly at a chunk boundary stays in the full chunk; overflow moves on
+	if (off > 0 && (off % CHUNK_SIZE) == 0) {
+		SetChunk(off / CHUNK_SIZE - 1);
+		pbump(CHUNK_SIZE);
+	} else {
+		SetChunk(off / CHUNK_SIZE);
+		pbump(off % CHUNK_SIZE);
+	}
+
+	return pos;
+}
+
+
+CChunkedOutputBuffer::~CChunkedOutputBuffer()
+{
+	// futures already consumed by WriteCompressed are no longer valid
+	for (auto& future: compressed) {
+		if (future->valid())
+			future->wait();
+	}
+}
+
+
+void CChunkedOutputBuffer::CompressChunks(size_t end)
+{
+	for (size_t idx = compressed.size(); idx < end; idx++) {
+		const char* data = chunks[idx].get();
+		const size_t size = std::min(CHUNK_SIZE, dataSize - idx * CHUNK_SIZE);
+		const int level = compressionLevel;
+
+		compressed.emplace_back(ThreadPool::Enqueue([=]() { return (DeflateChunk(data, size, level)); }));
+	}
+}
+
+void CChunkedOutputBuffer::Seal()
+{
+	UpdateSize();
+	// all writes are expected to have been appends at this point
+	assert(GetPos() == dataSize);
+
+	sealedSize = dataSize;
+	CompressChunks(sealedSize / CHUNK_SIZE);
+}
+
+void CChunkedOutputBuffer::Finish()
+{
+	Seal();
+	CompressChunks((dataSize + CHUNK_SIZE - 1) / CHUNK_SIZE);
+	setp(nullptr, nullptr);
+}
+
+size_t CChunkedOutputBuffer::WriteCompressed(FILE* file)
+{
+	size_t numBytes = 0;
+
+	for (auto& future: compressed) {
+		const CompressedChunk& chunk = future->get();
+
+		if (chunk.empty())
+			return 0;
+		if (fwrite(chunk.data(), 1, chunk.size(), file) != chunk.size())
+			return 0;
+
+		numBytes += chunk.size();
+	}
+
+	return numBytes;
+}
+
+
+
+CMemoryInputBuffer::pos_type CMemoryInputBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+	switch (dir) {
+		case std::ios_base::beg: { return (seekpos(off                       , which)); } break;
+		case std::ios_base::cur: { return (seekpos(off + off_type(GetPos())  , which)); } break;
+		case std::ios_base::end: { return (seekpos(off + off_type(GetSize()) , which)); } break;
+		default: {} break;
+	}
+
+	return (pos_type(off_type(-1)));
+}
+
+CMemoryInputBuffer::pos_type CMemoryInputBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+	const off_type off = pos;
+
+	if ((which & std::ios_base::in) == 0)
+		return (pos_type(off_type(-1)));
+	if (off < 0 || off > off_type(GetSize()))
+		return (pos_type(off_type(-1)));
+
+	setg(eback(), eback() + off, egptr());
+	return pos;
+}
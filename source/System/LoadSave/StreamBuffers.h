@@ -0,0 +1,96 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _STREAM_BUFFERS_H
+#define _STREAM_BUFFERS_H
+
+#include <algorithm>
+#include <cstdio>
+#include <cinttypes>
+#include <future>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+/**
+ * Output streambuf that stores data in fixed-size chunks instead of one
+ * contiguous (and repeatedly reallocated) block like std::stringbuf does.
+ *
+ * Seeking backwards is supported (creg rewrites its package headers) up to
+ * the last Seal() point; every chunk that lies entirely before that point
+ * is final and is handed to the thread pool to be deflated into its own
+ * gzip member while the caller keeps writing. zlib's gzread transparently
+ * handles concatenated members, so the output is a regular .gz file.
+ */
+class CChunkedOutputBuffer: public std::streambuf
+{
+public:
+	static constexpr size_t CHUNK_SIZE = 1 << 22;
+
+	typedef std::vector<std::uint8_t> CompressedChunk;
+
+	CChunkedOutputBuffer(int level = 5): compressionLevel(level) { SetChunk(0); }
+	/// waits for chunks still being deflated, they read from <chunks>
+	~CChunkedOutputBuffer();
+	CChunkedOutputBuffer(const CChunkedOutputBuffer&) = delete;
+	CChunkedOutputBuffer& operator = (const CChunkedOutputBuffer&) = delete;
+
+	/// marks all data written so far as final and starts compressing full chunks
+	void Seal();
+	/// seals and also compresses the trailing partial chunk; no writes allowed afterwards
+	void Finish();
+
+	/// blocks on each pending chunk and appends it to <file>; returns the number of bytes written
+	size_t WriteCompressed(FILE* file);
+
+	size_t GetSize() { UpdateSize(); return dataSize; }
+
+protected:
+	int_type overflow(int_type c) override;
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+private:
+	size_t GetPos() const { return (curChunk * CHUNK_SIZE + (pptr() - pbase())); }
+	void UpdateSize() { dataSize = std::max(dataSize, GetPos()); }
+	void SetChunk(size_t idx);
+	void CompressChunks(size_t end);
+
+private:
+	std::vector< std::unique_ptr<char[]> > chunks;
+	std::vector< std::shared_ptr< std::future<CompressedChunk> > > compressed;
+
+	size_t curChunk = 0;
+	size_t dataSize = 0;
+	size_t sealedSize = 0;
+
+	int compressionLevel = 5;
+};
+
+
+/**
+ * Read-only, seekable streambuf over an externally owned memory range;
+ * lets std::istream consumers parse a buffer without copying it into a
+ * std::stringstream first.
+ */
+class CMemoryInputBuffer: public std::streambuf
+{
+public:
+	CMemoryInputBuffer() = default;
+	CMemoryInputBuffer(const std::uint8_t* data, size_t size) { SetBuffer(data, size); }
+
+	void SetBuffer(const std::uint8_t* data, size_t size) {
+		char* beg = const_cast<char*>(reinterpret_cast<const char*>(data));
+		setg(beg, beg, beg + size);
+	}
+
+	size_t GetPos() const { return (gptr() - eback()); }
+	size_t GetSize() const { return (egptr() - eback()); }
+
+	const std::uint8_t* GetReadPtr() const { return (reinterpret_cast<const std::uint8_t*>(gptr())); }
+
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+#endif // _STREAM_BUFFERS_H
@@ -22,6 +22,8 @@
 #undef unlikely
 #endif
 
+#include <bitset>
+#include <deque>
 #include <utility>
 #include <functional>
 
@@ -40,6 +42,8 @@
 
 #ifndef UNIT_TEST
 CONFIG(int, WorkerThreadCount).defaultValue(-1).safemodeValue(0).minimumValue(-1).description("Number of workers (including the main thread!) used by ThreadPool.");
+CONFIG(int, WorkerThreadPartitionCount).defaultValue(1).minimumValue(1).description("Number of engine processes expected to run side by side on this machine (e.g. headless servers). Each one limits its ThreadPool to its own share of the cores.");
+CONFIG(int, WorkerThreadPartitionIndex).defaultValue(0).minimumValue(0).description("Which share of the cores (see WorkerThreadPartitionCount) this process binds its threads to.");
 #endif
 
 
@@ -56,12 +60,67 @@ struct ThreadStats {
 
 
 
+struct WorkerCounters {
+	// written by the owning thread only, read by GetWorkerStats
+	std::atomic<uint64_t> numTasksRun;
+	std::atomic<uint64_t> numTasksStolen;
+	std::atomic<uint64_t> sumIdleTime;
+};
+
+
+// tasks that may run on any thread; the owner pushes and pops at the back
+// (newest first, its data is most likely still cached) while idle threads
+// steal from the front (oldest first, usually the largest chunks of work)
+class TaskDeque {
+public:
+	void Push(ITaskGroup* tg) {
+		std::lock_guard<spring::spinlock> lck(mutex);
+		tasks.push_back(tg);
+		size.store(tasks.size(), std::memory_order_release);
+	}
+
+	bool Pop(ITaskGroup*& tg) { return (Take(tg, true)); }
+	bool Steal(ITaskGroup*& tg) { return (Take(tg, false)); }
+
+	// racy, only used to skip empty deques without taking their lock
+	bool Empty() const { return (size.load(std::memory_order_acquire) == 0); }
+
+private:
+	bool Take(ITaskGroup*& tg, bool back) {
+		if (Empty())
+			return false;
+
+		std::lock_guard<spring::spinlock> lck(mutex);
+
+		if (tasks.empty())
+			return false;
+
+		if (back) {
+			tg = tasks.back();
+			tasks.pop_back();
+		} else {
+			tg = tasks.front();
+			tasks.pop_front();
+		}
+
+		size.store(tasks.size(), std::memory_order_release);
+		return true;
+	}
+
+private:
+	spring::spinlock mutex;
+	std::deque<ITaskGroup*> tasks;
+	std::atomic<size_t> size = {0};
+};
+
+
+
 // external background threads which are only joined on exit
 static std::vector< spring::thread > extThreads;
 static std::vector< std::future<void> > extFutures;
 
-// global [idx = 0] and smaller per-thread [idx > 0] queues; the latter are
-// for tasks that want to execute on specific threads, e.g. parallel_reduce
+// per-thread queues for tasks that have to execute on that specific thread,
+// e.g. the slices of for_mt or parallel_reduce; only popped by their owner
 // note: std::shared_ptr<T> can not be made atomic, queues must store T*'s
 #ifdef USE_BOOST_LOCKFREE_QUEUE
 static std::array<boost::lockfree::queue<ITaskGroup*>, ThreadPool::MAX_THREADS> taskQueues[2];
@@ -69,11 +128,22 @@ static std::array<boost::lockfree::queue<ITaskGroup*>, ThreadPool::MAX_THREADS>
 static std::array<moodycamel::ConcurrentQueue<ITaskGroup*>, ThreadPool::MAX_THREADS> taskQueues[2];
 #endif
 
+// per-thread deques for all other tasks, which go to the pushing thread's
+// own deque; [idx = 0] is shared by main and any non-pool threads and has
+// no async owner, so async tasks pushed from there are only ever stolen
+static std::array<TaskDeque, ThreadPool::MAX_THREADS> taskDeques[2];
+
 static std::vector<void*> workerThreads[2];
 static std::array<bool, ThreadPool::MAX_THREADS> exitFlags;
 static std::array<ThreadStats, ThreadPool::MAX_THREADS> threadStats[2];
+static std::array<WorkerCounters, ThreadPool::MAX_THREADS> workerCounters[2];
 static spring::signal newTasksSignal[2];
 
+// see WorkerThreadPartition{Count,Index}; read once in SetMaximumThreadCount
+// because GetMaxThreads can be called (by the profiler) before config exists
+static int numCorePartitions = 1;
+static int corePartitionIndex = 0;
+
 static _threadlocal int threadnum(0);
 
 #ifndef UNITSYNC
@@ -132,12 +202,34 @@ static int GetDefaultNumWorkers() {
 // FIXME: mutex/atomic?
 // NOTE: +1 because we also count the main thread, workers start at 1
 int GetNumThreads() { return (workerThreads[false].size() + 1); }
-int GetMaxThreads() { return std::min(MAX_THREADS, Threading::GetPhysicalCpuCores()); }
+int GetMaxThreads() { return std::min(MAX_THREADS, std::max(1, Threading::GetPhysicalCpuCores() / numCorePartitions)); }
 
 bool HasThreads() { return !workerThreads[false].empty(); }
 
 
 
+static void RunTask(ITaskGroup* tg, int tid, bool async)
+{
+	assert(!async || tg->IsAsyncTask());
+
+	#ifdef USE_TASK_STATS_TRACKING
+	const uint64_t wdt = tg->GetDeltaTime(spring_now());
+	const uint64_t edt = tg->ExecuteLoop(tid, false);
+
+	threadStats[async][tid].numTasksRun += 1;
+	threadStats[async][tid].sumExecTime += edt;
+	threadStats[async][tid].sumWaitTime += wdt;
+	threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
+	threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
+	threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
+	threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
+	#else
+	tg->ExecuteLoop(tid, false);
+	#endif
+
+	workerCounters[async][tid].numTasksRun.fetch_add(1, std::memory_order_relaxed);
+}
+
 static bool DoTask(int tid, bool async)
 {
 	#ifndef UNIT_TEST
@@ -146,67 +238,52 @@ static bool DoTask(int tid, bool async)
 
 	ITaskGroup* tg = nullptr;
 
-	// any external thread calling WaitForFinished will have
-	// id=0 and *only* processes tasks from the global queue
-	for (int idx = 0; idx <= tid; idx += std::max(tid, 1)) {
-		auto& queue = taskQueues[async][idx];
+	auto& queue = taskQueues[async][tid];
+	auto& deque = taskDeques[async][tid];
 
-		#ifdef USE_BOOST_LOCKFREE_QUEUE
-		if (queue.pop(tg)) {
-		#else
-		if (queue.try_dequeue(tg)) {
-		#endif
-			// inform other workers when there is global work to do
-			// waking is an expensive kernel-syscall, so better shift this
-			// cost to the workers too (the main thread only wakes when ALL
-			// workers are sleeping)
-			if (idx == 0)
-				NotifyWorkerThreads(true, async);
-
-			assert(!async || tg->IsAsyncTask());
-
-			#ifdef USE_TASK_STATS_TRACKING
-			const uint64_t wdt = tg->GetDeltaTime(spring_now());
-			const uint64_t edt = tg->ExecuteLoop(tid, false);
-
-			threadStats[async][tid].numTasksRun += 1;
-			threadStats[async][tid].sumExecTime += edt;
-			threadStats[async][tid].sumWaitTime += wdt;
-			threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
-			threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
-			threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
-			threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
-			#else
-			tg->ExecuteLoop(tid, false);
-			#endif
-		}
+	bool ranTask = false;
 
-		#ifdef USE_BOOST_LOCKFREE_QUEUE
-		while (queue.pop(tg)) {
-		#else
-		while (queue.try_dequeue(tg)) {
-		#endif
-			assert(!async || tg->IsAsyncTask());
-
-			#ifdef USE_TASK_STATS_TRACKING
-			const uint64_t wdt = tg->GetDeltaTime(spring_now());
-			const uint64_t edt = tg->ExecuteLoop(tid, false);
-
-			threadStats[async][tid].numTasksRun += 1;
-			threadStats[async][tid].sumExecTime += edt;
-			threadStats[async][tid].sumWaitTime += wdt;
-			threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
-			threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
-			threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
-			threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
-			#else
-			tg->ExecuteLoop(tid, false);
-			#endif
-		}
+	// first the tasks that can only run on this thread
+	#ifdef USE_BOOST_LOCKFREE_QUEUE
+	while (queue.pop(tg)) {
+	#else
+	while (queue.try_dequeue(tg)) {
+	#endif
+		RunTask(tg, tid, async);
+		ranTask = true;
+	}
+
+	// then our own, which any external thread calling WaitForFinished
+	// shares with main (all of them have id=0)
+	while (deque.Pop(tg)) {
+		RunTask(tg, tid, async);
+		ranTask = true;
+	}
+
+	if (ranTask)
+		return true;
+
+	// out of work, steal one task from another thread (starting with our
+	// neighbour so thieves spread out) and let the caller come back here
+	for (int i = 1, n = GetNumThreads(); i < n; i++) {
+		const int victim = (tid + i) % n;
+
+		if (!taskDeques[async][victim].Steal(tg))
+			continue;
+
+		// inform other workers when there is more to steal; waking is an
+		// expensive kernel-syscall, so better shift this cost to workers
+		// (the main thread only wakes them when ALL are sleeping)
+		if (!taskDeques[async][victim].Empty())
+			NotifyWorkerThreads(true, async);
+
+		workerCounters[async][tid].numTasksStolen.fetch_add(1, std::memory_order_relaxed);
+
+		RunTask(tg, tid, async);
+		return true;
 	}
 
-	// if true, queue contained at least one element
-	return (tg != nullptr);
+	return false;
 }
 
 
@@ -235,7 +312,10 @@ static void WorkerLoop(int tid, bool async)
 			if (spring_now() < spinlockEnd)
 				continue;
 
+			const spring_time waitTime = spring_now();
+
 			newTasksSignal[async].wait_for(sleepTime = std::min(sleepTime * 1.25f, maxSleepTime));
+			workerCounters[async][tid].sumIdleTime.fetch_add((spring_now() - waitTime).toNanoSecsi(), std::memory_order_relaxed);
 		}
 	}
 }
@@ -306,7 +386,8 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 void PushTaskGroup(std::shared_ptr<ITaskGroup>&& taskGroup) { PushTaskGroup(taskGroup.get()); }
 void PushTaskGroup(ITaskGroup* taskGroup)
 {
-	auto& queue = taskQueues[ taskGroup->IsAsyncTask() ][ taskGroup->WantedThread() ];
+	const bool async = taskGroup->IsAsyncTask();
+	const int wantedThread = taskGroup->WantedThread();
 
 	#if 0
 	// fake single-task group, handled by WaitForFinished to
@@ -317,11 +398,17 @@ void PushTaskGroup(ITaskGroup* taskGroup)
 
 	taskGroup->SetTimeStamp(spring_now());
 
-	#ifdef USE_BOOST_LOCKFREE_QUEUE
-	while (!queue.push(taskGroup));
-	#else
-	while (!queue.enqueue(taskGroup));
-	#endif
+	if (wantedThread != 0) {
+		auto& queue = taskQueues[async][wantedThread];
+
+		#ifdef USE_BOOST_LOCKFREE_QUEUE
+		while (!queue.push(taskGroup));
+		#else
+		while (!queue.enqueue(taskGroup));
+		#endif
+	} else {
+		taskDeques[async][GetThreadNum()].Push(taskGroup);
+	}
 
 	#if 1
 	// AsyncTask's do not care about wakeup-latency as much
@@ -416,12 +503,46 @@ static void KillThreads(int wantedNumThreads, int curNumThreads)
 		while (taskQueues[false][i].try_dequeue(tg));
 		while (taskQueues[ true][i].try_dequeue(tg));
 		#endif
+
+		// unlike the above these can run anywhere, hand them to main
+		while (taskDeques[false][i].Steal(tg)) { taskDeques[false][0].Push(tg); }
+		while (taskDeques[ true][i].Steal(tg)) { taskDeques[ true][0].Push(tg); }
 	}
 
 	assert((wantedNumThreads != 0) || workerThreads[false].empty());
 }
 
 
+static std::uint32_t GetPartitionCoresMask(std::uint32_t systemCores)
+{
+	if (numCorePartitions <= 1)
+		return systemCores;
+
+	// the mask can not describe machines with more than 32 cores; only
+	// the number of threads is partitioned there (see GetMaxThreads)
+	if (Threading::GetLogicalCpuCores() > 32)
+		return systemCores;
+
+	const int numCores = std::bitset<32>(systemCores).count();
+	const int partSize = numCores / numCorePartitions;
+	const int partBase = partSize * (corePartitionIndex % numCorePartitions);
+
+	if (partSize == 0)
+		return systemCores;
+
+	std::uint32_t partCores = 0;
+
+	for (int bit = 0, n = 0; bit < 32; bit++) {
+		if ((systemCores & (1u << bit)) == 0)
+			continue;
+
+		partCores |= ((1u << bit) * (n >= partBase && n < (partBase + partSize)));
+		n += 1;
+	}
+
+	return partCores;
+}
+
 static std::uint32_t FindWorkerThreadCore(std::int32_t index, std::uint32_t availCores, std::uint32_t avoidCores)
 {
 	// find an unused core for worker-thread <index>
@@ -467,7 +588,7 @@ void SetThreadCount(int wantedNumThreads)
 		"[ThreadPool::%s][1] wanted=%d current=%d maximum=%d (init=%d)",
 		"[ThreadPool::%s][2] workers=%lu",
 		"\t[async=%d] threads=%d tasks=%lu {sum,avg}{exec,wait}time={{%.3f, %.3f}, {%.3f, %.3f}}ms",
-		"\t\tthread=%d tasks=%lu {sum,min,max,avg}{exec,wait}time={{%.3f, %.3f, %.3f, %.3f}, {%.3f, %.3f, %.3f, %.3f}}ms",
+		"\t\tthread=%d tasks=%lu {sum,min,max,avg}{exec,wait}time={{%.3f, %.3f, %.3f, %.3f}, {%.3f, %.3f, %.3f, %.3f}}ms stolen=%lu idle=%.3fms",
 	};
 
 	// total number of tasks executed by pool; total time spent in DoTask
@@ -498,6 +619,14 @@ void SetThreadCount(int wantedNumThreads)
 			}
 		}
 		#endif
+
+		for (bool async: {false, true}) {
+			for (int i = 0; i < MAX_THREADS; i++) {
+				workerCounters[async][i].numTasksRun.store(0);
+				workerCounters[async][i].numTasksStolen.store(0);
+				workerCounters[async][i].sumIdleTime.store(0);
+			}
+		}
 	}
 
 
@@ -559,7 +688,9 @@ void SetThreadCount(int wantedNumThreads)
 				const float tAvgExecTime = tSumExecTime / std::max(ts.numTasksRun, uint64_t(1));
 				const float tAvgWaitTime = tSumWaitTime / std::max(ts.numTasksRun, uint64_t(1));
 
-				LOG(fmts[3], i, ts.numTasksRun,  tSumExecTime, tMinExecTime, tMaxExecTime, tAvgExecTime,  tSumWaitTime, tMinWaitTime, tMaxWaitTime, tAvgWaitTime);
+				const WorkerStats ws = GetWorkerStats(i, async);
+
+				LOG(fmts[3], i, ts.numTasksRun,  tSumExecTime, tMinExecTime, tMaxExecTime, tAvgExecTime,  tSumWaitTime, tMinWaitTime, tMaxWaitTime, tAvgWaitTime,  ws.numTasksStolen, ws.sumIdleTime * 1e-6f);
 			}
 		}
 	}
@@ -574,6 +705,11 @@ void SetMaximumThreadCount()
 		workerThreads[false].reserve(MAX_THREADS);
 		workerThreads[ true].reserve(MAX_THREADS);
 
+		#ifndef UNIT_TEST
+		numCorePartitions = configHandler->GetInt("WorkerThreadPartitionCount");
+		corePartitionIndex = configHandler->GetInt("WorkerThreadPartitionIndex");
+		#endif
+
 		// NOTE:
 		//   do *not* remove, this makes sure the profiler instance
 		//   exists before any thread creates a timer that accesses
@@ -591,7 +727,7 @@ void SetMaximumThreadCount()
 
 void SetDefaultThreadCount()
 {
-	std::uint32_t systemCores  = Threading::GetAvailableCoresMask();
+	std::uint32_t systemCores  = GetPartitionCoresMask(Threading::GetAvailableCoresMask());
 	std::uint32_t mainAffinity = systemCores;
 
 	#ifndef UNIT_TEST
@@ -632,6 +768,19 @@ void SetDefaultThreadCount()
 
 
 
+WorkerStats GetWorkerStats(int threadNum, bool async)
+{
+	const WorkerCounters& wc = workerCounters[async][threadNum];
+
+	return {
+		wc.numTasksRun.load(std::memory_order_relaxed),
+		wc.numTasksStolen.load(std::memory_order_relaxed),
+		wc.sumIdleTime.load(std::memory_order_relaxed),
+	};
+}
+
+
+
 void AddExtJob(spring::thread&& t) {
 	for (auto& et: extThreads) {
 		if (et.joinable())
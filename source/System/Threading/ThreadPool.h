@@ -4,14 +4,25 @@
 #define _THREADPOOL_H
 
 #ifndef THREADPOOL
+#include <algorithm>
+#include <cinttypes>
 #include  <functional>
+#include <future>
+#include <memory>
 #include "System/Threading/SpringThreading.h"
 
 namespace ThreadPool {
 	template<class F, class... Args>
-	static inline void Enqueue(F&& f, Args&&... args)
+	static inline auto Enqueue(F&& f, Args&&... args)
+	-> std::shared_ptr<std::future<typename std::result_of<F(Args...)>::type>>
 	{
-		f(args ...);
+		typedef typename std::result_of<F(Args...)>::type return_type;
+
+		// same contract as the pooled version, the task just runs inline
+		auto task = std::make_shared< std::packaged_task<return_type()> >(std::bind(f, args ...));
+		auto fut = std::make_shared<std::future<return_type>>(task->get_future());
+		(*task)();
+		return fut;
 	}
 
 	static inline void AddExtJob(spring::thread&& t) { t.join(); }
@@ -27,6 +38,15 @@ namespace ThreadPool {
 	static inline void NotifyWorkerThreads(bool force, bool async) {}
 	static inline bool HasThreads() { return false; }
 
+	struct WorkerStats {
+		std::uint64_t numTasksRun;
+		std::uint64_t numTasksStolen;
+		std::uint64_t sumIdleTime;
+	};
+
+	static inline WorkerStats GetWorkerStats(int threadNum, bool async) { return {0, 0, 0}; }
+	static inline int GetDefaultGrainSize(int numItems) { return (std::max(1, numItems)); }
+
 	static constexpr int MAX_THREADS = 1;
 }
 
@@ -49,6 +69,47 @@ static inline void for_mt2(int start, int end, unsigned worksize, const std::fun
 }
 
 
+template <typename F>
+static inline void parallel_for(int begin, int end, int grainSize, F f)
+{
+	for (int i = begin; i < end; i++) {
+		f(i);
+	}
+}
+
+template <typename F>
+static inline void parallel_for(int begin, int end, F f)
+{
+	parallel_for(begin, end, 0, std::move(f));
+}
+
+template <typename T, typename F, typename G>
+static inline T parallel_reduce(int begin, int end, int grainSize, T init, F f, G g)
+{
+	constexpr int MAX_CHUNKS = 256;
+
+	if (end <= begin)
+		return init;
+
+	// same chunking as the pooled version, folding order matches it
+	grainSize = std::max(grainSize, (end - begin + MAX_CHUNKS - 1) / MAX_CHUNKS);
+
+	for (int chunkBeg = begin; chunkBeg < end; chunkBeg += grainSize) {
+		const int chunkEnd = std::min(chunkBeg + grainSize, end);
+
+		T acc = f(chunkBeg);
+
+		for (int i = chunkBeg + 1; i < chunkEnd; i++) {
+			acc = g(acc, f(i));
+		}
+
+		init = g(init, acc);
+	}
+
+	return init;
+}
+
+
 static inline void parallel(const std::function<void()>&& f)
 {
 	f();
@@ -66,6 +127,7 @@ static inline auto parallel_reduce(F&& f, G&& g) -> typename std::result_of<F()>
 #include "System/Platform/Threading.h"
 #include "System/Threading/SpringThreading.h"
 
+#include <algorithm>
 #include  <array>
 #include <vector>
 #include <numeric>
@@ -107,7 +169,19 @@ namespace ThreadPool {
 	int GetNumThreads();
 	void NotifyWorkerThreads(bool force, bool async);
 
-	static constexpr int MAX_THREADS = 16;
+	struct WorkerStats {
+		std::uint64_t numTasksRun;
+		std::uint64_t numTasksStolen; // taken from the deque of another thread
+		std::uint64_t sumIdleTime; // ns spent sleeping while out of tasks
+	};
+
+	/// totals since the pool was (re)started; safe to call from any thread
+	WorkerStats GetWorkerStats(int threadNum, bool async);
+
+	// hard limit on the pool size, per-thread state should be sized
+	// by GetMaxThreads() which is usually a lot smaller (and depends
+	// on the WorkerThreadPartitionCount setting)
+	static constexpr int MAX_THREADS = 64;
 }
 
 
@@ -538,102 +612,62 @@ private:
 
 
 
-#if 0
+// executes [from, to) in chunks of <grain> indices, claimed one at a time
+// by whichever threads run the group; never allocates, <func> points to the
+// (by-value) functor in the frame of the parallel_for that is waiting on it
 template<typename F>
-class ForTaskGroup: public ITaskGroup
+class ChunkTaskGroup: public ITaskGroup
 {
 public:
-	typedef  TTaskGroup<F, void, int>  ChildTaskType;
-
-	ForTaskGroup(bool pooled) : ITaskGroup(false, pooled) {}
+	ChunkTaskGroup(bool pooled) : ITaskGroup(false, pooled) {}
 
-	void Enqueue(const int from, const int to, const int step, F& func)
+	void Enqueue(const int from, const int to, const int grain, F* func)
 	{
-		assert(to >= from);
+		assert(to > from);
+		assert(grain > 0);
 
-		remainingTasks.store((step == 1) ? (to - from) : ((to - from + step - 1) / step));
+		this->from  = from;
+		this->to    = to;
+		this->grain = grain;
+		this->func  = func;
 
-		childTasks.clear();
-		childTasks.reserve(remainingTasks);
+		numChunks = (to - from + grain - 1) / grain;
 
-		for (int i = 0; i < remainingTasks; i++) {
-			auto task = std::make_shared<ChildTaskType>(1);
-
-			task->Enqueue(func, from + (step * i));
-			task->wantedThread.store(1 + i % (ThreadPool::GetNumThreads() - 1));
-
-			childTasks.push_back(task);
-			ThreadPool::PushTaskGroup(task);
-		}
+		remainingTasks.store(numChunks);
+		ctr.store(0);
 	}
 
+	int NumChunks() const { return numChunks; }
 
+	bool IsSliceTask() const override { return true; }
 	bool ExecuteStep() override
 	{
-		bool isFinished = true;
+		const int chunk = ctr.fetch_add(1, std::memory_order_relaxed);
 
-		for (size_t n = 0; n < childTasks.size(); n++) {
-			isFinished &= (childTasks[n]->IsFinished() && !childTasks[n]->IsInJobQueue());
-		}
+		if (chunk >= numChunks)
+			return false;
 
-		if (!isFinished)
-			return true;
+		const int beg = from + chunk * grain;
+		const int end = std::min(beg + grain, to);
 
-		remainingTasks.store(0);
-		childTasks.clear();
-		return false;
-	}
-
-private:
-	std::vector< std::shared_ptr<ITaskGroup> > childTasks;
-};
-
-#else
-
-template<typename F>
-class ForTaskGroup: public ITaskGroup
-{
-public:
-	typedef  TTaskGroup<F, void, int>  ChildTaskType;
-
-	ForTaskGroup(bool pooled) : ITaskGroup(false, pooled) {}
-
-	void Enqueue(const int from, const int to, const int step, F& func)
-	{
-		assert(to >= from);
-
-		remainingTasks.store((step == 1) ? (to - from) : ((to - from + step - 1) / step));
-		ctr.store(0);
-
-		this->from = from;
-		this->to   = to;
-		this->step = step;
-		this->func = func;
-	}
-
-	bool IsSliceTask() const override { return true; }
-	bool ExecuteStep() override
-	{
-		const int i = from + (step * ctr.fetch_add(1, std::memory_order_relaxed));
-
-		if (i < to) {
-			func(i);
-			remainingTasks -= 1;
-			return true;
+		for (int i = beg; i < end; i++) {
+			(*func)(i);
 		}
 
-		return false;
+		remainingTasks.fetch_sub(1, std::memory_order_release);
+		return true;
 	}
 
 private:
 	std::atomic<int> ctr;
-	std::function<void(const int)> func;
 
-	int from;
-	int to;
-	int step;
+	F* func = nullptr;
+
+	int from = 0;
+	int to = 0;
+	int grain = 1;
+	int numChunks = 0;
 };
-#endif
 
 
 
@@ -678,11 +712,32 @@ struct TaskPool {
 
 
 
+namespace ThreadPool {
+	// about four chunks per thread, enough to even out uneven chunks
+	static inline int GetDefaultGrainSize(int numItems) { return (std::max(1, numItems / (GetNumThreads() * 4))); }
+}
+
+/**
+ * Calls f(i) for every i in [begin, end), split into chunks of <grainSize>
+ * consecutive indices that the pool threads (including the calling one)
+ * claim as they go. Grain sizes <= 0 pick one based on the number of
+ * threads; small loops should use a large grain (or none at all) so each
+ * chunk does enough work to be worth scheduling.
+ *
+ * <f> is taken by value and the task groups are recycled, so calls do not
+ * allocate; blocks until every index has been processed.
+ */
 template <typename F>
-static inline void for_mt(int start, int end, int step, F&& f)
+static inline void parallel_for(int begin, int end, int grainSize, F f)
 {
-	if (!ThreadPool::HasThreads() || ((end - start) < step)) {
-		for (int i = start; i < end; i += step) {
+	if (end <= begin)
+		return;
+
+	if (grainSize <= 0)
+		grainSize = ThreadPool::GetDefaultGrainSize(end - begin);
+
+	if (!ThreadPool::HasThreads() || (end - begin) <= grainSize) {
+		for (int i = begin; i < end; i++) {
 			f(i);
 		}
 		return;
@@ -691,27 +746,85 @@ static inline void for_mt(int start, int end, int step, F&& f)
 	SCOPED_MT_TIMER("ThreadPool::AddTask");
 
 	// static, so TaskGroup's are recycled
-	static TaskPool<ForTaskGroup, F> pool;
+	static TaskPool<ChunkTaskGroup, F> pool;
 	auto taskGroup = pool.GetTaskGroup();
 
-	taskGroup->Enqueue(start, end, step, f);
+	taskGroup->Enqueue(begin, end, grainSize, &f);
 	taskGroup->UpdateId();
 
 	assert(taskGroup->IsInJobQueue());
 
-	#if 0
-	ThreadPool::PushTaskGroup(taskGroup);
-	#else
-	// store the group in all worker queues s.t. each executes a slice
-	for (size_t i = 1; i < ThreadPool::GetNumThreads(); ++i) {
+	// store the group in (at most) as many worker queues as there are chunks
+	// beyond the one the calling thread takes, s.t. each executes a slice
+	for (int i = 1, n = std::min(ThreadPool::GetNumThreads(), taskGroup->NumChunks()); i < n; ++i) {
 		taskGroup->wantedThread.store(i);
 		ThreadPool::PushTaskGroup(taskGroup);
 	}
-	#endif
 
 	// make calling thread also run ExecuteLoop
 	ThreadPool::WaitForFinished(taskGroup);
+}
 
+template <typename F>
+static inline void parallel_for(int begin, int end, F f)
+{
+	parallel_for(begin, end, 0, std::move(f));
+}
+
+/**
+ * Folds f(i) for all i in [begin, end) into <init> with g(T, T) -> T. Each
+ * chunk is folded separately and the chunk results in index order by the
+ * calling thread, so the result does not depend on scheduling. It does on
+ * the chunk boundaries: synced code (e.g. floating-point sums) has to pass
+ * an explicit grain, the default one depends on the number of threads.
+ */
+template <typename T, typename F, typename G>
+static inline T parallel_reduce(int begin, int end, int grainSize, T init, F f, G g)
+{
+	// bounds the per-call chunk results kept on the stack
+	constexpr int MAX_CHUNKS = 256;
+
+	if (end <= begin)
+		return init;
+
+	if (grainSize <= 0)
+		grainSize = ThreadPool::GetDefaultGrainSize(end - begin);
+
+	grainSize = std::max(grainSize, (end - begin + MAX_CHUNKS - 1) / MAX_CHUNKS);
+
+	std::array<T, MAX_CHUNKS> results;
+
+	const int numChunks = (end - begin + grainSize - 1) / grainSize;
+
+	parallel_for(0, numChunks, 1, [&](const int chunk) {
+		const int chunkBeg = begin + chunk * grainSize;
+		const int chunkEnd = std::min(chunkBeg + grainSize, end);
+
+		T acc = f(chunkBeg);
+
+		for (int i = chunkBeg + 1; i < chunkEnd; i++) {
+			acc = g(acc, f(i));
+		}
+
+		results[chunk] = acc;
+	});
+
+	for (int chunk = 0; chunk < numChunks; chunk++) {
+		init = g(init, results[chunk]);
+	}
+
+	return init;
+}
+
+
+template <typename F>
+static inline void for_mt(int start, int end, int step, F&& f)
+{
+	if (end <= start)
+		return;
+
+	// one index per chunk, for_mt is meant for coarse items of work
+	parallel_for(0, (end - start + step - 1) / step, 1, [&](const int i) { f(start + step * i); });
 }
 
 template <typename F>
@@ -811,11 +924,9 @@ namespace ThreadPool {
 		auto task = new AsyncTask<F, Args...>(std::forward<F>(f), std::forward<Args>(args)...);
 		auto fut = task->GetFuture();
 
-		// minor hack: assume AsyncTask's will cause (heavy) disk IO
-		// although these can never block the main thread, the async
-		// workers might still be handed an uneven work distribution
-		task->wantedThread.store(1 + task->GetId() % (ThreadPool::GetNumThreads() - 1));
-
+		// not bound to any thread; idle async workers steal it from
+		// the deque of the calling thread, which balances (heavy) IO
+		// better than handing tasks out round-robin
 		ThreadPool::PushTaskGroup(task);
 		return fut;
 	}
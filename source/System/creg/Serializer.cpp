@@ -129,14 +129,31 @@ bool COutputStreamSerializer::IsWriting()
 
 COutputStreamSerializer::ObjectRef* COutputStreamSerializer::FindObjectRef(void* inst, creg::Class* objClass, bool isEmbedded)
 {
-	std::vector<ObjectRef*>& refs = ptrToId[inst];
-	for (auto& obj: refs) {
+	const auto it = ptrToId.find(inst);
+
+	if (it == ptrToId.end())
+		return nullptr;
+
+	for (ObjectRef* obj = it->second; obj != nullptr; obj = obj->nextRef) {
 		if (obj->isThisObject(inst, objClass, isEmbedded))
 			return obj;
 	}
 	return nullptr;
 }
 
+COutputStreamSerializer::ObjectRef* COutputStreamSerializer::AddObjectRef(void* inst, creg::Class* objClass, bool isEmbedded)
+{
+	objects.emplace_back(inst, objects.size(), isEmbedded, objClass);
+
+	ObjectRef* obj = &objects.back();
+	ObjectRef*& head = ptrToId[inst];
+
+	// deque never relocates its elements on push_back, so the chain stays valid
+	obj->nextRef = head;
+	head = obj;
+	return obj;
+}
+
 void COutputStreamSerializer::SerializeObject(Class* c, void* ptr, ObjectRef* objr)
 {
 	const unsigned objstart = stream->tellp();
@@ -194,18 +211,14 @@ void COutputStreamSerializer::SerializeObjectInstance(void* inst, creg::Class* o
 	// register the object, and mark it as embedded if a pointer was already referencing it
 	ObjectRef* obj = FindObjectRef(inst, objClass, true);
 	if (!obj) {
-		objects.emplace_back(inst, objects.size(), true, objClass);
-		obj = &objects.back();
-		ptrToId[inst].push_back(obj);
+		obj = AddObjectRef(inst, objClass, true);
 	} else if (obj->isEmbedded) {
 		throw std::string("Reserialization of embedded object (") + objClass->name + ")";
+	} else if (!obj->isPending) {
+		throw std::string("Object pointer was serialized (") + objClass->name + ")";
 	} else {
-		std::vector<ObjectRef*>::iterator it = std::find(pendingObjects.begin(), pendingObjects.end(), obj);
-		if (it == pendingObjects.end()) {
-			throw std::string("Object pointer was serialized (") + objClass->name + ")";
-		} else {
-			pendingObjects.erase(it);
-		}
+		// lazily dropped from pendingObjects by SavePackage
+		obj->isPending = false;
 	}
 	obj->class_ = objClass;
 	obj->isEmbedded = true;
@@ -224,9 +237,8 @@ void COutputStreamSerializer::SerializeObjectPtr(void** ptr, creg::Class* objCla
 		int id;
 		ObjectRef* obj = FindObjectRef(*ptr, objClass, false);
 		if (!obj) {
-			objects.emplace_back(*ptr, objects.size(), false, objClass);
-			obj = &objects.back();
-			ptrToId[*ptr].push_back(obj);
+			obj = AddObjectRef(*ptr, objClass, false);
+			obj->isPending = true;
 			pendingObjects.push_back(obj);
 		}
 		id = obj->id;
@@ -284,18 +296,23 @@ void COutputStreamSerializer::SavePackage(std::ostream* s, void* rootObj, Class*
 	obj->classIndex = 0;
 
 	// Insert the first object that will provide references to everything
-	objects.emplace_back(rootObj, objects.size(), false, rootObjClass);
-	obj = &objects.back();
-	ptrToId[rootObj].push_back(obj);
+	obj = AddObjectRef(rootObj, rootObjClass, false);
+	obj->isPending = true;
 	pendingObjects.push_back(obj);
 
 	// Save until all the referenced objects have been stored
+	std::vector<ObjectRef*> po;
 	while (!pendingObjects.empty())
 	{
-		const std::vector<ObjectRef*> po = pendingObjects;
-		pendingObjects.clear();
+		po.clear();
+		po.swap(pendingObjects);
 
 		for (ObjectRef* obj: po) {
+			// claimed in the meantime by SerializeObjectInstance
+			if (!obj->isPending)
+				continue;
+
+			obj->isPending = false;
 			SerializeObject(obj->class_, obj->ptr, obj);
 			//LOG_SL(LOG_SECTION_CREG_SERIALIZER, L_DEBUG, "Serialized %s size:%i", obj->class_->name.c_str(), sz);
 		}
@@ -379,6 +396,7 @@ void COutputStreamSerializer::SavePackage(std::ostream* s, void* rootObj, Class*
 	pendingObjects.clear();
 	objects.clear();
 	classSizes.clear();
+	classCounts.clear();
 }
 
 //-------------------------------------------------------------------------
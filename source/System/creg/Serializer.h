@@ -8,11 +8,12 @@
 
 #ifdef USING_CREG
 
-#include <map>
 #include <vector>
 #include <deque>
 #include <istream>
 
+#include "System/UnorderedMap.hpp"
+
 namespace creg {
 
 	/**
@@ -39,26 +40,35 @@ namespace creg {
 				id=0;
 				classIndex=0;
 				isEmbedded=false;
+				isPending=false;
 				class_=0;
+				nextRef=nullptr;
 			}
 			ObjectRef(void* ptr, int id, bool isEmbedded, Class* class_) {
 				this->ptr = ptr;
 				this->id=id;
 				classIndex=0;
 				this->isEmbedded=isEmbedded;
+				isPending=false;
 				this->class_=class_;
+				nextRef=nullptr;
 			}
 			ObjectRef(const ObjectRef&src) :memberGroups(src.memberGroups){
 				ptr=src.ptr;
 				id=src.id;
 				classIndex=src.classIndex;
 				isEmbedded=src.isEmbedded;
+				isPending=src.isPending;
 				class_=src.class_;
+				nextRef=src.nextRef;
 			}
 			void* ptr;
 			int id, classIndex;
 			bool isEmbedded;
+			bool isPending; // true while queued in pendingObjects
 			Class* class_;
+			// next ref sharing the same address (e.g. a struct embedded at offset 0)
+			ObjectRef* nextRef;
 			std::vector<COutputStreamSerializer::ObjectMemberGroup> memberGroups;
 			bool isThisObject(void* objPtr, Class* objClass, bool objEmbedded) const
 			{
@@ -81,11 +91,12 @@ namespace creg {
 		struct ClassRef;
 
 		std::ostream* stream;
-		std::map<void*,std::vector<ObjectRef*> > ptrToId;
+		// maps an address to the head of its intrusive ObjectRef::nextRef chain
+		spring::unsynced_map<void*, ObjectRef*> ptrToId;
 		std::deque<ObjectRef> objects;
 		std::vector<ObjectRef*> pendingObjects; // these objects still have to be saved
-		std::map<Class*, int> classSizes;
-		std::map<Class*, int> classCounts;
+		spring::unsynced_map<Class*, int> classSizes;
+		spring::unsynced_map<Class*, int> classCounts;
 
 		// Serialize all class names
 		void WriteObjectInfo();
@@ -93,6 +104,7 @@ namespace creg {
 		void WriteObjectRef(void* inst, Class* cls, bool embedded);
 
 		ObjectRef* FindObjectRef(void* inst, Class* objClass, bool isEmbedded);
+		ObjectRef* AddObjectRef(void* inst, Class* objClass, bool isEmbedded);
 
 		void SerializeObject(Class* c, void* ptr, ObjectRef* objr);
 